@@ -0,0 +1,33 @@
+/*
+ * Benchmark Helpers
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Small helpers shared by the benchmarks in this directory.
+ *             Header-only so each benchmark still builds from its own
+ *             source file.
+ */
+
+#pragma once
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+/**
+ * @brief 스레드 수 순서 1, 2, 4, ... (max 미만), max에서 다음 값을 구하는 함수
+ *
+ * max가 2의 거듭제곱이 아니어도 max를 한 번만 측정하고 끝납니다.
+ * 사용: for (int n = 1; n <= max; n = bench_next_count(n, max))
+ *
+ * @param n 현재 스레드 수
+ * @param max 최대 스레드 수
+ * @return 다음 스레드 수 (max보다 크면 끝)
+ */
+static inline int bench_next_count(int n, int max) {
+    if (n < max && n * 2 > max) {
+        return max;
+    }
+    return n * 2;
+}
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,131 @@
+/*
+ * Lock Contention Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Command-line front end for the contention harness in
+ *             kernel_contention.h. Runs every selected lock at every thread
+ *             count from 1 up to the maximum (doubling) and prints the
+ *             results as JSON.
+ *
+ *             The idle time outside the lock is hold_ns * ratio, so a ratio
+ *             of 0 keeps the lock permanently contended and a large ratio
+ *             approaches the uncontended case. -p pins the measuring
+ *             threads with a kernel_affinity.h placement such as "spread"
+ *             or "compact:0-3" (default: KERNEL_PLACEMENT, else unpinned).
+ *
+ * Usage     : bench_contention.exec [-t max_threads] [-s hold_ns] [-r idle_ratio]
+ *                                   [-d duration_ms] [-l lock[,lock...]] [-p placement]
+ */
+
+#include "bench_common.h"
+#include "kernel_contention.h"
+#include "kernel_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_HOLD_NS 200
+#define BENCH_DEFAULT_RATIO 4.0
+#define BENCH_DEFAULT_DURATION_MS 200
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-t max_threads] [-s hold_ns] [-r idle_ratio] [-d duration_ms] [-l lock[,lock...]]\n"
+                    "          [-p none|compact|spread[:cpulist]]\n"
+                    "       locks: mutex, semaphore, spin, ticket, futex, kmutex (default: all)\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief 쉼표로 구분된 잠금 이름 목록을 선택 배열로 바꾸는 함수
+ */
+static void parse_locks(const char *prog, const char *list, int *selected) {
+    char *copy = strdup(list);
+    char *save = NULL;
+
+    memset(selected, 0, sizeof(int) * KLOCK_COUNT);
+    for (char *tok = strtok_r(copy, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)) {
+        int kind = contention_lock_from_name(tok);
+        if (kind < 0) {
+            fprintf(stderr, "알 수 없는 잠금: %s\n", tok);
+            free(copy);
+            usage(prog);
+        }
+        selected[kind] = 1;
+    }
+    free(copy);
+}
+
+int main(int argc, char *argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = cpus > 1 ? (int)(cpus < 16 ? cpus : 16) : 4;
+    long hold_ns = BENCH_DEFAULT_HOLD_NS;
+    double ratio = BENCH_DEFAULT_RATIO;
+    long duration_ms = BENCH_DEFAULT_DURATION_MS;
+    int selected[KLOCK_COUNT];
+    KPlacement placement;
+    char placement_desc[256];
+    int opt;
+
+    for (int i = 0; i < KLOCK_COUNT; i++) {
+        selected[i] = 1;
+    }
+    kplacement_from_env(&placement, NULL);
+    while ((opt = getopt(argc, argv, "t:s:r:d:l:p:h")) != -1) {
+        switch (opt) {
+            case 't': max_threads = atoi(optarg); break;
+            case 's': hold_ns = atol(optarg); break;
+            case 'r': ratio = atof(optarg); break;
+            case 'd': duration_ms = atol(optarg); break;
+            case 'l': parse_locks(argv[0], optarg, selected); break;
+            case 'p':
+                if (kplacement_parse(&placement, optarg) != 0) {
+                    fprintf(stderr, "잘못된 배치: %s\n", optarg);
+                    usage(argv[0]);
+                }
+                break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (max_threads < 1 || max_threads > KCONTENTION_MAX_THREADS || hold_ns < 0 || hold_ns > 100000000L ||
+        ratio < 0.0 || ratio * (double)hold_ns > 1e9 || duration_ms <= 0) {
+        usage(argv[0]);
+    }
+
+    kplacement_format(&placement, placement_desc, sizeof(placement_desc));
+    printf("{\n  \"benchmark\": \"contention\",\n  \"max_threads\": %d,\n  \"hold_ns\": %ld,\n"
+           "  \"idle_ratio\": %.2f,\n  \"duration_ms\": %ld,\n  \"placement\": \"%s\",\n  \"results\": [\n",
+           max_threads, hold_ns, ratio, duration_ms, placement_desc);
+
+    int first = 1;
+    for (int threads = 1; threads <= max_threads; threads = bench_next_count(threads, max_threads)) {
+        for (int kind = 0; kind < KLOCK_COUNT; kind++) {
+            if (!selected[kind]) {
+                continue;
+            }
+
+            KContentionConfig config = {
+                .num_threads = threads,
+                .hold_ns = (uint32_t)hold_ns,
+                .idle_ns = (uint32_t)(ratio * (double)hold_ns + 0.5),
+                .duration_ms = (uint32_t)duration_ms,
+                .placement = &placement,
+            };
+            KContentionResult result;
+            char json[2048];
+
+            if (contention_run((KLockKind)kind, &config, &result) != 0) {
+                kernel_errExit("%s 잠금 측정 실패 (스레드 %d)", contention_lock_name((KLockKind)kind), threads);
+            }
+            contention_format_json(&result, json, sizeof(json));
+            printf("%s    %s", first ? "" : ",\n", json);
+            fflush(stdout);
+            first = 0;
+        }
+    }
+
+    printf("\n  ]\n}\n");
+    return 0;
+}
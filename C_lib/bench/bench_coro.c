@@ -0,0 +1,207 @@
+/*
+ * Coroutine Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Measures the coroutine runtime in kernel_coro.h and prints the
+ *             results as JSON.
+ *
+ *             Scenarios:
+ *               switch    a few coroutines yield to each other; reports the
+ *                         cost of one round trip through the runtime
+ *               spawn     n simulated processes, each sleeping a random few
+ *                         milliseconds a few times before exiting
+ *               pingpong  pairs of coroutines bounce a byte over pipes with
+ *                         kcoro_wait_fd, so every hop goes through epoll
+ *
+ * Usage     : bench_coro.exec [-n processes] [-y yields] [-p pairs]
+ */
+
+#include "kernel_coro.h"
+#include "kernel_engine.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_PROCESSES 100000L
+#define BENCH_DEFAULT_YIELDS 1000000L
+#define BENCH_DEFAULT_PAIRS 64
+#define BENCH_SWITCH_COROS 4
+#define BENCH_PINGPONG_HOPS 2000
+#define BENCH_SLEEP_ROUNDS 3
+
+typedef struct {
+    long yields;
+} SwitchArg;
+
+typedef struct {
+    int in_fd;
+    int out_fd;
+    int hops;
+} PongArg;
+
+static long processes_done = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n processes] [-y yields] [-p pairs]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+static void switch_body(void *arg) {
+    SwitchArg *sa = (SwitchArg *)arg;
+    for (long i = 0; i < sa->yields; i++) {
+        kcoro_yield();
+    }
+}
+
+/**
+ * @brief 모의 프로세스: 몇 번 짧게 잠든 뒤 종료
+ */
+static void process_body(void *arg) {
+    unsigned seed = (unsigned)(uintptr_t)arg;
+    for (int round = 0; round < BENCH_SLEEP_ROUNDS; round++) {
+        seed = seed * 1103515245u + 12345u;
+        kcoro_sleep_us(1000 + (seed >> 16) % 4000);
+    }
+    processes_done++;
+}
+
+static void pong_body(void *arg) {
+    PongArg *pa = (PongArg *)arg;
+    char byte = 0;
+
+    for (int i = 0; i < pa->hops; i++) {
+        if (kcoro_wait_fd(pa->in_fd, KCORO_READABLE, -1) <= 0 || read(pa->in_fd, &byte, 1) != 1) {
+            kernel_errExit("pingpong 읽기 실패");
+        }
+        if (write(pa->out_fd, &byte, 1) != 1) {
+            kernel_errExit("pingpong 쓰기 실패");
+        }
+    }
+}
+
+/**
+ * @brief 직전 시나리오 이후의 런타임 통계 변화를 JSON 한 줄로 출력하는 함수 (peak_live는 누적 최대값)
+ */
+static void print_stats(const char *name, uint64_t elapsed_ns, const char *extra, int last) {
+    static KCoroStats previous;
+    KCoroStats now, stats;
+
+    kcoro_get_stats(&now);
+    stats.spawned = now.spawned - previous.spawned;
+    stats.switches = now.switches - previous.switches;
+    stats.peak_live = now.peak_live;
+    stats.stacks = now.stacks - previous.stacks;
+    stats.unguarded = now.unguarded - previous.unguarded;
+    stats.polls = now.polls - previous.polls;
+    previous = now;
+
+    printf("    { \"scenario\": \"%s\", \"elapsed_ms\": %.3f, %s, \"spawned\": %llu, \"switches\": %llu, "
+           "\"peak_live\": %llu, \"stacks\": %llu, \"unguarded\": %llu, \"polls\": %llu }%s\n",
+           name, (double)elapsed_ns / 1e6, extra, (unsigned long long)stats.spawned,
+           (unsigned long long)stats.switches, (unsigned long long)stats.peak_live,
+           (unsigned long long)stats.stacks, (unsigned long long)stats.unguarded,
+           (unsigned long long)stats.polls, last ? "" : ",");
+}
+
+int main(int argc, char *argv[]) {
+    long processes = BENCH_DEFAULT_PROCESSES;
+    long yields = BENCH_DEFAULT_YIELDS;
+    int pairs = BENCH_DEFAULT_PAIRS;
+    char extra[256];
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:y:p:h")) != -1) {
+        switch (opt) {
+            case 'n': processes = atol(optarg); break;
+            case 'y': yields = atol(optarg); break;
+            case 'p': pairs = atoi(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (processes < 1 || yields < 1 || pairs < 1) {
+        usage(argv[0]);
+    }
+
+    printf("{\n  \"benchmark\": \"coroutine\",\n  \"results\": [\n");
+
+    // 1. 전환 비용
+    SwitchArg sa = { yields / BENCH_SWITCH_COROS };
+    for (int i = 0; i < BENCH_SWITCH_COROS; i++) {
+        kcoro_spawn(switch_body, &sa);
+    }
+    uint64_t begin = now_ns();
+    if (kcoro_run() != 0) {
+        kernel_errExit("switch 실행 실패");
+    }
+    uint64_t elapsed = now_ns() - begin;
+    long total = sa.yields * BENCH_SWITCH_COROS;
+    snprintf(extra, sizeof(extra), "\"yields\": %ld, \"ns_per_yield\": %.1f", total, (double)elapsed / (double)total);
+    print_stats("switch", elapsed, extra, 0);
+
+    // 2. 대량 모의 프로세스
+    begin = now_ns();
+    for (long i = 0; i < processes; i++) {
+        if (kcoro_spawn(process_body, (void *)(uintptr_t)(i + 1)) < 0) {
+            kernel_errExit("코루틴 %ld 생성 실패", i);
+        }
+    }
+    uint64_t spawned_at = now_ns();
+    if (kcoro_run() != 0) {
+        kernel_errExit("spawn 실행 실패");
+    }
+    elapsed = now_ns() - begin;
+    if (processes_done != processes) {
+        kernel_errExit("완료된 프로세스 수 불일치 (%ld / %ld)", processes_done, processes);
+    }
+    snprintf(extra, sizeof(extra), "\"processes\": %ld, \"spawn_ns_each\": %.1f",
+             processes, (double)(spawned_at - begin) / (double)processes);
+    print_stats("spawn", elapsed, extra, 0);
+
+    // 3. 파이프 핑퐁 (A -> B -> A ...)
+    PongArg *args = (PongArg *)calloc((size_t)pairs * 2, sizeof(PongArg));
+    int (*fds)[4] = calloc((size_t)pairs, sizeof(*fds));
+    if (args == NULL || fds == NULL) {
+        kernel_errExit("pingpong 메모리 할당 실패");
+    }
+    for (int i = 0; i < pairs; i++) {
+        if (pipe(&fds[i][0]) != 0 || pipe(&fds[i][2]) != 0) {
+            kernel_errExit("pipe 생성 실패");
+        }
+        args[2 * i] = (PongArg){ fds[i][0], fds[i][3], BENCH_PINGPONG_HOPS };
+        args[2 * i + 1] = (PongArg){ fds[i][2], fds[i][1], BENCH_PINGPONG_HOPS };
+        kcoro_spawn(pong_body, &args[2 * i]);
+        kcoro_spawn(pong_body, &args[2 * i + 1]);
+        if (write(fds[i][1], "x", 1) != 1) {
+            kernel_errExit("pingpong 시작 실패");
+        }
+    }
+    begin = now_ns();
+    if (kcoro_run() != 0) {
+        kernel_errExit("pingpong 실행 실패");
+    }
+    elapsed = now_ns() - begin;
+    long hops = (long)pairs * 2 * BENCH_PINGPONG_HOPS;
+    snprintf(extra, sizeof(extra), "\"pairs\": %d, \"hops\": %ld, \"ns_per_hop\": %.1f",
+             pairs, hops, (double)elapsed / (double)hops);
+    print_stats("pingpong", elapsed, extra, 1);
+    for (int i = 0; i < pairs; i++) {
+        for (int j = 0; j < 4; j++) {
+            close(fds[i][j]);
+        }
+    }
+    free(fds);
+    free(args);
+
+    printf("  ]\n}\n");
+    return 0;
+}
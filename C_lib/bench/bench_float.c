@@ -0,0 +1,340 @@
+/*
+ * Float Formatting Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Checks and times the float paths of the printf library and
+ *             prints the results as JSON.
+ *
+ *             Checks:
+ *               float32 round trip  kernel_ftoa -> strtof gives the same
+ *                                   bits (every pattern with -x, otherwise
+ *                                   every stride-th), plus how often the
+ *                                   result is longer than the shortest
+ *                                   "%.Ne" that round-trips (every
+ *                                   stride-th pattern only). A longer
+ *                                   result counts as a failure.
+ *               double round trip   kernel_dtoa -> strtod and the same
+ *                                   shortest check on random bits
+ *               fixed precision     kernel_snprintf against glibc snprintf
+ *                                   for %f %e %g with random precision,
+ *                                   width and flags. '#' with %g is left
+ *                                   out: glibc drops the trailing zeros C
+ *                                   requires when rounding adds a digit.
+ *
+ *             Designs (ns per value):
+ *               kernel_fixed / glibc_fixed   "%.3f %10.2f %e %g"
+ *               kernel_dtoa / glibc_17g      shortest double vs "%.17g"
+ *               kernel_ftoa / glibc_9g       shortest float vs "%.9g"
+ *
+ *             Exits with status 1 when any check fails. -c runs the checks
+ *             only; "make bench-float-check" runs the float32 round trip over
+ *             every bit pattern.
+ *
+ * Usage     : bench_float.exec [-n values] [-s stride] [-x] [-c]
+ */
+
+#include "kernel_dtoa.h"
+#include "kernel_engine.h"
+#include "kernel_print_sink.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_VALUES 200000L
+#define BENCH_DEFAULT_STRIDE 4099u
+#define BENCH_VALUE_POOL     4096
+
+typedef enum {
+    DESIGN_KERNEL_FIXED,
+    DESIGN_GLIBC_FIXED,
+    DESIGN_KERNEL_DTOA,
+    DESIGN_GLIBC_17G,
+    DESIGN_KERNEL_FTOA,
+    DESIGN_GLIBC_9G,
+    DESIGN_COUNT
+} BenchDesign;
+
+static const char *design_names[] = { "kernel_fixed", "glibc_fixed", "kernel_dtoa",
+                                      "glibc_17g",    "kernel_ftoa", "glibc_9g" };
+
+static volatile size_t format_sink;     /* 결과가 최적화로 사라지지 않게 함 */
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/**
+ * @brief 10^k (|k| <= 22면 정확한 값)
+ */
+static double power_of_ten(int k) {
+    double r = 1.0;
+    for (int i = 0; i < (k < 0 ? -k : k); i++) {
+        r *= 10.0;
+    }
+    return k < 0 ? 1.0 / r : r;
+}
+
+/**
+ * @brief 유효 숫자 개수를 세는 함수 (부호, 소수점, 지수, 앞뒤의 0 제외)
+ */
+static int significant_digits(const char *s) {
+    const char *first = NULL;
+    const char *last = NULL;
+
+    for (; *s != '\0' && *s != 'e'; s++) {
+        if (*s >= '1' && *s <= '9') {
+            if (first == NULL) {
+                first = s;
+            }
+            last = s;
+        }
+    }
+    if (first == NULL) {
+        return 1;
+    }
+    int n = 0;
+    for (const char *p = first; p <= last; p++) {
+        n += *p >= '0' && *p <= '9';
+    }
+    return n;
+}
+
+/**
+ * @brief float 하나의 왕복과 최단 여부를 확인하는 함수
+ *
+ * @param bits float 비트 패턴
+ * @param shortest 최단 여부까지 확인할지 (snprintf를 여러 번 부르므로 느림)
+ * @return 0: 정상, 1: 왕복 실패, 2: 더 짧은 표현이 있음
+ */
+static int check_float(uint32_t bits, int shortest) {
+    char buf[KDTOA_BUFFER_SIZE];
+    float value;
+    float back;
+    uint32_t back_bits;
+
+    memcpy(&value, &bits, sizeof(value));
+    if (isnan(value)) {
+        return 0;
+    }
+    kernel_ftoa(value, buf);
+    back = strtof(buf, NULL);
+    memcpy(&back_bits, &back, sizeof(back_bits));
+    if (back_bits != bits) {
+        return 1;
+    }
+    if (!shortest || isinf(value) || value == 0.0f) {
+        return 0;
+    }
+    // 왕복하는 가장 짧은 %.Ne보다 길면 최단이 아님
+    int digits = significant_digits(buf);
+    for (int p = 0; p + 1 < digits; p++) {
+        char ref[32];
+        snprintf(ref, sizeof(ref), "%.*e", p, (double)value);
+        if (strtof(ref, NULL) == value) {
+            return 2;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief float32 왕복을 확인하고 결과를 출력하는 함수
+ *
+ * @return 실패 수 (왕복 실패와 최단이 아닌 결과)
+ */
+static uint64_t report_float32(int exhaustive, uint32_t stride) {
+    uint64_t checked = 0;
+    uint64_t failures = 0;
+    uint64_t longer = 0;
+    uint64_t first_failure = UINT64_MAX;
+    uint64_t begin = now_ns();
+
+    for (uint64_t bits = 0; bits <= UINT32_MAX; bits += exhaustive ? 1 : stride) {
+        int r = check_float((uint32_t)bits, bits % stride == 0);
+        checked++;
+        if (r == 1) {
+            failures++;
+            if (first_failure == UINT64_MAX) {
+                first_failure = bits;
+            }
+        } else if (r == 2) {
+            longer++;
+        }
+    }
+    double elapsed = (double)(now_ns() - begin) / 1e9;
+
+    printf("  \"float32_roundtrip\": {\"exhaustive\": %s, \"checked\": %llu, \"failures\": %llu, ",
+           exhaustive ? "true" : "false", (unsigned long long)checked, (unsigned long long)failures);
+    if (first_failure != UINT64_MAX) {
+        printf("\"first_failure\": \"0x%08llx\", ", (unsigned long long)first_failure);
+    }
+    printf("\"shortest_checked\": %llu, \"not_shortest\": %llu, \"elapsed_s\": %.1f},\n",
+           (unsigned long long)(UINT32_MAX / stride + 1), (unsigned long long)longer, elapsed);
+    return failures + longer;
+}
+
+static long report_double(long values) {
+    char buf[KDTOA_BUFFER_SIZE];
+    long failures = 0;
+    long longer = 0;
+
+    for (long i = 0; i < values; i++) {
+        uint64_t bits = next_random();
+        double value;
+        double back;
+        memcpy(&value, &bits, sizeof(value));
+        if (isnan(value)) {
+            continue;
+        }
+        kernel_dtoa(value, buf);
+        back = strtod(buf, NULL);
+        if (memcmp(&back, &value, sizeof(value)) != 0) {
+            failures++;
+            continue;
+        }
+        int digits = significant_digits(buf);
+        for (int p = 0; p + 1 < digits; p++) {
+            char ref[40];
+            snprintf(ref, sizeof(ref), "%.*e", p, value);
+            if (strtod(ref, NULL) == value) {
+                longer++;
+                break;
+            }
+        }
+    }
+    printf("  \"double_roundtrip\": {\"checked\": %ld, \"failures\": %ld, \"not_shortest\": %ld},\n", values,
+           failures, longer);
+    return failures + longer;
+}
+
+static long report_fixed(long values) {
+    static const char conversions[] = "fFeEgG";
+    static const char *flag_sets[] = { "", "-", "+", " ", "0", "#", "+0", "-#", " 0" };
+    char mine[1024];
+    char ref[1024];
+    long mismatches = 0;
+
+    for (long i = 0; i < values; i++) {
+        uint64_t bits = next_random();
+        double value;
+        char format[32];
+
+        if (i % 2 == 0) {
+            memcpy(&value, &bits, sizeof(value));
+        } else {
+            // 반올림 경계가 잦은 짧은 10진수
+            value = (double)(int64_t)(bits % 2000001 - 1000000) / power_of_ten((int)(next_random() % 8));
+        }
+        char conv = conversions[next_random() % 6];
+        const char *flags = flag_sets[next_random() % 9];
+        if ((conv == 'g' || conv == 'G') && strchr(flags, '#') != NULL) {
+            flags = "";
+        }
+        snprintf(format, sizeof(format), "%%%s%d.%d%c", flags, (int)(next_random() % 30), (int)(next_random() % 25),
+                 conv);
+        int a = kernel_snprintf(mine, sizeof(mine), format, value);
+        int b = snprintf(ref, sizeof(ref), format, value);
+        mismatches += a != b || strcmp(mine, ref) != 0;
+    }
+    printf("  \"fixed_vs_glibc\": {\"checked\": %ld, \"mismatches\": %ld},\n", values, mismatches);
+    return mismatches;
+}
+
+static void run_design(BenchDesign design, const double *pool, long values, int first) {
+    char line[256];
+    uint64_t begin = now_ns();
+
+    for (long i = 0; i < values; i++) {
+        double v = pool[i % BENCH_VALUE_POOL];
+        switch (design) {
+            case DESIGN_KERNEL_FIXED:
+                format_sink += (size_t)kernel_snprintf(line, sizeof(line), "%.3f %10.2f %e %g", v, v, v, v);
+                break;
+            case DESIGN_GLIBC_FIXED:
+                format_sink += (size_t)snprintf(line, sizeof(line), "%.3f %10.2f %e %g", v, v, v, v);
+                break;
+            case DESIGN_KERNEL_DTOA:
+                format_sink += (size_t)kernel_dtoa(v, line);
+                break;
+            case DESIGN_GLIBC_17G:
+                format_sink += (size_t)snprintf(line, sizeof(line), "%.17g", v);
+                break;
+            case DESIGN_KERNEL_FTOA:
+                format_sink += (size_t)kernel_ftoa((float)v, line);
+                break;
+            default:
+                format_sink += (size_t)snprintf(line, sizeof(line), "%.9g", (double)(float)v);
+                break;
+        }
+    }
+    uint64_t elapsed = now_ns() - begin;
+
+    printf("%s    {\"design\": \"%s\", \"values\": %ld, \"elapsed_ms\": %.3f, \"ns_per_value\": %.1f}",
+           first ? "" : ",\n", design_names[design], values, (double)elapsed / 1e6,
+           (double)elapsed / (double)values);
+    fflush(stdout);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n values] [-s stride] [-x] [-c]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    long values = BENCH_DEFAULT_VALUES;
+    uint32_t stride = BENCH_DEFAULT_STRIDE;
+    int exhaustive = 0;
+    int check_only = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:xch")) != -1) {
+        switch (opt) {
+            case 'n': values = atol(optarg); break;
+            case 's': stride = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'x': exhaustive = 1; break;
+            case 'c': check_only = 1; break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (values < 1 || stride < 1) {
+        usage(argv[0]);
+    }
+
+    // 텔레메트리 값처럼 크기가 다양한 값 (지수 -10 ~ 10)
+    double *pool = (double *)malloc(sizeof(double) * BENCH_VALUE_POOL);
+    if (pool == NULL) {
+        kernel_errExit("malloc 실패");
+    }
+    for (int i = 0; i < BENCH_VALUE_POOL; i++) {
+        double mantissa = (double)(next_random() >> 11) / 9007199254740992.0;
+        pool[i] = (i % 2 ? -1 : 1) * mantissa * power_of_ten((int)(next_random() % 21) - 10);
+    }
+
+    printf("{\n  \"benchmark\": \"float\",\n");
+    uint64_t failures = report_float32(exhaustive, stride);
+    failures += (uint64_t)report_double(values);
+    failures += (uint64_t)report_fixed(values);
+    printf("  \"results\": [\n");
+    for (int d = 0; d < DESIGN_COUNT && !check_only; d++) {
+        run_design((BenchDesign)d, pool, values, d == 0);
+    }
+    printf("\n  ]\n}\n");
+    free(pool);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
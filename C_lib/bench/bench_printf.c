@@ -0,0 +1,218 @@
+/*
+ * Printf Output Path Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Compares kernel_printf under each flush mode of
+ *             kernel_print_sink.h with glibc and prints the results as JSON.
+ *
+ *             Designs:
+ *               kernel_unbuffered  one sink write per byte (the old path)
+ *               kernel_call        one sink write per kernel_printf call
+ *               kernel_line        complete lines at the end of a call
+ *               kernel_full        only when the 4 KB buffer fills
+ *               glibc_fprintf      fprintf on a fully buffered FILE
+ *               glibc_dprintf      dprintf, one write per call
+ *               kernel_snprintf    kernel_snprintf into a stack buffer
+ *               glibc_snprintf     snprintf into a stack buffer
+ *               kernel_interp      kernel_call with the format compiler off
+ *                                  (every call re-parsed by the az_* code)
+ *               kernel_snprintf_int  integer-heavy line (32/64-bit %d %u %x %p)
+ *               glibc_snprintf_int   the same line through snprintf
+ *
+ *             Output goes to /dev/null unless -o names a file. The kernel
+ *             designs use a sink that counts its write(2) calls; glibc
+ *             system calls are not counted. The snprintf designs only
+ *             format and never write.
+ *
+ * Usage     : bench_printf.exec [-n lines] [-o output]
+ */
+
+#include "kernel_engine.h"
+#include "kernel_format.h"
+#include "kernel_print.h"
+#include "kernel_print_sink.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_LINES 200000L
+
+typedef enum {
+    DESIGN_KERNEL_UNBUFFERED,
+    DESIGN_KERNEL_CALL,
+    DESIGN_KERNEL_LINE,
+    DESIGN_KERNEL_FULL,
+    DESIGN_GLIBC_FPRINTF,
+    DESIGN_GLIBC_DPRINTF,
+    DESIGN_KERNEL_SNPRINTF,
+    DESIGN_GLIBC_SNPRINTF,
+    DESIGN_KERNEL_INTERP,
+    DESIGN_KERNEL_SNPRINTF_INT,
+    DESIGN_GLIBC_SNPRINTF_INT,
+    DESIGN_COUNT
+} BenchDesign;
+
+static const char *design_names[] = { "kernel_unbuffered", "kernel_call", "kernel_line", "kernel_full",
+                                      "glibc_fprintf", "glibc_dprintf", "kernel_snprintf", "glibc_snprintf",
+                                      "kernel_interp", "kernel_snprintf_int", "glibc_snprintf_int" };
+
+static volatile size_t snprintf_sink;   /* snprintf 결과가 최적화로 사라지지 않게 함 */
+
+/**
+ * @struct CountingSink
+ * @brief 쓰기 호출 수와 바이트 수를 세는 싱크 문맥
+ */
+typedef struct CountingSink {
+    int fd;
+    uint64_t writes;
+    uint64_t bytes;
+} CountingSink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void counting_write(void *ctx, const char *data, size_t len) {
+    CountingSink *cs = (CountingSink *)ctx;
+    cs->writes++;
+    cs->bytes += len;
+    kernel_print_fd_write((void *)(intptr_t)cs->fd, data, len);
+}
+
+/**
+ * @brief 콘솔 도구의 출력을 흉내 낸 한 줄 (세 가지 형태를 번갈아 출력)
+ */
+static void emit_line(BenchDesign design, FILE *fp, int fd, long i) {
+    static const char *states[] = { "running", "sleeping", "stopped" };
+    const char *state = states[i % 3];
+
+    switch (design) {
+        case DESIGN_GLIBC_FPRINTF:
+            fprintf(fp, "proc %ld: state=%s cpu=%ld\n", i, state, i % 64);
+            break;
+        case DESIGN_GLIBC_DPRINTF:
+            dprintf(fd, "proc %ld: state=%s cpu=%ld\n", i, state, i % 64);
+            break;
+        case DESIGN_KERNEL_SNPRINTF: {
+            char line[128];
+            snprintf_sink += (size_t)kernel_snprintf(line, sizeof(line), "proc %d: state=%s cpu=%d\n", (int)i, state,
+                                                     (int)(i % 64));
+            break;
+        }
+        case DESIGN_GLIBC_SNPRINTF: {
+            char line[128];
+            snprintf_sink += (size_t)snprintf(line, sizeof(line), "proc %ld: state=%s cpu=%ld\n", i, state, i % 64);
+            break;
+        }
+        case DESIGN_KERNEL_SNPRINTF_INT: {
+            char line[160];
+            snprintf_sink += (size_t)kernel_snprintf(line, sizeof(line), "pid=%d tid=%u seq=%lld addr=%p bytes=%zu flags=%#x\n",
+                                                     (int)i, (unsigned)(i * 7), (long long)i * 1000003LL, (void *)line,
+                                                     (size_t)i * 4096, (unsigned)i);
+            break;
+        }
+        case DESIGN_GLIBC_SNPRINTF_INT: {
+            char line[160];
+            snprintf_sink += (size_t)snprintf(line, sizeof(line), "pid=%d tid=%u seq=%lld addr=%p bytes=%zu flags=%#x\n",
+                                              (int)i, (unsigned)(i * 7), (long long)i * 1000003LL, (void *)line,
+                                              (size_t)i * 4096, (unsigned)i);
+            break;
+        }
+        default:
+            kernel_printf("proc %d: state=%s cpu=%d\n", (int)i, state, (int)(i % 64));
+            break;
+    }
+}
+
+static void run_design(BenchDesign design, int fd, long lines, int first) {
+    CountingSink counter = { fd, 0, 0 };
+    KPrintSink sink = { counting_write, &counter };
+    FILE *fp = NULL;
+
+    switch (design) {
+        case DESIGN_KERNEL_UNBUFFERED: kernel_print_set_flush_mode(KPRINT_UNBUFFERED); break;
+        case DESIGN_KERNEL_CALL:       kernel_print_set_flush_mode(KPRINT_FLUSH_CALL); break;
+        case DESIGN_KERNEL_LINE:       kernel_print_set_flush_mode(KPRINT_FLUSH_LINE); break;
+        case DESIGN_KERNEL_FULL:       kernel_print_set_flush_mode(KPRINT_FLUSH_FULL); break;
+        case DESIGN_KERNEL_INTERP:     kfmt_set_enabled(0); break;
+        case DESIGN_GLIBC_FPRINTF:
+            fp = fdopen(dup(fd), "w");
+            if (fp == NULL) {
+                kernel_errExit("fdopen 실패");
+            }
+            setvbuf(fp, NULL, _IOFBF, KPRINT_BUFFER_SIZE);
+            break;
+        default:
+            break;
+    }
+    kernel_print_set_sink(&sink);
+
+    uint64_t begin = now_ns();
+    for (long i = 0; i < lines; i++) {
+        emit_line(design, fp, fd, i);
+    }
+    kernel_print_flush();
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    uint64_t elapsed = now_ns() - begin;
+
+    kernel_print_set_sink(NULL);
+    kernel_print_set_flush_mode(KPRINT_FLUSH_CALL);
+    kfmt_set_enabled(1);
+
+    printf("%s    {\"design\": \"%s\", \"lines\": %ld, \"elapsed_ms\": %.3f, \"ns_per_line\": %.1f, ",
+           first ? "" : ",\n", design_names[design], lines, (double)elapsed / 1e6, (double)elapsed / (double)lines);
+    if (design < DESIGN_GLIBC_FPRINTF || design == DESIGN_KERNEL_SNPRINTF || design == DESIGN_KERNEL_INTERP ||
+        design == DESIGN_KERNEL_SNPRINTF_INT) {
+        printf("\"writes\": %llu, \"writes_per_line\": %.3f, \"bytes\": %llu}", (unsigned long long)counter.writes,
+               (double)counter.writes / (double)lines, (unsigned long long)counter.bytes);
+    } else {
+        printf("\"writes\": null, \"writes_per_line\": null, \"bytes\": null}");
+    }
+    fflush(stdout);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n lines] [-o output]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    long lines = BENCH_DEFAULT_LINES;
+    const char *output = "/dev/null";
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:o:h")) != -1) {
+        switch (opt) {
+            case 'n': lines = atol(optarg); break;
+            case 'o': output = optarg; break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (lines < 1) {
+        usage(argv[0]);
+    }
+
+    int fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        kernel_errExit("%s 열기 실패", output);
+    }
+
+    printf("{\n  \"benchmark\": \"printf\",\n  \"output\": \"%s\",\n  \"results\": [\n", output);
+    for (int d = 0; d < DESIGN_COUNT; d++) {
+        // 바이트마다 write하는 경로는 느리므로 줄 수를 줄여 측정
+        long n = d == DESIGN_KERNEL_UNBUFFERED && lines > 20000 ? 20000 : lines;
+        run_design((BenchDesign)d, fd, n, d == 0);
+    }
+    printf("\n  ]\n}\n");
+    close(fd);
+    return 0;
+}
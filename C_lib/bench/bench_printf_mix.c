@@ -0,0 +1,489 @@
+/*
+ * Printf Format Mix Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Runs representative format mixes through kernel_printf and
+ *             glibc, to a file descriptor and to memory, prints the results
+ *             as JSON and optionally compares them with a saved baseline.
+ *
+ *             Mixes:
+ *               ints     %d %u %x %ld %lld %hd %zu, negative and 64-bit values
+ *               strings  five %s fields of different lengths
+ *               floats   %.3f %8.2f %e %g %.10g
+ *               padding  %-12s %08d %+6d %#10x %*d %-8.3s %5c
+ *               long     a ~310-byte log line with a 101-byte %s
+ *
+ *             Targets:
+ *               kernel_fd   kernel_printf through an fd sink (default flush mode)
+ *               glibc_fd    fprintf on a FILE with glibc's default buffering,
+ *                           i.e. what printf does when stdout is a file
+ *               kernel_mem  kernel_snprintf into a stack buffer
+ *               glibc_mem   snprintf into a stack buffer
+ *
+ *             Every one of the -r rounds runs all cases once, each kernel
+ *             target right before its glibc counterpart. ns_per_call is the
+ *             best round. vs_glibc is the median over rounds of kernel time
+ *             over glibc time (kernel_fd / glibc_fd, kernel_mem / glibc_mem)
+ *             taken from the same round, so both sides of each ratio ran
+ *             under the same machine load.
+ *             syscalls_per_call counts write-type system calls from
+ *             /proc/self/io (syscw) and is null where the kernel does not
+ *             provide it. Before timing, each mix is formatted by
+ *             kernel_snprintf and snprintf and the two strings compared
+ *             ("checks").
+ *
+ *             Baselines are earlier outputs of this program. With -b, each
+ *             kernel target is matched by mix and target; a regression is a
+ *             vs_glibc more than -t percent above the baseline's, or more
+ *             system calls per call. Comparing against glibc in the same run
+ *             cancels machine speed and load, which raw ns do not. The exit
+ *             status is 1 when there is a regression. kernel_fd carries one
+ *             write(2) per call that glibc_fd does not, so its ratio moves
+ *             with system call cost; its system call count is exact.
+ *
+ *             The mixes need the format compiler (length modifiers, %e %g
+ *             and '*' are unknown to the az_* interpreter), so the program
+ *             refuses to run with KERNEL_PRINTF_COMPILE=0.
+ *
+ * Usage     : bench_printf_mix.exec [-n calls] [-r repeats] [-o output]
+ *                                   [-b baseline.json] [-t percent]
+ */
+
+#include "kernel_engine.h"
+#include "kernel_format.h"
+#include "kernel_print.h"
+#include "kernel_print_sink.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_CALLS     20000L
+#define BENCH_DEFAULT_REPEATS   25
+#define BENCH_DEFAULT_THRESHOLD 15.0
+#define BENCH_LINE_SIZE         512
+
+/* 시스템 호출 수가 이만큼 늘면 회귀로 봄 (호출당) */
+#define BENCH_SYSCALL_SLACK 0.01
+
+typedef enum { MIX_INTS, MIX_STRINGS, MIX_FLOATS, MIX_PADDING, MIX_LONG, MIX_COUNT } BenchMix;
+typedef enum { TARGET_KERNEL_FD, TARGET_GLIBC_FD, TARGET_KERNEL_MEM, TARGET_GLIBC_MEM, TARGET_COUNT } BenchTarget;
+
+static const char *mix_names[] = { "ints", "strings", "floats", "padding", "long" };
+static const char *target_names[] = { "kernel_fd", "glibc_fd", "kernel_mem", "glibc_mem" };
+
+/**
+ * @struct BenchResult
+ * @brief 한 (mix, target) 조합의 측정 결과
+ */
+typedef struct BenchResult {
+    double ns_per_call;
+    double syscalls_per_call;   /**< 셀 수 없으면 음수 */
+    double vs_glibc;            /**< 짝이 되는 glibc 경로 대비 시간 비율 (glibc 경로는 음수) */
+} BenchResult;
+
+static volatile size_t result_sink;     /* snprintf 결과가 최적화로 사라지지 않게 함 */
+
+static const char *hosts[] = { "node-a", "build-server-17", "x", "scheduler.internal.example" };
+static const char *words[] = { "ok", "running", "queue drained after rebalance", "", "timeout" };
+static const char long_reason[] =
+    "cpu3 runqueue exceeded its share for 4 consecutive ticks while cpu1 and cpu2 were idle; moved 3 tasks";
+
+/*
+ * target에 맞는 함수로 한 번 출력 (포맷 리터럴과 인자는 네 경로에 그대로 전달)
+ */
+#define EMIT(target, fp, buf, ...)                                                        \
+    switch (target) {                                                                     \
+        case TARGET_KERNEL_FD:                                                            \
+            kernel_printf(__VA_ARGS__);                                                   \
+            break;                                                                        \
+        case TARGET_GLIBC_FD:                                                             \
+            fprintf(fp, __VA_ARGS__);                                                     \
+            break;                                                                        \
+        case TARGET_KERNEL_MEM:                                                           \
+            result_sink += (size_t)kernel_snprintf(buf, BENCH_LINE_SIZE, __VA_ARGS__);    \
+            break;                                                                        \
+        default:                                                                          \
+            result_sink += (size_t)snprintf(buf, BENCH_LINE_SIZE, __VA_ARGS__);           \
+            break;                                                                        \
+    }
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 지금까지의 쓰기 계열 시스템 호출 수 (/proc/self/io의 syscw)
+ *
+ * @return 호출 수, 읽을 수 없으면 -1
+ */
+static long long write_syscalls(void) {
+    char line[128];
+    long long count = -1;
+    FILE *fp = fopen("/proc/self/io", "r");
+
+    if (fp == NULL) {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (sscanf(line, "syscw: %lld", &count) == 1) {
+            break;
+        }
+    }
+    fclose(fp);
+    return count;
+}
+
+/**
+ * @brief 호출 번호 i에 해당하는 인자로 mix 한 줄을 출력하는 함수
+ */
+static void emit_mix(BenchMix mix, BenchTarget target, FILE *fp, char *buf, long i) {
+    switch (mix) {
+        case MIX_INTS:
+            EMIT(target, fp, buf, "id=%d seq=%u mask=%x off=%ld total=%lld delta=%hd size=%zu\n", (int)(i - 5000),
+                 (unsigned)i * 2654435761u, (unsigned)i * 40503u, -(long)i * 977, (long long)i * 1000000007LL,
+                 (short)(i % 2000 - 1000), (size_t)i * 4096);
+            break;
+        case MIX_STRINGS:
+            EMIT(target, fp, buf, "%s@%s: %s [%s] %s\n", words[i % 5], hosts[i % 4], words[(i + 1) % 5],
+                 hosts[(i + 2) % 4], words[(i + 3) % 5]);
+            break;
+        case MIX_FLOATS: {
+            double v = (double)(i % 20001 - 10000) / 64.0 + (double)i * 1e-7;
+            EMIT(target, fp, buf, "t=%.3f load=%8.2f rate=%e val=%g ratio=%.10g\n", v, v / 3.0, v * 1e5, v / 7.0,
+                 1.0 / (double)(i + 3));
+            break;
+        }
+        case MIX_PADDING:
+            EMIT(target, fp, buf, "[%-12s|%08d|%+6d|%#10x|%*d|%-8.3s|%5c]\n", hosts[i % 4], (int)(i % 100000),
+                 (int)(i % 201 - 100), (unsigned)i, (int)(i % 9), (int)(i % 1000), words[i % 5],
+                 (int)('a' + i % 26));
+            break;
+        default:
+            EMIT(target, fp, buf,
+                 "[%06ld] sched: worker pool rebalanced after tick %lu; depth=%d runnable=%u blocked=%u "
+                 "migrated=%d latency_us=%ld node=%s reason=\"%s\" (see the per-cpu breakdown and affinity masks "
+                 "in the scheduler log)\n",
+                 i % 1000000, (unsigned long)i * 3, (int)(i % 512), (unsigned)(i % 64), (unsigned)(i % 7),
+                 (int)(i % 5), (long)(i % 100000), hosts[i % 4], long_reason);
+            break;
+    }
+}
+
+/**
+ * @brief 각 mix를 kernel_snprintf와 snprintf로 만들어 결과가 같은지 확인하는 함수
+ *
+ * @param line_bytes 표본 줄의 평균 길이
+ * @return 같으면 1
+ */
+static int check_mix(BenchMix mix, double *line_bytes) {
+    char mine[BENCH_LINE_SIZE];
+    char ref[BENCH_LINE_SIZE];
+    size_t total = 0;
+    int samples = 0;
+    int identical = 1;
+
+    for (long i = 0; i < 1000; i += 37) {
+        emit_mix(mix, TARGET_KERNEL_MEM, NULL, mine, i);
+        emit_mix(mix, TARGET_GLIBC_MEM, NULL, ref, i);
+        identical &= strcmp(mine, ref) == 0;
+        total += strlen(ref);
+        samples++;
+    }
+    *line_bytes = (double)total / (double)samples;
+    return identical;
+}
+
+static BenchTarget glibc_counterpart(BenchTarget target) {
+    return target == TARGET_KERNEL_FD ? TARGET_GLIBC_FD : TARGET_GLIBC_MEM;
+}
+
+static int is_kernel_target(BenchTarget target) {
+    return target == TARGET_KERNEL_FD || target == TARGET_KERNEL_MEM;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief mix와 target 하나를 calls번 출력하는 시간을 재는 함수
+ *
+ * @param result 시스템 호출 수를 저장할 위치
+ * @return 호출당 ns
+ */
+static double measure_case(BenchMix mix, BenchTarget target, int fd, long calls, BenchResult *result) {
+    KPrintSink sink = { kernel_print_fd_write, (void *)(intptr_t)fd };
+    char buf[BENCH_LINE_SIZE];
+    FILE *fp = NULL;
+
+    kernel_print_set_sink(&sink);
+    if (target == TARGET_GLIBC_FD) {
+        fp = fdopen(dup(fd), "w");
+        if (fp == NULL) {
+            kernel_errExit("fdopen 실패");
+        }
+    }
+    long long sys_begin = write_syscalls();
+    uint64_t begin = now_ns();
+    for (long i = 0; i < calls; i++) {
+        emit_mix(mix, target, fp, buf, i);
+    }
+    kernel_print_flush();
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    uint64_t elapsed = now_ns() - begin;
+    long long sys_end = write_syscalls();
+    kernel_print_set_sink(NULL);
+
+    result->syscalls_per_call = sys_begin >= 0 && sys_end >= 0 ? (double)(sys_end - sys_begin) / (double)calls : -1.0;
+    return (double)elapsed / (double)calls;
+}
+
+/**
+ * @brief 라운드별 측정값으로 결과를 채우는 함수
+ *
+ * @param samples [라운드][mix][target] 순서의 호출당 ns
+ */
+static void summarize(const double *samples, int repeats, BenchResult results[MIX_COUNT][TARGET_COUNT]) {
+    double *ratios = (double *)malloc(sizeof(double) * (size_t)repeats);
+    if (ratios == NULL) {
+        kernel_errExit("malloc 실패");
+    }
+    for (int m = 0; m < MIX_COUNT; m++) {
+        for (int t = 0; t < TARGET_COUNT; t++) {
+            BenchTarget pair = glibc_counterpart((BenchTarget)t);
+            BenchResult *r = &results[m][t];
+
+            r->ns_per_call = samples[m * TARGET_COUNT + t];
+            for (int k = 0; k < repeats; k++) {
+                const double *round = samples + (size_t)k * MIX_COUNT * TARGET_COUNT + m * TARGET_COUNT;
+                if (round[t] < r->ns_per_call) {
+                    r->ns_per_call = round[t];
+                }
+                ratios[k] = round[t] / round[pair];
+            }
+            if (is_kernel_target((BenchTarget)t)) {
+                qsort(ratios, (size_t)repeats, sizeof(double), compare_double);
+                r->vs_glibc = repeats % 2 ? ratios[repeats / 2]
+                                          : (ratios[repeats / 2 - 1] + ratios[repeats / 2]) / 2.0;
+            } else {
+                r->vs_glibc = -1.0;
+            }
+        }
+    }
+    free(ratios);
+}
+
+/**
+ * @brief 한 줄에서 "key": "value" 문자열 값을 꺼내는 함수
+ *
+ * @return 찾으면 1
+ */
+static int json_string(const char *line, const char *key, char *out, size_t size) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\": \"", key);
+    const char *p = strstr(line, pattern);
+    if (p == NULL) {
+        return 0;
+    }
+    p += strlen(pattern);
+    size_t n = 0;
+    while (p[n] != '\0' && p[n] != '"' && n + 1 < size) {
+        out[n] = p[n];
+        n++;
+    }
+    out[n] = '\0';
+    return 1;
+}
+
+/**
+ * @brief 한 줄에서 "key": 숫자 값을 꺼내는 함수 (null이면 음수)
+ *
+ * @return 찾으면 1
+ */
+static int json_number(const char *line, const char *key, double *out) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+    const char *p = strstr(line, pattern);
+    if (p == NULL) {
+        return 0;
+    }
+    p += strlen(pattern);
+    *out = strncmp(p, "null", 4) == 0 ? -1.0 : strtod(p, NULL);
+    return 1;
+}
+
+/**
+ * @brief 기준 JSON 파일에서 결과를 읽는 함수 (항목마다 처음 나온 줄만 사용)
+ *
+ * @param found 읽은 항목 표시
+ */
+static void load_baseline(const char *path, BenchResult base[MIX_COUNT][TARGET_COUNT],
+                          int found[MIX_COUNT][TARGET_COUNT]) {
+    char line[1024];
+    FILE *fp = fopen(path, "r");
+
+    if (fp == NULL) {
+        kernel_errExit("%s 열기 실패", path);
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char mix[32];
+        char target[32];
+        double ns;
+        double sys;
+        double ratio;
+        if (!json_string(line, "mix", mix, sizeof(mix)) || !json_string(line, "target", target, sizeof(target)) ||
+            !json_number(line, "ns_per_call", &ns)) {
+            continue;
+        }
+        if (!json_number(line, "syscalls_per_call", &sys)) {
+            sys = -1.0;
+        }
+        if (!json_number(line, "vs_glibc", &ratio)) {
+            ratio = -1.0;
+        }
+        for (int m = 0; m < MIX_COUNT; m++) {
+            for (int t = 0; t < TARGET_COUNT; t++) {
+                if (!found[m][t] && strcmp(mix, mix_names[m]) == 0 && strcmp(target, target_names[t]) == 0) {
+                    base[m][t].ns_per_call = ns;
+                    base[m][t].syscalls_per_call = sys;
+                    base[m][t].vs_glibc = ratio;
+                    found[m][t] = 1;
+                }
+            }
+        }
+    }
+    fclose(fp);
+}
+
+/**
+ * @brief 결과를 기준과 비교해 출력하는 함수
+ *
+ * @return 회귀 개수
+ */
+static int report_baseline(const char *path, double threshold, BenchResult results[MIX_COUNT][TARGET_COUNT]) {
+    static BenchResult base[MIX_COUNT][TARGET_COUNT];
+    static int found[MIX_COUNT][TARGET_COUNT];
+    int regressions = 0;
+    int first = 1;
+
+    load_baseline(path, base, found);
+    printf(",\n  \"baseline\": {\"file\": \"%s\", \"threshold_pct\": %.1f, \"compared\": [\n", path, threshold);
+    for (int m = 0; m < MIX_COUNT; m++) {
+        for (int t = 0; t < TARGET_COUNT; t++) {
+            if (!found[m][t] || !is_kernel_target((BenchTarget)t) || base[m][t].vs_glibc <= 0.0) {
+                continue;
+            }
+            const BenchResult *cur = &results[m][t];
+            const BenchResult *old = &base[m][t];
+            double change = (cur->vs_glibc / old->vs_glibc - 1.0) * 100.0;
+            int slower = change > threshold;
+            int more_syscalls = cur->syscalls_per_call >= 0.0 && old->syscalls_per_call >= 0.0 &&
+                                cur->syscalls_per_call > old->syscalls_per_call + BENCH_SYSCALL_SLACK;
+            regressions += slower || more_syscalls;
+
+            printf("%s    {\"mix\": \"%s\", \"target\": \"%s\", \"baseline_vs_glibc\": %.3f, "
+                   "\"current_vs_glibc\": %.3f, \"change_pct\": %.1f, \"regression\": %s%s}",
+                   first ? "" : ",\n", mix_names[m], target_names[t], old->vs_glibc, cur->vs_glibc, change,
+                   slower || more_syscalls ? "true" : "false", more_syscalls ? ", \"cause\": \"syscalls\"" : "");
+            first = 0;
+        }
+    }
+    printf("\n  ], \"regressions\": %d}", regressions);
+    return regressions;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n calls] [-r repeats] [-o output] [-b baseline.json] [-t percent]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    static BenchResult results[MIX_COUNT][TARGET_COUNT];
+    long calls = BENCH_DEFAULT_CALLS;
+    int repeats = BENCH_DEFAULT_REPEATS;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+    const char *output = "/dev/null";
+    const char *baseline = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:o:b:t:h")) != -1) {
+        switch (opt) {
+            case 'n': calls = atol(optarg); break;
+            case 'r': repeats = atoi(optarg); break;
+            case 'o': output = optarg; break;
+            case 'b': baseline = optarg; break;
+            case 't': threshold = strtod(optarg, NULL); break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (calls < 1 || repeats < 1 || threshold < 0.0) {
+        usage(argv[0]);
+    }
+    if (!kfmt_enabled()) {
+        kernel_fatal("포맷 컴파일러가 꺼져 있음 (KERNEL_PRINTF_COMPILE=0은 지원하지 않음)");
+    }
+
+    int fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        kernel_errExit("%s 열기 실패", output);
+    }
+
+    printf("{\n  \"benchmark\": \"printf_mix\",\n  \"output\": \"%s\",\n  \"calls\": %ld,\n  \"repeats\": %d,\n",
+           output, calls, repeats);
+    printf("  \"checks\": [\n");
+    for (int m = 0; m < MIX_COUNT; m++) {
+        double line_bytes;
+        int identical = check_mix((BenchMix)m, &line_bytes);
+        printf("%s    {\"mix\": \"%s\", \"identical\": %s, \"line_bytes\": %.1f}", m == 0 ? "" : ",\n",
+               mix_names[m], identical ? "true" : "false", line_bytes);
+    }
+    printf("\n  ],\n  \"results\": [\n");
+    fflush(stdout);
+    double *samples = (double *)malloc(sizeof(double) * (size_t)repeats * MIX_COUNT * TARGET_COUNT);
+    if (samples == NULL) {
+        kernel_errExit("malloc 실패");
+    }
+    for (int r = 0; r < repeats; r++) {
+        for (int m = 0; m < MIX_COUNT; m++) {
+            for (int t = 0; t < TARGET_COUNT; t++) {
+                samples[((size_t)r * MIX_COUNT + m) * TARGET_COUNT + t] =
+                    measure_case((BenchMix)m, (BenchTarget)t, fd, calls, &results[m][t]);
+            }
+        }
+    }
+    summarize(samples, repeats, results);
+    free(samples);
+    for (int m = 0; m < MIX_COUNT; m++) {
+        for (int t = 0; t < TARGET_COUNT; t++) {
+            BenchResult *r = &results[m][t];
+            printf("%s    {\"mix\": \"%s\", \"target\": \"%s\", \"ns_per_call\": %.1f, ", m + t == 0 ? "" : ",\n",
+                   mix_names[m], target_names[t], r->ns_per_call);
+            if (r->vs_glibc > 0.0) {
+                printf("\"vs_glibc\": %.3f, ", r->vs_glibc);
+            }
+            if (r->syscalls_per_call >= 0.0) {
+                printf("\"syscalls_per_call\": %.4f}", r->syscalls_per_call);
+            } else {
+                printf("\"syscalls_per_call\": null}");
+            }
+        }
+    }
+    printf("\n  ]");
+
+    int regressions = baseline != NULL ? report_baseline(baseline, threshold, results) : 0;
+    printf("\n}\n");
+    close(fd);
+    return regressions > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,238 @@
+/*
+ * Queue Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Compares the engine queues under producer/consumer load and
+ *             prints the results as JSON.
+ *
+ *             Designs:
+ *               mutex_list  LinkedList from kernel_engine.h behind one mutex
+ *               bounded     Vyukov MPMC ring (kernel_queue.h)
+ *               unbounded   fetch-and-add segment queue (kernel_queue.h)
+ *
+ *             Every run uses P producers and P consumers. Producers push
+ *             the values 1..n, consumers pop until all items are taken,
+ *             and the sum of popped values is checked.
+ *
+ * Usage     : bench_queue.exec [-n items] [-t max_pairs] [-c bounded_capacity]
+ */
+
+#include "bench_common.h"
+#include "kernel_engine.h"
+#include "kernel_queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_ITEMS 1000000L
+#define BENCH_DEFAULT_CAPACITY 1024
+
+typedef enum {
+    DESIGN_MUTEX_LIST,
+    DESIGN_BOUNDED,
+    DESIGN_UNBOUNDED
+} BenchDesign;
+
+static const char *design_names[] = { "mutex_list", "bounded", "unbounded" };
+
+/**
+ * @struct BenchShared
+ * @brief 한 번의 측정에서 모든 스레드가 공유하는 상태
+ */
+typedef struct BenchShared {
+    BenchDesign design;
+    LinkedList *list;
+    pthread_mutex_t list_mutex;
+    BoundedQueue *bounded;
+    UnboundedQueue *unbounded;
+    long per_producer;          /**< 생산자당 push 수 */
+    long total;                 /**< 전체 원소 수 */
+    long consumed;              /**< 소비된 원소 수 */
+    unsigned long long sum;     /**< 소비된 값의 합 (검증용) */
+    int ready;                  /**< 준비된 스레드 수 */
+    int go;                     /**< 측정 시작 신호 */
+} BenchShared;
+
+static int first_result = 1;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 결과 한 건을 JSON 객체로 출력하는 함수
+ */
+static void emit_result(const char *design, int pairs, long ops, uint64_t elapsed_ns, int valid) {
+    double ns_per_op = ops > 0 ? (double)elapsed_ns / (double)ops : 0.0;
+    double mops = elapsed_ns > 0 ? (double)ops * 1000.0 / (double)elapsed_ns : 0.0;
+
+    printf("%s    {\"design\": \"%s\", \"producers\": %d, \"consumers\": %d, \"ops\": %ld, "
+           "\"elapsed_ns\": %llu, \"ns_per_op\": %.2f, \"mops_per_sec\": %.2f, \"valid\": %s}",
+           first_result ? "" : ",\n", design, pairs, pairs, ops,
+           (unsigned long long)elapsed_ns, ns_per_op, mops, valid ? "true" : "false");
+    first_result = 0;
+}
+
+static void wait_for_start(BenchShared *shared) {
+    // macOS에는 pthread_barrier가 없으므로 간단한 시작 게이트 사용
+    __atomic_add_fetch(&shared->ready, 1, __ATOMIC_ACQ_REL);
+    while (!__atomic_load_n(&shared->go, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void *producer_main(void *arg) {
+    BenchShared *shared = (BenchShared *)arg;
+
+    wait_for_start(shared);
+    for (long i = 1; i <= shared->per_producer; i++) {
+        void *item = (void *)(uintptr_t)i;
+        switch (shared->design) {
+            case DESIGN_MUTEX_LIST:
+                pthread_mutex_lock(&shared->list_mutex);
+                push(shared->list, item);
+                pthread_mutex_unlock(&shared->list_mutex);
+                break;
+            case DESIGN_BOUNDED:
+                while (!bounded_queue_push(shared->bounded, item)) {
+                    sched_yield();
+                }
+                break;
+            case DESIGN_UNBOUNDED:
+                unbounded_queue_push(shared->unbounded, item);
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void *consumer_main(void *arg) {
+    BenchShared *shared = (BenchShared *)arg;
+    unsigned long long sum = 0;
+    long pending = 0;
+
+    wait_for_start(shared);
+    while (__atomic_load_n(&shared->consumed, __ATOMIC_RELAXED) < shared->total) {
+        void *item = NULL;
+        switch (shared->design) {
+            case DESIGN_MUTEX_LIST:
+                pthread_mutex_lock(&shared->list_mutex);
+                if (!is_empty(shared->list)) {
+                    item = pop(shared->list);
+                }
+                pthread_mutex_unlock(&shared->list_mutex);
+                break;
+            case DESIGN_BOUNDED:
+                item = bounded_queue_pop(shared->bounded);
+                break;
+            case DESIGN_UNBOUNDED:
+                item = unbounded_queue_pop(shared->unbounded);
+                break;
+        }
+
+        // 공유 카운터 갱신은 모아서 하되, 큐가 비면 바로 반영하여 종료 조건을 놓치지 않음
+        if (item == NULL) {
+            if (pending > 0) {
+                __atomic_add_fetch(&shared->consumed, pending, __ATOMIC_RELAXED);
+                pending = 0;
+            }
+            sched_yield();
+            continue;
+        }
+        sum += (uintptr_t)item;
+        if (++pending == 64) {
+            __atomic_add_fetch(&shared->consumed, pending, __ATOMIC_RELAXED);
+            pending = 0;
+        }
+    }
+    __atomic_add_fetch(&shared->consumed, pending, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&shared->sum, sum, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+/**
+ * @brief 생산자/소비자 P쌍으로 한 설계를 측정하는 함수
+ */
+static void bench_design(BenchDesign design, int pairs, long items, size_t capacity) {
+    BenchShared shared = { 0 };
+    pthread_t *tids = (pthread_t *)malloc(sizeof(pthread_t) * (size_t)pairs * 2);
+
+    shared.design = design;
+    shared.per_producer = items / pairs;
+    shared.total = shared.per_producer * pairs;
+    pthread_mutex_init(&shared.list_mutex, NULL);
+    shared.list = create_linkedlist();
+    shared.bounded = create_bounded_queue(capacity);
+    shared.unbounded = create_unbounded_queue();
+
+    for (int i = 0; i < pairs; i++) {
+        if (pthread_create(&tids[i], NULL, producer_main, &shared) != 0 ||
+            pthread_create(&tids[pairs + i], NULL, consumer_main, &shared) != 0) {
+            kernel_errExit("벤치마크 스레드 %d 생성 실패", i);
+        }
+    }
+
+    while (__atomic_load_n(&shared.ready, __ATOMIC_ACQUIRE) < pairs * 2) {
+        sched_yield();
+    }
+    uint64_t begin = now_ns();
+    __atomic_store_n(&shared.go, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < pairs * 2; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    uint64_t elapsed = now_ns() - begin;
+
+    unsigned long long expected = (unsigned long long)pairs *
+                                  (unsigned long long)shared.per_producer * (unsigned long long)(shared.per_producer + 1) / 2;
+    emit_result(design_names[design], pairs, shared.total * 2, elapsed, shared.sum == expected);
+
+    destroy_linkedlist(shared.list);
+    destroy_bounded_queue(shared.bounded);
+    destroy_unbounded_queue(shared.unbounded);
+    pthread_mutex_destroy(&shared.list_mutex);
+    free(tids);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n items] [-t max_pairs] [-c bounded_capacity]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    long items = BENCH_DEFAULT_ITEMS;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_pairs = cpus > 1 ? (int)(cpus / 2 < 8 ? cpus / 2 : 8) : 1;
+    long capacity = BENCH_DEFAULT_CAPACITY;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:c:h")) != -1) {
+        switch (opt) {
+            case 'n': items = atol(optarg); break;
+            case 't': max_pairs = atoi(optarg); break;
+            case 'c': capacity = atol(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (items <= 0 || max_pairs <= 0 || capacity <= 0) {
+        usage(argv[0]);
+    }
+
+    printf("{\n  \"benchmark\": \"queue\",\n  \"items\": %ld,\n  \"max_pairs\": %d,\n  \"bounded_capacity\": %ld,\n  \"results\": [\n",
+           items, max_pairs, capacity);
+
+    for (int pairs = 1; pairs <= max_pairs; pairs = bench_next_count(pairs, max_pairs)) {
+        for (int d = DESIGN_MUTEX_LIST; d <= DESIGN_UNBOUNDED; d++) {
+            bench_design((BenchDesign)d, pairs, items, (size_t)capacity);
+        }
+    }
+
+    printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * Scheduler Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Compares the work-stealing scheduler in kernel_sched.h with
+ *             the thread-per-task path the engine used before it (one
+ *             pthread_create/pthread_join per task) and prints the results
+ *             as JSON.
+ *
+ *             Scenarios:
+ *               for    sum a hashed value over n items, split into
+ *                      workers * 8 chunks
+ *               spawn  t small independent tasks
+ *
+ *             Each scenario runs once per path and checks that both
+ *             produce the same sum.
+ *
+ * Usage     : bench_sched.exec [-n items] [-t tasks] [-w workers]
+ */
+
+#include "kernel_engine.h"
+#include "kernel_sched.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_ITEMS 20000000L
+#define BENCH_DEFAULT_TASKS 20000L
+#define BENCH_CHUNKS_PER_WORKER 8
+#define BENCH_TASK_ITEMS 256
+
+/**
+ * @struct ChunkArg
+ * @brief 한 작업이 처리할 구간과 결과
+ */
+typedef struct ChunkArg {
+    size_t begin;
+    size_t end;
+    uint64_t sum;
+} ChunkArg;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n items] [-t tasks] [-w workers]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief 최적화로 사라지지 않는 항목별 작업 (splitmix64 해시)
+ */
+static inline uint64_t item_value(size_t i) {
+    uint64_t z = (uint64_t)i + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t sum_range(size_t begin, size_t end) {
+    uint64_t sum = 0;
+    for (size_t i = begin; i < end; i++) {
+        sum += item_value(i);
+    }
+    return sum;
+}
+
+static void chunk_body(void *arg) {
+    ChunkArg *chunk = (ChunkArg *)arg;
+    chunk->sum = sum_range(chunk->begin, chunk->end);
+}
+
+static void *chunk_thread(void *arg) {
+    chunk_body(arg);
+    return NULL;
+}
+
+static void for_body(size_t begin, size_t end, void *ctx) {
+    ChunkArg *chunks = (ChunkArg *)ctx;
+    for (size_t c = begin; c < end; c++) {
+        chunk_body(&chunks[c]);
+    }
+}
+
+static void split_chunks(ChunkArg *chunks, long count, size_t items_each) {
+    for (long i = 0; i < count; i++) {
+        chunks[i].begin = (size_t)i * items_each;
+        chunks[i].end = chunks[i].begin + items_each;
+        chunks[i].sum = 0;
+    }
+}
+
+static uint64_t total_sum(const ChunkArg *chunks, long count) {
+    uint64_t sum = 0;
+    for (long i = 0; i < count; i++) {
+        sum += chunks[i].sum;
+    }
+    return sum;
+}
+
+/**
+ * @brief 작업마다 스레드를 만들고 모두 join하는 기존 방식
+ *
+ * 한 번에 너무 많은 스레드가 살아 있지 않도록 batch개씩 나눠 실행합니다.
+ */
+static void run_thread_per_task(ChunkArg *chunks, long count, long batch) {
+    pthread_t *threads = (pthread_t *)malloc((size_t)batch * sizeof(pthread_t));
+    if (threads == NULL) {
+        kernel_errExit("스레드 목록 메모리 할당 실패");
+    }
+
+    for (long first = 0; first < count; first += batch) {
+        long n = count - first < batch ? count - first : batch;
+        for (long i = 0; i < n; i++) {
+            int err = pthread_create(&threads[i], NULL, chunk_thread, &chunks[first + i]);
+            if (err != 0) {
+                kernel_errExitEN(err, "작업 스레드 %ld 생성 실패", first + i);
+            }
+        }
+        for (long i = 0; i < n; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    free(threads);
+}
+
+static void run_spawn(ChunkArg *chunks, long count) {
+    KTaskGroup tg = KTASK_GROUP_INIT;
+    for (long i = 0; i < count; i++) {
+        task_group_spawn(&tg, chunk_body, &chunks[i]);
+    }
+    task_group_wait(&tg);
+}
+
+static void print_result(const char *scenario, const char *path, long tasks, uint64_t elapsed_ns,
+                         uint64_t sum, int last) {
+    printf("    { \"scenario\": \"%s\", \"path\": \"%s\", \"tasks\": %ld, \"elapsed_ms\": %.3f, "
+           "\"us_per_task\": %.3f, \"sum\": %llu }%s\n",
+           scenario, path, tasks, (double)elapsed_ns / 1e6, (double)elapsed_ns / 1e3 / (double)tasks,
+           (unsigned long long)sum, last ? "" : ",");
+}
+
+int main(int argc, char *argv[]) {
+    long items = BENCH_DEFAULT_ITEMS;
+    long tasks = BENCH_DEFAULT_TASKS;
+    int workers = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:w:h")) != -1) {
+        switch (opt) {
+            case 'n': items = atol(optarg); break;
+            case 't': tasks = atol(optarg); break;
+            case 'w': workers = atoi(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (items < 1 || tasks < 1 || workers < 0) {
+        usage(argv[0]);
+    }
+
+    ksched_init(workers);
+    workers = ksched_num_workers();
+
+    long chunk_count = (long)workers * BENCH_CHUNKS_PER_WORKER;
+    if (chunk_count > items) {
+        chunk_count = items;
+    }
+    long alloc_count = chunk_count > tasks ? chunk_count : tasks;
+    ChunkArg *chunks = (ChunkArg *)malloc((size_t)alloc_count * sizeof(ChunkArg));
+    if (chunks == NULL) {
+        kernel_errExit("작업 메모리 할당 실패");
+    }
+
+    printf("{\n  \"benchmark\": \"scheduler\",\n  \"workers\": %d,\n  \"items\": %ld,\n  \"results\": [\n",
+           workers, items);
+
+    // 1. 큰 구간 분할: 남는 항목은 버려 두 경로가 같은 구간을 처리하도록 함
+    size_t items_each = (size_t)(items / chunk_count);
+    split_chunks(chunks, chunk_count, items_each);
+    uint64_t begin = now_ns();
+    run_thread_per_task(chunks, chunk_count, chunk_count);
+    uint64_t elapsed = now_ns() - begin;
+    uint64_t expected = total_sum(chunks, chunk_count);
+    print_result("for", "thread_per_task", chunk_count, elapsed, expected, 0);
+
+    split_chunks(chunks, chunk_count, items_each);
+    begin = now_ns();
+    parallel_for(0, (size_t)chunk_count, 1, for_body, chunks);
+    elapsed = now_ns() - begin;
+    uint64_t sum = total_sum(chunks, chunk_count);
+    if (sum != expected) {
+        kernel_errExit("for 합계 불일치 (%llu / %llu)", (unsigned long long)sum, (unsigned long long)expected);
+    }
+    print_result("for", "work_stealing", chunk_count, elapsed, sum, 0);
+
+    // 2. 작은 작업 대량 생성
+    split_chunks(chunks, tasks, BENCH_TASK_ITEMS);
+    begin = now_ns();
+    run_thread_per_task(chunks, tasks, (long)workers * BENCH_CHUNKS_PER_WORKER);
+    elapsed = now_ns() - begin;
+    expected = total_sum(chunks, tasks);
+    print_result("spawn", "thread_per_task", tasks, elapsed, expected, 0);
+
+    split_chunks(chunks, tasks, BENCH_TASK_ITEMS);
+    begin = now_ns();
+    run_spawn(chunks, tasks);
+    elapsed = now_ns() - begin;
+    sum = total_sum(chunks, tasks);
+    if (sum != expected) {
+        kernel_errExit("spawn 합계 불일치 (%llu / %llu)", (unsigned long long)sum, (unsigned long long)expected);
+    }
+    print_result("spawn", "work_stealing", tasks, elapsed, sum, 1);
+
+    printf("  ]\n}\n");
+    free(chunks);
+    ksched_shutdown();
+    return 0;
+}
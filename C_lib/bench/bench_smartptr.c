@@ -0,0 +1,398 @@
+/*
+ * Smart Pointer Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Measures the reference-counting primitives in
+ *             kernel_smartptr.h / kernel_uniqueptr.h against lock-free
+ *             alternatives and prints the results as JSON.
+ *
+ *             Designs:
+ *               mutex      SmartPtr (heap count + heap mutex, 3 allocations)
+ *               shared     SharedPtr from kernel_uniqueptr.h (create/destroy only)
+ *               atomic     heap control block with an atomic count (2 allocations)
+ *               intrusive  count stored in front of the object (1 allocation)
+ *
+ *             Scenarios:
+ *               create_destroy   single-thread construct + final release
+ *               contended        N threads retain/release the same pointer
+ *               false_sharing    N threads, private counters packed in one line
+ *               padded           N threads, private counters on separate lines
+ *
+ * Usage     : bench_smartptr.exec [-n iterations] [-t max_threads]
+ */
+
+#include "bench_common.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * 할당 횟수 측정: 시스템 헤더를 먼저 포함한 뒤 malloc/free를 카운터 버전으로 바꾸고
+ * 스마트 포인터 헤더를 포함하여 헤더에 정의된 함수들의 할당만 집계합니다.
+ */
+static uint64_t bench_alloc_count = 0;
+
+static void *bench_malloc(size_t size) {
+    __atomic_add_fetch(&bench_alloc_count, 1, __ATOMIC_RELAXED);
+    return malloc(size);
+}
+
+static void bench_free(void *ptr) {
+    free(ptr);
+}
+
+#define malloc(size) bench_malloc(size)
+#define free(ptr) bench_free(ptr)
+
+#include "kernel_smartptr.h"
+#include "kernel_uniqueptr.h"
+
+#undef malloc
+#undef free
+
+#define BENCH_DEFAULT_ITERATIONS 1000000L
+#define BENCH_CACHE_LINE 64
+
+/**
+ * @struct AtomicCtrl
+ * @brief 원자적 참조 카운트를 가진 별도 제어 블록
+ */
+typedef struct AtomicCtrl {
+    int ref_count;
+    void *ptr;
+} AtomicCtrl;
+
+/**
+ * @struct IntrusiveHeader
+ * @brief 객체 앞에 붙는 참조 카운트 헤더 (단일 할당)
+ */
+typedef struct IntrusiveHeader {
+    int ref_count;
+    int reserved;
+} IntrusiveHeader;
+
+/**
+ * @struct PaddedCounter
+ * @brief 캐시 라인 하나를 단독으로 차지하는 카운터
+ */
+typedef struct PaddedCounter {
+    int ref_count;
+    char pad[BENCH_CACHE_LINE - sizeof(int)];
+} PaddedCounter;
+
+typedef enum {
+    DESIGN_MUTEX,
+    DESIGN_ATOMIC,
+    DESIGN_INTRUSIVE
+} BenchDesign;
+
+static const char *design_names[] = { "mutex", "atomic", "intrusive" };
+
+/**
+ * @struct BenchWorker
+ * @brief 다중 스레드 시나리오의 작업자 인자
+ */
+typedef struct BenchWorker {
+    BenchDesign design;
+    long iterations;
+    SmartPtr *sp;               /**< mutex 설계의 대상 */
+    int *counter;               /**< atomic/intrusive 설계의 대상 카운터 */
+    int *payload;               /**< retain 후 읽을 객체 (NULL이면 읽지 않음) */
+    int *ready;                 /**< 준비된 작업자 수 */
+    int *go;                    /**< 측정 시작 신호 */
+    long sink;                  /**< 읽은 값 누적 (최적화 방지) */
+} BenchWorker;
+
+static int first_result = 1;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 결과 한 건을 JSON 객체로 출력하는 함수
+ */
+static void emit_result(const char *design, const char *scenario, int threads,
+                        long ops, uint64_t elapsed_ns, double allocs_per_op) {
+    double ns_per_op = ops > 0 ? (double)elapsed_ns / (double)ops : 0.0;
+    double mops = elapsed_ns > 0 ? (double)ops * 1000.0 / (double)elapsed_ns : 0.0;
+
+    printf("%s    {\"design\": \"%s\", \"scenario\": \"%s\", \"threads\": %d, \"ops\": %ld, "
+           "\"elapsed_ns\": %llu, \"ns_per_op\": %.2f, \"mops_per_sec\": %.2f, \"allocs_per_op\": %.2f}",
+           first_result ? "" : ",\n", design, scenario, threads, ops,
+           (unsigned long long)elapsed_ns, ns_per_op, mops, allocs_per_op);
+    first_result = 0;
+}
+
+static inline void atomic_retain(int *count) {
+    __atomic_add_fetch(count, 1, __ATOMIC_RELAXED);
+}
+
+static inline int atomic_release(int *count) {
+    return __atomic_sub_fetch(count, 1, __ATOMIC_ACQ_REL) == 0;
+}
+
+/**
+ * @brief 생성/해제 처리량 측정 (단일 스레드)
+ */
+static void bench_create_destroy(long iterations) {
+    uint64_t start, elapsed, allocs;
+
+    // mutex: SmartPtr
+    allocs = bench_alloc_count;
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        SmartPtr sp = create_smart_ptr(sizeof(int), (int)i);
+        release(&sp);
+    }
+    elapsed = now_ns() - start;
+    emit_result("mutex", "create_destroy", 1, iterations, elapsed,
+                (double)(bench_alloc_count - allocs) / (double)iterations);
+
+    // shared: SharedPtr
+    allocs = bench_alloc_count;
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        SharedPtr sp = create_shared_ptr(sizeof(int), NULL);
+        *(int *)sp.ptr = (int)i;
+        release_shared_ptr(&sp);
+    }
+    elapsed = now_ns() - start;
+    emit_result("shared", "create_destroy", 1, iterations, elapsed,
+                (double)(bench_alloc_count - allocs) / (double)iterations);
+
+    // atomic: 객체 + 제어 블록
+    allocs = bench_alloc_count;
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        AtomicCtrl *ctrl = (AtomicCtrl *)bench_malloc(sizeof(AtomicCtrl));
+        ctrl->ptr = bench_malloc(sizeof(int));
+        ctrl->ref_count = 1;
+        *(int *)ctrl->ptr = (int)i;
+        if (atomic_release(&ctrl->ref_count)) {
+            bench_free(ctrl->ptr);
+            bench_free(ctrl);
+        }
+    }
+    elapsed = now_ns() - start;
+    emit_result("atomic", "create_destroy", 1, iterations, elapsed,
+                (double)(bench_alloc_count - allocs) / (double)iterations);
+
+    // intrusive: 헤더 + 객체 단일 할당
+    allocs = bench_alloc_count;
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        IntrusiveHeader *hdr = (IntrusiveHeader *)bench_malloc(sizeof(IntrusiveHeader) + sizeof(int));
+        hdr->ref_count = 1;
+        *(int *)(hdr + 1) = (int)i;
+        if (atomic_release(&hdr->ref_count)) {
+            bench_free(hdr);
+        }
+    }
+    elapsed = now_ns() - start;
+    emit_result("intrusive", "create_destroy", 1, iterations, elapsed,
+                (double)(bench_alloc_count - allocs) / (double)iterations);
+}
+
+/**
+ * @brief 작업자 스레드: retain/release 쌍을 반복
+ */
+static void *bench_worker(void *arg) {
+    BenchWorker *w = (BenchWorker *)arg;
+    long sink = 0;
+
+    // macOS에는 pthread_barrier가 없으므로 간단한 시작 게이트 사용
+    __atomic_add_fetch(w->ready, 1, __ATOMIC_ACQ_REL);
+    while (!__atomic_load_n(w->go, __ATOMIC_ACQUIRE)) {
+    }
+
+    if (w->design == DESIGN_MUTEX) {
+        for (long i = 0; i < w->iterations; i++) {
+            retain(w->sp);
+            sink += *(volatile int *)w->sp->ptr;
+            release(w->sp);
+        }
+    } else if (w->payload != NULL) {
+        for (long i = 0; i < w->iterations; i++) {
+            atomic_retain(w->counter);
+            sink += *(volatile int *)w->payload;
+            atomic_release(w->counter);
+        }
+    } else {
+        for (long i = 0; i < w->iterations; i++) {
+            atomic_retain(w->counter);
+            atomic_release(w->counter);
+        }
+    }
+    w->sink = sink;
+    return NULL;
+}
+
+/**
+ * @brief 작업자들을 실행하고 전체 경과 시간을 반환하는 함수
+ */
+static uint64_t bench_run_workers(BenchWorker *workers, int threads) {
+    pthread_t *tids = (pthread_t *)malloc(sizeof(pthread_t) * (size_t)threads);
+    int ready = 0;
+    int go = 0;
+    uint64_t begin;
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].ready = &ready;
+        workers[i].go = &go;
+        if (pthread_create(&tids[i], NULL, bench_worker, &workers[i]) != 0) {
+            kernel_errExit("벤치마크 스레드 %d 생성 실패", i);
+        }
+    }
+
+    while (__atomic_load_n(&ready, __ATOMIC_ACQUIRE) < threads) {
+        sched_yield();
+    }
+    begin = now_ns();
+    __atomic_store_n(&go, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    uint64_t elapsed = now_ns() - begin;
+
+    free(tids);
+    return elapsed;
+}
+
+/**
+ * @brief 같은 포인터에 대한 경합 retain/release 측정
+ */
+static void bench_contended(BenchDesign design, int threads, long iterations) {
+    BenchWorker *workers = (BenchWorker *)calloc((size_t)threads, sizeof(BenchWorker));
+    SmartPtr sp = create_smart_ptr(sizeof(int), 0);
+    AtomicCtrl *ctrl = (AtomicCtrl *)malloc(sizeof(AtomicCtrl));
+    IntrusiveHeader *hdr = (IntrusiveHeader *)malloc(sizeof(IntrusiveHeader) + sizeof(int));
+
+    // atomic은 제어 블록과 객체가 떨어져 있고, intrusive는 카운트 바로 뒤에 객체가 있음
+    ctrl->ref_count = 1;
+    ctrl->ptr = malloc(sizeof(int));
+    *(int *)ctrl->ptr = 1;
+    hdr->ref_count = 1;
+    *(int *)(hdr + 1) = 1;
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].design = design;
+        workers[i].iterations = iterations;
+        workers[i].sp = &sp;
+        if (design == DESIGN_ATOMIC) {
+            workers[i].counter = &ctrl->ref_count;
+            workers[i].payload = (int *)ctrl->ptr;
+        } else {
+            workers[i].counter = &hdr->ref_count;
+            workers[i].payload = (int *)(hdr + 1);
+        }
+    }
+
+    uint64_t elapsed = bench_run_workers(workers, threads);
+    emit_result(design_names[design], "contended", threads, iterations * threads * 2L, elapsed, 0.0);
+
+    release(&sp);
+    free(ctrl->ptr);
+    free(ctrl);
+    free(hdr);
+    free(workers);
+}
+
+/**
+ * @brief 스레드마다 독립된 카운터를 쓰되 배치만 다른 두 경우 측정
+ *
+ * @param padded 0이면 카운터를 한 캐시 라인에 붙여 배치 (거짓 공유), 1이면 라인별 배치
+ */
+static void bench_private(BenchDesign design, int threads, long iterations, int padded) {
+    BenchWorker *workers = (BenchWorker *)calloc((size_t)threads, sizeof(BenchWorker));
+    SmartPtr *sps = (SmartPtr *)calloc((size_t)threads, sizeof(SmartPtr));
+    PaddedCounter *lines = NULL;
+    size_t line_count = padded ? (size_t)threads : 1 + ((size_t)threads * sizeof(int)) / BENCH_CACHE_LINE;
+
+    if (posix_memalign((void **)&lines, BENCH_CACHE_LINE, sizeof(PaddedCounter) * line_count) != 0) {
+        kernel_errExit("벤치마크 카운터 메모리 할당 실패");
+    }
+    memset(lines, 0, sizeof(PaddedCounter) * line_count);
+
+    for (int i = 0; i < threads; i++) {
+        workers[i].design = design;
+        workers[i].iterations = iterations;
+        workers[i].counter = padded ? &lines[i].ref_count : &((int *)lines)[i];
+        *workers[i].counter = 1;
+
+        if (design == DESIGN_MUTEX) {
+            // SmartPtr의 카운트/뮤텍스를 같은 배치 규칙을 따르는 영역으로 교체
+            sps[i] = create_smart_ptr(sizeof(int), 0);
+            free(sps[i].ref_count);
+            sps[i].ref_count = workers[i].counter;
+            workers[i].sp = &sps[i];
+        }
+    }
+
+    uint64_t elapsed = bench_run_workers(workers, threads);
+    emit_result(design_names[design], padded ? "padded" : "false_sharing", threads,
+                iterations * threads * 2L, elapsed, 0.0);
+
+    if (design == DESIGN_MUTEX) {
+        for (int i = 0; i < threads; i++) {
+            free(sps[i].ptr);
+            pthread_mutex_destroy(sps[i].mutex);
+            free(sps[i].mutex);
+        }
+    }
+    free(lines);
+    free(sps);
+    free(workers);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n iterations] [-t max_threads]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    long iterations = BENCH_DEFAULT_ITERATIONS;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = cpus > 0 ? (int)(cpus < 8 ? cpus : 8) : 4;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:h")) != -1) {
+        switch (opt) {
+            case 'n': iterations = atol(optarg); break;
+            case 't': max_threads = atoi(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (iterations <= 0 || max_threads <= 0) {
+        usage(argv[0]);
+    }
+
+    printf("{\n  \"benchmark\": \"smartptr\",\n  \"iterations\": %ld,\n  \"max_threads\": %d,\n  \"results\": [\n",
+           iterations, max_threads);
+
+    bench_create_destroy(iterations);
+
+    // 스레드당 반복 수는 전체 작업량이 비슷하도록 나눔
+    for (int threads = 1; threads <= max_threads; threads = bench_next_count(threads, max_threads)) {
+        long per_thread = iterations / threads;
+        for (int d = DESIGN_MUTEX; d <= DESIGN_INTRUSIVE; d++) {
+            bench_contended((BenchDesign)d, threads, per_thread);
+        }
+        for (int d = DESIGN_MUTEX; d <= DESIGN_INTRUSIVE; d++) {
+            bench_private((BenchDesign)d, threads, per_thread, 0);
+            bench_private((BenchDesign)d, threads, per_thread, 1);
+        }
+    }
+
+    printf("\n  ]\n}\n");
+    return 0;
+}
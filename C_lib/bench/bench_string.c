@@ -0,0 +1,295 @@
+/*
+ * String Primitive Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Checks every implementation in az_strsimd.c that this build
+ *             and CPU can run against the C library, then times it, and
+ *             prints the results as JSON.
+ *
+ *             Checks (random inputs, half of them ending right before an
+ *             inaccessible page so an over-read faults):
+ *               az_strlen   == strspn over printable ASCII (32..126)
+ *               az_strchr   == strchr
+ *               az_chrpos   == strchr offset, -1 if absent or c is '\0'
+ *               az_strcmp   same sign as strcmp
+ *               az_memset / az_bzero  same bytes as memset, nothing outside
+ *                                     the range changed
+ *
+ *             Designs (ns per call on 16-byte and 4096-byte inputs):
+ *               <impl>  scalar / sse2 / avx2 / neon
+ *               libc    strlen / strchr / strcmp / memset
+ *
+ * Usage     : bench_string.exec [-n calls] [-f fuzz cases]
+ */
+
+#include "kernel_engine.h"
+#include "kernel_pr_he.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_CALLS 2000000L
+#define BENCH_DEFAULT_FUZZ  200000L
+#define BENCH_MAX_STRING    600
+#define BENCH_LONG_SIZE     4096
+
+typedef enum { FN_STRLEN, FN_STRCHR, FN_STRCMP, FN_MEMSET, FN_COUNT } BenchFunction;
+
+static const char *impl_names[] = { "scalar", "sse2", "avx2", "neon" };
+static const char *function_names[] = { "strlen", "strchr", "strcmp", "memset" };
+static const size_t sizes[] = { 16, BENCH_LONG_SIZE };
+
+static volatile size_t call_sink;       /* 결과가 최적화로 사라지지 않게 함 */
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+/* 반복문 밖으로 옮겨지지 않도록 함수 포인터로 호출 */
+static size_t (*volatile libc_strlen)(const char *) = strlen;
+static char *(*volatile libc_strchr)(const char *, int) = strchr;
+static int (*volatile libc_strcmp)(const char *, const char *) = strcmp;
+static void *(*volatile libc_memset)(void *, int, size_t) = memset;
+
+/**
+ * @struct Guarded
+ * @brief 바로 뒤에 접근할 수 없는 페이지가 붙은 버퍼
+ */
+typedef struct Guarded {
+    char *base;
+    char *end;          /**< 접근할 수 없는 페이지의 시작 */
+} Guarded;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static Guarded guarded_alloc(size_t size) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t span = (size + page - 1) / page * page;
+    Guarded g;
+
+    g.base = (char *)mmap(NULL, span + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (g.base == MAP_FAILED) {
+        kernel_errExit("mmap 실패");
+    }
+    g.end = g.base + span;
+    if (mprotect(g.end, page, PROT_NONE) != 0) {
+        kernel_errExit("mprotect 실패");
+    }
+    return g;
+}
+
+/* 대부분 출력 가능 문자이고 가끔 제어 문자나 128 이상의 바이트가 섞인 NUL 없는 바이트 */
+static char random_byte(void) {
+    uint64_t r = next_random();
+    if (r % 8 != 0) {
+        return (char)(32 + (r >> 8) % 95);
+    }
+    return (char)(1 + (r >> 8) % 255);
+}
+
+/**
+ * @brief len 바이트 문자열을 버퍼 안에 놓는 함수 (절반은 보호 페이지 바로 앞에서 끝나게)
+ */
+static char *place_string(Guarded *g, size_t len) {
+    size_t room = (size_t)(g->end - g->base) - len - 1;
+    char *s = next_random() % 2 ? g->end - len - 1 : g->base + next_random() % (room + 1);
+
+    for (size_t i = 0; i < len; i++) {
+        s[i] = random_byte();
+    }
+    s[len] = '\0';
+    // 끝 뒤쪽은 NUL이 아닌 값으로 채워 종료 검사를 확인
+    for (char *p = s + len + 1; p < g->end && p < s + len + 64; p++) {
+        *p = random_byte();
+    }
+    return s;
+}
+
+static size_t printable_span(const char *s) {
+    static char set[96];
+    if (set[0] == '\0') {
+        for (int i = 0; i < 95; i++) {
+            set[i] = (char)(32 + i);
+        }
+    }
+    return strspn(s, set);
+}
+
+static int sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+/**
+ * @brief 현재 구현을 C 라이브러리와 비교하는 함수
+ *
+ * @return 일치하지 않은 경우의 수
+ */
+static long fuzz_impl(long cases, Guarded *a, Guarded *b) {
+    long mismatches = 0;
+
+    for (long n = 0; n < cases; n++) {
+        size_t len = next_random() % 4 == 0 ? next_random() % BENCH_MAX_STRING : next_random() % 48;
+        char *s = place_string(a, len);
+
+        // az_strlen
+        mismatches += az_strlen(s) != printable_span(s);
+
+        // az_strchr / az_chrpos: 문자열 안의 문자, 없는 문자, NUL, 128 이상의 값
+        int c;
+        switch (next_random() % 4) {
+            case 0:  c = len > 0 ? s[next_random() % len] : 'x'; break;
+            case 1:  c = (int)(next_random() % 256); break;
+            case 2:  c = (int)(next_random() % 256) - 128; break;
+            default: c = '\0'; break;
+        }
+        char *ref = strchr(s, c);
+        mismatches += az_strchr(s, c) != ref;
+        mismatches += az_chrpos(s, c) != ((char)c != '\0' && ref != NULL ? (int)(ref - s) : -1);
+
+        // az_strcmp: 같은 문자열, 한 바이트만 다른 문자열, 더 짧은 문자열
+        char *t = place_string(b, len);
+        memcpy(t, s, len + 1);
+        if (len > 0 && next_random() % 3 != 0) {
+            size_t at = next_random() % len;
+            t[at] = next_random() % 5 == 0 ? '\0' : random_byte();
+        }
+        mismatches += sign(az_strcmp(s, t)) != sign(strcmp(s, t));
+        mismatches += sign(az_strcmp(t, s)) != sign(strcmp(t, s));
+
+        // az_memset / az_bzero
+        size_t total = (size_t)(a->end - a->base);
+        size_t count = next_random() % 4 == 0 ? next_random() % 2048 : next_random() % 64;
+        size_t off = next_random() % 2 ? total - count : next_random() % (total - count + 1);
+        int value = (int)(next_random() % 512) - 256;
+        memcpy(b->base, a->base, total);
+        if (next_random() % 4 == 0) {
+            az_bzero(a->base + off, count);
+            memset(b->base + off, 0, count);
+        } else {
+            az_memset(a->base + off, value, count);
+            memset(b->base + off, value, count);
+        }
+        mismatches += memcmp(a->base, b->base, total) != 0;
+    }
+    return mismatches;
+}
+
+static void run_design(const char *impl, BenchFunction fn, size_t size, long calls, char *s, char *t, int first) {
+    int libc = strcmp(impl, "libc") == 0;
+    uint64_t begin = now_ns();
+
+    switch (fn) {
+        case FN_STRLEN:
+            for (long i = 0; i < calls; i++) {
+                call_sink += libc ? libc_strlen(s) : az_strlen(s);
+            }
+            break;
+        case FN_STRCHR:
+            // 없는 문자를 찾아 끝까지 훑음
+            for (long i = 0; i < calls; i++) {
+                call_sink += (size_t)(libc ? libc_strchr(s, '~') : az_strchr(s, '~'));
+            }
+            break;
+        case FN_STRCMP:
+            for (long i = 0; i < calls; i++) {
+                call_sink += (size_t)(libc ? libc_strcmp(s, t) : az_strcmp(s, t));
+            }
+            break;
+        default:
+            for (long i = 0; i < calls; i++) {
+                if (libc) {
+                    libc_memset(t, (int)i, size);
+                } else {
+                    az_memset(t, (int)i, size);
+                }
+                call_sink += (unsigned char)t[0];
+            }
+            break;
+    }
+    uint64_t elapsed = now_ns() - begin;
+
+    printf("%s    {\"impl\": \"%s\", \"function\": \"%s\", \"size\": %zu, \"calls\": %ld, \"ns_per_call\": %.2f, "
+           "\"bytes_per_ns\": %.2f}",
+           first ? "" : ",\n", impl, function_names[fn], size, calls, (double)elapsed / (double)calls,
+           (double)size * (double)calls / (double)(elapsed ? elapsed : 1));
+    fflush(stdout);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-n calls] [-f fuzz cases]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    long calls = BENCH_DEFAULT_CALLS;
+    long fuzz = BENCH_DEFAULT_FUZZ;
+    const char *chosen;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:f:h")) != -1) {
+        switch (opt) {
+            case 'n': calls = atol(optarg); break;
+            case 'f': fuzz = atol(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (calls < 1 || fuzz < 0) {
+        usage(argv[0]);
+    }
+
+    Guarded a = guarded_alloc(BENCH_LONG_SIZE + 64);
+    Guarded b = guarded_alloc(BENCH_LONG_SIZE + 64);
+    chosen = az_simd_name();
+
+    printf("{\n  \"benchmark\": \"string\",\n  \"default_impl\": \"%s\",\n  \"fuzz\": [\n", chosen);
+    int first = 1;
+    for (size_t i = 0; i < sizeof(impl_names) / sizeof(impl_names[0]); i++) {
+        if (az_simd_select(impl_names[i]) != 0) {
+            continue;
+        }
+        printf("%s    {\"impl\": \"%s\", \"cases\": %ld, \"mismatches\": %ld}", first ? "" : ",\n", impl_names[i],
+               fuzz, fuzz_impl(fuzz, &a, &b));
+        first = 0;
+    }
+    printf("\n  ],\n  \"results\": [\n");
+
+    first = 1;
+    for (size_t i = 0; i <= sizeof(impl_names) / sizeof(impl_names[0]); i++) {
+        const char *impl = i < sizeof(impl_names) / sizeof(impl_names[0]) ? impl_names[i] : "libc";
+        if (strcmp(impl, "libc") != 0 && az_simd_select(impl) != 0) {
+            continue;
+        }
+        for (size_t z = 0; z < sizeof(sizes) / sizeof(sizes[0]); z++) {
+            // 출력 가능 문자만으로 된 같은 내용의 두 문자열 (t는 memset 대상도 겸함)
+            char *s = a.end - sizes[z] - 1;
+            char *t = b.end - sizes[z] - 1;
+            for (size_t k = 0; k < sizes[z]; k++) {
+                s[k] = (char)('a' + k % 26);
+            }
+            s[sizes[z]] = '\0';
+            long n = sizes[z] > 64 ? calls / 32 : calls;
+            for (int fn = 0; fn < FN_COUNT; fn++) {
+                memcpy(t, s, sizes[z] + 1);
+                run_design(impl, (BenchFunction)fn, sizes[z], n, s, t, first);
+                first = 0;
+            }
+        }
+    }
+    printf("\n  ]\n}\n");
+    az_simd_select(chosen);
+    return 0;
+}
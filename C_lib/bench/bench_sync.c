@@ -0,0 +1,248 @@
+/*
+ * Phase Synchronization Benchmark
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Measures the cost of one phase step for phase-structured work
+ *             and prints the results as JSON.
+ *
+ *             Designs:
+ *               kbarrier         persistent threads meeting on a KBarrier
+ *               pthread_barrier  persistent threads on pthread_barrier_t
+ *                                (skipped where it does not exist)
+ *               respawn          create and join the threads every phase
+ *               fork_join        persistent workers released by a KBarrier,
+ *                                the coordinator waits on a KCountdown
+ *
+ *             Every phase each thread adds its id to a per-phase slot, and
+ *             the slots are checked afterwards.
+ *
+ * Usage     : bench_sync.exec [-t threads] [-p phases]
+ */
+
+#include "kernel_engine.h"
+#include "kernel_sync.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_THREADS 4
+#define BENCH_DEFAULT_PHASES 20000L
+#define BENCH_RESPAWN_PHASES 2000L
+
+#if defined(_POSIX_BARRIERS) && _POSIX_BARRIERS > 0
+#define BENCH_HAVE_PTHREAD_BARRIER 1
+#endif
+
+typedef enum {
+    DESIGN_KBARRIER,
+    DESIGN_PTHREAD_BARRIER,
+    DESIGN_RESPAWN,
+    DESIGN_FORK_JOIN
+} BenchDesign;
+
+static const char *design_names[] = { "kbarrier", "pthread_barrier", "respawn", "fork_join" };
+
+/**
+ * @struct BenchShared
+ * @brief 한 번의 측정에서 모든 스레드가 공유하는 상태
+ */
+typedef struct BenchShared {
+    BenchDesign design;
+    int threads;
+    long phases;
+    long *slots;                /**< 단계별 합계 (검증용) */
+    KBarrier barrier;
+#ifdef BENCH_HAVE_PTHREAD_BARRIER
+    pthread_barrier_t pbarrier;
+#endif
+    KCountdown done;            /**< fork_join: 이번 단계에서 남은 작업자 수 */
+    long phase;                 /**< respawn: 현재 단계 */
+} BenchShared;
+
+typedef struct {
+    BenchShared *shared;
+    long id;
+} BenchThread;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void *phase_worker(void *arg) {
+    BenchThread *self = (BenchThread *)arg;
+    BenchShared *shared = self->shared;
+
+    for (long phase = 0; phase < shared->phases; phase++) {
+        __atomic_add_fetch(&shared->slots[phase], self->id, __ATOMIC_RELAXED);
+        switch (shared->design) {
+            case DESIGN_KBARRIER:
+                kbarrier_wait(&shared->barrier);
+                break;
+#ifdef BENCH_HAVE_PTHREAD_BARRIER
+            case DESIGN_PTHREAD_BARRIER:
+                pthread_barrier_wait(&shared->pbarrier);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void *respawn_worker(void *arg) {
+    BenchThread *self = (BenchThread *)arg;
+    __atomic_add_fetch(&self->shared->slots[self->shared->phase], self->id, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+/**
+ * @brief fork_join 작업자: 배리어로 단계 시작을 받고 카운트다운으로 완료를 알림
+ */
+static void *fork_join_worker(void *arg) {
+    BenchThread *self = (BenchThread *)arg;
+    BenchShared *shared = self->shared;
+
+    for (long phase = 0; phase < shared->phases; phase++) {
+        kbarrier_wait(&shared->barrier);
+        __atomic_add_fetch(&shared->slots[phase], self->id, __ATOMIC_RELAXED);
+        kcountdown_signal(&shared->done, 1);
+    }
+    return NULL;
+}
+
+static void spawn_all(BenchShared *shared, BenchThread *args, pthread_t *tids, void *(*func)(void *)) {
+    for (int i = 0; i < shared->threads; i++) {
+        int err = pthread_create(&tids[i], NULL, func, &args[i]);
+        if (err != 0) {
+            kernel_errExitEN(err, "벤치마크 스레드 생성 실패");
+        }
+    }
+}
+
+static void join_all(BenchShared *shared, pthread_t *tids) {
+    for (int i = 0; i < shared->threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+}
+
+/**
+ * @brief 한 설계를 측정하고 결과를 JSON 한 줄로 출력하는 함수
+ */
+static void run_design(BenchDesign design, int threads, long phases, int first) {
+    BenchShared shared;
+    BenchThread *args = (BenchThread *)calloc((size_t)threads, sizeof(BenchThread));
+    pthread_t *tids = (pthread_t *)calloc((size_t)threads, sizeof(pthread_t));
+
+    memset(&shared, 0, sizeof(shared));
+    shared.design = design;
+    shared.threads = threads;
+    shared.phases = design == DESIGN_RESPAWN && phases > BENCH_RESPAWN_PHASES ? BENCH_RESPAWN_PHASES : phases;
+    shared.slots = (long *)calloc((size_t)shared.phases, sizeof(long));
+    if (args == NULL || tids == NULL || shared.slots == NULL) {
+        kernel_errExit("벤치마크 메모리 할당 실패");
+    }
+    for (int i = 0; i < threads; i++) {
+        args[i].shared = &shared;
+        args[i].id = i + 1;
+    }
+
+    uint64_t begin = now_ns();
+    switch (design) {
+        case DESIGN_KBARRIER:
+            kbarrier_init(&shared.barrier, (uint32_t)threads);
+            begin = now_ns();
+            spawn_all(&shared, args, tids, phase_worker);
+            join_all(&shared, tids);
+            break;
+#ifdef BENCH_HAVE_PTHREAD_BARRIER
+        case DESIGN_PTHREAD_BARRIER:
+            pthread_barrier_init(&shared.pbarrier, NULL, (unsigned)threads);
+            begin = now_ns();
+            spawn_all(&shared, args, tids, phase_worker);
+            join_all(&shared, tids);
+            pthread_barrier_destroy(&shared.pbarrier);
+            break;
+#endif
+        case DESIGN_RESPAWN:
+            for (shared.phase = 0; shared.phase < shared.phases; shared.phase++) {
+                spawn_all(&shared, args, tids, respawn_worker);
+                join_all(&shared, tids);
+            }
+            break;
+        case DESIGN_FORK_JOIN:
+            // 조정자(이 스레드)도 배리어에 참여해 단계 시작을 알림
+            kbarrier_init(&shared.barrier, (uint32_t)threads + 1);
+            kcountdown_init(&shared.done, 0);
+            begin = now_ns();
+            spawn_all(&shared, args, tids, fork_join_worker);
+            for (long phase = 0; phase < shared.phases; phase++) {
+                kcountdown_reset(&shared.done, (uint32_t)threads);
+                kbarrier_wait(&shared.barrier);
+                kcountdown_wait(&shared.done, -1);
+            }
+            join_all(&shared, tids);
+            break;
+        default:
+            break;
+    }
+    uint64_t elapsed = now_ns() - begin;
+
+    long expected = (long)threads * (threads + 1) / 2;
+    for (long phase = 0; phase < shared.phases; phase++) {
+        if (shared.slots[phase] != expected) {
+            kernel_errExit("%s: 단계 %ld 합계 불일치 (%ld / %ld)", design_names[design], phase,
+                           shared.slots[phase], expected);
+        }
+    }
+
+    printf("%s    {\"design\": \"%s\", \"threads\": %d, \"phases\": %ld, \"elapsed_ms\": %.3f, \"ns_per_phase\": %.1f}",
+           first ? "" : ",\n", design_names[design], threads, shared.phases, (double)elapsed / 1e6,
+           (double)elapsed / (double)shared.phases);
+    fflush(stdout);
+
+    free(shared.slots);
+    free(tids);
+    free(args);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-t threads] [-p phases]\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]) {
+    int threads = BENCH_DEFAULT_THREADS;
+    long phases = BENCH_DEFAULT_PHASES;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:p:h")) != -1) {
+        switch (opt) {
+            case 't': threads = atoi(optarg); break;
+            case 'p': phases = atol(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (threads < 1 || phases < 1) {
+        usage(argv[0]);
+    }
+
+    printf("{\n  \"benchmark\": \"sync\",\n  \"threads\": %d,\n  \"cpus\": %ld,\n  \"results\": [\n",
+           threads, sysconf(_SC_NPROCESSORS_ONLN));
+    run_design(DESIGN_KBARRIER, threads, phases, 1);
+#ifdef BENCH_HAVE_PTHREAD_BARRIER
+    run_design(DESIGN_PTHREAD_BARRIER, threads, phases, 0);
+#endif
+    run_design(DESIGN_RESPAWN, threads, phases, 0);
+    run_design(DESIGN_FORK_JOIN, threads, phases, 0);
+    printf("\n  ]\n}\n");
+    return 0;
+}
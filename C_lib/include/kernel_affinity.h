@@ -0,0 +1,176 @@
+/*
+ * Kernel Thread Placement
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : CPU affinity and NUMA placement for engine threads. A placement
+ *             is a policy plus an allowed CPU set, turned into an ordered CPU
+ *             list. The i-th thread of a group is pinned to order[i % n].
+ *
+ *               compact  fill one NUMA node before the next, in CPU order,
+ *                        so cooperating threads share caches
+ *               spread   round-robin across NUMA nodes, first cores before
+ *                        SMT siblings, to maximise cache and memory bandwidth
+ *
+ *             Placements are written as "policy[:cpulist]", e.g. "spread",
+ *             "compact:0-7" or "spread:0-15,32-47". A bare cpulist means
+ *             compact over that list and "none" leaves threads unpinned.
+ *             Without a cpulist the process affinity mask is used.
+ *
+ *             Environment overrides, checked before KERNEL_PLACEMENT which
+ *             applies to all of them:
+ *               KERNEL_POOL_PLACEMENT   engine thread pool workers
+ *               KERNEL_SCHED_PLACEMENT  work-stealing scheduler workers
+ *               KERNEL_CHAT_PLACEMENT   chat server accept/client threads
+ *
+ *             NUMA memory is bound with mbind(MPOL_PREFERRED) on Linux.
+ *             Elsewhere, or on single-node machines, pinning still applies
+ *             and the allocation helpers fall back to plain anonymous
+ *             memory.
+ */
+
+#pragma once
+#ifndef KERNEL_AFFINITY_H
+#define KERNEL_AFFINITY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 배치에 사용할 수 있는 최대 CPU 번호 + 1 */
+#define KPLACEMENT_MAX_CPUS 1024
+
+/* 지원하는 최대 NUMA 노드 수 */
+#define KNUMA_MAX_NODES 64
+
+/**
+ * @brief 스레드 배치 정책
+ */
+typedef enum KPlacementPolicy {
+    KPLACE_NONE = 0,    /**< 고정하지 않음 (스케줄러에 맡김) */
+    KPLACE_COMPACT,     /**< 한 노드를 채운 뒤 다음 노드로 */
+    KPLACE_SPREAD       /**< 노드와 물리 코어에 고르게 분산 */
+} KPlacementPolicy;
+
+/**
+ * @struct KPlacement
+ * @brief 스레드 배치 설정 (정책과 스레드 순서대로의 CPU 목록)
+ */
+typedef struct KPlacement {
+    KPlacementPolicy policy;                /**< 배치 정책 */
+    int num_cpus;                           /**< order에 있는 CPU 수 */
+    int16_t order[KPLACEMENT_MAX_CPUS];     /**< i번째 스레드는 order[i % num_cpus]에 고정 */
+} KPlacement;
+
+/**
+ * @brief 정책과 CPU 집합으로 배치를 만드는 함수 선언
+ *
+ * @param placement 결과를 저장할 위치
+ * @param policy 배치 정책
+ * @param cpulist 허용 CPU 목록 ("0-3,8" 형식, 프로세스 affinity 마스크와의 교집합, NULL이면 마스크 전체)
+ * @return 성공 시 0, 목록이 잘못되었거나 비었으면 -1
+ */
+int kplacement_init(KPlacement *placement, KPlacementPolicy policy, const char *cpulist);
+
+/**
+ * @brief "policy[:cpulist]" 문자열로 배치를 만드는 함수 선언
+ *
+ * @param placement 결과를 저장할 위치
+ * @param spec 배치 문자열
+ * @return 성공 시 0, 형식 오류 시 -1
+ */
+int kplacement_parse(KPlacement *placement, const char *spec);
+
+/**
+ * @brief 환경 변수로 배치를 만드는 함수 선언
+ *
+ * name이 없으면 KERNEL_PLACEMENT를 사용합니다.
+ *
+ * @param placement 결과를 저장할 위치
+ * @param name 환경 변수 이름 (NULL이면 KERNEL_PLACEMENT만 확인)
+ * @return 설정된 배치가 있으면 0, 없거나 잘못되었으면 -1 (이때 placement는 KPLACE_NONE)
+ */
+int kplacement_from_env(KPlacement *placement, const char *name);
+
+/**
+ * @brief i번째 스레드가 고정될 CPU를 반환하는 함수 선언
+ *
+ * @param placement 배치 (NULL 허용)
+ * @param index 스레드 순번
+ * @return CPU 번호, 고정하지 않으면 -1
+ */
+int kplacement_cpu(const KPlacement *placement, int index);
+
+/**
+ * @brief 호출 스레드를 i번째 자리에 고정하는 함수 선언
+ *
+ * @param placement 배치 (NULL이거나 KPLACE_NONE이면 아무것도 하지 않음)
+ * @param index 스레드 순번
+ * @return 성공 시 0, 실패 시 오류 번호 (affinity를 지원하지 않는 플랫폼은 0)
+ */
+int kplacement_apply(const KPlacement *placement, int index);
+
+/**
+ * @brief 배치를 사람이 읽을 수 있는 문자열로 만드는 함수 선언 ("spread: 0,4,1,5")
+ *
+ * @param placement 배치
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int kplacement_format(const KPlacement *placement, char *buf, size_t size);
+
+/**
+ * @brief NUMA 노드 수를 반환하는 함수 선언
+ */
+int kernel_numa_nodes(void);
+
+/**
+ * @brief CPU가 속한 NUMA 노드를 반환하는 함수 선언
+ *
+ * @param cpu CPU 번호
+ * @return 노드 번호 (알 수 없으면 0)
+ */
+int kernel_cpu_node(int cpu);
+
+/**
+ * @brief 호출 스레드가 현재 실행 중인 NUMA 노드를 반환하는 함수 선언
+ */
+int kernel_current_node(void);
+
+/**
+ * @brief 지정한 NUMA 노드에 0으로 초기화된 메모리를 할당하는 함수 선언
+ *
+ * 페이지 단위로 할당하므로 스레드별 버퍼처럼 큰 단위에 사용합니다.
+ *
+ * @param size 할당 크기
+ * @param node NUMA 노드 (음수면 노드를 지정하지 않음)
+ * @return 할당된 메모리 (페이지 정렬), 실패 시 NULL
+ */
+void *kernel_numa_alloc(size_t size, int node);
+
+/**
+ * @brief 호출 스레드의 NUMA 노드에 메모리를 할당하는 함수 선언
+ *
+ * @param size 할당 크기
+ * @return 할당된 메모리, 실패 시 NULL
+ */
+void *kernel_numa_alloc_local(size_t size);
+
+/**
+ * @brief kernel_numa_alloc으로 할당한 메모리를 해제하는 함수 선언
+ *
+ * @param ptr 해제할 메모리 (NULL 허용)
+ * @param size 할당 시 크기
+ */
+void kernel_numa_free(void *ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_AFFINITY_H
@@ -0,0 +1,135 @@
+/*
+ * Kernel Lock Contention Harness
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Measures lock behaviour under a configurable load. N threads
+ *             repeatedly acquire one shared lock, spin for the critical
+ *             section length while holding it, release it and spin for the
+ *             idle length. The harness reports throughput, per-thread
+ *             fairness and an acquire-latency histogram.
+ *
+ *             Locks: pthread mutex, POSIX semaphore, test-and-test-and-set
+ *             spinlock, FIFO ticket lock, futex lock (0/1/2 state) and the
+ *             adaptive KMutex from kernel_mutex.h.
+ */
+
+#pragma once
+#ifndef KERNEL_CONTENTION_H
+#define KERNEL_CONTENTION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "kernel_affinity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 획득 지연 히스토그램 구간 수 (구간 i는 [2^i, 2^(i+1)) ns) */
+#define KCONTENTION_HIST_BUCKETS 32
+
+/* 측정에 참여할 수 있는 최대 스레드 수 */
+#define KCONTENTION_MAX_THREADS 256
+
+/**
+ * @brief 측정할 잠금 종류
+ */
+typedef enum KLockKind {
+    KLOCK_MUTEX = 0,    /**< pthread_mutex_t */
+    KLOCK_SEMAPHORE,    /**< 초기값 1인 sem_t */
+    KLOCK_SPIN,         /**< TTAS 스핀락 */
+    KLOCK_TICKET,       /**< 티켓 락 (도착 순서대로 획득) */
+    KLOCK_FUTEX,        /**< futex 기반 잠금 */
+    KLOCK_KMUTEX,       /**< 적응형 스핀 KMutex (kernel_mutex.h) */
+    KLOCK_COUNT
+} KLockKind;
+
+/**
+ * @struct KContentionConfig
+ * @brief 측정 설정
+ */
+typedef struct KContentionConfig {
+    int num_threads;        /**< 스레드 수 */
+    uint32_t hold_ns;       /**< 잠금을 쥔 채 일하는 시간 (임계 구역 길이) */
+    uint32_t idle_ns;       /**< 잠금 밖에서 일하는 시간 */
+    uint32_t duration_ms;   /**< 측정 시간 */
+    const KPlacement *placement; /**< 측정 스레드 배치 (NULL이면 고정하지 않음, 측정 중에만 참조) */
+} KContentionConfig;
+
+/**
+ * @struct KContentionResult
+ * @brief 측정 결과
+ */
+typedef struct KContentionResult {
+    KLockKind kind;                                 /**< 잠금 종류 */
+    KContentionConfig config;                       /**< 사용한 설정 */
+    uint64_t total_ops;                             /**< 전체 획득 횟수 */
+    uint64_t elapsed_ns;                            /**< 실제 측정 시간 */
+    double ops_per_sec;                             /**< 초당 획득 횟수 */
+    double fairness;                                /**< 스레드별 획득 횟수의 Jain 공정성 지수 (1.0이 완전 공정) */
+    uint64_t min_thread_ops;                        /**< 가장 적게 획득한 스레드의 횟수 */
+    uint64_t max_thread_ops;                        /**< 가장 많이 획득한 스레드의 횟수 */
+    uint64_t latency_hist[KCONTENTION_HIST_BUCKETS]; /**< 획득 지연 히스토그램 */
+    uint64_t p50_ns;                                /**< 획득 지연 중앙값 (구간 상한) */
+    uint64_t p99_ns;                                /**< 획득 지연 99백분위 (구간 상한) */
+    uint64_t max_ns;                                /**< 최대 획득 지연 */
+} KContentionResult;
+
+/**
+ * @brief 잠금 종류 이름을 반환하는 함수 선언 ("mutex", "semaphore", "spin", "ticket", "futex", "kmutex")
+ */
+const char *contention_lock_name(KLockKind kind);
+
+/**
+ * @brief 이름으로 잠금 종류를 찾는 함수 선언
+ *
+ * @return 잠금 종류, 없으면 -1
+ */
+int contention_lock_from_name(const char *name);
+
+/**
+ * @brief 측정과 같은 보정된 바쁜 대기 루프로 ns 동안 CPU를 사용하는 함수 선언
+ *
+ * 처음 호출할 때 한 번 보정하며, 잠금을 쥔 채 하는 일을 흉내 낼 때 sleep 대신 사용합니다.
+ *
+ * @param ns 대기 시간 (나노초)
+ */
+void contention_busy_wait(uint32_t ns);
+
+/**
+ * @brief 한 잠금 종류에 대해 경합 측정을 실행하는 함수 선언
+ *
+ * @param kind 잠금 종류
+ * @param config 측정 설정
+ * @param result 결과를 저장할 위치
+ * @return 성공 시 0, 설정이 잘못되었거나 스레드 생성에 실패하면 -1
+ */
+int contention_run(KLockKind kind, const KContentionConfig *config, KContentionResult *result);
+
+/**
+ * @brief 결과를 사람이 읽을 수 있는 여러 줄 문자열로 만드는 함수 선언
+ *
+ * @param result 측정 결과
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int contention_format_result(const KContentionResult *result, char *buf, size_t size);
+
+/**
+ * @brief 결과를 JSON 객체 하나로 만드는 함수 선언
+ *
+ * @param result 측정 결과
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int contention_format_json(const KContentionResult *result, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_CONTENTION_H
@@ -0,0 +1,133 @@
+/*
+ * Kernel Coroutine Runtime
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Stackful coroutines for running many lightweight simulated
+ *             processes inside one OS thread. Each OS thread has its own
+ *             runtime: coroutines spawned on a thread run only on that
+ *             thread, cooperatively, until kcoro_run returns.
+ *
+ *             Context switches save only callee-saved registers, in a few
+ *             instructions of assembly on x86-64 and AArch64. Other targets,
+ *             or builds with -DKCORO_USE_UCONTEXT, use ucontext.
+ *
+ *             Stacks are carved from pooled slabs. The control block lives
+ *             at the top of the stack, so a spawn allocates nothing once the
+ *             pool is warm. The lowest page of every stack is a PROT_NONE
+ *             guard, so overflow faults instead of corrupting a neighbour.
+ *             Linux limits the number of mappings per process
+ *             (vm.max_map_count). When that limit is reached, further stacks
+ *             run without a guard page, counted in KCoroStats.unguarded.
+ *
+ *             A blocked coroutine parks on one of two things: a sleep deadline
+ *             (a min-heap in the runtime) or fd readiness (one-shot epoll
+ *             registration, poll() elsewhere). When nothing is runnable, the
+ *             runtime sleeps in epoll_wait until the nearest deadline.
+ *
+ *             The stack size defaults to KCORO_DEFAULT_STACK_SIZE and can be
+ *             changed with KERNEL_CORO_STACK_KB.
+ */
+
+#pragma once
+#ifndef KERNEL_CORO_H
+#define KERNEL_CORO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 기본 코루틴 스택 크기 (가드 페이지 제외) */
+#define KCORO_DEFAULT_STACK_SIZE (64 * 1024)
+
+/* kcoro_wait_fd의 이벤트 비트 (poll/epoll 값과 동일) */
+#define KCORO_READABLE 0x001
+#define KCORO_WRITABLE 0x004
+
+/**
+ * @brief 코루틴 본문 함수 타입
+ */
+typedef void (*KCoroFunc)(void *arg);
+
+/**
+ * @struct KCoroStats
+ * @brief 호출 스레드 런타임의 누적 통계
+ */
+typedef struct KCoroStats {
+    uint64_t spawned;       /**< 생성한 코루틴 수 */
+    uint64_t switches;      /**< 코루틴으로 전환한 횟수 */
+    uint64_t peak_live;     /**< 동시에 살아 있던 최대 코루틴 수 */
+    uint64_t stacks;        /**< 할당한 스택 수 (재사용 제외) */
+    uint64_t unguarded;     /**< 가드 페이지 없이 할당한 스택 수 */
+    uint64_t polls;         /**< 이벤트 대기 시스템 호출 횟수 */
+} KCoroStats;
+
+/**
+ * @brief 호출 스레드의 런타임에 코루틴을 만드는 함수 선언
+ *
+ * kcoro_run 전이나 다른 코루틴 안에서 호출할 수 있으며, 새 코루틴은 실행 대기열 끝에 들어갑니다.
+ *
+ * @param func 코루틴 본문
+ * @param arg 본문 인자
+ * @return 코루틴 ID (1부터), 스택을 할당할 수 없으면 -1
+ */
+long kcoro_spawn(KCoroFunc func, void *arg);
+
+/**
+ * @brief 호출 스레드의 코루틴을 모두 끝날 때까지 실행하는 함수 선언
+ *
+ * 반환 시 스택 풀도 해제합니다. 코루틴 안에서 호출할 수 없습니다.
+ *
+ * @return 모든 코루틴이 끝나면 0, 코루틴 안에서 호출했거나 이벤트 대기를 준비할 수 없으면 -1
+ */
+int kcoro_run(void);
+
+/**
+ * @brief 실행 중인 코루틴의 ID를 반환하는 함수 선언
+ *
+ * @return 코루틴 ID, 코루틴 밖이면 0
+ */
+long kcoro_self(void);
+
+/**
+ * @brief 실행 대기 중인 다른 코루틴에게 양보하는 함수 선언 (코루틴 밖에서는 아무것도 하지 않음)
+ */
+void kcoro_yield(void);
+
+/**
+ * @brief 현재 코루틴을 지정한 시간 동안 재우는 함수 선언
+ *
+ * 코루틴 밖에서 호출하면 스레드가 잠듭니다.
+ *
+ * @param usec 대기 시간 (마이크로초)
+ */
+void kcoro_sleep_us(uint64_t usec);
+
+/**
+ * @brief fd가 준비될 때까지 현재 코루틴을 재우는 함수 선언
+ *
+ * fd 하나에는 한 코루틴만 대기할 수 있습니다. 코루틴 밖에서는 poll로 스레드가 대기합니다.
+ *
+ * @param fd 파일 디스크립터
+ * @param events KCORO_READABLE / KCORO_WRITABLE 조합
+ * @param timeout_us 최대 대기 시간 (마이크로초, 음수면 무한)
+ * @return 준비된 이벤트 비트, 시간 초과면 0, 실패 시 -1
+ */
+int kcoro_wait_fd(int fd, uint32_t events, int64_t timeout_us);
+
+/**
+ * @brief 호출 스레드 런타임의 누적 통계를 복사하는 함수 선언
+ *
+ * @param stats 결과를 저장할 위치
+ */
+void kcoro_get_stats(KCoroStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_CORO_H
@@ -0,0 +1,52 @@
+/*
+ * Shortest Round-Trip Float Formatting
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Converts a double or float to the shortest decimal string
+ *             that reads back (strtod / strtof) as the same value, for
+ *             telemetry and logs where "%.17g" is noisy and "%g" loses
+ *             information. kernel_printf's %f %e %g keep C semantics and
+ *             are rounded exactly at the requested precision.
+ *
+ *             Layout follows %.17g: plain decimal when the exponent of the
+ *             first digit is in [-4, 17), otherwise d.ddde+XX. Trailing
+ *             zeros and a bare decimal point are never printed; "nan",
+ *             "inf" and "-0" are spelled as glibc does.
+ */
+
+#pragma once
+#ifndef KERNEL_DTOA_H
+#define KERNEL_DTOA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 결과에 필요한 버퍼 크기 (부호, 17자리, 소수점, 지수, NUL 포함) */
+#define KDTOA_BUFFER_SIZE 32
+
+/**
+ * @brief double을 가장 짧은 왕복 문자열로 바꾸는 함수 선언
+ *
+ * @param value 변환할 값
+ * @param buf 결과 (KDTOA_BUFFER_SIZE 이상, NUL로 끝남)
+ * @return 문자열 길이 (NUL 제외)
+ */
+int kernel_dtoa(double value, char *buf);
+
+/**
+ * @brief float을 가장 짧은 왕복 문자열로 바꾸는 함수 선언 (float 정밀도 기준)
+ *
+ * @param value 변환할 값
+ * @param buf 결과 (KDTOA_BUFFER_SIZE 이상, NUL로 끝남)
+ * @return 문자열 길이 (NUL 제외)
+ */
+int kernel_ftoa(float value, char *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_DTOA_H
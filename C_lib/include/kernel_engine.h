@@ -28,42 +28,49 @@
 extern "C" {
 #endif
 
-/**
- * @brief 전역 뮤텍스 변수
- * 
- * 출력 시 스레드 동기화를 위해 사용됩니다.
- */
-static pthread_mutex_t print_mutex = PTHREAD_MUTEX_INITIALIZER;
-
 /**
  * @brief 스레드 안전한 출력 함수 선언
  * 
+ * kernel_log.h의 버퍼링된 로그 싱크로 기록하며, 줄 단위로 섞이지 않고 출력됩니다.
+ * 줄바꿈으로 끝나지 않는 포맷 (프롬프트 등)은 즉시 출력됩니다.
+ * 
  * @param format 포맷 문자열
  * @param ... 가변 인자 리스트
  */
 void safe_kernel_printf(const char *format, ...);
 
+/* 연결 리스트 청크 하나가 담는 원소 수 (청크 크기 512바이트) */
+#define LINKEDLIST_CHUNK_SLOTS 62
+
+/* 리스트마다 재사용을 위해 보관하는 빈 청크 수 */
+#define LINKEDLIST_FREE_CHUNKS 8
+
 /**
- * @struct Node
- * @brief 연결 리스트의 노드를 정의하는 구조체
- * 
- * 각 노드는 데이터를 저장하고, 다음 노드를 가리킵니다.
+ * @struct ListChunk
+ * @brief 연결 리스트의 청크 (여러 원소를 연속 배열에 저장)
+ *
+ * [begin, end) 구간에 원소가 있으며, 청크 단위로만 할당/해제됩니다.
  */
-typedef struct Node {
-    void* data;           /**< 데이터를 가리키는 포인터 */
-    struct Node* next;    /**< 다음 노드를 가리키는 포인터 */
-} Node;
+typedef struct ListChunk {
+    struct ListChunk* next;                 /**< 다음 청크 */
+    int begin;                              /**< 첫 원소 위치 */
+    int end;                                /**< 마지막 원소 다음 위치 */
+    void* slots[LINKEDLIST_CHUNK_SLOTS];    /**< 원소 배열 */
+} ListChunk;
 
 /**
  * @struct LinkedList
  * @brief 연결 리스트를 정의하는 구조체
  * 
- * 연결 리스트의 헤드, 테일, 크기를 포함합니다.
+ * 원소를 청크 단위로 묶은 펼친(unrolled) 리스트이며, 다 쓴 청크는 리스트의 빈 청크 목록에서 재사용됩니다.
+ * 동기화가 없으므로 여러 스레드가 공유하는 큐는 kernel_queue.h의 큐를 사용합니다.
  */
 typedef struct LinkedList {
-    Node* head;           /**< 연결 리스트의 첫 번째 노드를 가리키는 포인터 */
-    Node* tail;           /**< 연결 리스트의 마지막 노드를 가리키는 포인터 */
-    int size;             /**< 연결 리스트의 크기 */
+    ListChunk* head;        /**< 첫 번째 청크 (pop 위치) */
+    ListChunk* tail;        /**< 마지막 청크 (push 위치) */
+    int size;               /**< 연결 리스트의 크기 */
+    ListChunk* free_chunks; /**< 재사용할 빈 청크 목록 */
+    int free_count;         /**< 빈 청크 수 */
 } LinkedList;
 
 /**
@@ -89,6 +96,34 @@ void push(LinkedList* list, void* data);
  */
 void* pop(LinkedList* list);
 
+/**
+ * @brief 연결 리스트에 여러 요소를 순서대로 추가하는 함수 선언
+ * 
+ * @param list 연결 리스트의 포인터
+ * @param data 추가할 데이터 포인터 배열
+ * @param count 추가할 요소 수
+ */
+void push_n(LinkedList* list, void* const* data, size_t count);
+
+/**
+ * @brief 연결 리스트에서 최대 max_count개의 요소를 꺼내는 함수 선언
+ * 
+ * @param list 연결 리스트의 포인터
+ * @param out 꺼낸 데이터를 저장할 배열
+ * @param max_count 꺼낼 최대 요소 수
+ * @return 실제로 꺼낸 요소 수
+ */
+size_t pop_n(LinkedList* list, void** out, size_t max_count);
+
+/**
+ * @brief 연결 리스트의 요소를 앞에서부터 순회하는 함수 선언
+ * 
+ * @param list 연결 리스트의 포인터
+ * @param func 요소마다 호출할 함수
+ * @param ctx 함수에 전달할 사용자 데이터
+ */
+void linkedlist_for_each(LinkedList* list, void (*func)(void* data, void* ctx), void* ctx);
+
 /**
  * @brief 연결 리스트가 비었는지 확인하는 함수 선언
  * 
@@ -113,6 +148,15 @@ void destroy_linkedlist(LinkedList* list);
  */
 void create_threads(int num_threads, ...);
 
+/**
+ * @brief 같은 인자를 전달하는 스레드 생성 함수 선언
+ * 
+ * @param num_threads 생성할 스레드 수
+ * @param arg 각 스레드 함수에 전달할 인자
+ * @param ... 스레드 함수 포인터
+ */
+void create_threads_with_arg(int num_threads, void *arg, ...);
+
 /**
  * @brief 단일 프로세스 생성 함수 선언
  * 
@@ -192,9 +236,18 @@ void kernel_usageErr(const char *format, ...) __attribute__ ((__noreturn__));
  */
 void kernel_cmdLineErr(const char *format, ...) __attribute__ ((__noreturn__));
 
+/**
+ * @brief semaphore_thread / mutex_thread가 잠금을 쥔 채 일하는 시간을 설정하는 함수 선언
+ *
+ * @param hold_ns 임계 구역 길이 (나노초, 기본 1ms)
+ */
+void kernel_sync_hold_configure(unsigned hold_ns);
+
 /**
  * @brief 세마포어를 사용하는 스레드 작업 함수 선언
  * 
+ * 세마포어를 쥔 채 kernel_sync_hold_configure로 정한 시간만큼 보정된 바쁜 대기로 일합니다.
+ *
  * @param arg 세마포어 포인터
  * @return NULL
  */
@@ -203,6 +256,8 @@ void* semaphore_thread(void* arg);
 /**
  * @brief 뮤텍스를 사용하는 스레드 작업 함수 선언
  * 
+ * 뮤텍스를 쥔 채 kernel_sync_hold_configure로 정한 시간만큼 보정된 바쁜 대기로 일합니다.
+ *
  * @param arg 뮤텍스 포인터
  * @return NULL
  */
@@ -211,6 +266,8 @@ void* mutex_thread(void* arg);
 /**
  * @brief 멀티스레드 실행 함수 선언 (쓰레드 수 및 동기화 방법을 입력받음)
  * 
+ * kernel_contention.h의 경합 측정으로 선택한 잠금을 측정하고 결과를 출력합니다.
+ * 
  * @param num_threads 생성할 스레드 수
  * @param use_semaphore 세마포어 사용 여부
  * @param ... 동기화 방법 (세마포어 또는 뮤텍스)
@@ -0,0 +1,77 @@
+/*
+ * Epoch-Based Reclamation
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Lets readers walk shared tables without taking a lock.
+ *             Readers enter a cheap read-side critical section, writers
+ *             unpublish an object and retire it, and the object is
+ *             reclaimed only after every reader that could still see it
+ *             has left its critical section (grace period).
+ */
+
+#pragma once
+#ifndef KERNEL_EPOCH_H
+#define KERNEL_EPOCH_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 공유 포인터를 읽기 구역 안에서 안전하게 읽는 매크로
+ *
+ * 작성자가 다른 스레드에서 포인터를 NULL로 바꾸는 중에도 찢어지지 않은 값을 읽습니다.
+ */
+#define EPOCH_LOAD(p) __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+
+/**
+ * @brief 공유 포인터를 게시하는 매크로
+ *
+ * 객체 초기화가 끝난 뒤 호출해야 읽기 스레드가 완성된 객체만 보게 됩니다.
+ */
+#define EPOCH_STORE(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+
+/**
+ * @brief 읽기 측 임계 구역 진입 함수 선언
+ *
+ * 중첩 호출이 가능하며, 가장 바깥쪽 호출만 전역 에포크를 기록합니다.
+ */
+void epoch_enter(void);
+
+/**
+ * @brief 읽기 측 임계 구역 종료 함수 선언
+ */
+void epoch_exit(void);
+
+/**
+ * @brief 게시 해제된 객체를 유예 기간 후 해제하도록 예약하는 함수 선언
+ *
+ * @param ptr 해제할 객체 포인터 (이미 공유 테이블에서 제거되어 있어야 함)
+ * @param deleter 유예 기간 후 호출될 소멸자 함수 (NULL이면 free, 내부에서 epoch_retire 호출 금지)
+ */
+void epoch_retire(void *ptr, void (*deleter)(void *));
+
+/**
+ * @brief 에포크 전진을 시도하고 유예 기간이 지난 객체를 해제하는 함수 선언
+ *
+ * 블로킹하지 않으며, 읽기 스레드가 남아 있으면 해제 가능한 객체만 정리합니다.
+ */
+void epoch_collect(void);
+
+/**
+ * @brief 현재까지 예약된 객체가 모두 해제될 때까지 대기하는 함수 선언
+ *
+ * 읽기 측 임계 구역 안에서 호출하면 교착 상태가 되므로 반드시 구역 밖에서 호출해야 합니다.
+ */
+void epoch_synchronize(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_EPOCH_H
@@ -0,0 +1,180 @@
+/*
+ * Kernel Format Compiler
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Compiles kernel_printf format strings once into a compact
+ *             list of ops (literal spans and conversion descriptors with
+ *             flags, width, precision and length already decoded) and
+ *             caches the result by format pointer, so repeated calls with
+ *             the same literal only execute the ops.
+ *
+ *             The cache is a fixed open-addressing table claimed with CAS;
+ *             lookups take no lock. A hit is confirmed by comparing the
+ *             cached copy of the text, so a buffer reused with different
+ *             contents at the same address is compiled afresh rather than
+ *             executed with a stale program. Programs are never freed; once
+ *             the table is full new formats are compiled per call.
+ *
+ *             Compiled conversions follow C printf: flags "-+ 0#", width
+ *             and precision (numbers or '*'), length modifiers hh h l ll z
+ *             j t L, and the conversions d i u o x X c s p f F e E g G a A
+ *             and %%. Anything else (for example %n) makes the whole format
+ *             fall back to the original az_* interpreter. %f %e %g are
+ *             rendered exactly by az_dtoa.c; %a and long double go through
+ *             the C library.
+ *
+ *             KERNEL_PRINTF_COMPILE=0 disables the compiler.
+ *
+ *             The conversion emitters (kfmt_emit_*) are exported so other
+ *             front ends share the same back end: kernel_format.hpp parses
+ *             formats at C++ compile time and calls them directly, and
+ *             kfmt_print_args formats a runtime format from tagged
+ *             arguments (the Qt console) without building a va_list.
+ */
+
+#pragma once
+#ifndef KERNEL_FORMAT_H
+#define KERNEL_FORMAT_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 캐시 슬롯 수 (2의 거듭제곱) */
+#define KFMT_CACHE_SLOTS 1024
+
+/* 한 포맷이 캐시에서 찾아보는 최대 슬롯 수 */
+#define KFMT_MAX_PROBES 8
+
+/**
+ * @struct KFmtStats
+ * @brief 포맷 캐시 통계 (드문 경로만 셈)
+ */
+typedef struct KFmtStats {
+    uint64_t compiled;      /**< 컴파일한 포맷 수 (캐시 여부 무관) */
+    uint64_t uncached;      /**< 캐시에 넣지 못하고 호출마다 컴파일한 횟수 */
+    uint64_t fallbacks;     /**< 컴파일할 수 없어 az_* 해석기로 처리한 횟수 */
+    uint32_t entries;       /**< 캐시에 등록된 포맷 수 */
+} KFmtStats;
+
+/* KFmtSpec.flags (kernel_pr_he.h의 AZ_FLAG_*와 같은 값) */
+#define KFMT_FLAG_LEFT  0x01u   /* '-' */
+#define KFMT_FLAG_PLUS  0x02u   /* '+' */
+#define KFMT_FLAG_SPACE 0x04u   /* ' ' */
+#define KFMT_FLAG_ZERO  0x08u   /* '0' */
+#define KFMT_FLAG_ALT   0x10u   /* '#' */
+
+/**
+ * @struct KFmtSpec
+ * @brief 변환 하나의 해석된 지정자 ('*'는 호출자가 값으로 바꿔서 넘김)
+ */
+typedef struct KFmtSpec {
+    char conv;              /**< 변환 문자 ('i'는 'd'로) */
+    unsigned char flags;    /**< KFMT_FLAG_* */
+    int width;              /**< 너비 (없으면 -1) */
+    int precision;          /**< 정밀도 (없으면 -1) */
+} KFmtSpec;
+
+/**
+ * @brief kfmt_print_args 인자 종류
+ */
+typedef enum {
+    KFMT_ARG_INT = 0,       /**< 부호 있는 정수 (d i u o x X c, '*', 실수 변환, 주소 값으로 p) */
+    KFMT_ARG_UINT,          /**< 부호 없는 정수 (KFMT_ARG_INT와 같은 변환) */
+    KFMT_ARG_DOUBLE,        /**< 실수 (f F e E g G a A) */
+    KFMT_ARG_STRING,        /**< NUL로 끝난 문자열 (s) */
+    KFMT_ARG_POINTER        /**< 포인터 (p) */
+} KFmtArgType;
+
+/**
+ * @struct KFmtArg
+ * @brief 종류 태그가 붙은 인자
+ */
+typedef struct KFmtArg {
+    KFmtArgType type;
+    union {
+        intmax_t i;
+        uintmax_t u;
+        double d;
+        const char *s;
+        const void *p;
+    } v;
+} KFmtArg;
+
+/* kfmt_print_args 반환값 */
+#define KFMT_OK        0
+#define KFMT_EFORMAT (-1)   /* 지원하지 않거나 잘못된 포맷 */
+#define KFMT_ETYPE   (-2)   /* 변환과 맞지 않는 인자 */
+#define KFMT_ECOUNT  (-3)   /* 인자 개수가 다름 */
+#define KFMT_ENOMEM  (-4)
+
+/**
+ * @brief 포맷을 컴파일(또는 캐시에서 찾아) 현재 출력 버퍼로 출력하는 함수 선언
+ *
+ * kernel_printf / kernel_sink_vprintf 내부에서 사용합니다. -1을 반환하면 인자를 하나도 읽지 않은 상태이므로
+ * 호출자가 az_* 해석기로 출력해야 합니다.
+ *
+ * @param format 포맷 문자열
+ * @param ap 가변 인자 (포인터로 받으므로 읽은 만큼 호출자 쪽에서도 소비됨)
+ * @return 출력했으면 0, 컴파일러가 꺼져 있거나 지원하지 않는 포맷이면 -1
+ */
+int kfmt_vformat(const char *format, va_list *ap);
+
+/**
+ * @brief 태그가 붙은 인자로 포맷을 출력하는 함수 선언 (kernel_printf와 같은 출력 경로)
+ *
+ * 모든 변환과 인자를 먼저 확인하고 맞지 않으면 아무것도 출력하지 않습니다. 정수 인자는 실수 변환과
+ * %p(주소 값)에도 쓸 수 있으며 길이 지정자(hh, l 등)에 맞게 잘립니다. 포맷은 캐시하지 않습니다.
+ *
+ * @param format 포맷 문자열
+ * @param args 인자 배열
+ * @param nargs 인자 개수
+ * @param bad_arg 실패 위치 (KFMT_ETYPE이면 인자 번호, KFMT_ECOUNT면 포맷이 요구하는 개수, NULL 가능)
+ * @return KFMT_OK 또는 KFMT_E*
+ */
+int kfmt_print_args(const char *format, const KFmtArg *args, size_t nargs, size_t *bad_arg);
+
+/*
+ * 변환 하나를 현재 출력 버퍼에 쓰는 함수들 (az_print_begin / az_print_to_sink 안에서 호출)
+ *
+ * spec.conv에 맞는 함수를 불러야 합니다: d는 signed, u o x X는 unsigned, c s p는 각각 char / string /
+ * pointer, f F e E g G a A는 double / long_double.
+ */
+void kfmt_emit_signed(KFmtSpec spec, intmax_t value);
+void kfmt_emit_unsigned(KFmtSpec spec, uintmax_t value);
+void kfmt_emit_char(KFmtSpec spec, int c);
+void kfmt_emit_string(KFmtSpec spec, const char *s);
+void kfmt_emit_pointer(KFmtSpec spec, const void *ptr);
+void kfmt_emit_double(KFmtSpec spec, double value);
+void kfmt_emit_long_double(KFmtSpec spec, long double value);
+
+/**
+ * @brief 포맷 컴파일러를 켜거나 끄는 함수 선언 (끄면 az_* 해석기 사용)
+ *
+ * @param enabled 0이면 끔
+ */
+void kfmt_set_enabled(int enabled);
+
+/**
+ * @brief 포맷 컴파일러가 켜져 있는지 반환하는 함수 선언
+ */
+int kfmt_enabled(void);
+
+/**
+ * @brief 포맷 캐시 통계를 복사하는 함수 선언
+ *
+ * @param stats 결과를 저장할 위치
+ */
+void kfmt_get_stats(KFmtStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_FORMAT_H
@@ -0,0 +1,491 @@
+/*
+ * Kernel Format (C++ front end)
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Compile-time checked kernel_printf for C++17 callers.
+ *
+ *               kernel::format(KERNEL_FMT("pid=%d name=%s\n"), pid, name);
+ *
+ *             KERNEL_FMT wraps the literal in a type, so constexpr code
+ *             parses the format while the call site compiles. A malformed
+ *             or unsupported conversion, a wrong argument count or an
+ *             argument that does not fit its conversion is a static_assert
+ *             failure at that call site. Each call site then gets its own
+ *             emitter: literal spans and one kfmt_emit_* call per argument
+ *             with the decoded spec as constants. Nothing parses the format
+ *             at run time and no va_list is built; the output goes through
+ *             the same buffers, sinks and az_* conversions as kernel_printf.
+ *
+ *             Conversions follow kernel_format.h (%n and %lc / %ls are
+ *             rejected). Accepted arguments:
+ *               d i u o x X  integer or enum no wider than the length
+ *                            modifier's type (int for none and for hh / h)
+ *               c            integer no wider than int
+ *               s            char pointer or array, nullptr
+ *               p            object pointer, nullptr
+ *               f F e E g G a A  float or double (any floating type with L)
+ *               *            integer no wider than int
+ *             bool is rejected everywhere. Integers are converted to the
+ *             length modifier's type first, as printf does after reading
+ *             them from va_list, so signedness may differ from the
+ *             conversion.
+ */
+
+#pragma once
+#ifndef KERNEL_FORMAT_HPP
+#define KERNEL_FORMAT_HPP
+
+#include "kernel_format.h"
+#include "kernel_pr_he.h"
+#include "kernel_print_sink.h"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 문자열 리터럴을 컴파일 시간 포맷 타입으로 감싸는 매크로
+ *
+ * 리터럴이 아니면 컴파일되지 않습니다. 호출마다 다른 타입이 만들어지므로 호출 위치마다 출력 코드가 따로 생성됩니다.
+ */
+#define KERNEL_FMT(str)                                               \
+    ([] {                                                             \
+        struct KernelFmtText {                                        \
+            static constexpr const char *text() { return "" str; }   \
+        };                                                            \
+        return KernelFmtText{};                                       \
+    }())
+
+namespace kernel {
+namespace detail {
+
+/* FmtOp.width / FmtOp.precision 값: 없음, '*' */
+constexpr int FMT_NONE = -1;
+constexpr int FMT_STAR = -2;
+
+enum FmtLength : unsigned char { LEN_NONE, LEN_HH, LEN_H, LEN_L, LEN_LL, LEN_Z, LEN_J, LEN_T, LEN_LD };
+
+enum class FmtError { None, Syntax, TooFewArgs, TooManyArgs, BadArg };
+
+/**
+ * @struct FmtOp
+ * @brief 컴파일 시간에 해석한 포맷의 한 단계 (리터럴 구간 또는 변환)
+ */
+struct FmtOp {
+    bool literal = false;
+    char conv = 0;                  /**< 변환 문자 ('i'는 'd'로 정규화) */
+    unsigned char flags = 0;        /**< KFMT_FLAG_* */
+    unsigned char length = LEN_NONE;
+    int width = FMT_NONE;
+    int precision = FMT_NONE;
+    std::size_t offset = 0;         /**< 리터럴 시작 위치 */
+    std::size_t len = 0;            /**< 리터럴 길이 */
+    std::size_t arg = 0;            /**< 변환이 처음 쓰는 인자 번호 ('*' 포함) */
+};
+
+/**
+ * @struct FmtProgram
+ * @brief 해석된 포맷 (N은 ops 개수의 상한)
+ */
+template <std::size_t N>
+struct FmtProgram {
+    FmtOp ops[N];
+    std::size_t nops = 0;
+    std::size_t nargs = 0;          /**< 포맷이 쓰는 인자 수 */
+    bool error = false;             /**< 잘못되었거나 지원하지 않는 변환 */
+};
+
+constexpr std::size_t fmt_capacity(const char *text) {
+    std::size_t n = 1;
+    for (; *text != '\0'; text++) {
+        n += *text == '%' ? 2 : 0;
+    }
+    return n;
+}
+
+template <std::size_t N>
+constexpr void fmt_add_literal(FmtProgram<N> &prog, std::size_t from, std::size_t to) {
+    if (to > from) {
+        FmtOp &op = prog.ops[prog.nops++];
+        op.literal = true;
+        op.offset = from;
+        op.len = to - from;
+    }
+}
+
+constexpr bool fmt_parse_number(const char *text, std::size_t &i, int &out) {
+    int n = 0;
+    while (text[i] >= '0' && text[i] <= '9') {
+        if (n > (INT_MAX - 9) / 10) {
+            return false;
+        }
+        n = n * 10 + (text[i++] - '0');
+    }
+    out = n;
+    return true;
+}
+
+/**
+ * @brief '%' 다음부터 변환 하나를 해석하는 함수 (kernel_format.c의 parse_conversion과 같은 규칙)
+ *
+ * @return 성공하면 true (i는 변환 문자 다음으로 이동)
+ */
+constexpr bool fmt_parse_conversion(const char *text, std::size_t &i, FmtOp &op) {
+    for (;; i++) {
+        if (text[i] == '-') op.flags |= KFMT_FLAG_LEFT;
+        else if (text[i] == '+') op.flags |= KFMT_FLAG_PLUS;
+        else if (text[i] == ' ') op.flags |= KFMT_FLAG_SPACE;
+        else if (text[i] == '0') op.flags |= KFMT_FLAG_ZERO;
+        else if (text[i] == '#') op.flags |= KFMT_FLAG_ALT;
+        else break;
+    }
+
+    if (text[i] == '*') {
+        op.width = FMT_STAR;
+        i++;
+    } else if (text[i] >= '1' && text[i] <= '9' && !fmt_parse_number(text, i, op.width)) {
+        return false;
+    }
+
+    if (text[i] == '.') {
+        i++;
+        if (text[i] == '*') {
+            op.precision = FMT_STAR;
+            i++;
+        } else if (!fmt_parse_number(text, i, op.precision)) {
+            return false;
+        }
+    }
+
+    switch (text[i]) {
+        case 'h': op.length = text[i + 1] == 'h' ? LEN_HH : LEN_H; i += text[i + 1] == 'h' ? 2 : 1; break;
+        case 'l': op.length = text[i + 1] == 'l' ? LEN_LL : LEN_L; i += text[i + 1] == 'l' ? 2 : 1; break;
+        case 'z': op.length = LEN_Z; i++; break;
+        case 'j': op.length = LEN_J; i++; break;
+        case 't': op.length = LEN_T; i++; break;
+        case 'L': op.length = LEN_LD; i++; break;
+        default: break;
+    }
+
+    op.conv = text[i];
+    switch (text[i]) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            if (op.length == LEN_LD) {
+                return false;
+            }
+            if (text[i] == 'i') {
+                op.conv = 'd';
+            }
+            break;
+        case 'c': case 's': case 'p':
+            if (op.length != LEN_NONE) {
+                return false;
+            }
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            if (op.length != LEN_NONE && op.length != LEN_L && op.length != LEN_LD) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    i++;
+    return true;
+}
+
+/**
+ * @brief 포맷을 ops로 해석하는 함수 (컴파일 시간에 실행)
+ */
+template <std::size_t N>
+constexpr FmtProgram<N> fmt_parse(const char *text) {
+    FmtProgram<N> prog{};
+    std::size_t lit = 0;
+    std::size_t i = 0;
+
+    while (text[i] != '\0') {
+        if (text[i] != '%') {
+            i++;
+            continue;
+        }
+        if (text[i + 1] == '%') {
+            // "%%"는 앞쪽 '%'까지를 리터럴에 포함시키고 뒤쪽은 건너뜀
+            fmt_add_literal(prog, lit, i + 1);
+            i += 2;
+            lit = i;
+            continue;
+        }
+        fmt_add_literal(prog, lit, i);
+        FmtOp op{};
+        i++;
+        if (!fmt_parse_conversion(text, i, op)) {
+            prog.error = true;
+            return prog;
+        }
+        op.arg = prog.nargs;
+        prog.nargs += 1 + (op.width == FMT_STAR) + (op.precision == FMT_STAR);
+        prog.ops[prog.nops++] = op;
+        lit = i;
+    }
+    fmt_add_literal(prog, lit, i);
+    return prog;
+}
+
+/**
+ * @struct FmtTraits
+ * @brief KERNEL_FMT 타입마다 한 번 해석한 포맷
+ */
+template <typename Fmt>
+struct FmtTraits {
+    static constexpr const char *text = Fmt::text();
+    static constexpr FmtProgram<fmt_capacity(Fmt::text())> program = fmt_parse<fmt_capacity(Fmt::text())>(Fmt::text());
+};
+
+/**
+ * @struct ArgInfo
+ * @brief 인자 타입의 분류
+ */
+struct ArgInfo {
+    bool integer = false;           /**< 정수 또는 enum (bool 제외) */
+    std::size_t size = 0;
+    bool floating = false;
+    bool long_double = false;
+    bool string = false;            /**< char 포인터 (배열 포함) */
+    bool pointer = false;           /**< 객체 포인터 */
+    bool null = false;              /**< nullptr */
+};
+
+template <typename T>
+constexpr ArgInfo arg_info() {
+    using D = std::decay_t<T>;
+    ArgInfo info{};
+    info.integer = (std::is_integral<D>::value && !std::is_same<D, bool>::value) || std::is_enum<D>::value;
+    info.size = sizeof(D);
+    info.floating = std::is_floating_point<D>::value;
+    info.long_double = std::is_same<D, long double>::value;
+    if constexpr (std::is_pointer<D>::value) {
+        using P = std::remove_cv_t<std::remove_pointer_t<D>>;
+        info.pointer = !std::is_function<P>::value;
+        info.string = std::is_same<P, char>::value;
+    }
+    info.null = std::is_null_pointer<D>::value;
+    return info;
+}
+
+constexpr std::size_t length_size(unsigned char length) {
+    switch (length) {
+        case LEN_L:  return sizeof(long);
+        case LEN_LL: return sizeof(long long);
+        case LEN_Z:  return sizeof(std::size_t);
+        case LEN_J:  return sizeof(std::intmax_t);
+        case LEN_T:  return sizeof(std::ptrdiff_t);
+        default:     return sizeof(int);    // hh / h도 int로 승격된 값을 받음
+    }
+}
+
+constexpr bool arg_fits(const FmtOp &op, const ArgInfo &arg) {
+    switch (op.conv) {
+        case 'd': case 'u': case 'o': case 'x': case 'X':
+            return arg.integer && arg.size <= length_size(op.length);
+        case 'c':
+            return arg.integer && arg.size <= sizeof(int);
+        case 's':
+            return arg.string || arg.null;
+        case 'p':
+            return arg.pointer || arg.null;
+        default:
+            return arg.floating && (op.length == LEN_LD || !arg.long_double);
+    }
+}
+
+constexpr bool star_fits(const ArgInfo &arg) {
+    return arg.integer && arg.size <= sizeof(int);
+}
+
+/**
+ * @brief 포맷과 인자 타입을 확인하는 함수 (컴파일 시간에 실행)
+ */
+template <typename Fmt, typename... Args>
+constexpr FmtError fmt_check() {
+    constexpr auto &prog = FmtTraits<Fmt>::program;
+    constexpr ArgInfo args[sizeof...(Args) + 1] = { arg_info<Args>()..., ArgInfo{} };
+
+    if (prog.error) {
+        return FmtError::Syntax;
+    }
+    if (prog.nargs > sizeof...(Args)) {
+        return FmtError::TooFewArgs;
+    }
+    if (prog.nargs < sizeof...(Args)) {
+        return FmtError::TooManyArgs;
+    }
+    for (std::size_t i = 0; i < prog.nops; i++) {
+        const FmtOp &op = prog.ops[i];
+        if (op.literal) {
+            continue;
+        }
+        std::size_t a = op.arg;
+        if (op.width == FMT_STAR && !star_fits(args[a++])) {
+            return FmtError::BadArg;
+        }
+        if (op.precision == FMT_STAR && !star_fits(args[a++])) {
+            return FmtError::BadArg;
+        }
+        if (!arg_fits(op, args[a])) {
+            return FmtError::BadArg;
+        }
+    }
+    return FmtError::None;
+}
+
+template <typename Fmt, typename... Args>
+constexpr bool fmt_static_check() {
+    constexpr FmtError error = fmt_check<Fmt, Args...>();
+    static_assert(error != FmtError::Syntax, "kernel::format: malformed or unsupported conversion in format");
+    static_assert(error != FmtError::TooFewArgs, "kernel::format: too few arguments for format");
+    static_assert(error != FmtError::TooManyArgs, "kernel::format: too many arguments for format");
+    static_assert(error != FmtError::BadArg, "kernel::format: argument type does not match its conversion");
+    return error == FmtError::None;
+}
+
+/* 길이 지정자에 해당하는 정수 타입 (kernel_format.c의 read_signed / read_unsigned와 같음) */
+template <unsigned char Length> struct LengthType { using S = int; using U = unsigned int; };
+template <> struct LengthType<LEN_HH> { using S = signed char; using U = unsigned char; };
+template <> struct LengthType<LEN_H> { using S = short; using U = unsigned short; };
+template <> struct LengthType<LEN_L> { using S = long; using U = unsigned long; };
+template <> struct LengthType<LEN_LL> { using S = long long; using U = unsigned long long; };
+template <> struct LengthType<LEN_Z> { using S = std::ptrdiff_t; using U = std::size_t; };
+template <> struct LengthType<LEN_J> { using S = std::intmax_t; using U = std::uintmax_t; };
+template <> struct LengthType<LEN_T> { using S = std::ptrdiff_t; using U = std::size_t; };
+
+template <typename T>
+inline void spec_set_width(KFmtSpec &spec, const T &value) {
+    int width = static_cast<int>(value);
+    if (width < 0) {
+        spec.flags |= KFMT_FLAG_LEFT;
+        width = width == INT_MIN ? INT_MAX : -width;
+    }
+    spec.width = width;
+}
+
+template <typename T>
+inline void spec_set_precision(KFmtSpec &spec, const T &value) {
+    int precision = static_cast<int>(value);
+    spec.precision = precision < 0 ? FMT_NONE : precision;
+}
+
+template <char Conv, unsigned char Length, typename T>
+inline void fmt_emit_value(KFmtSpec spec, const T &value) {
+    if constexpr (Conv == 'd') {
+        kfmt_emit_signed(spec, static_cast<typename LengthType<Length>::S>(value));
+    } else if constexpr (Conv == 'u' || Conv == 'o' || Conv == 'x' || Conv == 'X') {
+        kfmt_emit_unsigned(spec, static_cast<typename LengthType<Length>::U>(value));
+    } else if constexpr (Conv == 'c') {
+        kfmt_emit_char(spec, static_cast<int>(value));
+    } else if constexpr (Conv == 's') {
+        kfmt_emit_string(spec, value);
+    } else if constexpr (Conv == 'p') {
+        if constexpr (std::is_null_pointer<T>::value) {
+            kfmt_emit_pointer(spec, nullptr);
+        } else {
+            kfmt_emit_pointer(spec, const_cast<const void *>(static_cast<const volatile void *>(value)));
+        }
+    } else if constexpr (Length == LEN_LD) {
+        kfmt_emit_long_double(spec, static_cast<long double>(value));
+    } else {
+        kfmt_emit_double(spec, static_cast<double>(value));
+    }
+}
+
+/**
+ * @brief I번째 op를 출력하는 함수 (op의 모든 값이 상수이므로 호출 위치마다 분기 없는 코드가 됨)
+ */
+template <typename Fmt, std::size_t I, typename Tuple>
+inline void fmt_emit_op(const Tuple &args) {
+    constexpr FmtOp op = FmtTraits<Fmt>::program.ops[I];
+
+    if constexpr (op.literal) {
+        az_print_write(FmtTraits<Fmt>::text + op.offset, op.len);
+    } else {
+        constexpr std::size_t value = op.arg + (op.width == FMT_STAR) + (op.precision == FMT_STAR);
+        KFmtSpec spec = { op.conv, op.flags, op.width, op.precision };
+
+        if constexpr (op.width == FMT_STAR) {
+            spec_set_width(spec, std::get<op.arg>(args));
+        }
+        if constexpr (op.precision == FMT_STAR) {
+            spec_set_precision(spec, std::get<value - 1>(args));
+        }
+        fmt_emit_value<op.conv, op.length>(spec, std::get<value>(args));
+    }
+}
+
+template <typename Fmt, typename Tuple, std::size_t... I>
+inline void fmt_run(const Tuple &args, std::index_sequence<I...>) {
+    (void)args;
+    (fmt_emit_op<Fmt, I>(args), ...);
+}
+
+template <typename Fmt, typename Tuple>
+inline void fmt_run(const Tuple &args) {
+    fmt_run<Fmt>(args, std::make_index_sequence<FmtTraits<Fmt>::program.nops>{});
+}
+
+} // namespace detail
+
+/**
+ * @brief kernel_printf처럼 현재 스레드의 출력 버퍼로 출력하는 함수
+ *
+ * @param fmt KERNEL_FMT("...")
+ * @param args 포맷 인자 (컴파일 시간에 확인)
+ */
+template <typename Fmt, typename... Args>
+inline void format(Fmt fmt, const Args &...args) {
+    (void)fmt;
+    if constexpr (detail::fmt_static_check<Fmt, Args...>()) {
+        az_print_begin();
+        detail::fmt_run<Fmt>(std::forward_as_tuple(args...));
+        az_print_end();
+    }
+}
+
+/**
+ * @brief kernel_sink_printf처럼 지정한 싱크로 출력하는 함수 (호출 스레드의 출력 버퍼는 건드리지 않음)
+ *
+ * @return 출력한 바이트 수
+ */
+template <typename Fmt, typename... Args>
+inline int format_sink(const KPrintSink *sink, Fmt fmt, const Args &...args) {
+    (void)fmt;
+    if constexpr (detail::fmt_static_check<Fmt, Args...>()) {
+        using Tuple = std::tuple<const Args &...>;
+        Tuple tuple(args...);
+        void (*render)(void *) = [](void *arg) { detail::fmt_run<Fmt>(*static_cast<const Tuple *>(arg)); };
+        return static_cast<int>(az_print_to_sink(sink, render, &tuple));
+    } else {
+        return 0;
+    }
+}
+
+/**
+ * @brief kernel_snprintf처럼 버퍼에 출력하는 함수 (시스템 호출 없음)
+ *
+ * @return 잘리기 전 길이 (size 이상이면 잘린 것)
+ */
+template <typename Fmt, typename... Args>
+inline int format_to(char *buf, std::size_t size, Fmt fmt, const Args &...args) {
+    KPrintMem mem;
+    KPrintSink sink = { kernel_print_mem_write, &mem };
+
+    kernel_print_mem_init(&mem, buf, size);
+    format_sink(&sink, fmt, args...);
+    return static_cast<int>(mem.len);
+}
+
+} // namespace kernel
+
+#endif // KERNEL_FORMAT_HPP
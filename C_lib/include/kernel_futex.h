@@ -0,0 +1,105 @@
+/*
+ * Kernel Futex Wrapper
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Minimal wait/wake on a 32-bit word. Uses the futex system
+ *             call on Linux and a hashed mutex/condition-variable parking
+ *             lot elsewhere, so callers can park idle threads without
+ *             owning a mutex/cond pair per wait site. Also hosts the small
+ *             spin-wait helpers (clock, pause hint, CPU count) shared by the
+ *             lock and timer primitives built on top of it.
+ */
+
+#pragma once
+#ifndef KERNEL_FUTEX_H
+#define KERNEL_FUTEX_H
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief *addr가 expected와 같으면 깨울 때까지 대기하는 함수 선언
+ *
+ * 값이 이미 다르면 즉시 반환하며, 가짜 깨어남이 있을 수 있으므로 호출자는 조건을 다시 확인해야 합니다.
+ *
+ * @param addr 대기할 32비트 주소
+ * @param expected 대기 조건 값
+ * @param timeout 상대 대기 시간 (NULL이면 무한 대기)
+ * @return 깨어나면 0, 실패 시 -1 (errno: EAGAIN 값 불일치, ETIMEDOUT 시간 초과, EINTR 시그널)
+ */
+int kernel_futex_wait(uint32_t *addr, uint32_t expected, const struct timespec *timeout);
+
+/**
+ * @brief addr에서 대기 중인 스레드를 깨우는 함수 선언
+ *
+ * 값을 바꾼 뒤에 호출해야 대기 스레드가 깨어남을 놓치지 않습니다.
+ *
+ * @param addr 깨울 32비트 주소
+ * @param count 깨울 최대 스레드 수 (INT32_MAX면 모두)
+ * @return 깨운 스레드 수 (대체 구현은 0 또는 1 이상의 추정값)
+ */
+int kernel_futex_wake(uint32_t *addr, int count);
+
+/**
+ * @brief 프로세스 간 공유 메모리의 *addr가 expected와 같으면 대기하는 함수 선언
+ *
+ * MAP_SHARED로 매핑된 주소에 사용합니다. Linux 외에서는 최대 1ms 동안 잠든 뒤 반환하므로 호출자가 다시 확인해야 합니다.
+ *
+ * @param addr 공유 메모리의 32비트 주소
+ * @param expected 대기 조건 값
+ * @param timeout 상대 대기 시간 (NULL이면 무한 대기)
+ * @return 깨어나면 0, 실패 시 -1 (errno는 kernel_futex_wait와 동일)
+ */
+int kernel_futex_wait_shared(uint32_t *addr, uint32_t expected, const struct timespec *timeout);
+
+/**
+ * @brief 프로세스 간 공유 메모리의 addr에서 대기 중인 프로세스를 깨우는 함수 선언
+ *
+ * @param addr 공유 메모리의 32비트 주소
+ * @param count 깨울 최대 대기자 수
+ * @return 깨운 대기자 수 (Linux 외에서는 0)
+ */
+int kernel_futex_wake_shared(uint32_t *addr, int count);
+
+/**
+ * @brief 온라인 CPU 수를 반환하는 함수 선언 (처음 호출 시 한 번 조회 후 캐시)
+ *
+ * 스핀 대기 여부를 정할 때 사용하며, CPU가 하나면 소유자가 실행 중일 수 없으므로 스핀하지 않아야 합니다.
+ *
+ * @return 온라인 CPU 수 (조회 실패 시 1)
+ */
+int kernel_online_cpus(void);
+
+/**
+ * @brief CLOCK_MONOTONIC 현재 시각을 나노초로 반환하는 함수
+ */
+static inline uint64_t kernel_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 스핀 루프 한 번마다 CPU에 대기 중임을 알리는 함수 (x86 pause, ARM yield)
+ */
+static inline void kernel_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_FUTEX_H
@@ -0,0 +1,105 @@
+/*
+ * Kernel Log Sink
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Buffered, line-atomic logging for multi-threaded code.
+ *             Each thread formats into its own line buffer and publishes
+ *             only complete lines into a shared block with one memcpy, so
+ *             lines from different threads never interleave. A background
+ *             flusher writes whole blocks with write(2) instead of one
+ *             fflush per message.
+ *
+ *             Everything is flushed on exit (atexit), before fork (so the
+ *             child does not repeat buffered output) and when a thread
+ *             exits. After kernel_log_shutdown, in forked children, or with
+ *             KERNEL_LOG_SYNC=1 in the environment, every line is written
+ *             immediately.
+ */
+
+#pragma once
+#ifndef KERNEL_LOG_H
+#define KERNEL_LOG_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 스레드별 줄 버퍼 크기 (이보다 긴 줄은 나뉘어 출력될 수 있음) */
+#define KLOG_LINE_BUFFER 4096
+
+/* 공유 블록 크기 (플러셔가 한 번에 write하는 최대 크기) */
+#define KLOG_BLOCK_SIZE 65536
+
+/* 플러셔가 깨어나는 최대 간격 (ms) */
+#define KLOG_FLUSH_INTERVAL_MS 20
+
+/**
+ * @brief 로그 데이터를 기록하는 함수 선언
+ *
+ * 완성된 줄만 공유 블록으로 넘어가며, 줄바꿈이 없는 나머지는 같은 스레드의 다음 기록이나 flush까지 보관됩니다.
+ *
+ * @param data 기록할 데이터
+ * @param len 데이터 길이
+ */
+void kernel_log_write(const char *data, size_t len);
+
+/**
+ * @brief printf 형식으로 로그를 기록하는 함수 선언
+ *
+ * @param format 포맷 문자열
+ * @param ... 가변 인자 리스트
+ * @return 기록한 바이트 수
+ */
+int kernel_logf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief va_list를 받는 kernel_logf 함수 선언
+ *
+ * @param format 포맷 문자열
+ * @param args 가변 인자 리스트
+ * @return 기록한 바이트 수
+ */
+int kernel_vlogf(const char *format, va_list args);
+
+/**
+ * @brief 호출 스레드가 마지막으로 기록한 바이트가 줄바꿈이 아닌지 확인하는 함수 선언
+ *
+ * 포맷 문자열이 아니라 실제로 기록된 출력을 기준으로 하므로 "%s"로 넘긴 줄도 올바르게 판단합니다.
+ *
+ * @return 마지막 바이트가 줄바꿈이 아니면 1, 줄바꿈이거나 아직 기록이 없으면 0
+ */
+int kernel_log_partial(void);
+
+/**
+ * @brief 호출 스레드의 미완성 줄과 대기 중인 모든 로그를 출력하는 함수 선언
+ *
+ * 반환 시점에는 그때까지 게시된 로그가 모두 출력 파일 디스크립터에 기록되어 있습니다.
+ */
+void kernel_log_flush(void);
+
+/**
+ * @brief 로그 출력 파일 디스크립터를 바꾸는 함수 선언 (기본값: 표준 출력)
+ *
+ * 바꾸기 전에 대기 중인 로그를 기존 디스크립터로 모두 출력합니다.
+ *
+ * @param fd 출력 파일 디스크립터
+ */
+void kernel_log_set_fd(int fd);
+
+/**
+ * @brief 로그를 모두 출력하고 플러셔를 종료하는 함수 선언
+ *
+ * 이후의 로그는 즉시 출력됩니다. 프로세스 종료 시 자동으로 호출됩니다.
+ */
+void kernel_log_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_LOG_H
@@ -0,0 +1,137 @@
+/*
+ * Kernel Adaptive Mutex
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Futex-based mutex that spins briefly before parking and keeps
+ *             contention counters. The spin budget adapts per lock: it
+ *             follows how long successful spinners had to wait for the
+ *             holder, and shrinks when spinning fails, so short critical
+ *             sections are taken without a system call while long ones park
+ *             right away. Single-CPU machines never spin.
+ *
+ *             Every lock carries a class name. Live locks are registered and
+ *             the counters of destroyed locks are folded into their class,
+ *             so kmutex_format_report shows which lock classes are contended
+ *             over the whole run.
+ */
+
+#pragma once
+#ifndef KERNEL_MUTEX_H
+#define KERNEL_MUTEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 잠금을 기다릴 때 스핀하는 최소/최대 횟수 */
+#define KMUTEX_SPIN_MIN 16
+#define KMUTEX_SPIN_MAX 1000
+
+/* 통계를 따로 모으는 잠금 클래스(이름)의 최대 수 (넘치면 "other"로 합산) */
+#define KMUTEX_MAX_CLASSES 64
+
+/**
+ * @struct KMutexStats
+ * @brief 잠금 경합 통계
+ */
+typedef struct KMutexStats {
+    uint64_t acquisitions;  /**< 획득 횟수 */
+    uint64_t contended;     /**< 바로 획득하지 못한 횟수 */
+    uint64_t wait_ns_total; /**< 경합 시 대기한 시간의 합 */
+    uint64_t wait_ns_max;   /**< 가장 오래 대기한 시간 */
+} KMutexStats;
+
+/**
+ * @struct KMutex
+ * @brief 적응형 스핀 후 대기하는 futex 뮤텍스
+ *
+ * 필드는 내부용이며 kmutex_* 함수로만 사용합니다.
+ */
+typedef struct KMutex {
+    uint32_t state;             /**< 0: 해제, 1: 잠김, 2: 잠김 + 대기자 있음 */
+    uint32_t spin_avg;          /**< 스핀으로 획득하는 데 걸린 횟수의 이동 평균 */
+    KMutexStats stats;          /**< 경합 통계 (소유자만 갱신) */
+    const char *name;           /**< 잠금 클래스 이름 */
+    struct KMutex *reg_prev;    /**< 등록 목록의 이전 잠금 */
+    struct KMutex *reg_next;    /**< 등록 목록의 다음 잠금 */
+} KMutex;
+
+/**
+ * @brief 뮤텍스를 초기화하고 등록하는 함수 선언
+ *
+ * @param mutex 초기화할 뮤텍스
+ * @param name 잠금 클래스 이름 (문자열은 프로그램이 끝날 때까지 유효해야 함, NULL이면 "anonymous")
+ */
+void kmutex_init(KMutex *mutex, const char *name);
+
+/**
+ * @brief 뮤텍스의 등록을 해제하고 통계를 클래스에 합산하는 함수 선언
+ *
+ * @param mutex 정리할 뮤텍스 (잠겨 있지 않아야 함)
+ */
+void kmutex_destroy(KMutex *mutex);
+
+/**
+ * @brief 힙에 뮤텍스를 할당하고 초기화하는 함수 선언 (init_mutex 대체)
+ *
+ * @param name 잠금 클래스 이름
+ * @return 뮤텍스 포인터
+ */
+KMutex *kmutex_create(const char *name);
+
+/**
+ * @brief kmutex_create로 만든 뮤텍스를 정리하고 해제하는 함수 선언
+ *
+ * @param mutex 해제할 뮤텍스 (NULL 허용)
+ */
+void kmutex_free(KMutex *mutex);
+
+/**
+ * @brief 뮤텍스를 잠그는 함수 선언
+ *
+ * @param mutex 잠글 뮤텍스
+ */
+void kmutex_lock(KMutex *mutex);
+
+/**
+ * @brief 뮤텍스 잠금을 시도하는 함수 선언
+ *
+ * @param mutex 잠글 뮤텍스
+ * @return 잠갔으면 1, 이미 잠겨 있으면 0
+ */
+int kmutex_trylock(KMutex *mutex);
+
+/**
+ * @brief 뮤텍스를 해제하는 함수 선언
+ *
+ * @param mutex 해제할 뮤텍스
+ */
+void kmutex_unlock(KMutex *mutex);
+
+/**
+ * @brief 뮤텍스 하나의 통계를 읽는 함수 선언
+ *
+ * @param mutex 뮤텍스
+ * @param stats 통계를 저장할 위치
+ */
+void kmutex_get_stats(const KMutex *mutex, KMutexStats *stats);
+
+/**
+ * @brief 잠금 클래스별 통계를 경합 대기 시간이 긴 순서로 문자열로 만드는 함수 선언
+ *
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int kmutex_format_report(char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_MUTEX_H
@@ -0,0 +1,189 @@
+/*
+ * Kernel Thread Pool
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Persistent worker threads for the engine. Tasks carry a
+ *             void* argument, idle workers park on a futex word instead of
+ *             being recreated, and shutdown drains queued tasks before the
+ *             workers are joined.
+ */
+
+#pragma once
+#ifndef KERNEL_POOL_H
+#define KERNEL_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "kernel_affinity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 풀 하나가 가질 수 있는 최대 작업자 수 */
+#define KERNEL_POOL_MAX_THREADS 256
+
+/**
+ * @brief 풀에서 실행할 작업 함수 타입 (pthread 시작 함수와 같은 형태, 반환값은 무시)
+ */
+typedef void *(*KernelTaskFunc)(void *arg);
+
+/**
+ * @struct KWaitGroup
+ * @brief 제출한 작업 묶음의 완료를 기다리기 위한 카운터
+ *
+ * 0으로 초기화한 뒤 thread_pool_submit에 넘기면 제출과 완료 시 자동으로 증감됩니다.
+ */
+typedef struct KWaitGroup {
+    uint32_t pending;    /**< 완료되지 않은 작업 수 */
+} KWaitGroup;
+
+/**
+ * @brief 정적 초기화용 매크로
+ */
+#define KWAIT_GROUP_INIT { 0 }
+
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief 대기 그룹 카운터를 증가시키는 함수 선언
+ *
+ * @param wg 대기 그룹
+ * @param count 증가시킬 값
+ */
+void wait_group_add(KWaitGroup *wg, uint32_t count);
+
+/**
+ * @brief 대기 그룹 카운터를 1 감소시키고 0이 되면 대기 스레드를 깨우는 함수 선언
+ *
+ * @param wg 대기 그룹
+ */
+void wait_group_done(KWaitGroup *wg);
+
+/**
+ * @brief 대기 그룹 카운터가 0이 될 때까지 대기하는 함수 선언
+ *
+ * @param wg 대기 그룹
+ */
+void wait_group_wait(KWaitGroup *wg);
+
+/**
+ * @brief 스레드 풀 생성 함수 선언
+ *
+ * @param num_workers 작업자 수 (0 이하이면 온라인 CPU 수)
+ * @return 생성된 ThreadPool 포인터 (실패 시 NULL)
+ */
+ThreadPool *thread_pool_create(int num_workers);
+
+/**
+ * @brief 작업자 배치를 지정해 스레드 풀을 생성하는 함수 선언
+ *
+ * i번째로 시작한 작업자는 kplacement_apply(placement, i)로 고정됩니다.
+ *
+ * @param num_workers 작업자 수 (0 이하이면 온라인 CPU 수)
+ * @param placement 작업자 배치 (NULL이면 고정하지 않음, 내용은 복사됨)
+ * @return 생성된 ThreadPool 포인터 (실패 시 NULL)
+ */
+ThreadPool *thread_pool_create_placed(int num_workers, const KPlacement *placement);
+
+/**
+ * @brief 작업 제출 함수 선언
+ *
+ * @param pool 스레드 풀
+ * @param func 실행할 작업 함수
+ * @param arg 작업 함수에 전달할 인자
+ * @param wg 완료를 알릴 대기 그룹 (NULL 가능)
+ * @return 성공 시 0, 풀이 종료 중이면 -1
+ */
+int thread_pool_submit(ThreadPool *pool, KernelTaskFunc func, void *arg, KWaitGroup *wg);
+
+/**
+ * @brief 서로를 기다릴 수 있는 작업 묶음을 동시에 실행되도록 제출하는 함수 선언
+ *
+ * 실행 중인 작업과 앞서 대기 중인 작업 외에 count개의 작업자가 남도록 작업자를 늘리고 같은 잠금 구간에서
+ * 묶음을 넣으므로, 묶음의 모든 작업이 동시에 작업자를 받습니다. 풀 작업 안에서 호출해도 됩니다.
+ *
+ * @param pool 스레드 풀
+ * @param funcs 실행할 작업 함수 목록
+ * @param count 작업 수
+ * @param arg 각 작업 함수에 전달할 인자
+ * @param wg 완료를 알릴 대기 그룹 (NULL 가능)
+ * @return 성공 시 0, 필요한 작업자 수가 KERNEL_POOL_MAX_THREADS를 넘거나 생성 실패/종료 중이면 -1
+ */
+int thread_pool_submit_concurrent(ThreadPool *pool, const KernelTaskFunc *funcs, int count,
+                                  void *arg, KWaitGroup *wg);
+
+/**
+ * @brief 지금까지 제출된 모든 작업이 끝날 때까지 대기하는 함수 선언
+ *
+ * @param pool 스레드 풀
+ */
+void thread_pool_wait(ThreadPool *pool);
+
+/**
+ * @brief 작업자 수를 최소 num_workers개로 늘리는 함수 선언
+ *
+ * 전체 작업자 수만 보장하며 유휴 작업자 수는 보장하지 않으므로, 서로를 기다리는 작업에는
+ * thread_pool_submit_concurrent를 사용해야 합니다. 작업자 수는 줄지 않습니다.
+ *
+ * @param pool 스레드 풀
+ * @param num_workers 필요한 최소 작업자 수
+ * @return 변경 후 작업자 수, num_workers가 KERNEL_POOL_MAX_THREADS를 넘으면 -1
+ */
+int thread_pool_reserve(ThreadPool *pool, int num_workers);
+
+/**
+ * @brief 현재 작업자 수를 반환하는 함수 선언
+ *
+ * @param pool 스레드 풀
+ * @return 작업자 수
+ */
+int thread_pool_size(ThreadPool *pool);
+
+/**
+ * @brief 대기 중인 작업을 모두 실행한 뒤 작업자를 종료하고 풀을 해제하는 함수 선언
+ *
+ * @param pool 스레드 풀
+ */
+void thread_pool_destroy(ThreadPool *pool);
+
+/**
+ * @brief 엔진 공용 스레드 풀 설정 함수 선언
+ *
+ * 공용 풀이 처음 사용되기 전에 호출해야 하며, 0 이하이면 KERNEL_POOL_THREADS 환경 변수나 CPU 수를 사용합니다.
+ *
+ * @param num_workers 공용 풀의 초기 작업자 수
+ */
+void kernel_engine_pool_configure(int num_workers);
+
+/**
+ * @brief 엔진 공용 스레드 풀의 작업자 배치 설정 함수 선언
+ *
+ * 공용 풀이 처음 사용되기 전에 호출해야 합니다. 설정하지 않으면 KERNEL_POOL_PLACEMENT 또는
+ * KERNEL_PLACEMENT 환경 변수를 사용하고, 둘 다 없으면 작업자를 고정하지 않습니다.
+ *
+ * @param placement 작업자 배치 (NULL이면 설정 해제)
+ */
+void kernel_engine_pool_configure_placement(const KPlacement *placement);
+
+/**
+ * @brief 엔진 공용 스레드 풀을 반환하는 함수 선언 (처음 호출 시 생성)
+ *
+ * @return 공용 ThreadPool 포인터
+ */
+ThreadPool *kernel_engine_pool(void);
+
+/**
+ * @brief 엔진 공용 스레드 풀을 종료하는 함수 선언
+ *
+ * 이후 kernel_engine_pool을 호출하면 새 풀이 생성됩니다.
+ */
+void kernel_engine_pool_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_POOL_H
@@ -13,6 +13,7 @@
 #define KERNEL_PRINTF_H
 
 #include "kernel_pr_he.h"
+#include "kernel_print_sink.h"
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
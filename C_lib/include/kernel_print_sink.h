@@ -0,0 +1,258 @@
+/*
+ * Kernel Print Buffer and Sinks
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Output path for kernel_printf and the az_put* helpers.
+ *             Characters are rendered into a per-thread buffer and handed
+ *             to a sink in one piece instead of one write(2) per byte.
+ *
+ *             When the buffer is handed over depends on the flush mode:
+ *               KPRINT_UNBUFFERED  every byte immediately (the old path)
+ *               KPRINT_FLUSH_CALL  once per outermost kernel_printf /
+ *                                  kernel_putchar / az_put* call (default)
+ *               KPRINT_FLUSH_LINE  complete lines at the end of a call
+ *               KPRINT_FLUSH_FULL  only when the buffer fills
+ *             The buffer is also flushed when it fills, on
+ *             kernel_print_flush, when a thread exits, before fork and at
+ *             exit. KERNEL_PRINT_FLUSH=none|call|line|full selects the
+ *             initial mode.
+ *
+ *             A sink is a write callback with a context pointer. The
+ *             default sink writes to standard output. Ready-made sinks cover
+ *             a file descriptor, a fixed memory buffer, a ring buffer that
+ *             keeps the most recent output, and a line callback (the Qt
+ *             console). kernel_snprintf / kernel_dprintf / kernel_sink_printf
+ *             run the same az_* formatter as kernel_printf against them.
+ */
+
+#pragma once
+#ifndef KERNEL_PRINT_SINK_H
+#define KERNEL_PRINT_SINK_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 스레드별 출력 버퍼 크기 (가득 차면 바로 싱크로 넘김) */
+#define KPRINT_BUFFER_SIZE 4096
+
+/**
+ * @brief 출력 버퍼를 싱크로 넘기는 시점
+ */
+typedef enum {
+    KPRINT_UNBUFFERED = 0,  /**< 바이트마다 */
+    KPRINT_FLUSH_CALL,      /**< 가장 바깥 호출이 끝날 때마다 */
+    KPRINT_FLUSH_LINE,      /**< 호출이 끝날 때 완성된 줄만 */
+    KPRINT_FLUSH_FULL       /**< 버퍼가 가득 찰 때만 */
+} KPrintFlush;
+
+/**
+ * @brief 싱크 쓰기 함수 타입
+ *
+ * @param ctx 싱크 문맥
+ * @param data 출력할 데이터
+ * @param len 데이터 길이
+ */
+typedef void (*KPrintSinkWrite)(void *ctx, const char *data, size_t len);
+
+/**
+ * @struct KPrintSink
+ * @brief 출력 대상
+ */
+typedef struct KPrintSink {
+    KPrintSinkWrite write;  /**< 쓰기 함수 */
+    void *ctx;              /**< 쓰기 함수에 넘길 문맥 */
+} KPrintSink;
+
+/**
+ * @brief 출력 싱크를 바꾸는 함수 선언
+ *
+ * 호출 스레드의 버퍼를 기존 싱크로 먼저 내보냅니다. 다른 스레드의 버퍼는 다음 flush 때 새 싱크로 나갑니다.
+ *
+ * @param sink 새 싱크 (프로그램이 끝날 때까지 유효해야 함, NULL이면 표준 출력)
+ */
+void kernel_print_set_sink(const KPrintSink *sink);
+
+/**
+ * @brief 파일 디스크립터에 쓰는 싱크 쓰기 함수 (ctx는 (void *)(intptr_t)fd)
+ *
+ * 짧은 쓰기와 EINTR을 처리합니다.
+ */
+void kernel_print_fd_write(void *ctx, const char *data, size_t len);
+
+/**
+ * @struct KPrintMem
+ * @brief 고정 크기 메모리 버퍼 싱크 문맥 (kernel_print_mem_write)
+ *
+ * 넘치는 내용은 버리지만 len은 계속 세므로 len >= size면 잘린 것입니다. 내용은 항상 NUL로 끝납니다.
+ */
+typedef struct KPrintMem {
+    char *buf;              /**< 출력 버퍼 */
+    size_t size;            /**< 버퍼 크기 (NUL 포함) */
+    size_t len;             /**< 지금까지 출력하려 한 바이트 수 */
+} KPrintMem;
+
+/**
+ * @struct KPrintRing
+ * @brief 최근 출력만 남기는 링 버퍼 싱크 문맥 (kernel_print_ring_write)
+ *
+ * 여러 스레드가 같은 링에 써도 되며, 오래된 내용부터 덮어씁니다.
+ */
+typedef struct KPrintRing {
+    char *buf;              /**< 링 저장소 */
+    size_t size;            /**< 저장소 크기 */
+    uint64_t written;       /**< 지금까지 쓴 바이트 수 */
+    int lock;               /**< 내부 스핀락 */
+} KPrintRing;
+
+/**
+ * @struct KPrintCallback
+ * @brief 줄 단위 콜백 싱크 문맥 (kernel_print_callback_write)
+ *
+ * 줄바꿈을 만날 때마다 줄바꿈을 뺀 한 줄을 NUL로 끝난 문자열로 func에 넘깁니다.
+ * 한 스레드에서만 사용해야 합니다.
+ */
+typedef struct KPrintCallback {
+    void (*func)(const char *str);  /**< 줄을 받을 함수 (예: Qt 콘솔 출력) */
+    size_t len;                     /**< 모아 둔 줄의 길이 */
+    char line[KPRINT_BUFFER_SIZE];  /**< 미완성 줄 (가득 차면 그대로 넘김) */
+} KPrintCallback;
+
+/**
+ * @brief KPrintMem 싱크 쓰기 함수
+ */
+void kernel_print_mem_write(void *ctx, const char *data, size_t len);
+
+/**
+ * @brief 메모리 버퍼 싱크 문맥을 초기화하는 함수 선언
+ *
+ * @param mem 초기화할 문맥
+ * @param buf 출력 버퍼 (NULL이면 길이만 셈)
+ * @param size 버퍼 크기
+ */
+void kernel_print_mem_init(KPrintMem *mem, char *buf, size_t size);
+
+/**
+ * @brief KPrintRing 싱크 쓰기 함수
+ */
+void kernel_print_ring_write(void *ctx, const char *data, size_t len);
+
+/**
+ * @brief 링 버퍼 싱크 문맥을 초기화하는 함수 선언
+ *
+ * @param ring 초기화할 문맥
+ * @param buf 링 저장소
+ * @param size 저장소 크기
+ */
+void kernel_print_ring_init(KPrintRing *ring, char *buf, size_t size);
+
+/**
+ * @brief 링에 남아 있는 최근 출력을 오래된 순서로 복사하는 함수 선언
+ *
+ * @param ring 링 버퍼
+ * @param out 복사할 위치 (NUL로 끝남)
+ * @param size out 크기
+ * @return 복사한 바이트 수 (NUL 제외)
+ */
+size_t kernel_print_ring_read(KPrintRing *ring, char *out, size_t size);
+
+/**
+ * @brief KPrintCallback 싱크 쓰기 함수
+ */
+void kernel_print_callback_write(void *ctx, const char *data, size_t len);
+
+/**
+ * @brief 줄 단위 콜백 싱크 문맥을 초기화하는 함수 선언
+ *
+ * @param cb 초기화할 문맥
+ * @param func 줄을 받을 함수
+ */
+void kernel_print_callback_init(KPrintCallback *cb, void (*func)(const char *str));
+
+/**
+ * @brief 줄바꿈 없이 남은 내용을 콜백으로 넘기는 함수 선언
+ *
+ * @param cb 콜백 싱크 문맥
+ */
+void kernel_print_callback_flush(KPrintCallback *cb);
+
+/**
+ * @brief az 포맷터로 sink에 출력하는 함수 선언
+ *
+ * 호출 스레드의 출력 버퍼와 전역 싱크에는 영향을 주지 않습니다.
+ *
+ * @param sink 출력 대상
+ * @param format 포맷 문자열
+ * @param ... 가변 인자 리스트
+ * @return 출력한 바이트 수
+ */
+int kernel_sink_printf(const KPrintSink *sink, const char *format, ...);
+
+/**
+ * @brief va_list를 받는 kernel_sink_printf 함수 선언
+ */
+int kernel_sink_vprintf(const KPrintSink *sink, const char *format, va_list ap);
+
+/**
+ * @brief az 포맷터로 버퍼에 출력하는 함수 선언 (시스템 호출 없음)
+ *
+ * @param buf 출력 버퍼 (size가 0이면 NULL 허용)
+ * @param size 버퍼 크기 (NUL 포함)
+ * @param format 포맷 문자열
+ * @param ... 가변 인자 리스트
+ * @return 잘리지 않았다면 출력했을 길이 (NUL 제외, snprintf와 같은 의미)
+ */
+int kernel_snprintf(char *buf, size_t size, const char *format, ...);
+
+/**
+ * @brief va_list를 받는 kernel_snprintf 함수 선언
+ */
+int kernel_vsnprintf(char *buf, size_t size, const char *format, va_list ap);
+
+/**
+ * @brief az 포맷터로 파일 디스크립터에 출력하는 함수 선언
+ *
+ * 한 번의 호출은 KPRINT_BUFFER_SIZE 이하라면 write 한 번으로 나갑니다.
+ *
+ * @param fd 파일 디스크립터
+ * @param format 포맷 문자열
+ * @param ... 가변 인자 리스트
+ * @return 출력한 바이트 수
+ */
+int kernel_dprintf(int fd, const char *format, ...);
+
+/**
+ * @brief va_list를 받는 kernel_dprintf 함수 선언
+ */
+int kernel_vdprintf(int fd, const char *format, va_list ap);
+
+/**
+ * @brief 플러시 모드를 바꾸는 함수 선언
+ *
+ * 호출 스레드의 버퍼를 먼저 내보냅니다.
+ *
+ * @param mode 새 모드
+ */
+void kernel_print_set_flush_mode(KPrintFlush mode);
+
+/**
+ * @brief 현재 플러시 모드를 반환하는 함수 선언
+ */
+KPrintFlush kernel_print_get_flush_mode(void);
+
+/**
+ * @brief 호출 스레드의 버퍼를 싱크로 내보내는 함수 선언
+ */
+void kernel_print_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_PRINT_SINK_H
@@ -0,0 +1,128 @@
+/*
+ * Kernel Process Pool
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Pre-forked worker processes for jobs that need process
+ *             isolation. Workers are forked once and stay alive; jobs and
+ *             results travel through a ring of fixed-size slots in a shared
+ *             memory region (memfd on Linux), with futex wait/wake on the
+ *             slot state words. A single-threaded zygote process, forked
+ *             once at creation, forks every worker, reaps crashed ones,
+ *             fails the job they were running and forks a replacement, so
+ *             the (possibly multithreaded) owner never forks again.
+ *
+ *             Jobs are plain function pointers. Workers are forked from the
+ *             zygote, which is a copy of the owner at pool creation, so any
+ *             function linked into the program (or loaded before the pool
+ *             was created) can be used.
+ */
+
+#pragma once
+#ifndef KERNEL_PROCPOOL_H
+#define KERNEL_PROCPOOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 공유 메모리 링의 작업 슬롯 수 (동시에 제출되어 대기할 수 있는 작업 수) */
+#define KPROC_POOL_SLOTS 64
+
+/* 작업 하나가 전달할 수 있는 최대 입력/출력 크기 (바이트) */
+#define KPROC_JOB_INPUT_MAX 4096
+#define KPROC_JOB_OUTPUT_MAX 4096
+
+/* 풀 하나가 가질 수 있는 최대 작업자 프로세스 수 */
+#define KPROC_POOL_MAX_WORKERS 64
+
+/* kproc_pool_wait 반환값 */
+#define KPROC_JOB_DONE 0        /**< 작업 함수가 정상 반환함 */
+#define KPROC_JOB_CRASHED -1    /**< 작업 도중 작업자 프로세스가 종료됨 */
+
+/**
+ * @brief 작업자 프로세스에서 실행되는 작업 함수 타입
+ *
+ * @param input 입력 데이터 (공유 메모리, 읽기 전용)
+ * @param input_len 입력 크기
+ * @param output 결과를 기록할 버퍼 (공유 메모리)
+ * @param output_cap 출력 버퍼 크기 (KPROC_JOB_OUTPUT_MAX)
+ * @param output_len 기록한 결과 크기를 저장할 위치
+ * @return 작업 결과 코드 (kproc_pool_wait의 job_result로 전달됨)
+ */
+typedef int (*KProcJobFunc)(const void *input, size_t input_len, void *output, size_t output_cap, size_t *output_len);
+
+typedef struct KProcPool KProcPool;
+
+/**
+ * @brief 프로세스 풀 생성 함수 선언
+ *
+ * @param num_workers 작업자 프로세스 수 (0 이하이면 온라인 CPU 수)
+ * @return 생성된 풀 (실패 시 NULL)
+ */
+KProcPool *kproc_pool_create(int num_workers);
+
+/**
+ * @brief 작업 제출 함수 선언
+ *
+ * 빈 슬롯이 없으면 슬롯이 반납될 때까지 대기합니다. 반환된 작업 번호는 kproc_pool_wait로 한 번 회수해야 합니다.
+ *
+ * @param pool 프로세스 풀
+ * @param func 작업자에서 실행할 함수
+ * @param input 입력 데이터 (슬롯으로 복사됨, NULL 가능)
+ * @param input_len 입력 크기 (KPROC_JOB_INPUT_MAX 이하)
+ * @return 작업 번호, 실패 시 -1 (errno: EINVAL 입력 초과, ESHUTDOWN 종료 중)
+ */
+int kproc_pool_submit(KProcPool *pool, KProcJobFunc func, const void *input, size_t input_len);
+
+/**
+ * @brief 작업 완료를 기다리고 결과를 가져오는 함수 선언
+ *
+ * @param pool 프로세스 풀
+ * @param job kproc_pool_submit이 반환한 작업 번호
+ * @param output 결과를 복사할 버퍼 (NULL 가능)
+ * @param output_cap 결과 버퍼 크기
+ * @param output_len 결과 크기를 저장할 위치 (NULL 가능)
+ * @param job_result 작업 함수 반환값, 충돌 시 종료 시그널 번호 또는 종료 코드 (NULL 가능)
+ * @return KPROC_JOB_DONE 또는 KPROC_JOB_CRASHED
+ */
+int kproc_pool_wait(KProcPool *pool, int job, void *output, size_t output_cap, size_t *output_len, int *job_result);
+
+/**
+ * @brief 작업을 제출하고 완료까지 기다리는 함수 선언
+ *
+ * @return KPROC_JOB_DONE, KPROC_JOB_CRASHED 또는 제출 실패 시 -2
+ */
+int kproc_pool_run(KProcPool *pool, KProcJobFunc func, const void *input, size_t input_len,
+                   void *output, size_t output_cap, size_t *output_len, int *job_result);
+
+/**
+ * @brief 작업자 프로세스 수를 반환하는 함수 선언
+ */
+int kproc_pool_size(KProcPool *pool);
+
+/**
+ * @brief 충돌 후 다시 생성된 작업자 수를 반환하는 함수 선언
+ */
+unsigned kproc_pool_respawns(KProcPool *pool);
+
+/**
+ * @brief 프로세스 풀 종료 함수 선언
+ *
+ * 실행 중인 작업이 끝나면 작업자가 종료되며, 유예 시간 안에 끝나지 않는 작업자는 SIGTERM, 그다음 SIGKILL로
+ * 종료시킨 뒤 공유 메모리를 해제합니다. 제출한 작업은 종료 전에 모두 kproc_pool_wait로 회수해야 하며,
+ * 끝나지 않는 작업을 기다리는 중이라면 먼저 그 대기를 포기해야 합니다.
+ *
+ * @param pool 프로세스 풀
+ */
+void kproc_pool_destroy(KProcPool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_PROCPOOL_H
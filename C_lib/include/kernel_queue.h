@@ -0,0 +1,118 @@
+/*
+ * Kernel Concurrent Queues
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Thread-safe FIFO queues for the engine, shaped like the
+ *             LinkedList push/pop/is_empty API.
+ *
+ *             bounded_queue   : Vyukov MPMC ring. Every cell carries a
+ *                               sequence number, so producers and consumers
+ *                               claim cells with one CAS on their own index
+ *                               and never allocate.
+ *             unbounded_queue : linked segments of fixed-size cell arrays.
+ *                               Indices are claimed with fetch-and-add and
+ *                               drained segments are freed through
+ *                               epoch-based reclamation (kernel_epoch.h).
+ *
+ *             NULL cannot be stored: pop returns NULL for an empty queue.
+ */
+
+#pragma once
+#ifndef KERNEL_QUEUE_H
+#define KERNEL_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* unbounded_queue 세그먼트 하나의 칸 수 */
+#define KQUEUE_SEGMENT_SIZE 1024
+
+typedef struct BoundedQueue BoundedQueue;
+typedef struct UnboundedQueue UnboundedQueue;
+
+/**
+ * @brief 고정 크기 MPMC 큐 생성 함수 선언
+ *
+ * @param capacity 최대 원소 수 (2의 거듭제곱으로 올림, 최소 2)
+ * @return 생성된 큐 포인터
+ */
+BoundedQueue *create_bounded_queue(size_t capacity);
+
+/**
+ * @brief 고정 크기 큐에 원소 추가 함수 선언
+ *
+ * @param queue 큐 포인터
+ * @param data 추가할 데이터 (NULL 불가)
+ * @return 성공 시 true, 큐가 가득 차면 false
+ */
+bool bounded_queue_push(BoundedQueue *queue, void *data);
+
+/**
+ * @brief 고정 크기 큐에서 원소 제거 함수 선언
+ *
+ * @param queue 큐 포인터
+ * @return 제거된 데이터, 비어 있으면 NULL
+ */
+void *bounded_queue_pop(BoundedQueue *queue);
+
+/**
+ * @brief 고정 크기 큐가 비었는지 확인하는 함수 선언 (동시 접근 중에는 근사값)
+ */
+bool bounded_queue_is_empty(BoundedQueue *queue);
+
+/**
+ * @brief 고정 크기 큐의 용량을 반환하는 함수 선언
+ */
+size_t bounded_queue_capacity(BoundedQueue *queue);
+
+/**
+ * @brief 고정 크기 큐 삭제 함수 선언 (남은 원소는 해제하지 않음)
+ */
+void destroy_bounded_queue(BoundedQueue *queue);
+
+/**
+ * @brief 무제한 MPMC 큐 생성 함수 선언
+ *
+ * @return 생성된 큐 포인터
+ */
+UnboundedQueue *create_unbounded_queue(void);
+
+/**
+ * @brief 무제한 큐에 원소 추가 함수 선언
+ *
+ * @param queue 큐 포인터
+ * @param data 추가할 데이터 (NULL 불가)
+ */
+void unbounded_queue_push(UnboundedQueue *queue, void *data);
+
+/**
+ * @brief 무제한 큐에서 원소 제거 함수 선언
+ *
+ * @param queue 큐 포인터
+ * @return 제거된 데이터, 비어 있으면 NULL
+ */
+void *unbounded_queue_pop(UnboundedQueue *queue);
+
+/**
+ * @brief 무제한 큐가 비었는지 확인하는 함수 선언 (동시 접근 중에는 근사값)
+ */
+bool unbounded_queue_is_empty(UnboundedQueue *queue);
+
+/**
+ * @brief 무제한 큐 삭제 함수 선언
+ *
+ * 다른 스레드가 더 이상 큐를 사용하지 않을 때 호출해야 하며, 남은 원소는 해제하지 않습니다.
+ */
+void destroy_unbounded_queue(UnboundedQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_QUEUE_H
@@ -0,0 +1,122 @@
+/*
+ * Kernel Sharded Reader-Writer Lock
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Reader-writer lock for read-mostly tables. Readers only touch
+ *             their own cache-line sized reader counter, so concurrent
+ *             readers do not bounce a shared line between CPUs. Each thread
+ *             is given a counter slot round-robin on its first read lock and
+ *             keeps it, so unlock needs no token and std::shared_lock works.
+ *
+ *             Writers are preferred: once a writer announces itself, new
+ *             readers back off until it is done, and the writer waits only
+ *             for readers already inside. Writers are serialised by a KMutex.
+ *             Read locks are not recursive when a writer may be waiting.
+ */
+
+#pragma once
+#ifndef KERNEL_RWLOCK_H
+#define KERNEL_RWLOCK_H
+
+#include <stdint.h>
+#include "kernel_mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 읽기 카운터 샤드 수 */
+#define KRWLOCK_SHARDS 16
+
+/**
+ * @struct KRWLockShard
+ * @brief 캐시 라인 하나를 차지하는 읽기 카운터
+ */
+typedef struct KRWLockShard {
+    __attribute__((aligned(64))) uint32_t readers;  /**< 이 샤드를 쓰는 읽기 스레드 중 잠금 안에 있는 수 */
+} KRWLockShard;
+
+/**
+ * @struct KRWLock
+ * @brief 샤드 읽기 카운터와 쓰기 우선 정책을 가진 읽기/쓰기 잠금
+ */
+typedef struct KRWLock {
+    KRWLockShard shards[KRWLOCK_SHARDS];        /**< 스레드별 읽기 카운터 */
+    __attribute__((aligned(64))) uint32_t writer; /**< 쓰기 스레드가 대기 중이거나 잠금을 쥐고 있으면 1 */
+    KMutex writer_mutex;                        /**< 쓰기 스레드 간 직렬화 */
+} KRWLock;
+
+/**
+ * @brief 읽기/쓰기 잠금 초기화 함수 선언
+ *
+ * @param lock 초기화할 잠금
+ * @param name 쓰기 뮤텍스의 잠금 클래스 이름 (kmutex_format_report에 표시)
+ */
+void krwlock_init(KRWLock *lock, const char *name);
+
+/**
+ * @brief 읽기/쓰기 잠금 정리 함수 선언
+ *
+ * @param lock 정리할 잠금 (잠겨 있지 않아야 함)
+ */
+void krwlock_destroy(KRWLock *lock);
+
+/**
+ * @brief 읽기 잠금 획득 함수 선언
+ *
+ * @param lock 잠금
+ */
+void krwlock_rdlock(KRWLock *lock);
+
+/**
+ * @brief 읽기 잠금 해제 함수 선언 (같은 스레드에서 호출)
+ *
+ * @param lock 잠금
+ */
+void krwlock_rdunlock(KRWLock *lock);
+
+/**
+ * @brief 쓰기 잠금 획득 함수 선언
+ *
+ * @param lock 잠금
+ */
+void krwlock_wrlock(KRWLock *lock);
+
+/**
+ * @brief 쓰기 잠금 해제 함수 선언
+ *
+ * @param lock 잠금
+ */
+void krwlock_wrunlock(KRWLock *lock);
+
+#ifdef __cplusplus
+}
+
+namespace kernel {
+
+/**
+ * @brief KRWLock의 C++ 래퍼 (std::unique_lock / std::shared_lock과 함께 사용 가능)
+ */
+class shared_rwlock {
+public:
+    explicit shared_rwlock(const char *name = "kernel::shared_rwlock") { krwlock_init(&lock_, name); }
+    ~shared_rwlock() { krwlock_destroy(&lock_); }
+    shared_rwlock(const shared_rwlock &) = delete;
+    shared_rwlock &operator=(const shared_rwlock &) = delete;
+
+    void lock() { krwlock_wrlock(&lock_); }
+    void unlock() { krwlock_wrunlock(&lock_); }
+    void lock_shared() { krwlock_rdlock(&lock_); }
+    void unlock_shared() { krwlock_rdunlock(&lock_); }
+
+private:
+    KRWLock lock_;
+};
+
+} // namespace kernel
+
+#endif // __cplusplus
+
+#endif // KERNEL_RWLOCK_H
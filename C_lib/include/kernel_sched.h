@@ -0,0 +1,228 @@
+/*
+ * Kernel Work-Stealing Scheduler
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Fork-join scheduler for recursive parallel work. Every
+ *             worker owns a Chase-Lev deque: it pushes and pops spawned
+ *             tasks at the bottom while idle workers steal from the top,
+ *             so load balances itself without a central queue. Threads that
+ *             wait on a task group execute pending tasks instead of
+ *             blocking, which makes nested spawn/wait safe.
+ *
+ *             C API : task_group_*, parallel_for, parallel_reduce
+ *             C++   : kernel::task_group, kernel::parallel_for,
+ *                     kernel::parallel_reduce (thin templates over the C API)
+ */
+
+#pragma once
+#ifndef KERNEL_SCHED_H
+#define KERNEL_SCHED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 워커 스레드가 아닌 스레드가 동시에 참여할 수 있는 최대 수 (초과 시 해당 스레드는 직렬 실행) */
+#define KSCHED_MAX_EXTERNAL 16
+
+/* 워커별 덱 용량 (가득 차면 spawn한 작업을 즉시 실행) */
+#define KSCHED_DEQUE_SIZE 4096
+
+/**
+ * @struct KTaskGroup
+ * @brief spawn한 작업들의 완료를 기다리기 위한 그룹
+ */
+typedef struct KTaskGroup {
+    uint32_t pending;    /**< 완료되지 않은 작업 수 */
+} KTaskGroup;
+
+#define KTASK_GROUP_INIT { 0 }
+
+/**
+ * @brief 스케줄러 작업 함수 타입
+ */
+typedef void (*KSchedFunc)(void *arg);
+
+/**
+ * @brief parallel_for 본문 함수 타입 ([begin, end) 구간 처리)
+ */
+typedef void (*KRangeFunc)(size_t begin, size_t end, void *ctx);
+
+/**
+ * @brief parallel_reduce 구간 누적 함수 타입 (acc에 [begin, end) 결과를 누적)
+ */
+typedef void (*KReduceMapFunc)(size_t begin, size_t end, void *ctx, void *acc);
+
+/**
+ * @brief parallel_reduce 결합 함수 타입 (acc = acc ⊕ other)
+ */
+typedef void (*KReduceCombineFunc)(void *acc, const void *other, void *ctx);
+
+/**
+ * @brief 스케줄러 초기화 함수 선언
+ *
+ * 호출하지 않으면 처음 사용할 때 KERNEL_SCHED_THREADS 환경 변수나 CPU 수로 초기화됩니다.
+ *
+ * @param num_workers 워커 스레드 수 (0 이하이면 기본값)
+ * @return 성공 시 0, 이미 초기화되어 있으면 -1
+ */
+int ksched_init(int num_workers);
+
+/**
+ * @brief 스케줄러 종료 함수 선언
+ *
+ * 모든 작업 그룹의 대기가 끝난 뒤 호출해야 합니다.
+ */
+void ksched_shutdown(void);
+
+/**
+ * @brief 워커 스레드 수를 반환하는 함수 선언 (필요하면 초기화)
+ *
+ * @return 워커 스레드 수
+ */
+int ksched_num_workers(void);
+
+/**
+ * @brief 작업 그룹 초기화 함수 선언
+ *
+ * @param tg 초기화할 작업 그룹
+ */
+void task_group_init(KTaskGroup *tg);
+
+/**
+ * @brief 작업 그룹에 작업을 추가하는 함수 선언
+ *
+ * 현재 스레드의 덱에 넣으며, 유휴 워커가 있으면 깨워서 훔쳐 가도록 합니다.
+ *
+ * @param tg 작업 그룹
+ * @param func 실행할 함수
+ * @param arg 함수 인자
+ */
+void task_group_spawn(KTaskGroup *tg, KSchedFunc func, void *arg);
+
+/**
+ * @brief 작업 그룹의 모든 작업이 끝날 때까지 다른 작업을 실행하며 대기하는 함수 선언
+ *
+ * @param tg 작업 그룹
+ */
+void task_group_wait(KTaskGroup *tg);
+
+/**
+ * @brief [begin, end) 구간을 grain 이하 크기로 재귀 분할하여 병렬 처리하는 함수 선언
+ *
+ * @param begin 시작 인덱스
+ * @param end 끝 인덱스 (미포함)
+ * @param grain 더 이상 나누지 않을 최대 구간 크기 (0이면 자동)
+ * @param body 구간 처리 함수
+ * @param ctx 본문 함수에 전달할 사용자 데이터
+ */
+void parallel_for(size_t begin, size_t end, size_t grain, KRangeFunc body, void *ctx);
+
+/**
+ * @brief [begin, end) 구간을 병렬로 누적한 뒤 결합하는 함수 선언
+ *
+ * 구간은 순서대로 결합되므로 combine은 결합 법칙만 만족하면 됩니다 (교환 법칙 불필요).
+ *
+ * @param begin 시작 인덱스
+ * @param end 끝 인덱스 (미포함)
+ * @param grain 최소 구간 크기 (0이면 자동)
+ * @param result_size 누적값 크기 (바이트)
+ * @param identity 항등원 (각 구간의 누적값 초기값으로 복사됨)
+ * @param map 구간 누적 함수
+ * @param combine 결합 함수
+ * @param ctx 사용자 데이터
+ * @param result 최종 결과를 저장할 버퍼 (result_size 바이트)
+ */
+void parallel_reduce(size_t begin, size_t end, size_t grain, size_t result_size,
+                     const void *identity, KReduceMapFunc map, KReduceCombineFunc combine,
+                     void *ctx, void *result);
+
+#ifdef __cplusplus
+}
+
+#include <type_traits>
+#include <utility>
+
+namespace kernel {
+
+/**
+ * @brief C++ 작업 그룹 (소멸 시 남은 작업을 기다림)
+ */
+class task_group {
+public:
+    task_group() { task_group_init(&tg_); }
+    ~task_group() { wait(); }
+    task_group(const task_group &) = delete;
+    task_group &operator=(const task_group &) = delete;
+
+    template <typename F>
+    void run(F &&f) {
+        using Fn = typename std::decay<F>::type;
+        task_group_spawn(&tg_, &trampoline<Fn>, new Fn(std::forward<F>(f)));
+    }
+
+    void wait() { task_group_wait(&tg_); }
+
+private:
+    template <typename Fn>
+    static void trampoline(void *arg) {
+        Fn *fn = static_cast<Fn *>(arg);
+        (*fn)();
+        delete fn;
+    }
+
+    KTaskGroup tg_;
+};
+
+/**
+ * @brief 인덱스마다 f(i)를 호출하는 parallel_for
+ */
+template <typename F>
+void parallel_for(size_t begin, size_t end, size_t grain, F &&f) {
+    ::parallel_for(begin, end, grain,
+                   [](size_t b, size_t e, void *ctx) {
+                       auto &fn = *static_cast<typename std::remove_reference<F>::type *>(ctx);
+                       for (size_t i = b; i < e; i++) {
+                           fn(i);
+                       }
+                   },
+                   const_cast<void *>(static_cast<const void *>(&f)));
+}
+
+/**
+ * @brief map(begin, end, acc)가 구간 결과를 반환하고 combine(a, b)가 결합하는 parallel_reduce
+ *
+ * T는 구간별 누적값을 memcpy로 초기화하므로 trivially copyable이어야 합니다.
+ */
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(size_t begin, size_t end, size_t grain, const T &identity, Map map, Combine combine) {
+    static_assert(std::is_trivially_copyable<T>::value, "kernel::parallel_reduce requires a trivially copyable T");
+    struct Ctx {
+        Map *map;
+        Combine *combine;
+    } ctx = { &map, &combine };
+    T result = identity;
+
+    ::parallel_reduce(begin, end, grain, sizeof(T), &identity,
+                      [](size_t b, size_t e, void *c, void *acc) {
+                          Ctx *x = static_cast<Ctx *>(c);
+                          *static_cast<T *>(acc) = (*x->map)(b, e, *static_cast<T *>(acc));
+                      },
+                      [](void *acc, const void *other, void *c) {
+                          Ctx *x = static_cast<Ctx *>(c);
+                          *static_cast<T *>(acc) = (*x->combine)(*static_cast<T *>(acc), *static_cast<const T *>(other));
+                      },
+                      &ctx, &result);
+    return result;
+}
+
+} // namespace kernel
+
+#endif // __cplusplus
+
+#endif // KERNEL_SCHED_H
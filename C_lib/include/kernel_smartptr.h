@@ -21,6 +21,7 @@
 #include <dlfcn.h>
 
 #include "kernel_engine.h"
+#include "kernel_trace.h"
 #include "../src/ename.c.inc"
 
 #define NUM_THREADS 3
@@ -29,6 +30,18 @@
 typedef struct SmartPtr SmartPtr;
 #define CREATE_SMART_PTR(type, ...) create_smart_ptr(sizeof(type), __VA_ARGS__)
 
+/**
+ * @brief 이미 할당된 type 객체의 소유권을 넘겨받는 매크로 (포인터 타입 검사 포함)
+ */
+#define SMART_PTR_ADOPT(type, ptr, deleter) \
+    smart_ptr_adopt((void *)(1 ? (ptr) : (type *)0), (deleter))
+
+/**
+ * @brief type 크기의 객체를 할당하고 init 콜백으로 제자리 초기화하는 매크로
+ */
+#define SMART_PTR_MAKE(type, init, arg, deleter) \
+    smart_ptr_make(sizeof(type), (init), (arg), (deleter))
+
 static void retain(SmartPtr *sp);
 static void release(SmartPtr *sp);
 static void* thread_function(void* arg);
@@ -45,6 +58,7 @@ typedef struct SmartPtr {
     void *ptr;                ///< 실제 메모리를 가리킴
     int *ref_count;           ///< 참조 카운트
     pthread_mutex_t *mutex;   ///< 뮤텍스 보호
+    void (*deleter)(void *);  ///< 참조 카운트가 0이 될 때 호출할 소멸자 (NULL이면 free)
 } SmartPtr;
 
 /**
@@ -95,6 +109,7 @@ SmartPtr create_smart_ptr(size_t size, ...) {
     (void)size;
     SmartPtr sp;
     sp.ptr = malloc(size);
+    sp.deleter = NULL;
     sp.ref_count = (int *)malloc(sizeof(int));
     *(sp.ref_count) = 1;
     sp.mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
@@ -115,6 +130,50 @@ SmartPtr create_smart_ptr(size_t size, ...) {
     return sp;
 }
 
+/**
+ * @brief 이미 할당된 메모리의 소유권을 넘겨받는 스마트 포인터 생성 함수
+ *
+ * create_smart_ptr와 달리 새 버퍼를 할당하거나 내용을 복사하지 않습니다.
+ *
+ * @param ptr 소유권을 넘겨받을 포인터 (이후 호출자가 직접 해제하면 안 됨)
+ * @param deleter 참조 카운트가 0이 될 때 호출할 소멸자 (NULL이면 free)
+ * @return SmartPtr 스마트 포인터 구조체
+ */
+static inline SmartPtr smart_ptr_adopt(void *ptr, void (*deleter)(void *)) {
+    SmartPtr sp;
+    sp.ptr = ptr;
+    sp.deleter = deleter;
+    sp.ref_count = (int *)malloc(sizeof(int));
+    sp.mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+    if (sp.ref_count == NULL || sp.mutex == NULL) {
+        kernel_errExit("스마트 포인터 메모리 할당 실패");
+    }
+    *(sp.ref_count) = 1;
+    pthread_mutex_init(sp.mutex, NULL);
+    return sp;
+}
+
+/**
+ * @brief 메모리를 할당하고 콜백으로 제자리 초기화하는 스마트 포인터 생성 함수
+ *
+ * @param size 할당할 메모리 크기
+ * @param init 할당된 객체를 초기화할 콜백 (NULL이면 0으로 초기화)
+ * @param arg init 콜백에 전달할 인자
+ * @param deleter 참조 카운트가 0이 될 때 호출할 소멸자 (NULL이면 free)
+ * @return SmartPtr 스마트 포인터 구조체
+ */
+static inline SmartPtr smart_ptr_make(size_t size, void (*init)(void *obj, void *arg), void *arg,
+                                      void (*deleter)(void *)) {
+    void *obj = init ? malloc(size) : calloc(1, size);
+    if (obj == NULL) {
+        kernel_errExit("스마트 포인터 메모리 할당 실패");
+    }
+    if (init) {
+        init(obj, arg);
+    }
+    return smart_ptr_adopt(obj, deleter);
+}
+
 /**
  * @brief 스마트 포인터의 참조 카운트를 증가시키는 함수
  *
@@ -136,17 +195,21 @@ static void release(SmartPtr *sp) {
 
     pthread_mutex_lock(sp->mutex);
     (*(sp->ref_count))--;
-    safe_kernel_printf("Smart pointer released (ref_count: %d)\n", *(sp->ref_count));
+    KTRACE(KTRACE_CAT_SMARTPTR, KTRACE_LVL_DEBUG, "Smart pointer released (ref_count: %d)", *(sp->ref_count));
 
     if (*(sp->ref_count) == 0) {
         should_free = 1;
-        safe_kernel_printf("Reference count is 0, freeing memory...\n");
+        KTRACE(KTRACE_CAT_SMARTPTR, KTRACE_LVL_DEBUG, "Reference count is 0, freeing memory (%p)", sp->ptr);
     }
 
     pthread_mutex_unlock(sp->mutex);
 
     if (should_free) {
-        free(sp->ptr);
+        if (sp->deleter) {
+            sp->deleter(sp->ptr);
+        } else {
+            free(sp->ptr);
+        }
         sp->ptr = NULL;
         free(sp->ref_count);
         sp->ref_count = NULL;
@@ -155,7 +218,7 @@ static void release(SmartPtr *sp) {
         free(sp->mutex);
         sp->mutex = NULL;
 
-        safe_kernel_printf("Memory has been freed\n");
+        KTRACE(KTRACE_CAT_SMARTPTR, KTRACE_LVL_DEBUG, "Memory has been freed");
     }
 }
 
@@ -0,0 +1,185 @@
+/*
+ * Kernel Phase Synchronization
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Futex-based primitives for phase-structured work, so worker
+ *             threads can stay alive across phases instead of being joined
+ *             and re-created for each step.
+ *
+ *               KBarrier    reusable: all participants meet, then the next
+ *                           phase starts on the same object
+ *               KLatch      one-shot: waiters block until the count reaches
+ *                           zero, after which waits return immediately
+ *               KCountdown  reusable counter: work can be added while it is
+ *                           outstanding, waits can time out, and reset
+ *                           rearms it for the next round
+ *
+ *             Waiters spin for a bounded number of iterations before parking
+ *             on a futex, because the last arrival is usually microseconds
+ *             away. Single-CPU machines never spin. The releasing thread
+ *             only issues a wake system call when someone actually parked.
+ */
+
+#pragma once
+#ifndef KERNEL_SYNC_H
+#define KERNEL_SYNC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 잠들기 전에 스핀하는 최대 횟수 */
+#define KSYNC_SPIN_LIMIT 4000
+
+/* kbarrier_wait가 마지막 도착 스레드에 반환하는 값 (pthread_barrier와 같은 의미) */
+#define KBARRIER_SERIAL_THREAD 1
+
+/**
+ * @struct KBarrier
+ * @brief 재사용 가능한 배리어 (필드는 내부용)
+ *
+ * 도착 카운터와 세대 워드를 다른 캐시 라인에 두어 도착 원자 연산이 스핀하는 대기자를 방해하지 않게 합니다.
+ */
+typedef struct KBarrier {
+    uint32_t count;                                 /**< 참여 스레드 수 */
+    uint32_t arrived;                               /**< 이번 세대에 도착한 스레드 수 */
+    __attribute__((aligned(64))) uint32_t generation; /**< 세대 번호 (대기 futex 워드) */
+    uint32_t sleepers;                              /**< futex에서 잠든 스레드 수 */
+} KBarrier;
+
+/**
+ * @struct KLatch
+ * @brief 한 번만 쓰는 래치 (필드는 내부용)
+ */
+typedef struct KLatch {
+    uint32_t count;         /**< 남은 수 (대기 futex 워드) */
+    uint32_t sleepers;      /**< futex에서 잠든 스레드 수 */
+} KLatch;
+
+/**
+ * @struct KCountdown
+ * @brief 재사용 가능한 카운트다운 이벤트 (필드는 내부용)
+ */
+typedef struct KCountdown {
+    uint32_t count;         /**< 남은 수 (대기 futex 워드) */
+    uint32_t sleepers;      /**< futex에서 잠든 스레드 수 */
+} KCountdown;
+
+/**
+ * @brief 배리어를 초기화하는 함수 선언
+ *
+ * @param barrier 초기화할 배리어
+ * @param count 참여 스레드 수 (1 이상)
+ * @return 성공 시 0, count가 0이면 -1 (errno = EINVAL)
+ */
+int kbarrier_init(KBarrier *barrier, uint32_t count);
+
+/**
+ * @brief 모든 참여 스레드가 도착할 때까지 대기하는 함수 선언
+ *
+ * 반환 즉시 같은 배리어를 다음 단계에 다시 쓸 수 있습니다.
+ *
+ * @param barrier 배리어
+ * @return 마지막에 도착한 스레드 하나에는 KBARRIER_SERIAL_THREAD, 나머지는 0
+ */
+int kbarrier_wait(KBarrier *barrier);
+
+/**
+ * @brief 래치를 초기화하는 함수 선언
+ *
+ * @param latch 초기화할 래치
+ * @param count 초기 수 (0이면 처음부터 열린 상태)
+ */
+void klatch_init(KLatch *latch, uint32_t count);
+
+/**
+ * @brief 래치의 수를 n만큼 줄이고 0이 되면 대기자를 모두 깨우는 함수 선언
+ *
+ * @param latch 래치
+ * @param n 줄일 수 (남은 수보다 크면 0으로 맞춤)
+ */
+void klatch_count_down(KLatch *latch, uint32_t n);
+
+/**
+ * @brief 래치가 열렸는지 확인하는 함수 선언
+ *
+ * @param latch 래치
+ * @return 수가 0이면 1, 아니면 0
+ */
+int klatch_try_wait(const KLatch *latch);
+
+/**
+ * @brief 래치가 열릴 때까지 대기하는 함수 선언
+ *
+ * @param latch 래치
+ */
+void klatch_wait(KLatch *latch);
+
+/**
+ * @brief 래치의 수를 1 줄이고 열릴 때까지 대기하는 함수 선언 (시작 게이트용)
+ *
+ * @param latch 래치
+ */
+void klatch_arrive_and_wait(KLatch *latch);
+
+/**
+ * @brief 카운트다운 이벤트를 초기화하는 함수 선언
+ *
+ * @param countdown 초기화할 카운트다운
+ * @param count 초기 수
+ */
+void kcountdown_init(KCountdown *countdown, uint32_t count);
+
+/**
+ * @brief 남은 수를 n만큼 늘리는 함수 선언
+ *
+ * 이미 0에 도달한 라운드에 더하면 새 라운드가 시작됩니다. 대기자가 깨어난 뒤에 호출해야 합니다.
+ *
+ * @param countdown 카운트다운
+ * @param n 늘릴 수
+ */
+void kcountdown_add(KCountdown *countdown, uint32_t n);
+
+/**
+ * @brief 남은 수를 n만큼 줄이는 함수 선언
+ *
+ * @param countdown 카운트다운
+ * @param n 줄일 수 (남은 수보다 크면 0으로 맞춤)
+ * @return 이 호출로 0이 되었으면 1, 아니면 0
+ */
+int kcountdown_signal(KCountdown *countdown, uint32_t n);
+
+/**
+ * @brief 남은 수가 0이 될 때까지 대기하는 함수 선언
+ *
+ * @param countdown 카운트다운
+ * @param timeout_us 최대 대기 시간 (마이크로초, 음수면 무한)
+ * @return 0에 도달하면 0, 시간 초과면 -1 (errno = ETIMEDOUT)
+ */
+int kcountdown_wait(KCountdown *countdown, int64_t timeout_us);
+
+/**
+ * @brief 카운트다운을 새 라운드로 다시 설정하는 함수 선언 (대기자가 없을 때 호출)
+ *
+ * @param countdown 카운트다운
+ * @param count 새 초기 수
+ */
+void kcountdown_reset(KCountdown *countdown, uint32_t count);
+
+/**
+ * @brief 남은 수를 반환하는 함수 선언
+ *
+ * @param countdown 카운트다운
+ * @return 남은 수
+ */
+uint32_t kcountdown_remaining(const KCountdown *countdown);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_SYNC_H
@@ -0,0 +1,130 @@
+/*
+ * Kernel Timer Service
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Engine-wide timeouts on a hierarchical timing wheel. Timers
+ *             are caller-owned KTimer structures linked into wheel slots, so
+ *             scheduling and cancelling are O(1) and allocation free, and
+ *             millions of pending timeouts cost only their own memory.
+ *
+ *             The wheel has one 256-slot level of single ticks and four
+ *             64-slot levels above it (2^32 ticks in total, longer delays
+ *             are clamped). A timer is placed by how far away it is and
+ *             cascades down one level each time the level below wraps.
+ *
+ *             One service thread sleeps on a timerfd armed for the next
+ *             occupied tick (or the next cascade), so an idle wheel costs no
+ *             wakeups. Expired callbacks run on the engine thread pool, never
+ *             on the service thread. Without timerfd the thread sleeps on a
+ *             futex with a timeout instead.
+ *
+ *             The tick is 1 ms unless KERNEL_TIMER_TICK_MS or
+ *             ktimer_service_start says otherwise.
+ */
+
+#pragma once
+#ifndef KERNEL_TIMER_H
+#define KERNEL_TIMER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 기본 틱 길이 (밀리초) */
+#define KTIMER_DEFAULT_TICK_MS 1
+
+/**
+ * @brief 타이머 만료 시 스레드 풀에서 실행되는 콜백 타입
+ */
+typedef void (*KTimerFunc)(void *arg);
+
+/**
+ * @struct KTimer
+ * @brief 호출자가 소유하는 타이머 (내부 필드는 타이머 서비스 전용)
+ */
+typedef struct KTimer {
+    struct KTimer *next;    /**< 휠 슬롯 연결 */
+    struct KTimer *prev;    /**< 휠 슬롯 연결 */
+    uint64_t expires;       /**< 만료 틱 */
+    KTimerFunc func;        /**< 만료 콜백 */
+    void *arg;              /**< 콜백 인자 */
+    int pending;            /**< 휠에 등록되어 있으면 1 */
+    uint32_t running;       /**< 풀에 넘겨졌지만 끝나지 않은 콜백 수 */
+} KTimer;
+
+/**
+ * @brief 정적 초기화용 매크로
+ */
+#define KTIMER_INIT(func, arg) { NULL, NULL, 0, (func), (arg), 0, 0 }
+
+/**
+ * @brief 타이머 서비스를 시작하는 함수 선언
+ *
+ * 호출하지 않으면 첫 ktimer_schedule에서 기본 설정으로 시작합니다.
+ *
+ * @param tick_ms 틱 길이 (0이면 KERNEL_TIMER_TICK_MS 환경 변수 또는 기본값)
+ * @return 새로 시작하면 0, 이미 실행 중이면 -1
+ */
+int ktimer_service_start(uint32_t tick_ms);
+
+/**
+ * @brief 타이머 서비스를 종료하는 함수 선언
+ *
+ * 대기 중인 타이머는 실행되지 않고 해제 상태가 되며, 이미 풀에 넘겨진 콜백은 그대로 실행됩니다.
+ */
+void ktimer_service_shutdown(void);
+
+/**
+ * @brief 타이머를 초기화하는 함수 선언
+ *
+ * @param timer 초기화할 타이머
+ * @param func 만료 콜백
+ * @param arg 콜백 인자
+ */
+void ktimer_init(KTimer *timer, KTimerFunc func, void *arg);
+
+/**
+ * @brief delay_ms 뒤에 만료되도록 타이머를 등록하는 함수 선언
+ *
+ * 이미 등록된 타이머는 새 만료 시각으로 옮깁니다 (유휴 시간 연장에 사용).
+ * 콜백 안에서 같은 타이머를 다시 등록해 주기 타이머로 쓸 수 있습니다.
+ *
+ * @param timer 타이머
+ * @param delay_ms 지연 시간 (틱 단위로 올림)
+ * @return 성공 시 0, 서비스를 시작할 수 없으면 -1
+ */
+int ktimer_schedule(KTimer *timer, uint64_t delay_ms);
+
+/**
+ * @brief 등록된 타이머를 취소하는 함수 선언
+ *
+ * @param timer 타이머
+ * @return 대기 중이던 타이머를 취소했으면 1, 이미 만료되었거나 등록되지 않았으면 0
+ */
+int ktimer_cancel(KTimer *timer);
+
+/**
+ * @brief 타이머를 취소하고 실행 중인 콜백이 끝날 때까지 기다리는 함수 선언
+ *
+ * 반환 후에는 타이머 메모리를 해제해도 안전합니다. 자신의 콜백 안에서 호출하면 안 됩니다.
+ *
+ * @param timer 타이머
+ * @return 대기 중이던 타이머를 취소했으면 1, 아니면 0
+ */
+int ktimer_cancel_sync(KTimer *timer);
+
+/**
+ * @brief 휠에 등록된 타이머 수를 반환하는 함수 선언
+ */
+uint64_t ktimer_pending_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_TIMER_H
@@ -0,0 +1,145 @@
+/*
+ * Kernel Trace Points
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Compile-time gated trace points for the C library.
+ *             A trace point whose level or category is disabled at build
+ *             time compiles to nothing (its format is still type-checked).
+ *             Enabled trace points append a fixed-size binary record to a
+ *             per-thread ring; formatting happens only in ktrace_dump().
+ *             When the library is built with tracing, the rings are dumped
+ *             at exit (KERNEL_TRACE_DUMP selects a file, or "off").
+ *
+ * Build     : make TRACE_LEVEL=4 TRACE_CATEGORIES=0x3
+ */
+
+#pragma once
+#ifndef KERNEL_TRACE_H
+#define KERNEL_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 트레이스 카테고리 (비트 마스크) */
+#define KTRACE_CAT_SMARTPTR 0x01u
+#define KTRACE_CAT_CHAT     0x02u
+#define KTRACE_CAT_ENGINE   0x04u
+#define KTRACE_CAT_PRINTF   0x08u
+#define KTRACE_CAT_ALL      0x0fu
+
+/* 트레이스 레벨 (값이 클수록 상세) */
+#define KTRACE_LVL_ERROR 1
+#define KTRACE_LVL_WARN  2
+#define KTRACE_LVL_INFO  3
+#define KTRACE_LVL_DEBUG 4
+
+/* 빌드 시 활성화할 최대 레벨 (0이면 모든 트레이스 포인트 제거) */
+#ifndef KTRACE_LEVEL
+#define KTRACE_LEVEL 0
+#endif
+
+/* 빌드 시 활성화할 카테고리 마스크 */
+#ifndef KTRACE_CATEGORIES
+#define KTRACE_CATEGORIES KTRACE_CAT_ALL
+#endif
+
+/* 레코드 하나에 저장하는 최대 인자 수와 문자열 인자 복사 영역 크기 */
+#define KTRACE_MAX_ARGS  4
+#define KTRACE_TEXT_SIZE 64
+
+/**
+ * @brief 컴파일 시점에 트레이스 포인트 활성 여부를 판단하는 매크로
+ */
+#define KTRACE_ENABLED(cat, level) \
+    ((level) <= KTRACE_LEVEL && ((cat) & KTRACE_CATEGORIES) != 0)
+
+/**
+ * @brief 트레이스 포인트 매크로
+ *
+ * 비활성화된 경우 상수 조건으로 제거되며 포맷 검사만 수행됩니다.
+ * 인자는 최대 KTRACE_MAX_ARGS개까지 기록되고, %s 인자는 레코드 안에 복사됩니다.
+ *
+ * @param cat 카테고리 (KTRACE_CAT_*)
+ * @param level 레벨 (KTRACE_LVL_*)
+ * @param fmt printf 형식 포맷 문자열 (문자열 리터럴이어야 함)
+ */
+#define KTRACE(cat, level, fmt, ...)                                           \
+    do {                                                                       \
+        if (KTRACE_ENABLED(cat, level)) {                                      \
+            ktrace_record((cat), (level), fmt, ##__VA_ARGS__);                 \
+        } else if (0) {                                                        \
+            ktrace_format_check(fmt, ##__VA_ARGS__);                           \
+        }                                                                      \
+    } while (0)
+
+/**
+ * @brief 비활성화된 트레이스 포인트의 포맷 검사용 함수
+ */
+static inline void ktrace_format_check(const char *fmt, ...)
+    __attribute__((format(printf, 1, 2)));
+static inline void ktrace_format_check(const char *fmt, ...) {
+    (void)fmt;
+}
+
+/**
+ * @brief 현재 스레드의 링 버퍼에 트레이스 레코드를 기록하는 함수 선언
+ *
+ * 직접 호출하지 말고 KTRACE 매크로를 사용해야 합니다.
+ *
+ * @param category 카테고리
+ * @param level 레벨
+ * @param fmt 포맷 문자열 (프로그램 종료 시까지 유효해야 함)
+ * @param ... 가변 인자 리스트
+ */
+void ktrace_record(unsigned category, unsigned level, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief 실행 중에 기록할 카테고리를 제한하는 함수 선언
+ *
+ * 컴파일 시점에 제거된 카테고리는 다시 켤 수 없습니다.
+ *
+ * @param mask 기록할 카테고리 마스크
+ */
+void ktrace_set_mask(unsigned mask);
+
+/**
+ * @brief 실행 중 기록 중인 카테고리 마스크를 반환하는 함수 선언
+ *
+ * @return 현재 카테고리 마스크
+ */
+unsigned ktrace_get_mask(void);
+
+/**
+ * @brief 라이브러리가 빌드된 트레이스 레벨을 반환하는 함수 선언
+ *
+ * 호출하는 쪽과 라이브러리의 KTRACE_LEVEL이 다를 수 있으므로 실행 중 확인용으로 사용합니다.
+ *
+ * @return 라이브러리 빌드 시 KTRACE_LEVEL (0이면 모든 트레이스 포인트가 제거됨)
+ */
+int ktrace_compiled_level(void);
+
+/**
+ * @brief 모든 스레드의 링 버퍼 내용을 시간순으로 출력하는 함수 선언
+ *
+ * @param out 출력 스트림 (NULL이면 stderr)
+ * @return 출력한 레코드 수
+ */
+size_t ktrace_dump(FILE *out);
+
+/**
+ * @brief 모든 스레드의 링 버퍼를 비우는 함수 선언
+ */
+void ktrace_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_TRACE_H
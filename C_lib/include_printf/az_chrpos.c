@@ -9,16 +9,15 @@
  */
 #include "kernel_pr_he.h"
 
+// 첫 번째 c의 번호, 없거나 c가 '\0'이면 -1
 int az_chrpos(const char *s, int c)
 {
-	int i;
+	const char *p;
 
-	i = 0;
-	while (s[i])
-	{
-		if ((int)s[i] == c)
-			return (i);
-		i++;
-	}
-	return (-1);
+	if ((char)c == '\0')
+		return (-1);
+	p = az_simd_strchrnul(s, c);
+	if (*p == '\0')
+		return (-1);
+	return ((int)(p - s));
 }
@@ -0,0 +1,934 @@
+/*
+ * Floating-Point Formatting
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : %f %e %g for kernel_printf and the shortest round-trip
+ *             conversion behind kernel_dtoa.h, without allocation.
+ *
+ *             Fixed precision is exact: the double is split into an integer
+ *             part and a binary fraction, and decimal digits are produced
+ *             from them one at a time, in 128-bit arithmetic when the
+ *             fraction has at most 124 bits (|value| above about 1e-21) and
+ *             in a fixed-size bignum otherwise. The digit after the last kept one plus a sticky
+ *             "anything left" bit give correct rounding (half to even, as
+ *             glibc does) at any precision.
+ *
+ *             Shortest output uses Grisu3 (Loitsch, "Printing
+ *             Floating-Point Numbers Quickly and Accurately with Integers",
+ *             2010) with the rounding boundaries of the source type, so a
+ *             float gets the digits that identify it among floats. When the
+ *             64-bit approximation cannot prove its digits are shortest
+ *             (about 0.4% of values, mostly a candidate on or next to a
+ *             rounding boundary), the digits are recomputed exactly with
+ *             the fixed-precision generator above, so the result is always
+ *             the shortest string that reads back as the same value.
+ */
+
+#include "kernel_dtoa.h"
+#include "kernel_pr_he.h"
+#include <limits.h>
+#include <string.h>
+
+/* double의 정확한 10진 전개에서 첫 유효 숫자부터 0이 아닌 마지막 숫자까지의 최대 길이보다 큼 */
+#define FLOAT_DIGITS_MAX 1120
+
+/* 분수 부분 bignum (분모 2^1074, 10을 곱해도 넘치지 않을 만큼) */
+#define FLOAT_FRAC_LIMBS 36
+
+/* 정수 부분 bignum (2^1024 미만) */
+#define FLOAT_INT_LIMBS 34
+
+/* ------------------------------------------------------------------------ */
+/* 정확한 자릿수 생성                                                        */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @struct FloatGen
+ * @brief |value|의 10진 자릿수를 가장 높은 자리부터 하나씩 내는 생성기
+ */
+typedef struct FloatGen {
+    int zero;                           /**< 값이 0 */
+    char ints[320];                     /**< 정수 부분 자릿수 (앞자리 0 없음) */
+    int nint;                           /**< 정수 부분 자릿수 개수 */
+    int int_end;                        /**< 정수 부분에서 0이 아닌 마지막 자리 다음 위치 */
+    int ipos;                           /**< 다음에 낼 정수 자리 */
+    int big;                            /**< 분수 부분을 limbs에 보관 */
+    int shift;                          /**< 분수 부분 분모 2^shift */
+    unsigned __int128 frac;             /**< 분수 부분 (big == 0) */
+    int nlimbs;                         /**< 0이 아닌 limb 개수 (big == 1) */
+    uint32_t limbs[FLOAT_FRAC_LIMBS];   /**< 분수 부분 (big == 1, 작은 자리부터) */
+} FloatGen;
+
+/**
+ * @brief 2^1024 미만의 정수를 10진수로 바꾸는 함수 (10^9씩 나눔)
+ */
+static void gen_big_integer(FloatGen *g, uint64_t m, int e) {
+    uint32_t limbs[FLOAT_INT_LIMBS];
+    uint32_t chunks[FLOAT_INT_LIMBS + 2];
+    int nlimbs = e / 32 + 3;
+    int nchunks = 0;
+
+    memset(limbs, 0, sizeof(limbs));
+    limbs[e / 32] = (uint32_t)(m << (e % 32));
+    limbs[e / 32 + 1] = (uint32_t)((m << (e % 32)) >> 32);
+    limbs[e / 32 + 2] = e % 32 != 0 ? (uint32_t)(m >> (64 - e % 32)) : 0;
+    while (nlimbs > 0 && limbs[nlimbs - 1] == 0) {
+        nlimbs--;
+    }
+    while (nlimbs > 0) {
+        uint64_t rem = 0;
+        for (int i = nlimbs - 1; i >= 0; i--) {
+            uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        chunks[nchunks++] = (uint32_t)rem;
+        while (nlimbs > 0 && limbs[nlimbs - 1] == 0) {
+            nlimbs--;
+        }
+    }
+
+    // 가장 높은 덩어리는 앞자리 0 없이, 나머지는 9자리씩
+    char *p = g->ints;
+    char tmp[AZ_NUMBUF_SIZE];
+    size_t len = az_utoa(chunks[nchunks - 1], 10, 0, tmp + sizeof(tmp));
+    memcpy(p, tmp + sizeof(tmp) - len, len);
+    p += len;
+    for (int i = nchunks - 2; i >= 0; i--) {
+        uint32_t c = chunks[i];
+        for (int k = 8; k >= 0; k--) {
+            p[k] = (char)('0' + c % 10);
+            c /= 10;
+        }
+        p += 9;
+    }
+    g->nint = (int)(p - g->ints);
+}
+
+/**
+ * @brief m × 2^e의 자릿수 생성기를 준비하는 함수 (m < 2^64, 2^-1076 < 값 < 2^1024)
+ */
+static void gen_init_parts(FloatGen *g, uint64_t m, int e) {
+    g->nint = 0;
+    g->ipos = 0;
+    g->big = 0;
+    g->shift = 0;
+    g->frac = 0;
+    g->nlimbs = 0;
+    g->zero = m == 0;
+    if (g->zero) {
+        g->int_end = 0;
+        return;
+    }
+    // 끝의 0비트를 없애 분모를 줄임
+    while ((m & 1) == 0) {
+        m >>= 1;
+        e++;
+    }
+
+    if (e >= 0) {
+        if (e <= __builtin_clzll(m)) {
+            size_t len = az_utoa(m << e, 10, 0, g->ints + sizeof(g->ints));
+            memmove(g->ints, g->ints + sizeof(g->ints) - len, len);
+            g->nint = (int)len;
+        } else {
+            gen_big_integer(g, m, e);
+        }
+    } else {
+        int s = -e;
+        uint64_t ipart = s < 64 ? m >> s : 0;
+        uint64_t fpart = s < 64 ? m & ((1ULL << s) - 1) : m;
+
+        if (ipart != 0) {
+            size_t len = az_utoa(ipart, 10, 0, g->ints + sizeof(g->ints));
+            memmove(g->ints, g->ints + sizeof(g->ints) - len, len);
+            g->nint = (int)len;
+        }
+        g->shift = s;
+        if (s <= 124) {
+            g->frac = fpart;
+        } else {
+            g->big = 1;
+            g->limbs[0] = (uint32_t)fpart;
+            g->limbs[1] = (uint32_t)(fpart >> 32);
+            g->nlimbs = g->limbs[1] != 0 ? 2 : g->limbs[0] != 0 ? 1 : 0;
+        }
+    }
+
+    g->int_end = g->nint;
+    while (g->int_end > 0 && g->ints[g->int_end - 1] == '0') {
+        g->int_end--;
+    }
+}
+
+static void gen_init(FloatGen *g, double value) {
+    uint64_t bits;
+    uint64_t m;
+    int e;
+
+    memcpy(&bits, &value, sizeof(bits));
+    m = bits & ((1ULL << 52) - 1);
+    e = (int)((bits >> 52) & 0x7FF);
+    if (e != 0) {
+        m |= 1ULL << 52;
+        e -= 1075;
+    } else {
+        e = -1074;
+    }
+    gen_init_parts(g, m, e);
+}
+
+/**
+ * @brief 남은 자리가 모두 0인지 확인하는 함수
+ */
+static int gen_done(const FloatGen *g) {
+    return g->ipos >= g->int_end && (g->big ? g->nlimbs == 0 : g->frac == 0);
+}
+
+/**
+ * @brief 다음 자리를 내는 함수 (남은 것이 없으면 0)
+ */
+static int gen_next(FloatGen *g) {
+    if (g->ipos < g->nint) {
+        return g->ints[g->ipos++] - '0';
+    }
+    if (!g->big) {
+        if (g->frac == 0) {
+            return 0;
+        }
+        // frac < 2^124 이므로 10을 곱해도 넘치지 않음
+        g->frac *= 10;
+        int d = (int)(g->frac >> g->shift);
+        g->frac &= ((unsigned __int128)1 << g->shift) - 1;
+        return d;
+    }
+    if (g->nlimbs == 0) {
+        return 0;
+    }
+
+    uint64_t carry = 0;
+    for (int i = 0; i < g->nlimbs; i++) {
+        uint64_t t = (uint64_t)g->limbs[i] * 10 + carry;
+        g->limbs[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    if (carry != 0) {
+        g->limbs[g->nlimbs++] = (uint32_t)carry;
+    }
+
+    // 자리 값은 shift 위의 4비트
+    int word = g->shift / 32;
+    int bit = g->shift % 32;
+    uint32_t d = 0;
+    if (word < g->nlimbs) {
+        d = g->limbs[word] >> bit;
+        if (bit > 28 && word + 1 < g->nlimbs) {
+            d |= g->limbs[word + 1] << (32 - bit);
+        }
+        g->limbs[word] &= bit != 0 ? (1u << bit) - 1 : 0;
+        g->nlimbs = word + 1;
+        while (g->nlimbs > 0 && g->limbs[g->nlimbs - 1] == 0) {
+            g->nlimbs--;
+        }
+    }
+    return (int)(d & 0xF);
+}
+
+/**
+ * @brief 반올림된 자릿수를 만드는 함수
+ *
+ * fixed면 10^-prec 자리까지, 아니면 유효 숫자 prec개를 만듭니다. 저장하지 않은 뒤쪽 자리는 모두 0입니다.
+ *
+ * @param g 생성기
+ * @param fixed 1이면 소수점 아래 prec자리까지
+ * @param prec 자리 수
+ * @param out 자릿수 (FLOAT_DIGITS_MAX)
+ * @param stored out에 저장한 자릿수 개수
+ * @param exp10 첫 자리의 10진 지수
+ * @return 전체 자릿수 (fixed에서 0 이하면 값이 0으로 반올림됨)
+ */
+static int gen_digits(FloatGen *g, int fixed, int prec, char *out, int *stored, int *exp10) {
+    int x;
+    int n;
+    int first;
+    int round_digit;
+    int sticky;
+    int last_odd = 0;
+
+    *stored = 0;
+    if (g->zero) {
+        *exp10 = 0;
+        return fixed ? 0 : prec;
+    }
+
+    // 첫 유효 숫자와 그 지수
+    if (g->nint > 0) {
+        x = g->nint - 1;
+        first = gen_next(g);
+    } else {
+        x = -1;
+        while ((first = gen_next(g)) == 0) {
+            x--;
+        }
+    }
+    n = fixed ? x + 1 + prec : prec;
+
+    if (n <= 0) {
+        round_digit = n == 0 ? first : 0;
+        sticky = n == 0 ? !gen_done(g) : 1;
+    } else {
+        int k = 0;
+        out[k++] = (char)('0' + first);
+        while (k < n && k < FLOAT_DIGITS_MAX && !gen_done(g)) {
+            out[k++] = (char)('0' + gen_next(g));
+        }
+        *stored = k;
+        if (k < n) {
+            // 남은 자리가 모두 0
+            round_digit = 0;
+            sticky = 0;
+        } else {
+            round_digit = gen_done(g) ? 0 : gen_next(g);
+            sticky = !gen_done(g);
+            last_odd = (out[n - 1] - '0') & 1;
+        }
+    }
+
+    if (round_digit > 5 || (round_digit == 5 && (sticky || last_odd))) {
+        int i = n - 1;
+        while (i >= 0 && out[i] == '9') {
+            out[i--] = '0';
+        }
+        if (i >= 0) {
+            out[i]++;
+        } else {
+            // 모든 자리가 올림되어 한 자리 늘어남 (n <= 0이면 10^-prec 하나)
+            out[0] = '1';
+            *stored = 1;
+            if (n <= 0) {
+                x = -prec;
+                n = 1;
+            } else {
+                x++;
+                n += fixed;
+            }
+        }
+    }
+    *exp10 = x;
+    return n;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 출력                                                                      */
+/* ------------------------------------------------------------------------ */
+
+static void put_repeat(char c, int n) {
+    char chunk[32];
+
+    if (n <= 0) {
+        return;
+    }
+    memset(chunk, c, (size_t)n < sizeof(chunk) ? (size_t)n : sizeof(chunk));
+    while (n > 0) {
+        int k = n < (int)sizeof(chunk) ? n : (int)sizeof(chunk);
+        az_print_write(chunk, (size_t)k);
+        n -= k;
+    }
+}
+
+/**
+ * @brief digits[from, from + len)을 출력하는 함수 (저장하지 않은 자리는 0)
+ */
+static void put_digits(const char *digits, int stored, int from, int len) {
+    if (len <= 0) {
+        return;
+    }
+    if (from < stored) {
+        int k = stored - from < len ? stored - from : len;
+        az_print_write(digits + from, (size_t)k);
+        from += k;
+        len -= k;
+    }
+    put_repeat('0', len);
+}
+
+/**
+ * @struct FloatOut
+ * @brief 출력할 실수 한 개의 구성 ([부호][정수].[0...][소수][지수])
+ */
+typedef struct FloatOut {
+    char sign;              /**< '-', '+', ' ' 또는 0 */
+    const char *digits;     /**< 자릿수 */
+    int stored;             /**< digits에 저장된 개수 */
+    int int_from;           /**< 정수 부분 시작 */
+    int int_len;            /**< 정수 부분 길이 (0이면 "0") */
+    int point;              /**< 소수점 출력 여부 */
+    int frac_zeros;         /**< 소수점 바로 뒤의 0 개수 */
+    int frac_from;          /**< 소수 부분 시작 */
+    int frac_len;           /**< 소수 부분 길이 */
+    char exp[8];            /**< 지수 ("e+05") */
+    int exp_len;
+} FloatOut;
+
+static void float_emit(const FloatOut *fo, int width, unsigned flags) {
+    int len = (fo->sign != 0) + (fo->int_len > 0 ? fo->int_len : 1) + fo->point + fo->frac_zeros + fo->frac_len +
+              fo->exp_len;
+    int pad = width > len ? width - len : 0;
+
+    if (!(flags & (AZ_FLAG_LEFT | AZ_FLAG_ZERO))) {
+        put_repeat(' ', pad);
+    }
+    if (fo->sign != 0) {
+        az_print_write(&fo->sign, 1);
+    }
+    if ((flags & AZ_FLAG_ZERO) && !(flags & AZ_FLAG_LEFT)) {
+        put_repeat('0', pad);
+    }
+    if (fo->int_len > 0) {
+        put_digits(fo->digits, fo->stored, fo->int_from, fo->int_len);
+    } else {
+        az_print_write("0", 1);
+    }
+    if (fo->point) {
+        az_print_write(".", 1);
+    }
+    put_repeat('0', fo->frac_zeros);
+    put_digits(fo->digits, fo->stored, fo->frac_from, fo->frac_len);
+    if (fo->exp_len > 0) {
+        az_print_write(fo->exp, (size_t)fo->exp_len);
+    }
+    if (flags & AZ_FLAG_LEFT) {
+        put_repeat(' ', pad);
+    }
+}
+
+static int format_exponent(char *out, char e, int x) {
+    char buf[AZ_NUMBUF_SIZE];
+    unsigned ax = x < 0 ? (unsigned)-x : (unsigned)x;
+    size_t len = az_utoa(ax, 10, 0, buf + sizeof(buf));
+    int n = 0;
+
+    out[n++] = e;
+    out[n++] = x < 0 ? '-' : '+';
+    if (len < 2) {
+        out[n++] = '0';
+    }
+    memcpy(out + n, buf + sizeof(buf) - len, len);
+    return n + (int)len;
+}
+
+/**
+ * @brief 고정 소수점 표기 (%f, %g의 고정 표기)를 구성하는 함수
+ */
+static void layout_fixed(FloatOut *fo, int n, int x, int prec) {
+    if (n <= 0) {
+        fo->int_len = 0;
+        fo->frac_zeros = prec;
+        fo->frac_len = 0;
+    } else if (x >= 0) {
+        fo->int_from = 0;
+        fo->int_len = x + 1;
+        fo->frac_zeros = 0;
+        fo->frac_from = x + 1;
+        fo->frac_len = n - x - 1;
+    } else {
+        fo->int_len = 0;
+        fo->frac_zeros = -x - 1;
+        fo->frac_from = 0;
+        fo->frac_len = n;
+    }
+}
+
+/**
+ * @brief %g에서 소수 부분 끝의 0을 지우는 함수
+ */
+static void trim_zeros(FloatOut *fo) {
+    if (fo->frac_from + fo->frac_len > fo->stored) {
+        fo->frac_len = fo->stored > fo->frac_from ? fo->stored - fo->frac_from : 0;
+    }
+    while (fo->frac_len > 0 && fo->digits[fo->frac_from + fo->frac_len - 1] == '0') {
+        fo->frac_len--;
+    }
+    if (fo->frac_len == 0) {
+        fo->frac_zeros = 0;
+    }
+}
+
+/**
+ * @brief 실수 하나를 %f %F %e %E %g %G 형식으로 출력하는 함수
+ *
+ * @param value 출력할 값
+ * @param conv 변환 문자
+ * @param width 최소 너비 (0 이하면 없음)
+ * @param precision 정밀도 (음수면 6)
+ * @param flags AZ_FLAG_* 조합
+ */
+void az_putfloat(double value, char conv, int width, int precision, unsigned flags) {
+    char digits[FLOAT_DIGITS_MAX];
+    FloatGen gen;
+    FloatOut fo;
+    int upper = conv == 'F' || conv == 'E' || conv == 'G';
+    int alt = (flags & AZ_FLAG_ALT) != 0;
+    int n;
+    int x;
+
+    memset(&fo, 0, sizeof(fo));
+    fo.digits = digits;
+    if (__builtin_signbit(value)) {
+        fo.sign = '-';
+    } else if (flags & AZ_FLAG_PLUS) {
+        fo.sign = '+';
+    } else if (flags & AZ_FLAG_SPACE) {
+        fo.sign = ' ';
+    }
+
+    if (__builtin_isnan(value) || __builtin_isinf(value)) {
+        const char *text = __builtin_isnan(value) ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+        memcpy(digits, text, 3);
+        fo.stored = 3;
+        fo.int_len = 3;
+        float_emit(&fo, width, flags & ~AZ_FLAG_ZERO);
+        return;
+    }
+    if (precision < 0) {
+        precision = 6;
+    }
+    // 저장 범위를 넘는 자리는 0으로 채우므로 자릿수 계산이 넘치지 않을 만큼만 제한
+    if (precision > INT_MAX / 2) {
+        precision = INT_MAX / 2;
+    }
+    gen_init(&gen, value);
+
+    switch (conv) {
+        case 'f':
+        case 'F':
+            n = gen_digits(&gen, 1, precision, digits, &fo.stored, &x);
+            layout_fixed(&fo, n, x, precision);
+            fo.point = precision > 0 || alt;
+            break;
+        case 'e':
+        case 'E':
+            gen_digits(&gen, 0, precision + 1, digits, &fo.stored, &x);
+            fo.int_from = 0;
+            fo.int_len = 1;
+            fo.frac_from = 1;
+            fo.frac_len = precision;
+            fo.point = precision > 0 || alt;
+            fo.exp_len = format_exponent(fo.exp, upper ? 'E' : 'e', x);
+            break;
+        default: {
+            int p = precision == 0 ? 1 : precision;
+            gen_digits(&gen, 0, p, digits, &fo.stored, &x);
+            if (x < p && x >= -4) {
+                layout_fixed(&fo, p, x, p - 1 - x);
+            } else {
+                fo.int_from = 0;
+                fo.int_len = 1;
+                fo.frac_from = 1;
+                fo.frac_len = p - 1;
+                fo.exp_len = format_exponent(fo.exp, upper ? 'E' : 'e', x);
+            }
+            if (!alt) {
+                trim_zeros(&fo);
+            }
+            fo.point = fo.frac_zeros + fo.frac_len > 0 || alt;
+            break;
+        }
+    }
+    float_emit(&fo, width, flags);
+}
+
+/* ------------------------------------------------------------------------ */
+/* 가장 짧은 왕복 표현 (Grisu3, 확실하지 않으면 정확한 계산)                 */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @struct DiyFp
+ * @brief 64비트 가수와 2진 지수로 나타낸 값 (f × 2^e)
+ */
+typedef struct DiyFp {
+    uint64_t f;
+    int e;
+} DiyFp;
+
+/* 10^-348 ... 10^340 (8 간격)의 정규화된 근사값 */
+static const uint64_t cached_f[87] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+static const int16_t cached_e[87] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+static const uint32_t pow10_32[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+static DiyFp diy_mul(DiyFp x, DiyFp y) {
+    unsigned __int128 p = (unsigned __int128)x.f * y.f;
+    uint64_t h = (uint64_t)(p >> 64);
+    uint64_t l = (uint64_t)p;
+    DiyFp r = { h + (l >> 63), x.e + y.e + 64 };
+    return r;
+}
+
+static DiyFp diy_normalize(DiyFp x) {
+    int s = __builtin_clzll(x.f);
+    x.f <<= s;
+    x.e -= s;
+    return x;
+}
+
+/**
+ * @brief 지수 e를 알맞은 범위로 옮기는 10^-K 근사값을 고르는 함수
+ */
+static DiyFp cached_power(int e, int *k) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int)dk;
+    if (dk - ik > 0.0) {
+        ik++;
+    }
+    unsigned index = (unsigned)((ik >> 3) + 1);
+    *k = -(-348 + (int)(index << 3));
+    DiyFp r = { cached_f[index], cached_e[index] };
+    return r;
+}
+
+static uint64_t grisu_round(char *buf, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buf[len - 1]--;
+        rest += ten_kappa;
+    }
+    return rest;
+}
+
+static int count_digits32(uint32_t n) {
+    int d = 1;
+    while (d < 10 && n >= pow10_32[d]) {
+        d++;
+    }
+    return d;
+}
+
+/**
+ * @brief [mp - delta, mp] 안에서 가장 짧은 자릿수를 만드는 함수
+ *
+ * @param sure 결과가 양쪽 끝에서 근사 오차(2 단위) 이상 떨어져 있으면 1
+ */
+static int grisu_digits(DiyFp w, DiyFp mp, uint64_t delta, char *buf, int *k, int *sure) {
+    DiyFp one = { 1ULL << -mp.e, mp.e };
+    uint64_t unit = 1;
+    uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int kappa = count_digits32(p1);
+    int len = 0;
+
+    while (kappa > 0) {
+        uint32_t d = p1 / pow10_32[kappa - 1];
+        p1 %= pow10_32[kappa - 1];
+        if (d != 0 || len != 0) {
+            buf[len++] = (char)('0' + d);
+        }
+        kappa--;
+        uint64_t tmp = ((uint64_t)p1 << -one.e) + p2;
+        if (tmp <= delta) {
+            *k += kappa;
+            uint64_t rest = grisu_round(buf, len, delta, tmp, (uint64_t)pow10_32[kappa] << -one.e, wp_w);
+            *sure = rest >= 2 * unit && delta - rest >= 2 * unit;
+            return len;
+        }
+    }
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        unit *= 10;
+        char d = (char)(p2 >> -one.e);
+        if (d != 0 || len != 0) {
+            buf[len++] = (char)('0' + d);
+        }
+        p2 &= one.f - 1;
+        kappa--;
+        if (p2 < delta) {
+            *k += kappa;
+            int index = -kappa;
+            uint64_t rest = grisu_round(buf, len, delta, p2, one.f, wp_w * (index < 10 ? pow10_32[index] : 0));
+            *sure = rest >= 2 * unit && delta - rest >= 2 * unit;
+            return len;
+        }
+    }
+}
+
+/**
+ * @brief f × 2^e 값과 반올림 경계로 가장 짧은 자릿수를 구하는 함수 (Grisu3)
+ *
+ * 경계의 근사 오차(1 단위)만큼 넓힌 구간에서 자릿수를 만듭니다. 넓힌 구간에 더 짧은 후보가 없으므로,
+ * 결과가 같은 만큼 좁힌 구간에도 들어가면 가장 짧은 왕복 표현이 확실합니다.
+ *
+ * @param f 가수 (숨은 비트 포함)
+ * @param e 2진 지수
+ * @param lower_closer 아래쪽 이웃과의 간격이 절반인 경우 (2의 거듭제곱)
+ * @param buf 자릿수 (최대 17자리)
+ * @param k 10진 지수 (값 = 자릿수 × 10^k)
+ * @param sure 확실하면 1, 0이면 결과 길이가 하한일 뿐이므로 shortest_exact로 다시 구해야 함
+ * @return 자릿수 개수
+ */
+static int grisu3(uint64_t f, int e, int lower_closer, char *buf, int *k, int *sure) {
+    DiyFp v = { f, e };
+    DiyFp pl = { (f << 1) + 1, e - 1 };
+    DiyFp mi = lower_closer ? (DiyFp){ (f << 2) - 1, e - 2 } : (DiyFp){ (f << 1) - 1, e - 1 };
+
+    pl = diy_normalize(pl);
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+
+    DiyFp c = cached_power(pl.e, k);
+    DiyFp w = diy_mul(diy_normalize(v), c);
+    DiyFp wp = diy_mul(pl, c);
+    DiyFp wm = diy_mul(mi, c);
+    wm.f--;
+    wp.f++;
+    return grisu_digits(w, wp, wp.f - wm.f, buf, k, sure);
+}
+
+/**
+ * @brief 10진 자릿수 (첫 자리 지수 x)와 m × 2^e를 정확히 비교하는 함수
+ *
+ * @return 자릿수 쪽이 작으면 음수, 같으면 0, 크면 양수
+ */
+static int compare_exact(const char *digits, int len, int x, uint64_t m, int e) {
+    FloatGen g;
+    int xb;
+    int d;
+
+    gen_init_parts(&g, m, e);
+    if (g.nint > 0) {
+        xb = g.nint - 1;
+        d = gen_next(&g);
+    } else {
+        xb = -1;
+        while ((d = gen_next(&g)) == 0) {
+            xb--;
+        }
+    }
+    if (x != xb) {
+        return x < xb ? -1 : 1;
+    }
+    for (int i = 0; i < len; i++) {
+        if (i > 0) {
+            d = gen_next(&g);
+        }
+        if (digits[i] - '0' != d) {
+            return digits[i] - '0' < d ? -1 : 1;
+        }
+    }
+    return gen_done(&g) ? 0 : -1;
+}
+
+/**
+ * @brief 10진 자릿수가 f × 2^e와 같은 값으로 읽히는지 확인하는 함수
+ *
+ * 가수가 짝수면 정확히 경계인 값도 짝수 쪽, 즉 같은 값으로 읽힙니다.
+ */
+static int reads_back(const char *digits, int len, int x, uint64_t f, int e, int lower_closer) {
+    int lo = lower_closer ? compare_exact(digits, len, x, (f << 2) - 1, e - 2)
+                          : compare_exact(digits, len, x, (f << 1) - 1, e - 1);
+    int hi = compare_exact(digits, len, x, (f << 1) + 1, e - 1);
+    int closed = (f & 1) == 0;
+    return (lo > 0 || (closed && lo == 0)) && (hi < 0 || (closed && hi == 0));
+}
+
+/**
+ * @brief 정확한 계산으로 가장 짧은 왕복 자릿수를 구하는 함수 (grisu3가 확신하지 못한 드문 경우)
+ *
+ * n자리로 정확히 반올림한 값이 같은 값으로 읽히는 가장 작은 n을 찾습니다. 구간이 대칭이면 가장 가까운
+ * n자리 값만 보면 되고, 아래쪽이 좁으면(lower_closer) 위쪽 이웃도 확인합니다. 17자리면 항상 읽힙니다.
+ *
+ * @param from 자릿수 하한 (grisu3 결과 길이)
+ */
+static int shortest_exact(uint64_t f, int e, int lower_closer, int from, char *buf, int *k) {
+    FloatGen g;
+    int n;
+    int stored;
+    int x;
+
+    for (n = from; n < 17; n++) {
+        gen_init_parts(&g, f, e);
+        gen_digits(&g, 0, n, buf, &stored, &x);
+        memset(buf + stored, '0', (size_t)(n - stored));
+        if (reads_back(buf, n, x, f, e, lower_closer)) {
+            *k = x - n + 1;
+            return n;
+        }
+        if (lower_closer && compare_exact(buf, n, x, f, e) < 0) {
+            int i = n - 1;
+            while (i >= 0 && buf[i] == '9') {
+                buf[i--] = '0';
+            }
+            if (i >= 0) {
+                buf[i]++;
+            } else {
+                buf[0] = '1';
+                x++;
+            }
+            if (reads_back(buf, n, x, f, e, lower_closer)) {
+                *k = x - n + 1;
+                return n;
+            }
+        }
+    }
+    gen_init_parts(&g, f, e);
+    gen_digits(&g, 0, n, buf, &stored, &x);
+    memset(buf + stored, '0', (size_t)(n - stored));
+    *k = x - n + 1;
+    return n;
+}
+
+/**
+ * @brief 자릿수와 10진 지수를 %.17g와 같은 모양의 문자열로 만드는 함수
+ */
+static int shortest_layout(char *out, int negative, const char *digits, int len, int k) {
+    int x = len + k - 1;
+    int n = 0;
+
+    if (negative) {
+        out[n++] = '-';
+    }
+    if (x >= -4 && x < 17) {
+        if (x >= len - 1) {
+            memcpy(out + n, digits, (size_t)len);
+            n += len;
+            memset(out + n, '0', (size_t)(x - len + 1));
+            n += x - len + 1;
+        } else if (x >= 0) {
+            memcpy(out + n, digits, (size_t)x + 1);
+            n += x + 1;
+            out[n++] = '.';
+            memcpy(out + n, digits + x + 1, (size_t)(len - x - 1));
+            n += len - x - 1;
+        } else {
+            out[n++] = '0';
+            out[n++] = '.';
+            memset(out + n, '0', (size_t)(-x - 1));
+            n += -x - 1;
+            memcpy(out + n, digits, (size_t)len);
+            n += len;
+        }
+    } else {
+        out[n++] = digits[0];
+        if (len > 1) {
+            out[n++] = '.';
+            memcpy(out + n, digits + 1, (size_t)len - 1);
+            n += len - 1;
+        }
+        n += format_exponent(out + n, 'e', x);
+    }
+    out[n] = '\0';
+    return n;
+}
+
+static int special_layout(char *buf, int negative, int is_nan, int is_inf) {
+    const char *text = is_nan ? "nan" : is_inf ? "inf" : "0";
+    int n = 0;
+
+    if (negative) {
+        buf[n++] = '-';
+    }
+    memcpy(buf + n, text, strlen(text) + 1);
+    return n + (int)strlen(text);
+}
+
+/**
+ * @brief double을 다시 읽으면 같은 값이 되는 가장 짧은 문자열로 바꾸는 함수
+ */
+int kernel_dtoa(double value, char *buf) {
+    uint64_t bits;
+    char digits[20];
+    int k;
+
+    memcpy(&bits, &value, sizeof(bits));
+    int negative = (int)(bits >> 63);
+    int biased = (int)((bits >> 52) & 0x7FF);
+    uint64_t f = bits & ((1ULL << 52) - 1);
+
+    if (biased == 0x7FF || (biased == 0 && f == 0)) {
+        return special_layout(buf, negative, biased == 0x7FF && f != 0, biased == 0x7FF && f == 0);
+    }
+    int e = biased != 0 ? biased - 1075 : -1074;
+    int lower_closer = biased > 1 && f == 0;
+    if (biased != 0) {
+        f |= 1ULL << 52;
+    }
+    int sure;
+    int len = grisu3(f, e, lower_closer, digits, &k, &sure);
+    if (!sure) {
+        len = shortest_exact(f, e, lower_closer, len, digits, &k);
+    }
+    return shortest_layout(buf, negative, digits, len, k);
+}
+
+/**
+ * @brief float을 다시 읽으면 같은 float이 되는 가장 짧은 문자열로 바꾸는 함수
+ */
+int kernel_ftoa(float value, char *buf) {
+    uint32_t bits;
+    char digits[20];
+    int k;
+
+    memcpy(&bits, &value, sizeof(bits));
+    int negative = (int)(bits >> 31);
+    int biased = (int)((bits >> 23) & 0xFF);
+    uint64_t f = bits & ((1u << 23) - 1);
+
+    if (biased == 0xFF || (biased == 0 && f == 0)) {
+        return special_layout(buf, negative, biased == 0xFF && f != 0, biased == 0xFF && f == 0);
+    }
+    int e = biased != 0 ? biased - 150 : -149;
+    int lower_closer = biased > 1 && f == 0;
+    if (biased != 0) {
+        f |= 1u << 23;
+    }
+    int sure;
+    int len = grisu3(f, e, lower_closer, digits, &k, &sure);
+    if (!sure) {
+        len = shortest_exact(f, e, lower_closer, len, digits, &k);
+    }
+    return shortest_layout(buf, negative, digits, len, k);
+}
@@ -9,46 +9,27 @@
  */
 #include "kernel_pr_he.h"
 
-static int az_pow(int nb, int pow)
-{
-	if (pow == 0)
-		return (1);
-	else
-		return (nb * az_pow(nb, pow - 1));
-}
-
+// 반환한 문자열은 호출자가 free 해야 함 (10진수가 아니면 2의 보수 그대로 변환)
 char *az_itoa(int value, int base)
 {
-	int i;
+	char buf[AZ_NUMBUF_SIZE];
+	char *end;
 	char *nbr;
+	size_t len;
 	int neg;
 
-	// 10진수
-	// base = 10..
-
-	i = 1;
-	neg = 0;
-	if (value < 0)
-	{
-		if (base == 10)
-			neg = 1;
-		value *= -1;
-	}
-
-	while (az_pow(base, i) - 1 < value)
-		i++;
-
-	nbr = (char *)malloc(sizeof(nbr) * i);
-
-	nbr[i + neg] = '\0';
-
-	while (i-- > 0)
-	{
-		nbr[i + neg] = (value % base) + (value % base > 9 ? 'A' - 10 : '0');
-		value = value / base;
-	}
+	neg = base == 10 && value < 0;
+	end = buf + sizeof(buf);
 	if (neg)
-		nbr[0] = '-';
-
+		len = az_utoa(0u - (unsigned int)value, 10, 1, end);
+	else
+		len = az_utoa((unsigned int)value, (unsigned)base, 1, end);
+	if (neg)
+		*(end - ++len) = '-';
+	nbr = (char *)malloc(len + 1);
+	if (nbr == NULL)
+		return (NULL);
+	memcpy(nbr, end - len, len);
+	nbr[len] = '\0';
 	return (nbr);
 }
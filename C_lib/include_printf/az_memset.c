@@ -11,20 +11,10 @@
 
 void *az_memset(void *b, int c, size_t len)
 {
-	unsigned char *s;
-	size_t i;
-
-	i = 0;
 	if (len == 0)
 		return (b);
 
-	s = b;
-
-	while (i < len)
-	{
-		s[i] = (unsigned char)c;
-		i++;
-	}
+	az_simd_memset(b, c, len);
 
 	return (b);
 }
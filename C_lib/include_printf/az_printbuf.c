@@ -0,0 +1,294 @@
+/*
+ * Kernel Print Buffer and Sinks
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the per-thread print buffer declared in
+ *             kernel_print_sink.h. Output helpers bracket their work with
+ *             az_print_begin / az_print_end; only the outermost end decides
+ *             whether the buffer goes to the sink, so nested helpers
+ *             (kernel_printf -> az_putnbr -> kernel_putchar) cost a store per
+ *             byte and one sink write per call.
+ *
+ *             az_print_to_sink swaps in a buffer on the caller's stack that
+ *             drains to an explicit sink, so the same formatter serves
+ *             kernel_snprintf / kernel_dprintf without touching the thread's
+ *             pending output.
+ */
+
+#include "kernel_pr_he.h"
+#include "kernel_print_sink.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @struct PrintBuffer
+ * @brief 스레드별 출력 버퍼
+ */
+typedef struct PrintBuffer {
+    size_t used;                        /**< 버퍼에 쌓인 바이트 수 */
+    int depth;                          /**< az_print_begin 중첩 깊이 */
+    const KPrintSink *sink;             /**< 출력 대상 (NULL이면 전역 싱크) */
+    size_t total;                       /**< 싱크로 넘긴 바이트 수 (az_print_to_sink 반환값) */
+    char data[KPRINT_BUFFER_SIZE];
+} PrintBuffer;
+
+static const KPrintSink stdout_sink = { kernel_print_fd_write, (void *)(intptr_t)STDOUT_FILENO };
+static const KPrintSink *print_sink = &stdout_sink;
+static int print_mode = KPRINT_FLUSH_CALL;
+
+static pthread_once_t print_once = PTHREAD_ONCE_INIT;
+static pthread_key_t print_key;
+static int print_key_ready = 0;
+static __thread PrintBuffer *print_local = NULL;
+static __thread int print_no_buffer = 0;   /* 버퍼 할당에 실패한 스레드는 바로 출력 */
+
+/**
+ * @brief 파일 디스크립터에 쓰는 싱크 쓰기 함수
+ */
+void kernel_print_fd_write(void *ctx, const char *data, size_t len) {
+    int fd = (int)(intptr_t)ctx;
+
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+static inline void sink_emit(const char *data, size_t len) {
+    const KPrintSink *sink = __atomic_load_n(&print_sink, __ATOMIC_ACQUIRE);
+    sink->write(sink->ctx, data, len);
+}
+
+static void buffer_drain(PrintBuffer *pb, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    if (pb->sink != NULL) {
+        pb->sink->write(pb->sink->ctx, pb->data, len);
+    } else {
+        sink_emit(pb->data, len);
+    }
+    pb->total += len;
+    memmove(pb->data, pb->data + len, pb->used - len);
+    pb->used -= len;
+}
+
+static void print_thread_exit(void *arg) {
+    PrintBuffer *pb = (PrintBuffer *)arg;
+    buffer_drain(pb, pb->used);
+    print_local = NULL;
+    free(pb);
+}
+
+static void print_flush_local(void) {
+    PrintBuffer *pb = print_local;
+    if (pb != NULL) {
+        buffer_drain(pb, pb->used);
+    }
+}
+
+static void print_init(void) {
+    const char *env = getenv("KERNEL_PRINT_FLUSH");
+
+    if (env != NULL) {
+        if (strcmp(env, "none") == 0) {
+            print_mode = KPRINT_UNBUFFERED;
+        } else if (strcmp(env, "line") == 0) {
+            print_mode = KPRINT_FLUSH_LINE;
+        } else if (strcmp(env, "full") == 0) {
+            print_mode = KPRINT_FLUSH_FULL;
+        }
+    }
+    print_key_ready = pthread_key_create(&print_key, print_thread_exit) == 0;
+    // fork 전에 비워 자식이 같은 내용을 다시 출력하지 않게 함
+    pthread_atfork(print_flush_local, NULL, NULL);
+    atexit(print_flush_local);
+}
+
+/**
+ * @brief 호출 스레드의 버퍼를 반환하는 함수 (처음 호출 시 할당, 실패하면 NULL)
+ */
+static PrintBuffer *print_buffer(void) {
+    PrintBuffer *pb = print_local;
+    if (__builtin_expect(pb != NULL, 1)) {
+        return pb;
+    }
+    pthread_once(&print_once, print_init);
+    if (print_no_buffer || !print_key_ready) {
+        return NULL;
+    }
+    pb = (PrintBuffer *)malloc(sizeof(PrintBuffer));
+    if (pb == NULL) {
+        print_no_buffer = 1;
+        return NULL;
+    }
+    pb->used = 0;
+    pb->depth = 0;
+    pb->sink = NULL;
+    pb->total = 0;
+    print_local = pb;
+    pthread_setspecific(print_key, pb);
+    return pb;
+}
+
+/**
+ * @brief 출력 묶음을 시작하는 함수 (az_print_end와 짝을 이룸)
+ */
+void az_print_begin(void) {
+    PrintBuffer *pb = print_buffer();
+    if (pb != NULL) {
+        pb->depth++;
+    }
+}
+
+/**
+ * @brief 출력 묶음을 끝내고, 가장 바깥 묶음이면 플러시 모드에 따라 버퍼를 내보내는 함수
+ */
+void az_print_end(void) {
+    PrintBuffer *pb = print_local;
+    if (pb == NULL || --pb->depth > 0) {
+        return;
+    }
+
+    switch (__atomic_load_n(&print_mode, __ATOMIC_RELAXED)) {
+        case KPRINT_FLUSH_FULL:
+            break;
+        case KPRINT_FLUSH_LINE:
+            for (size_t i = pb->used; i > 0; i--) {
+                if (pb->data[i - 1] == '\n') {
+                    buffer_drain(pb, i);
+                    break;
+                }
+            }
+            break;
+        default:
+            buffer_drain(pb, pb->used);
+            break;
+    }
+}
+
+/**
+ * @brief 데이터를 호출 스레드의 버퍼에 쓰는 함수 (가득 차면 싱크로 넘김)
+ *
+ * @param data 출력할 데이터
+ * @param len 데이터 길이
+ */
+void az_print_write(const char *data, size_t len) {
+    PrintBuffer *pb = print_buffer();
+
+    if (pb == NULL || (pb->sink == NULL && __atomic_load_n(&print_mode, __ATOMIC_RELAXED) == KPRINT_UNBUFFERED)) {
+        if (pb != NULL) {
+            buffer_drain(pb, pb->used);
+        }
+        // 이전 경로와 같이 바이트마다 출력
+        for (size_t i = 0; i < len; i++) {
+            sink_emit(data + i, 1);
+        }
+        return;
+    }
+
+    while (len > 0) {
+        size_t room = KPRINT_BUFFER_SIZE - pb->used;
+        size_t n = len < room ? len : room;
+        memcpy(pb->data + pb->used, data, n);
+        pb->used += n;
+        data += n;
+        len -= n;
+        if (pb->used == KPRINT_BUFFER_SIZE) {
+            buffer_drain(pb, pb->used);
+        }
+    }
+}
+
+/**
+ * @brief 한 바이트를 출력하는 함수
+ *
+ * 다른 출력 함수 안에서 불리면 버퍼에 저장만 합니다.
+ */
+void kernel_putchar(char c) {
+    PrintBuffer *pb = print_local;
+
+    if (pb != NULL && pb->depth > 0 && pb->used < KPRINT_BUFFER_SIZE - 1 &&
+        (pb->sink != NULL || __atomic_load_n(&print_mode, __ATOMIC_RELAXED) != KPRINT_UNBUFFERED)) {
+        pb->data[pb->used++] = c;
+        return;
+    }
+    az_print_begin();
+    az_print_write(&c, 1);
+    az_print_end();
+}
+
+/**
+ * @brief render가 출력하는 내용을 호출 스레드의 버퍼 대신 sink로 보내는 함수
+ *
+ * 스택에 임시 버퍼를 두고 호출 스레드의 출력 버퍼 자리에 끼워 넣으므로, 대기 중인 출력은 그대로 남습니다.
+ *
+ * @param sink 출력 대상
+ * @param render 출력 함수 (kernel_putchar / az_put* 를 호출)
+ * @param arg render 인자
+ * @return sink로 넘긴 바이트 수
+ */
+size_t az_print_to_sink(const KPrintSink *sink, void (*render)(void *arg), void *arg) {
+    PrintBuffer frame;
+    PrintBuffer *saved = print_local;
+
+    frame.used = 0;
+    frame.depth = 1;
+    frame.sink = sink;
+    frame.total = 0;
+    print_local = &frame;
+    render(arg);
+    buffer_drain(&frame, frame.used);
+    print_local = saved;
+    return frame.total;
+}
+
+/**
+ * @brief 출력 싱크를 바꾸는 함수
+ *
+ * @param sink 새 싱크 (NULL이면 표준 출력)
+ */
+void kernel_print_set_sink(const KPrintSink *sink) {
+    pthread_once(&print_once, print_init);
+    print_flush_local();
+    __atomic_store_n(&print_sink, sink != NULL ? sink : &stdout_sink, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 플러시 모드를 바꾸는 함수
+ *
+ * @param mode 새 모드
+ */
+void kernel_print_set_flush_mode(KPrintFlush mode) {
+    pthread_once(&print_once, print_init);
+    print_flush_local();
+    __atomic_store_n(&print_mode, (int)mode, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 현재 플러시 모드를 반환하는 함수
+ */
+KPrintFlush kernel_print_get_flush_mode(void) {
+    pthread_once(&print_once, print_init);
+    return (KPrintFlush)__atomic_load_n(&print_mode, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 호출 스레드의 버퍼를 싱크로 내보내는 함수
+ */
+void kernel_print_flush(void) {
+    print_flush_local();
+}
@@ -0,0 +1,163 @@
+/*
+ * Kernel Print Sinks
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Ready-made sinks for kernel_print_sink.h: a fixed memory
+ *             buffer with snprintf truncation semantics, a ring buffer that
+ *             keeps the most recent output, and a line callback for
+ *             consoles that want one string per line.
+ */
+
+#include "kernel_pr_he.h"
+#include "kernel_print_sink.h"
+#include <sched.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------------ */
+/* 메모리 버퍼                                                               */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 메모리 버퍼 싱크 문맥을 초기화하는 함수
+ */
+void kernel_print_mem_init(KPrintMem *mem, char *buf, size_t size) {
+    mem->buf = buf;
+    mem->size = buf != NULL ? size : 0;
+    mem->len = 0;
+    if (mem->size > 0) {
+        buf[0] = '\0';
+    }
+}
+
+/**
+ * @brief KPrintMem 싱크 쓰기 함수 (넘치는 부분은 버리고 길이만 셈)
+ */
+void kernel_print_mem_write(void *ctx, const char *data, size_t len) {
+    KPrintMem *mem = (KPrintMem *)ctx;
+
+    if (mem->len + 1 < mem->size) {
+        size_t room = mem->size - 1 - mem->len;
+        size_t n = len < room ? len : room;
+        memcpy(mem->buf + mem->len, data, n);
+        mem->buf[mem->len + n] = '\0';
+    }
+    mem->len += len;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 링 버퍼                                                                   */
+/* ------------------------------------------------------------------------ */
+
+static void ring_lock(KPrintRing *ring) {
+    while (__atomic_exchange_n(&ring->lock, 1, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(&ring->lock, __ATOMIC_RELAXED)) {
+            sched_yield();
+        }
+    }
+}
+
+static void ring_unlock(KPrintRing *ring) {
+    __atomic_store_n(&ring->lock, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 링 버퍼 싱크 문맥을 초기화하는 함수
+ */
+void kernel_print_ring_init(KPrintRing *ring, char *buf, size_t size) {
+    ring->buf = buf;
+    ring->size = size;
+    ring->written = 0;
+    ring->lock = 0;
+}
+
+/**
+ * @brief KPrintRing 싱크 쓰기 함수 (저장소보다 긴 데이터는 끝부분만 남음)
+ */
+void kernel_print_ring_write(void *ctx, const char *data, size_t len) {
+    KPrintRing *ring = (KPrintRing *)ctx;
+
+    if (ring->size == 0) {
+        return;
+    }
+    ring_lock(ring);
+    ring->written += len;
+    if (len > ring->size) {
+        data += len - ring->size;
+        len = ring->size;
+    }
+    // written은 이미 더했으므로 시작 위치는 끝에서 len만큼 앞
+    size_t pos = (size_t)((ring->written - len) % ring->size);
+    size_t first = ring->size - pos < len ? ring->size - pos : len;
+    memcpy(ring->buf + pos, data, first);
+    memcpy(ring->buf, data + first, len - first);
+    ring_unlock(ring);
+}
+
+/**
+ * @brief 링에 남아 있는 최근 출력을 오래된 순서로 복사하는 함수
+ */
+size_t kernel_print_ring_read(KPrintRing *ring, char *out, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    ring_lock(ring);
+    size_t avail = ring->written < ring->size ? (size_t)ring->written : ring->size;
+    size_t n = avail < size - 1 ? avail : size - 1;
+    // 공간이 모자라면 가장 최근 n바이트를 복사
+    size_t pos = (size_t)((ring->written - n) % (ring->size > 0 ? ring->size : 1));
+    size_t first = ring->size - pos < n ? ring->size - pos : n;
+    memcpy(out, ring->buf + pos, first);
+    memcpy(out + first, ring->buf, n - first);
+    ring_unlock(ring);
+    out[n] = '\0';
+    return n;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 줄 단위 콜백                                                              */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 줄 단위 콜백 싱크 문맥을 초기화하는 함수
+ */
+void kernel_print_callback_init(KPrintCallback *cb, void (*func)(const char *str)) {
+    cb->func = func;
+    cb->len = 0;
+}
+
+static void callback_emit(KPrintCallback *cb) {
+    cb->line[cb->len] = '\0';
+    if (cb->func != NULL) {
+        cb->func(cb->line);
+    }
+    cb->len = 0;
+}
+
+/**
+ * @brief KPrintCallback 싱크 쓰기 함수 (줄바꿈마다 한 줄씩 콜백 호출)
+ */
+void kernel_print_callback_write(void *ctx, const char *data, size_t len) {
+    KPrintCallback *cb = (KPrintCallback *)ctx;
+
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == '\n') {
+            callback_emit(cb);
+            continue;
+        }
+        if (cb->len == KPRINT_BUFFER_SIZE - 1) {
+            callback_emit(cb);
+        }
+        cb->line[cb->len++] = data[i];
+    }
+}
+
+/**
+ * @brief 줄바꿈 없이 남은 내용을 콜백으로 넘기는 함수
+ */
+void kernel_print_callback_flush(KPrintCallback *cb) {
+    if (cb->len > 0) {
+        callback_emit(cb);
+    }
+}
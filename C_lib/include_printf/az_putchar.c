@@ -10,10 +10,8 @@
 #include "kernel_pr_he.h"
 #include <unistd.h>
 
-void kernel_putchar(char c)
-{
-    write(1, &c, 1);
-}
+// kernel_putchar는 az_printbuf.c에서 스레드별 출력 버퍼에 기록합니다.
+// (이전에는 write(1, &c, 1)로 바이트마다 시스템 호출을 했음)
 
 
 // 인라인 어셈블리언어.
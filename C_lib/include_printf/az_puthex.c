@@ -11,40 +11,11 @@
 
 void az_puthex(unsigned int n)
 {
-	char c;
-	char *map;
+	char buf[AZ_NUMBUF_SIZE];
+	size_t len;
 
-	map = "0123456789abcdef";
-	if (n)
-	{
-		c = (char)(n & 0xF);
-		n = (n >> 4);
-		az_puthex(n);
-		kernel_putchar(map[(int)c]);
-	}
+	len = az_utoa(n, 16, 0, buf + sizeof(buf));
+	az_print_begin();
+	az_print_write(buf + sizeof(buf) - len, len);
+	az_print_end();
 }
-
-/*
- void	az_puthex(uint64_t nb)
-{
-	char	hex[16];
-	int		tmp;
-	int		i;
-
-	az_bzero(hex, 16);
-	i = 0;
-	while (nb)
-	{
-		tmp = nb % 16;
-		hex[i] = (tmp + (tmp >= 10 ? ('A' - 10) : '0'));
-		nb /= 16;
-		i++;
-	}
-	az_putstr("0x");
-	while (i >= 0)
-	{
-		az_putchar(hex[i]);
-		i--;
-	}
-}
-*/
@@ -11,24 +11,18 @@
 
 void az_putnbr(int n)
 {
+	char buf[AZ_NUMBUF_SIZE];
+	char *end;
+	size_t len;
 	unsigned int i;
 
-	i = 0;
-	if (n >= 0)
-	{
-		i = n;
-	}
-
+	// 음수는 unsigned로 바꿔 INT_MIN도 넘치지 않게 함
+	i = n < 0 ? 0u - (unsigned int)n : (unsigned int)n;
+	end = buf + sizeof(buf);
+	len = az_utoa(i, 10, 0, end);
 	if (n < 0)
-	{
-		i = n * -1;
-		kernel_putchar('-');
-	}
-
-	if (i >= 10)
-	{
-		az_putnbr(i / 10);
-	}
-
-	kernel_putchar((i % 10) + '0');
+		*(end - ++len) = '-';
+	az_print_begin();
+	az_print_write(end - len, len);
+	az_print_end();
 }
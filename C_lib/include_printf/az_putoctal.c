@@ -11,16 +11,17 @@
 
 void az_putoctal(int n)
 {
+	char buf[AZ_NUMBUF_SIZE];
+	char *end;
+	size_t len;
+	unsigned int o;
+
+	o = n < 0 ? 0u - (unsigned int)n : (unsigned int)n;
+	end = buf + sizeof(buf);
+	len = az_utoa(o, 8, 0, end);
 	if (n < 0)
-	{
-		kernel_putchar('-');
-		az_putnbr(-n);
-	}
-	else if (n > 9)
-	{
-		az_putoctal(n / 8);
-		az_putoctal(n % 8);
-	}
-	else
-		kernel_putchar(n + '0');
+		*(end - ++len) = '-';
+	az_print_begin();
+	az_print_write(end - len, len);
+	az_print_end();
 }
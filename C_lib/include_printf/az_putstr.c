@@ -11,12 +11,7 @@
 
 void az_putstr(char const *s)
 {
-	int i;
-
-	i = 0;
-	while (s[i])
-	{
-		kernel_putchar(s[i]);
-		i++;
-	}
+	az_print_begin();
+	az_print_write(s, strlen(s)); // az_strlen은 출력 불가 문자에서 멈추므로 사용하지 않음
+	az_print_end();
 }
@@ -11,11 +11,11 @@
 
 void az_putunsigned(unsigned int n)
 {
-	if (n > 9)
-	{
-		az_putunsigned(n / 10);
-		az_putunsigned(n % 10);
-	}
-	else
-		kernel_putchar(n + '0');
+	char buf[AZ_NUMBUF_SIZE];
+	size_t len;
+
+	len = az_utoa(n, 10, 0, buf + sizeof(buf));
+	az_print_begin();
+	az_print_write(buf + sizeof(buf) - len, len);
+	az_print_end();
 }
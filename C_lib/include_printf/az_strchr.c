@@ -8,31 +8,14 @@
  *
  */
 #include "kernel_pr_he.h"
-#include <stdlib.h>
 
+// 첫 번째 c의 위치, 없으면 NULL (C 라이브러리 strchr와 같음, c가 '\0'이면 끝 위치)
 char *az_strchr(const char *s, int c)
 {
-	char *tmp;
-	int i;
-	int track;
+	const char *p;
 
-	tmp = (char *)malloc(sizeof(char) * az_strlen(s));
-	i = 0;
-	track = 0;
-	if ((char)s[i] == '\0')
+	p = az_simd_strchrnul(s, c);
+	if (*p != (char)c)
 		return (NULL);
-	while (s[i] != '\0' && s[i] != c)
-		i++;
-	if (s[i] != '\0')
-		i = i - 1;
-	while (s[i] != '\0')
-	{
-		tmp[track] = (char)s[i];
-		i++;
-		track++;
-	}
-	tmp[track] = '\0';
-	if (track == 0)
-		return (NULL);
-	return (tmp);
+	return ((char *)p);
 }
@@ -9,18 +9,8 @@
  */
 #include "kernel_pr_he.h"
 
+// 첫 번째로 다른 바이트를 unsigned char로 뺀 값 (부호는 C 라이브러리 strcmp와 같음)
 int az_strcmp(const char *s1, const char *s2)
 {
-	int i;
-	char *my_s1;
-	char *my_s2;
-
-	i = 0;
-	my_s1 = (char *)s1;
-	my_s2 = (char *)s2;
-
-	while (my_s1[i] && my_s2[i] && my_s1[i] == my_s2[i])
-		i++;
-
-	return (my_s1[i] - my_s2[i]);
+	return (az_simd_strcmp(s1, s2));
 }
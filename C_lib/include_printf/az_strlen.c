@@ -9,17 +9,8 @@
  */
 #include "kernel_pr_he.h"
 
+// 앞쪽의 출력 가능 문자(32~126) 개수 (NUL이나 '\n' 같은 제어 문자에서 멈춤, az_strsimd.c)
 size_t az_strlen(const char *s)
 {
-	size_t i;
-
-	i = 0;
-
-	if (s[i] == '\0' || az_isprint(s[i]) == 0)
-		return (0);
-
-	while (s[i] != '\0' && az_isprint(s[i]))
-		i++;
-
-	return (i);
+	return (az_simd_printable(s));
 }
@@ -0,0 +1,502 @@
+/*
+ * SIMD String Primitives
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Vector kernels behind az_strlen, az_strchr, az_chrpos,
+ *             az_strcmp, az_memset and az_bzero, with one scalar fallback.
+ *
+ *               scalar  byte loops (any target)
+ *               sse2    16 bytes per step (x86-64 baseline)
+ *               avx2    32 bytes per step (x86-64, chosen when the CPU has it)
+ *               neon    16 bytes per step (arm64 baseline)
+ *
+ *             Each object file of the Makefile's x86_64 / arm64 pair only
+ *             contains the kernels its compiler targets. The choice is made
+ *             once, on first use, and KERNEL_PRINTF_SIMD=scalar|sse2|avx2|
+ *             neon overrides it.
+ *
+ *             Scans over NUL-terminated strings read whole aligned blocks,
+ *             which may include bytes before the string or after its
+ *             terminator but never cross into another page. strcmp loads
+ *             both strings unaligned, so it only takes a vector step when
+ *             neither load crosses a 4 KB boundary.
+ */
+
+#include "kernel_pr_he.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#define AZ_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define AZ_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* 블록 단위 읽기는 문자열 밖의 바이트를 포함하므로 ASan 검사에서 제외 */
+#if defined(__has_attribute)
+#if __has_attribute(no_sanitize_address)
+#define AZ_NO_ASAN __attribute__((no_sanitize_address))
+#endif
+#endif
+#ifndef AZ_NO_ASAN
+#define AZ_NO_ASAN
+#endif
+
+#define AZ_PAGE_SIZE 4096u
+
+/**
+ * @struct AzStrOps
+ * @brief 한 구현의 문자열 연산 모음
+ */
+typedef struct AzStrOps {
+    const char *name;
+    int (*supported)(void);
+    size_t (*printable)(const char *s);             /**< 앞쪽 출력 가능 문자(32~126) 개수 */
+    const char *(*strchrnul)(const char *s, int c); /**< 첫 c 또는 NUL 위치 */
+    int (*strcmp)(const char *s1, const char *s2);  /**< unsigned char 차이 */
+    void (*memset)(unsigned char *d, int c, size_t n);
+} AzStrOps;
+
+static int always_supported(void) {
+    return 1;
+}
+
+/* 페이지 끝에서 n바이트 이내가 아니면 p부터 n바이트를 읽어도 됨 */
+static inline int page_safe(const char *p, size_t n) {
+    return ((uintptr_t)p & (AZ_PAGE_SIZE - 1)) <= AZ_PAGE_SIZE - n;
+}
+
+/* ------------------------------------------------------------------------ */
+/* scalar                                                                    */
+/* ------------------------------------------------------------------------ */
+
+static size_t scalar_printable(const char *s) {
+    size_t i = 0;
+
+    while ((unsigned char)(s[i] - 32) < 95) {
+        i++;
+    }
+    return i;
+}
+
+static const char *scalar_strchrnul(const char *s, int c) {
+    while (*s != '\0' && *s != (char)c) {
+        s++;
+    }
+    return s;
+}
+
+static int scalar_strcmp(const char *s1, const char *s2) {
+    const unsigned char *a = (const unsigned char *)s1;
+    const unsigned char *b = (const unsigned char *)s2;
+
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a - *b;
+}
+
+static void scalar_memset(unsigned char *d, int c, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        d[i] = (unsigned char)c;
+    }
+}
+
+static const AzStrOps scalar_ops = { "scalar", always_supported, scalar_printable, scalar_strchrnul, scalar_strcmp,
+                                     scalar_memset };
+
+#if AZ_SIMD_X86
+/* ------------------------------------------------------------------------ */
+/* sse2                                                                      */
+/* ------------------------------------------------------------------------ */
+
+/* 출력 가능 문자가 아닌 바이트의 비트 마스크 (부호 있는 비교: 128 이상은 음수라 제외됨) */
+static inline unsigned sse2_stop_printable(__m128i v) {
+    __m128i ok = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(31)), _mm_cmplt_epi8(v, _mm_set1_epi8(127)));
+    return ~(unsigned)_mm_movemask_epi8(ok) & 0xFFFFu;
+}
+
+AZ_NO_ASAN static size_t sse2_printable(const char *s) {
+    size_t off = (uintptr_t)s & 15;
+    const char *p = s - off;
+    unsigned mask = sse2_stop_printable(_mm_load_si128((const __m128i *)p)) >> off;
+
+    if (mask != 0) {
+        return (size_t)__builtin_ctz(mask);
+    }
+    for (;;) {
+        p += 16;
+        mask = sse2_stop_printable(_mm_load_si128((const __m128i *)p));
+        if (mask != 0) {
+            return (size_t)(p - s) + (size_t)__builtin_ctz(mask);
+        }
+    }
+}
+
+AZ_NO_ASAN static const char *sse2_strchrnul(const char *s, int c) {
+    const __m128i vc = _mm_set1_epi8((char)c);
+    const __m128i zero = _mm_setzero_si128();
+    size_t off = (uintptr_t)s & 15;
+    const char *p = s - off;
+    __m128i v = _mm_load_si128((const __m128i *)p);
+    unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, vc), _mm_cmpeq_epi8(v, zero))) >> off;
+
+    if (mask != 0) {
+        return s + __builtin_ctz(mask);
+    }
+    for (;;) {
+        p += 16;
+        v = _mm_load_si128((const __m128i *)p);
+        mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, vc), _mm_cmpeq_epi8(v, zero)));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+}
+
+/* 16바이트 중 다르거나 s1이 끝난 위치의 비트 마스크 */
+AZ_NO_ASAN static inline unsigned sse2_cmp_mask(const char *s1, const char *s2) {
+    __m128i a = _mm_loadu_si128((const __m128i *)s1);
+    __m128i b = _mm_loadu_si128((const __m128i *)s2);
+    unsigned diff = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFFu;
+    return diff | (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128()));
+}
+
+static int sse2_strcmp(const char *s1, const char *s2) {
+    size_t i = 0;
+
+    for (;;) {
+        if (page_safe(s1 + i, 16) && page_safe(s2 + i, 16)) {
+            unsigned mask = sse2_cmp_mask(s1 + i, s2 + i);
+            if (mask != 0) {
+                i += (size_t)__builtin_ctz(mask);
+                return (unsigned char)s1[i] - (unsigned char)s2[i];
+            }
+            i += 16;
+        } else {
+            // 페이지 경계 근처는 한 바이트씩
+            for (size_t end = i + 16; i < end; i++) {
+                if (s1[i] == '\0' || s1[i] != s2[i]) {
+                    return (unsigned char)s1[i] - (unsigned char)s2[i];
+                }
+            }
+        }
+    }
+}
+
+static void sse2_memset(unsigned char *d, int c, size_t n) {
+    if (n < 16) {
+        scalar_memset(d, c, n);
+        return;
+    }
+    const __m128i v = _mm_set1_epi8((char)c);
+    unsigned char *end = d + n - 16;
+    unsigned char *p = (unsigned char *)(((uintptr_t)d + 16) & ~(uintptr_t)15);
+
+    // 앞뒤는 비정렬 저장으로 겹쳐 쓰고 가운데는 정렬 저장
+    _mm_storeu_si128((__m128i *)d, v);
+    for (; p < end; p += 16) {
+        _mm_store_si128((__m128i *)p, v);
+    }
+    _mm_storeu_si128((__m128i *)end, v);
+}
+
+static const AzStrOps sse2_ops = { "sse2", always_supported, sse2_printable, sse2_strchrnul, sse2_strcmp,
+                                   sse2_memset };
+
+/* ------------------------------------------------------------------------ */
+/* avx2                                                                      */
+/* ------------------------------------------------------------------------ */
+
+#define AZ_AVX2 __attribute__((target("avx2")))
+
+static int avx2_supported(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+AZ_AVX2 static inline unsigned avx2_stop_printable(__m256i v) {
+    __m256i ok = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(31)),
+                                  _mm256_cmpgt_epi8(_mm256_set1_epi8(127), v));
+    return ~(unsigned)_mm256_movemask_epi8(ok);
+}
+
+AZ_AVX2 AZ_NO_ASAN static size_t avx2_printable(const char *s) {
+    size_t off = (uintptr_t)s & 31;
+    const char *p = s - off;
+    unsigned mask = avx2_stop_printable(_mm256_load_si256((const __m256i *)p)) >> off;
+
+    if (mask != 0) {
+        return (size_t)__builtin_ctz(mask);
+    }
+    for (;;) {
+        p += 32;
+        mask = avx2_stop_printable(_mm256_load_si256((const __m256i *)p));
+        if (mask != 0) {
+            return (size_t)(p - s) + (size_t)__builtin_ctz(mask);
+        }
+    }
+}
+
+AZ_AVX2 AZ_NO_ASAN static const char *avx2_strchrnul(const char *s, int c) {
+    const __m256i vc = _mm256_set1_epi8((char)c);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t off = (uintptr_t)s & 31;
+    const char *p = s - off;
+    __m256i v = _mm256_load_si256((const __m256i *)p);
+    unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, vc),
+                                                                   _mm256_cmpeq_epi8(v, zero))) >> off;
+
+    if (mask != 0) {
+        return s + __builtin_ctz(mask);
+    }
+    for (;;) {
+        p += 32;
+        v = _mm256_load_si256((const __m256i *)p);
+        mask = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, vc), _mm256_cmpeq_epi8(v, zero)));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+    }
+}
+
+AZ_AVX2 AZ_NO_ASAN static int avx2_strcmp(const char *s1, const char *s2) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (;;) {
+        if (page_safe(s1 + i, 32) && page_safe(s2 + i, 32)) {
+            __m256i a = _mm256_loadu_si256((const __m256i *)(s1 + i));
+            __m256i b = _mm256_loadu_si256((const __m256i *)(s2 + i));
+            unsigned diff = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+            unsigned mask = diff | (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero));
+            if (mask != 0) {
+                i += (size_t)__builtin_ctz(mask);
+                return (unsigned char)s1[i] - (unsigned char)s2[i];
+            }
+            i += 32;
+        } else if (page_safe(s1 + i, 16) && page_safe(s2 + i, 16)) {
+            unsigned mask = sse2_cmp_mask(s1 + i, s2 + i);
+            if (mask != 0) {
+                i += (size_t)__builtin_ctz(mask);
+                return (unsigned char)s1[i] - (unsigned char)s2[i];
+            }
+            i += 16;
+        } else {
+            // 16바이트도 페이지를 넘으면 한 바이트씩
+            for (size_t end = i + 16; i < end; i++) {
+                if (s1[i] == '\0' || s1[i] != s2[i]) {
+                    return (unsigned char)s1[i] - (unsigned char)s2[i];
+                }
+            }
+        }
+    }
+}
+
+AZ_AVX2 static void avx2_memset(unsigned char *d, int c, size_t n) {
+    if (n < 32) {
+        sse2_memset(d, c, n);
+        return;
+    }
+    const __m256i v = _mm256_set1_epi8((char)c);
+    unsigned char *end = d + n - 32;
+    unsigned char *p = (unsigned char *)(((uintptr_t)d + 32) & ~(uintptr_t)31);
+
+    _mm256_storeu_si256((__m256i *)d, v);
+    for (; p < end; p += 32) {
+        _mm256_store_si256((__m256i *)p, v);
+    }
+    _mm256_storeu_si256((__m256i *)end, v);
+}
+
+static const AzStrOps avx2_ops = { "avx2", avx2_supported, avx2_printable, avx2_strchrnul, avx2_strcmp,
+                                   avx2_memset };
+#endif /* AZ_SIMD_X86 */
+
+#if AZ_SIMD_NEON
+/* ------------------------------------------------------------------------ */
+/* neon                                                                      */
+/* ------------------------------------------------------------------------ */
+
+/* 비교 결과를 바이트당 4비트 마스크로 줄임 (movemask 대용) */
+static inline uint64_t neon_mask(uint8x16_t cmp) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+}
+
+static inline uint64_t neon_stop_printable(uint8x16_t v) {
+    return neon_mask(vcgeq_u8(vsubq_u8(v, vdupq_n_u8(32)), vdupq_n_u8(95)));
+}
+
+AZ_NO_ASAN static size_t neon_printable(const char *s) {
+    size_t off = (uintptr_t)s & 15;
+    const char *p = s - off;
+    uint64_t mask = neon_stop_printable(vld1q_u8((const uint8_t *)p)) >> (off * 4);
+
+    if (mask != 0) {
+        return (size_t)(__builtin_ctzll(mask) >> 2);
+    }
+    for (;;) {
+        p += 16;
+        mask = neon_stop_printable(vld1q_u8((const uint8_t *)p));
+        if (mask != 0) {
+            return (size_t)(p - s) + (size_t)(__builtin_ctzll(mask) >> 2);
+        }
+    }
+}
+
+static inline uint64_t neon_chr_or_nul(uint8x16_t v, uint8x16_t vc) {
+    return neon_mask(vorrq_u8(vceqq_u8(v, vc), vceqzq_u8(v)));
+}
+
+AZ_NO_ASAN static const char *neon_strchrnul(const char *s, int c) {
+    const uint8x16_t vc = vdupq_n_u8((uint8_t)c);
+    size_t off = (uintptr_t)s & 15;
+    const char *p = s - off;
+    uint64_t mask = neon_chr_or_nul(vld1q_u8((const uint8_t *)p), vc) >> (off * 4);
+
+    if (mask != 0) {
+        return s + (__builtin_ctzll(mask) >> 2);
+    }
+    for (;;) {
+        p += 16;
+        mask = neon_chr_or_nul(vld1q_u8((const uint8_t *)p), vc);
+        if (mask != 0) {
+            return p + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+}
+
+AZ_NO_ASAN static int neon_strcmp(const char *s1, const char *s2) {
+    size_t i = 0;
+
+    for (;;) {
+        if (page_safe(s1 + i, 16) && page_safe(s2 + i, 16)) {
+            uint8x16_t a = vld1q_u8((const uint8_t *)(s1 + i));
+            uint8x16_t b = vld1q_u8((const uint8_t *)(s2 + i));
+            uint64_t mask = neon_mask(vorrq_u8(vmvnq_u8(vceqq_u8(a, b)), vceqzq_u8(a)));
+            if (mask != 0) {
+                i += (size_t)(__builtin_ctzll(mask) >> 2);
+                return (unsigned char)s1[i] - (unsigned char)s2[i];
+            }
+            i += 16;
+        } else {
+            for (size_t end = i + 16; i < end; i++) {
+                if (s1[i] == '\0' || s1[i] != s2[i]) {
+                    return (unsigned char)s1[i] - (unsigned char)s2[i];
+                }
+            }
+        }
+    }
+}
+
+static void neon_memset(unsigned char *d, int c, size_t n) {
+    if (n < 16) {
+        scalar_memset(d, c, n);
+        return;
+    }
+    const uint8x16_t v = vdupq_n_u8((uint8_t)c);
+    unsigned char *end = d + n - 16;
+    unsigned char *p = (unsigned char *)(((uintptr_t)d + 16) & ~(uintptr_t)15);
+
+    vst1q_u8(d, v);
+    for (; p < end; p += 16) {
+        vst1q_u8(p, v);
+    }
+    vst1q_u8(end, v);
+}
+
+static const AzStrOps neon_ops = { "neon", always_supported, neon_printable, neon_strchrnul, neon_strcmp,
+                                   neon_memset };
+#endif /* AZ_SIMD_NEON */
+
+/* ------------------------------------------------------------------------ */
+/* 선택                                                                      */
+/* ------------------------------------------------------------------------ */
+
+/* 뒤쪽일수록 우선 */
+static const AzStrOps *const str_impls[] = {
+    &scalar_ops,
+#if AZ_SIMD_X86
+    &sse2_ops,
+    &avx2_ops,
+#endif
+#if AZ_SIMD_NEON
+    &neon_ops,
+#endif
+};
+
+#define AZ_IMPL_COUNT (sizeof(str_impls) / sizeof(str_impls[0]))
+
+static const AzStrOps *str_ops = NULL;
+
+static const AzStrOps *find_impl(const char *name) {
+    for (size_t i = 0; i < AZ_IMPL_COUNT; i++) {
+        if (strcmp(str_impls[i]->name, name) == 0) {
+            return str_impls[i]->supported() ? str_impls[i] : NULL;
+        }
+    }
+    return NULL;
+}
+
+static const AzStrOps *str_resolve(void) {
+    const AzStrOps *ops = __atomic_load_n(&str_ops, __ATOMIC_ACQUIRE);
+
+    if (__builtin_expect(ops == NULL, 0)) {
+        const char *env = getenv("KERNEL_PRINTF_SIMD");
+        if (env != NULL) {
+            ops = find_impl(env);
+        }
+        for (size_t i = AZ_IMPL_COUNT; ops == NULL && i > 0; i--) {
+            if (str_impls[i - 1]->supported()) {
+                ops = str_impls[i - 1];
+            }
+        }
+        // 여러 스레드가 동시에 골라도 결과는 같음
+        __atomic_store_n(&str_ops, ops, __ATOMIC_RELEASE);
+    }
+    return ops;
+}
+
+/**
+ * @brief 사용 중인 구현 이름을 반환하는 함수 ("scalar", "sse2", "avx2", "neon")
+ */
+const char *az_simd_name(void) {
+    return str_resolve()->name;
+}
+
+/**
+ * @brief 구현을 이름으로 고르는 함수 (벤치마크와 비교 검사용)
+ *
+ * @param name 구현 이름
+ * @return 성공하면 0, 이 빌드나 CPU에서 쓸 수 없으면 -1
+ */
+int az_simd_select(const char *name) {
+    const AzStrOps *ops = find_impl(name);
+
+    if (ops == NULL) {
+        return -1;
+    }
+    __atomic_store_n(&str_ops, ops, __ATOMIC_RELEASE);
+    return 0;
+}
+
+size_t az_simd_printable(const char *s) {
+    return str_resolve()->printable(s);
+}
+
+const char *az_simd_strchrnul(const char *s, int c) {
+    return str_resolve()->strchrnul(s, c);
+}
+
+int az_simd_strcmp(const char *s1, const char *s2) {
+    return str_resolve()->strcmp(s1, s2);
+}
+
+void az_simd_memset(void *b, int c, size_t len) {
+    str_resolve()->memset((unsigned char *)b, c, len);
+}
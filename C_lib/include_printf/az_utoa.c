@@ -0,0 +1,155 @@
+/*
+ * Integer to Digits
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Allocation-free integer conversion shared by the az_put*
+ *             helpers and the compiled kernel_printf path. Digits are
+ *             written backwards into the caller's buffer two at a time from
+ *             lookup tables (one division by 100 per pair in decimal, one
+ *             table load per byte in hex), so a 64-bit value needs at most
+ *             ten divisions and no recursion.
+ */
+
+#include "kernel_pr_he.h"
+#include <string.h>
+
+/* 00부터 99까지 10진수 두 자리 */
+static const char dec_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* 바이트 하나의 16진수 두 자리 (소문자 / 대문자) */
+static const char hex_lower[513] =
+    "000102030405060708090a0b0c0d0e0f"
+    "101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f"
+    "303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f"
+    "505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f"
+    "707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f"
+    "909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+    "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+    "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+    "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+static const char hex_upper[513] =
+    "000102030405060708090A0B0C0D0E0F"
+    "101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F"
+    "303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F"
+    "505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F"
+    "707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F"
+    "909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+    "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+    "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+    "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+static size_t utoa_dec32(uint32_t v, char *end) {
+    char *p = end;
+
+    while (v >= 100) {
+        uint32_t pair = (v % 100) * 2;
+        v /= 100;
+        p -= 2;
+        memcpy(p, dec_pairs + pair, 2);
+    }
+    if (v >= 10) {
+        p -= 2;
+        memcpy(p, dec_pairs + v * 2, 2);
+    } else {
+        *--p = (char)('0' + v);
+    }
+    return (size_t)(end - p);
+}
+
+static size_t utoa_dec(uintmax_t v, char *end) {
+    char *p = end;
+
+    // 32비트에 들어올 때까지만 64비트 나눗셈을 씀
+    while (v > UINT32_MAX) {
+        uint32_t pair = (uint32_t)(v % 100) * 2;
+        v /= 100;
+        p -= 2;
+        memcpy(p, dec_pairs + pair, 2);
+    }
+    return (size_t)(end - p) + utoa_dec32((uint32_t)v, p);
+}
+
+static size_t utoa_hex(uintmax_t v, int upper, char *end) {
+    const char *pairs = upper ? hex_upper : hex_lower;
+    char *p = end;
+
+    while (v > 0xFF) {
+        p -= 2;
+        memcpy(p, pairs + (v & 0xFF) * 2, 2);
+        v >>= 8;
+    }
+    if (v > 0xF) {
+        p -= 2;
+        memcpy(p, pairs + v * 2, 2);
+    } else {
+        *--p = pairs[v * 2 + 1];
+    }
+    return (size_t)(end - p);
+}
+
+/**
+ * @brief 부호 없는 정수를 end 바로 앞까지 거꾸로 채우는 함수
+ *
+ * 버퍼는 end 앞쪽으로 AZ_NUMBUF_SIZE 바이트면 충분하며 NUL은 쓰지 않습니다. 0은 "0" 한 자리입니다.
+ *
+ * @param value 변환할 값
+ * @param base 진법 (2~36, 10과 16은 표를 사용)
+ * @param upper 10보다 큰 자리를 대문자로 쓸지 여부
+ * @param end 마지막 자리 다음 위치
+ * @return 쓴 자리 수 (첫 자리는 end - 반환값)
+ */
+size_t az_utoa(uintmax_t value, unsigned base, int upper, char *end) {
+    static const char lower_digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    static const char upper_digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    const char *digits = upper ? upper_digits : lower_digits;
+    char *p = end;
+
+    if (base == 10) {
+        return utoa_dec(value, end);
+    }
+    if (base == 16) {
+        return utoa_hex(value, upper, end);
+    }
+    if (base == 8) {
+        do {
+            *--p = (char)('0' + (value & 7));
+            value >>= 3;
+        } while (value != 0);
+        return (size_t)(end - p);
+    }
+    if (base < 2 || base > 36) {
+        return 0;
+    }
+    do {
+        *--p = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    return (size_t)(end - p);
+}
@@ -9,6 +9,7 @@
  */
 #ifndef STDIO_H
 #define STDIO_H
+#include <stdint.h>
 #include <string.h>
 #include <wchar.h>
 #include <stdlib.h>
@@ -20,6 +21,34 @@ extern "C"
 #endif
     void kernel_putchar(char c);
 
+    // 스레드별 출력 버퍼 (az_printbuf.c, kernel_print_sink.h 참고)
+    void az_print_begin(void);
+    void az_print_end(void);
+    void az_print_write(const char *s, size_t len);
+    struct KPrintSink;
+    size_t az_print_to_sink(const struct KPrintSink *sink, void (*render)(void *arg), void *arg);
+
+    // 할당 없는 정수 변환 (az_utoa.c), 64비트 2진수와 부호까지 AZ_NUMBUF_SIZE 바이트면 충분
+#define AZ_NUMBUF_SIZE 72
+    size_t az_utoa(uintmax_t value, unsigned base, int upper, char *end);
+
+    // 실수 변환 (az_dtoa.c), flags는 AZ_FLAG_* 조합
+#define AZ_FLAG_LEFT  0x01u
+#define AZ_FLAG_PLUS  0x02u
+#define AZ_FLAG_SPACE 0x04u
+#define AZ_FLAG_ZERO  0x08u
+#define AZ_FLAG_ALT   0x10u
+    void az_putfloat(double value, char conv, int width, int precision, unsigned flags);
+
+    // 문자열 기본 연산의 SIMD 구현 (az_strsimd.c): scalar / sse2 / avx2 / neon 중 하나를 처음 사용할 때 고름
+    // KERNEL_PRINTF_SIMD=scalar|sse2|avx2|neon으로 바꿀 수 있음
+    const char *az_simd_name(void);
+    int az_simd_select(const char *name);
+    size_t az_simd_printable(const char *s);
+    const char *az_simd_strchrnul(const char *s, int c);
+    int az_simd_strcmp(const char *s1, const char *s2);
+    void az_simd_memset(void *b, int c, size_t len);
+
     void az_putoctal(int n);
     void az_putunsigned(unsigned int n);
     void *az_memalloc(size_t size);
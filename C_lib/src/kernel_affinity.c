@@ -0,0 +1,443 @@
+/*
+ * Kernel Thread Placement
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the placement API declared in kernel_affinity.h.
+ *             The topology (CPU to NUMA node, SMT sibling rank) is read once
+ *             from sysfs, so no libnuma dependency is needed.
+ */
+
+#include "kernel_affinity.h"
+#include "kernel_engine.h"
+#include "kernel_trace.h"
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+/* mbind 정책 값 (linux/mempolicy.h) */
+#define KNUMA_MPOL_PREFERRED 1
+
+static pthread_once_t topology_once = PTHREAD_ONCE_INIT;
+static int topology_nodes = 1;
+static int topology_cpus = 1;
+static unsigned char cpu_node_map[KPLACEMENT_MAX_CPUS];
+static unsigned char cpu_sibling_rank[KPLACEMENT_MAX_CPUS];
+
+/**
+ * @brief "0-3,8,10-11" 형식의 CPU 목록을 집합으로 바꾸는 함수
+ *
+ * @return 집합에 들어간 CPU 수, 형식 오류 시 -1
+ */
+static int parse_cpulist(const char *list, unsigned char *set) {
+    const char *p = list;
+    int count = 0;
+
+    memset(set, 0, KPLACEMENT_MAX_CPUS);
+    while (*p != '\0' && *p != '\n') {
+        char *end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+
+        if (end == p || first < 0) {
+            return -1;
+        }
+        p = end;
+        if (*p == '-') {
+            p++;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first) {
+                return -1;
+            }
+            p = end;
+        }
+        if (last >= KPLACEMENT_MAX_CPUS) {
+            return -1;
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            if (!set[cpu]) {
+                set[cpu] = 1;
+                count++;
+            }
+        }
+        if (*p == ',') {
+            p++;
+        } else if (*p != '\0' && *p != '\n') {
+            return -1;
+        }
+    }
+    return count;
+}
+
+#ifdef __linux__
+static int read_sysfs_line(const char *path, char *buf, size_t size) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    char *line = fgets(buf, (int)size, fp);
+    fclose(fp);
+    return line != NULL ? 0 : -1;
+}
+#endif
+
+/**
+ * @brief sysfs에서 CPU별 NUMA 노드와 SMT 형제 순위를 읽는 함수
+ */
+static void topology_init(void) {
+    long online = sysconf(_SC_NPROCESSORS_CONF);
+    topology_cpus = online > 0 ? (int)(online < KPLACEMENT_MAX_CPUS ? online : KPLACEMENT_MAX_CPUS) : 1;
+
+#ifdef __linux__
+    char path[128];
+    char line[4096];
+    unsigned char set[KPLACEMENT_MAX_CPUS];
+
+    for (int node = 0; node < KNUMA_MAX_NODES; node++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        if (read_sysfs_line(path, line, sizeof(line)) != 0 || parse_cpulist(line, set) < 0) {
+            continue;
+        }
+        for (int cpu = 0; cpu < KPLACEMENT_MAX_CPUS; cpu++) {
+            if (set[cpu]) {
+                cpu_node_map[cpu] = (unsigned char)node;
+                if (cpu >= topology_cpus) {
+                    topology_cpus = cpu + 1;
+                }
+            }
+        }
+        topology_nodes = node + 1;
+    }
+
+    // 같은 물리 코어의 첫 번째 CPU가 아니면 SMT 형제로 간주
+    for (int cpu = 0; cpu < topology_cpus; cpu++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+        if (read_sysfs_line(path, line, sizeof(line)) == 0) {
+            cpu_sibling_rank[cpu] = atoi(line) != cpu;
+        }
+    }
+#endif
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "CPU 토폴로지 (CPU: %d, NUMA 노드: %d)", topology_cpus, topology_nodes);
+}
+
+/**
+ * @brief 프로세스가 실행될 수 있는 CPU 집합을 구하는 함수
+ */
+static int allowed_cpus(unsigned char *set) {
+    int count = 0;
+
+    memset(set, 0, KPLACEMENT_MAX_CPUS);
+#ifdef __linux__
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < KPLACEMENT_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &mask)) {
+                set[cpu] = 1;
+                count++;
+            }
+        }
+        return count;
+    }
+#endif
+    for (int cpu = 0; cpu < topology_cpus; cpu++) {
+        set[cpu] = 1;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief 정책과 CPU 집합으로 배치를 만드는 함수
+ *
+ * @param placement 결과를 저장할 위치
+ * @param policy 배치 정책
+ * @param cpulist 허용 CPU 목록 (프로세스 affinity 마스크와의 교집합, NULL이면 마스크 전체)
+ * @return 성공 시 0, 목록이 잘못되었거나 비었으면 -1
+ */
+int kplacement_init(KPlacement *placement, KPlacementPolicy policy, const char *cpulist) {
+    unsigned char set[KPLACEMENT_MAX_CPUS];
+    int count;
+
+    pthread_once(&topology_once, topology_init);
+    placement->policy = KPLACE_NONE;
+    placement->num_cpus = 0;
+    if (policy == KPLACE_NONE) {
+        return 0;
+    }
+
+    count = allowed_cpus(set);
+    if (cpulist != NULL) {
+        // 목록 중 프로세스가 실제로 실행될 수 있는 CPU만 사용
+        unsigned char listed[KPLACEMENT_MAX_CPUS];
+        if (parse_cpulist(cpulist, listed) < 0) {
+            return -1;
+        }
+        count = 0;
+        for (int cpu = 0; cpu < KPLACEMENT_MAX_CPUS; cpu++) {
+            set[cpu] = set[cpu] && listed[cpu];
+            count += set[cpu];
+        }
+    }
+    if (count <= 0) {
+        return -1;
+    }
+
+    int n = 0;
+    if (policy == KPLACE_COMPACT) {
+        // 노드 순서, 노드 안에서는 CPU 번호 순서
+        for (int node = 0; node < topology_nodes; node++) {
+            for (int cpu = 0; cpu < KPLACEMENT_MAX_CPUS; cpu++) {
+                if (set[cpu] && cpu_node_map[cpu] == node) {
+                    placement->order[n++] = (int16_t)cpu;
+                }
+            }
+        }
+    } else {
+        // 노드마다 물리 코어를 먼저, SMT 형제를 나중에 나열한 뒤 노드를 번갈아 선택
+        int16_t *per_node = (int16_t *)malloc(sizeof(int16_t) * (size_t)topology_nodes * KPLACEMENT_MAX_CPUS);
+        int node_count[KNUMA_MAX_NODES] = { 0 };
+        int node_pos[KNUMA_MAX_NODES] = { 0 };
+
+        if (per_node == NULL) {
+            return -1;
+        }
+        for (int rank = 0; rank < 2; rank++) {
+            for (int cpu = 0; cpu < KPLACEMENT_MAX_CPUS; cpu++) {
+                if (set[cpu] && cpu_sibling_rank[cpu] == rank) {
+                    int node = cpu_node_map[cpu];
+                    per_node[node * KPLACEMENT_MAX_CPUS + node_count[node]++] = (int16_t)cpu;
+                }
+            }
+        }
+        while (n < count) {
+            for (int node = 0; node < topology_nodes; node++) {
+                if (node_pos[node] < node_count[node]) {
+                    placement->order[n++] = per_node[node * KPLACEMENT_MAX_CPUS + node_pos[node]++];
+                }
+            }
+        }
+        free(per_node);
+    }
+
+    placement->policy = policy;
+    placement->num_cpus = n;
+    return 0;
+}
+
+/**
+ * @brief "policy[:cpulist]" 문자열로 배치를 만드는 함수
+ *
+ * @param placement 결과를 저장할 위치
+ * @param spec 배치 문자열
+ * @return 성공 시 0, 형식 오류 시 -1
+ */
+int kplacement_parse(KPlacement *placement, const char *spec) {
+    static const struct {
+        const char *name;
+        KPlacementPolicy policy;
+    } policies[] = { { "none", KPLACE_NONE }, { "compact", KPLACE_COMPACT }, { "spread", KPLACE_SPREAD } };
+
+    if (spec == NULL) {
+        return kplacement_init(placement, KPLACE_NONE, NULL);
+    }
+    if (isdigit((unsigned char)spec[0])) {
+        return kplacement_init(placement, KPLACE_COMPACT, spec);
+    }
+
+    const char *colon = strchr(spec, ':');
+    size_t name_len = colon != NULL ? (size_t)(colon - spec) : strlen(spec);
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (strlen(policies[i].name) == name_len && strncmp(spec, policies[i].name, name_len) == 0) {
+            return kplacement_init(placement, policies[i].policy, colon != NULL ? colon + 1 : NULL);
+        }
+    }
+    kplacement_init(placement, KPLACE_NONE, NULL);
+    return -1;
+}
+
+/**
+ * @brief 환경 변수로 배치를 만드는 함수
+ *
+ * @param placement 결과를 저장할 위치
+ * @param name 환경 변수 이름 (없으면 KERNEL_PLACEMENT 사용)
+ * @return 설정된 배치가 있으면 0, 없거나 잘못되었으면 -1
+ */
+int kplacement_from_env(KPlacement *placement, const char *name) {
+    const char *spec = name != NULL ? getenv(name) : NULL;
+
+    if (spec == NULL) {
+        name = "KERNEL_PLACEMENT";
+        spec = getenv(name);
+    }
+    if (spec == NULL) {
+        kplacement_init(placement, KPLACE_NONE, NULL);
+        return -1;
+    }
+    if (kplacement_parse(placement, spec) != 0) {
+        errno = EINVAL;
+        kernel_errMsg("잘못된 스레드 배치 설정: %s=%s", name, spec);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief i번째 스레드가 고정될 CPU를 반환하는 함수
+ *
+ * @param placement 배치
+ * @param index 스레드 순번
+ * @return CPU 번호, 고정하지 않으면 -1
+ */
+int kplacement_cpu(const KPlacement *placement, int index) {
+    if (placement == NULL || placement->policy == KPLACE_NONE || placement->num_cpus <= 0 || index < 0) {
+        return -1;
+    }
+    return placement->order[index % placement->num_cpus];
+}
+
+/**
+ * @brief 호출 스레드를 i번째 자리에 고정하는 함수
+ *
+ * @param placement 배치
+ * @param index 스레드 순번
+ * @return 성공 시 0, 실패 시 오류 번호
+ */
+int kplacement_apply(const KPlacement *placement, int index) {
+    int cpu = kplacement_cpu(placement, index);
+    if (cpu < 0) {
+        return 0;
+    }
+
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+    if (err != 0) {
+        KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_WARN, "CPU %d 고정 실패 (%s)", cpu, strerror(err));
+        return err;
+    }
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "스레드 %d를 CPU %d (노드 %d)에 고정", index, cpu, kernel_cpu_node(cpu));
+#endif
+    return 0;
+}
+
+/**
+ * @brief 배치를 사람이 읽을 수 있는 문자열로 만드는 함수
+ *
+ * @param placement 배치
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int kplacement_format(const KPlacement *placement, char *buf, size_t size) {
+    static const char *names[] = { "none", "compact", "spread" };
+    size_t len = 0;
+    int n = snprintf(buf, size, "%s", names[placement->policy]);
+
+    if (n > 0) {
+        len += (size_t)n;
+    }
+    for (int i = 0; i < placement->num_cpus; i++) {
+        n = snprintf(buf + (len < size ? len : size), len < size ? size - len : 0, "%s%d",
+                     i == 0 ? ": " : ",", placement->order[i]);
+        if (n > 0) {
+            len += (size_t)n;
+        }
+    }
+    return (int)len;
+}
+
+/**
+ * @brief NUMA 노드 수를 반환하는 함수
+ */
+int kernel_numa_nodes(void) {
+    pthread_once(&topology_once, topology_init);
+    return topology_nodes;
+}
+
+/**
+ * @brief CPU가 속한 NUMA 노드를 반환하는 함수
+ *
+ * @param cpu CPU 번호
+ * @return 노드 번호 (알 수 없으면 0)
+ */
+int kernel_cpu_node(int cpu) {
+    pthread_once(&topology_once, topology_init);
+    if (cpu < 0 || cpu >= KPLACEMENT_MAX_CPUS) {
+        return 0;
+    }
+    return cpu_node_map[cpu];
+}
+
+/**
+ * @brief 호출 스레드가 현재 실행 중인 NUMA 노드를 반환하는 함수
+ */
+int kernel_current_node(void) {
+#ifdef __linux__
+    return kernel_cpu_node(sched_getcpu());
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 지정한 NUMA 노드에 0으로 초기화된 메모리를 할당하는 함수
+ *
+ * @param size 할당 크기
+ * @param node NUMA 노드 (음수면 노드를 지정하지 않음)
+ * @return 할당된 메모리, 실패 시 NULL
+ */
+void *kernel_numa_alloc(size_t size, int node) {
+    void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+
+#if defined(__linux__) && defined(SYS_mbind)
+    // 페이지가 아직 할당되지 않았으므로 첫 접근 시 선호 노드에서 할당됨
+    if (node >= 0 && node < KNUMA_MAX_NODES && kernel_numa_nodes() > 1) {
+        unsigned long nodemask[(KNUMA_MAX_NODES + 8 * sizeof(unsigned long) - 1) / (8 * sizeof(unsigned long))] = { 0 };
+        nodemask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+        if (syscall(SYS_mbind, ptr, size, KNUMA_MPOL_PREFERRED, nodemask, (unsigned long)KNUMA_MAX_NODES + 1, 0) != 0) {
+            KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_WARN, "NUMA 노드 %d 지정 실패 (%s)", node, strerror(errno));
+        }
+    }
+#else
+    (void)node;
+#endif
+    return ptr;
+}
+
+/**
+ * @brief 호출 스레드의 NUMA 노드에 메모리를 할당하는 함수
+ *
+ * @param size 할당 크기
+ * @return 할당된 메모리, 실패 시 NULL
+ */
+void *kernel_numa_alloc_local(size_t size) {
+    return kernel_numa_alloc(size, kernel_current_node());
+}
+
+/**
+ * @brief kernel_numa_alloc으로 할당한 메모리를 해제하는 함수
+ *
+ * @param ptr 해제할 메모리
+ * @param size 할당 시 크기
+ */
+void kernel_numa_free(void *ptr, size_t size) {
+    if (ptr != NULL) {
+        munmap(ptr, size);
+    }
+}
@@ -7,6 +7,12 @@
 #include <stdarg.h>
 #include "kernel_smartptr.h"
 #include "kernel_uniqueptr.h"
+#include "kernel_epoch.h"
+#include "kernel_trace.h"
+#include "kernel_mutex.h"
+#include "kernel_rwlock.h"
+#include "kernel_affinity.h"
+#include "kernel_timer.h"
 #include <fcntl.h>
 #include <pthread.h>
 
@@ -61,7 +67,9 @@ typedef struct {
     int client_id;               /**< 클라이언트 ID */
     int room_id;                 /**< 클라이언트가 참여한 채팅방 ID */
     char username[BUFFER_SIZE];  /**< 클라이언트 사용자명 */
-    pthread_mutex_t *client_mutex; /**< 클라이언트 별 뮤텍스 */
+    KMutex *client_mutex;        /**< 클라이언트 별 뮤텍스 (소켓 쓰기 직렬화) */
+    KTimer idle_timer;           /**< 유휴 연결 정리 타이머 (수신할 때마다 연장) */
+    int refs;                    /**< 참조 수 (슬롯 1 + 에포크 밖에서 쓰는 스레드 수) */
 } ClientInfo;
 
 /**
@@ -71,6 +79,177 @@ typedef struct {
  */
 SmartPtr client_infos[MAX_CLIENTS];
 
+/**
+ * @brief 클라이언트 소켓에 메시지 전체를 쓰는 함수
+ *
+ * 여러 스레드가 같은 클라이언트에게 동시에 브로드캐스트해도 메시지가 섞이지 않도록
+ * client_mutex로 쓰기를 직렬화합니다. 상대가 읽지 않으면 블록될 수 있으므로 에포크 읽기
+ * 구역 안에서 호출하면 안 되며, client_get으로 참조를 잡고 구역을 나온 뒤 호출합니다.
+ * 블록된 쓰기는 소켓을 shutdown하면 풀립니다.
+ *
+ * @param client_info 대상 클라이언트
+ * @param message 보낼 메시지
+ * @param len 메시지 길이
+ * @return void
+ */
+static void send_to_client(ClientInfo *client_info, const char *message, size_t len) {
+    size_t sent = 0;
+
+    kmutex_lock(client_info->client_mutex);
+    while (sent < len) {
+        ssize_t n = send(client_info->client_fd, message + sent, len - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;
+        }
+        sent += (size_t)n;
+    }
+    kmutex_unlock(client_info->client_mutex);
+}
+
+/**
+ * @brief 클라이언트 정보의 가변 필드(username, room_id)를 보호하는 잠금
+ *
+ * 슬롯 포인터의 게시/회수는 에포크로 처리하고, 이 잠금은 client_handler가 필드를
+ * 바꾸는 동안 조회 쪽이 찢어진 값을 읽지 않도록 합니다. 조회는 서로 막지 않습니다.
+ */
+static KRWLock client_table_lock;
+static pthread_once_t client_table_lock_once = PTHREAD_ONCE_INIT;
+
+static void client_table_lock_init(void) {
+    krwlock_init(&client_table_lock, "chat.client_table");
+}
+
+static KRWLock *client_table(void) {
+    pthread_once(&client_table_lock_once, client_table_lock_init);
+    return &client_table_lock;
+}
+
+/**
+ * @brief 채팅 서버 스레드 배치
+ *
+ * 수신(accept) 스레드는 0번, 클라이언트 처리 스레드는 클라이언트 ID 번째 자리에 고정됩니다.
+ * chat_server_set_placement로 지정하지 않으면 서버 시작 시 KERNEL_CHAT_PLACEMENT를 읽습니다.
+ */
+static KPlacement chat_placement;
+static int chat_placement_set = 0;
+
+/**
+ * @brief 채팅 서버 스레드 배치 설정 함수 (서버 시작 전에 호출)
+ *
+ * @param placement 스레드 배치 (NULL이면 설정 해제)
+ */
+void chat_server_set_placement(const KPlacement *placement) {
+    chat_placement_set = placement != NULL;
+    if (placement != NULL) {
+        chat_placement = *placement;
+    }
+}
+
+/* 기본 유휴 연결 제한 시간 (초) */
+#define CHAT_DEFAULT_IDLE_TIMEOUT 600
+
+/**
+ * @brief 유휴 연결 제한 시간 (밀리초, 0이면 정리하지 않음, 음수면 서버 시작 시 환경 변수에서 읽음)
+ */
+static long long chat_idle_timeout_ms = -1;
+
+/**
+ * @brief 유휴 연결 제한 시간 설정 함수 (서버 시작 전에 호출)
+ *
+ * 설정하지 않으면 KERNEL_CHAT_IDLE_TIMEOUT 환경 변수(초) 또는 기본값을 사용합니다.
+ *
+ * @param seconds 아무것도 받지 못한 채 이 시간이 지나면 연결을 끊음 (0이면 끊지 않음)
+ */
+void chat_server_set_idle_timeout(unsigned int seconds) {
+    chat_idle_timeout_ms = (long long)seconds * 1000;
+}
+
+/**
+ * @brief 유휴 시간이 초과된 클라이언트의 연결을 끊는 타이머 콜백 (스레드 풀에서 실행)
+ *
+ * 소켓만 shutdown하고, 정리는 read가 반환된 client_handler가 retire_client로 수행합니다.
+ * retire_client가 이 콜백이 끝나기를 기다린 뒤 해제하므로 client_info는 유효합니다.
+ * 읽지 않는 상대에게 풀 스레드가 묶이지 않도록 안내 메시지는 블록하지 않고 보낼 수 있을
+ * 때만 보냅니다 (다른 스레드가 쓰는 중이거나 송신 버퍼가 차 있으면 생략).
+ *
+ * @param arg ClientInfo 포인터
+ */
+static void chat_idle_expired(void *arg) {
+    ClientInfo *client_info = (ClientInfo *)arg;
+    static const char notice[] = "Disconnected: idle timeout.\n";
+
+    KTRACE(KTRACE_CAT_CHAT, KTRACE_LVL_INFO, "클라이언트 %d 유휴 시간 초과로 연결 종료", client_info->client_id);
+    if (kmutex_trylock(client_info->client_mutex)) {
+        ssize_t n = send(client_info->client_fd, notice, sizeof(notice) - 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+        (void)n;
+        kmutex_unlock(client_info->client_mutex);
+    }
+    shutdown(client_info->client_fd, SHUT_RDWR);
+}
+
+/**
+ * @brief 클라이언트의 유휴 타이머를 다시 시작하는 함수
+ *
+ * @param client_info 클라이언트 정보
+ */
+static void chat_touch(ClientInfo *client_info) {
+    if (chat_idle_timeout_ms > 0) {
+        ktimer_schedule(&client_info->idle_timer, (uint64_t)chat_idle_timeout_ms);
+    }
+}
+
+/**
+ * @brief ClientInfo를 할당하고 초기화하는 함수 (add_new_client와 accept 경로 공용)
+ *
+ * @param sock 클라이언트 소켓 FD
+ * @param client_id 클라이언트 ID
+ * @param username 사용자명 (아직 모르면 빈 문자열)
+ * @return 참조 수 1(슬롯 몫)인 ClientInfo
+ */
+static ClientInfo *client_info_create(int sock, int client_id, const char *username) {
+    ClientInfo *client_info = (ClientInfo *)malloc(sizeof(ClientInfo));
+    if (client_info == NULL) {
+        kernel_errExit("클라이언트 정보 메모리 할당 실패");
+    }
+    client_info->client_fd = sock;
+    client_info->client_id = client_id;
+    client_info->room_id = 0;
+    snprintf(client_info->username, sizeof(client_info->username), "%s", username);
+    client_info->client_mutex = kmutex_create("chat.client");
+    ktimer_init(&client_info->idle_timer, chat_idle_expired, client_info);
+    client_info->refs = 1;
+    return client_info;
+}
+
+/**
+ * @brief 에포크 읽기 구역 안에서 읽은 ClientInfo의 참조를 잡는 함수
+ *
+ * 슬롯의 참조는 유예 기간이 지나야 놓이므로 구역 안에서는 참조 수가 0이 아닙니다.
+ * 잡은 참조는 구역을 나온 뒤에도 유효하며 client_put으로 놓습니다.
+ *
+ * @param client_info 읽기 구역 안에서 EPOCH_LOAD로 읽은 클라이언트
+ * @return client_info
+ */
+static ClientInfo *client_get(ClientInfo *client_info) {
+    __atomic_add_fetch(&client_info->refs, 1, __ATOMIC_RELAXED);
+    return client_info;
+}
+
+/**
+ * @brief ClientInfo의 참조를 놓는 함수 (마지막 참조면 소켓을 닫고 해제)
+ *
+ * 소켓도 여기서 닫아야 다른 스레드가 들고 있던 FD 번호가 다른 연결에 재사용되지 않습니다.
+ *
+ * @param client_info 참조를 놓을 클라이언트
+ */
+static void client_put(ClientInfo *client_info) {
+    if (__atomic_sub_fetch(&client_info->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        close(client_info->client_fd);
+        kmutex_free(client_info->client_mutex);
+        free(client_info);
+    }
+}
+
 /**
  * @brief 클라이언트 정보를 스마트 포인터로 관리하는 배열
  * @param client_infos 클라이언트 정보를 담는 스마트 포인터 배열
@@ -150,10 +329,12 @@ void kill_user(const char *username);
  * @return void
  */
 void list_users() {
+    epoch_enter();
+    krwlock_rdlock(client_table());
     printf("현재 접속 중인 유저 목록:\n");
     for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (client_infos[i].ptr != NULL) {
-            ClientInfo *client_info = (ClientInfo *)client_infos[i].ptr;
+        ClientInfo *client_info = (ClientInfo *)EPOCH_LOAD(client_infos[i].ptr);
+        if (client_info != NULL) {
             printf("User: %s, Room: %d\n", client_info->username, client_info->room_id);
         }
     }
@@ -161,15 +342,15 @@ void list_users() {
     for (int room_id = 1; room_id <= 5; room_id++) {
         int user_count = 0;
         for (int i = 0; i < MAX_CLIENTS; i++) {
-            if (client_infos[i].ptr != NULL) {
-                ClientInfo *client_info = (ClientInfo *)client_infos[i].ptr;
-                if (client_info->room_id == room_id) {
-                    user_count++;
-                }
+            ClientInfo *client_info = (ClientInfo *)EPOCH_LOAD(client_infos[i].ptr);
+            if (client_info != NULL && client_info->room_id == room_id) {
+                user_count++;
             }
         }
         printf("Room %d: %d명\n", room_id, user_count);
     }
+    krwlock_rdunlock(client_table());
+    epoch_exit();
 }
 
 /**
@@ -178,15 +359,26 @@ void list_users() {
  * @return void
  */
 void kill_room(int room_id) {
+    ClientInfo *targets[MAX_CLIENTS];
+    int target_count = 0;
+
+    // 대상은 읽기 구역 안에서 참조를 잡아 고르고, 소켓 쓰기는 구역 밖에서 수행
+    epoch_enter();
+    krwlock_rdlock(client_table());
     for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (client_infos[i].ptr != NULL) {
-            ClientInfo *client_info = (ClientInfo *)client_infos[i].ptr;
-            if (client_info->room_id == room_id) {
-                send(client_info->client_fd, "The room has been closed. You have been kicked out.\n", strlen("The room has been closed. You have been kicked out.\n"), 0);
-                release_client(i);  // Properly release client
-            }
+        ClientInfo *client_info = (ClientInfo *)EPOCH_LOAD(client_infos[i].ptr);
+        if (client_info != NULL && client_info->room_id == room_id) {
+            targets[target_count++] = client_get(client_info);
         }
     }
+    krwlock_rdunlock(client_table());
+    epoch_exit();
+
+    for (int i = 0; i < target_count; i++) {
+        send_to_client(targets[i], "The room has been closed. You have been kicked out.\n", strlen("The room has been closed. You have been kicked out.\n"));
+        release_client(targets[i]->client_fd);  // Properly release client
+        client_put(targets[i]);
+    }
     printf("Room %d has been closed, and all users have been kicked.\n", room_id);
 }
 
@@ -198,36 +390,96 @@ void kill_room(int room_id) {
  */
 SmartPtr client_infos[MAX_CLIENTS];
 
+static void free_client_info(void *ptr);
+
+/**
+ * @brief 초기화가 끝난 ClientInfo를 클라이언트 슬롯에 게시하는 함수
+ *
+ * 새 버퍼를 할당하지 않고 client_info의 소유권을 넘겨받으며, 읽기 스레드가
+ * 완성된 객체만 보도록 포인터는 마지막에 게시합니다.
+ *
+ * @param sock 클라이언트 슬롯 (소켓 FD)
+ * @param client_info 게시할 클라이언트 정보
+ * @return void
+ */
+static void publish_client(int sock, ClientInfo *client_info) {
+    SmartPtr sp = SMART_PTR_ADOPT(ClientInfo, client_info, free_client_info);
+
+    client_infos[sock].ref_count = sp.ref_count;
+    client_infos[sock].mutex = sp.mutex;
+    client_infos[sock].deleter = sp.deleter;
+    EPOCH_STORE(client_infos[sock].ptr, sp.ptr);
+}
+
 /**
  * @brief 클라이언트 정보를 스마트 포인터로 관리하는 배열
  * @param client_infos 클라이언트 정보를 담는 스마트 포인터 배열
  * @return void
  */
 void add_new_client(int sock, int client_id, const char *username) {
-    ClientInfo *client_info = (ClientInfo *)malloc(sizeof(ClientInfo));
-    client_info->client_fd = sock;
-    client_info->client_id = client_id;
-    strcpy(client_info->username, username); 
-    pthread_mutex_t *client_mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
-    pthread_mutex_init(client_mutex, NULL);
-    client_info->client_mutex = client_mutex;
-    
-    // client_infos[sock] = create_smart_ptr(client_info, free);
-    client_infos[sock] = create_smart_ptr(sizeof(ClientInfo), client_info, free);
+    publish_client(sock, client_info_create(sock, client_id, username));
 }
 
 /**
- * @brief 클라이언트 정보를 스마트 포인터로 관리하는 배열
- * @param client_infos 클라이언트 정보를 담는 스마트 포인터 배열
+ * @brief 유예 기간이 지난 클라이언트 정보에서 슬롯의 참조를 놓는 소멸자 함수
+ *
+ * 다른 스레드가 client_get으로 잡은 참조가 남아 있으면 마지막 client_put에서 해제됩니다.
+ *
+ * @param ptr ClientInfo 포인터
+ * @return void
+ */
+static void free_client_info(void *ptr) {
+    client_put((ClientInfo *)ptr);
+}
+
+/**
+ * @brief 클라이언트 슬롯을 비우고 ClientInfo를 유예 기간 후 해제하도록 예약하는 함수
+ *
+ * 슬롯 포인터를 NULL로 교환한 스레드만 해제를 담당합니다. 유예 기간을 기다리지 않고
+ * 반환하며, 예약된 객체는 이후의 epoch_collect(연결 종료와 accept마다 호출)에서 해제됩니다.
+ *
+ * @param sp 비울 클라이언트 슬롯의 스마트 포인터
+ * @return void
+ */
+static void retire_client(SmartPtr *sp) {
+    ClientInfo *client_info = (ClientInfo *)__atomic_exchange_n(&sp->ptr, NULL, __ATOMIC_ACQ_REL);
+    if (client_info == NULL) {
+        return;
+    }
+
+    // 유휴 타이머 콜백이 client_info를 쓰고 있을 수 있으므로 끝날 때까지 대기
+    ktimer_cancel_sync(&client_info->idle_timer);
+
+    // 참조 카운트와 뮤텍스는 읽기 스레드가 접근하지 않으므로 바로 해제
+    free(sp->ref_count);
+    sp->ref_count = NULL;
+    if (sp->mutex != NULL) {
+        pthread_mutex_destroy(sp->mutex);
+        free(sp->mutex);
+        sp->mutex = NULL;
+    }
+
+    epoch_retire(client_info, sp->deleter);
+    epoch_collect();
+}
+
+/**
+ * @brief 클라이언트 연결 종료를 요청하는 함수
+ *
+ * 소켓을 shutdown하여 client_handler의 read가 반환되게 하고, 슬롯 정리와
+ * 메모리 해제는 해당 client_handler가 retire_client로 수행합니다.
+ *
+ * @param sock 종료할 클라이언트 슬롯 (소켓 FD)
  * @return void
  */
 void release_client(int sock) {
-    if (client_infos[sock].ptr != NULL) {
-        ClientInfo *client_info = (ClientInfo *)client_infos[sock].ptr;
-        close(client_info->client_fd);
-        release_shared_ptr((SharedPtr*)&client_infos[sock]);
-        printf("클라이언트 %d 연결 종료 및 메모리 해제 완료\n", client_info->client_id);
+    epoch_enter();
+    ClientInfo *client_info = (ClientInfo *)EPOCH_LOAD(client_infos[sock].ptr);
+    if (client_info != NULL) {
+        shutdown(client_info->client_fd, SHUT_RDWR);
+        printf("클라이언트 %d 연결 종료 요청 완료\n", client_info->client_id);
     }
+    epoch_exit();
 }
 
 
@@ -237,17 +489,26 @@ void release_client(int sock) {
  * @return void
  */
 void kill_user(const char *username) {
+    ClientInfo *target = NULL;
+
+    epoch_enter();
+    krwlock_rdlock(client_table());
     for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (client_infos[i].ptr != NULL) {
-            ClientInfo *client_info = (ClientInfo *)client_infos[i].ptr;
-            if (strcmp(client_info->username, username) == 0) {
-                send(client_info->client_fd, "You have been kicked from the chat.\n", strlen("You have been kicked from the chat.\n"), 0);
-                release_client(i);  // Properly release client
-                printf("User %s has been kicked.\n", username);
-                break;
-            }
+        ClientInfo *client_info = (ClientInfo *)EPOCH_LOAD(client_infos[i].ptr);
+        if (client_info != NULL && strcmp(client_info->username, username) == 0) {
+            target = client_get(client_info);
+            break;
         }
     }
+    krwlock_rdunlock(client_table());
+    epoch_exit();
+
+    if (target != NULL) {
+        send_to_client(target, "You have been kicked from the chat.\n", strlen("You have been kicked from the chat.\n"));
+        release_client(target->client_fd);  // Properly release client
+        printf("User %s has been kicked.\n", username);
+        client_put(target);
+    }
 }
 
 /**
@@ -259,19 +520,33 @@ void kill_user(const char *username) {
  */
 void broadcast_message(int sender_fd, char *message, int room_id) {
     char broadcast_message[BUFFER_SIZE + 50];
-    ClientInfo *sender_info = (ClientInfo *)client_infos[sender_fd].ptr;
+    ClientInfo *targets[MAX_CLIENTS];
+    int target_count = 0;
 
-    snprintf(broadcast_message, sizeof(broadcast_message), "[%s]: %s", sender_info->username, message);
-    log_chat_message(broadcast_message);
+    epoch_enter();
+    ClientInfo *sender_info = (ClientInfo *)EPOCH_LOAD(client_infos[sender_fd].ptr);
+    if (sender_info == NULL) {
+        epoch_exit();
+        return;
+    }
 
+    // 필드는 읽기 잠금 안에서 읽고, 느릴 수 있는 로그 기록과 소켓 쓰기는 잠금과 읽기 구역 밖에서 수행
+    krwlock_rdlock(client_table());
+    snprintf(broadcast_message, sizeof(broadcast_message), "[%s]: %s", sender_info->username, message);
     for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (client_infos[i].ptr != NULL) {
-            ClientInfo *client_info = (ClientInfo *)client_infos[i].ptr;
-            if (client_info->room_id == room_id && client_info->client_fd != sender_fd) {
-                write(client_info->client_fd, broadcast_message, strlen(broadcast_message));
-            }
+        ClientInfo *client_info = (ClientInfo *)EPOCH_LOAD(client_infos[i].ptr);
+        if (client_info != NULL && client_info->room_id == room_id && client_info->client_fd != sender_fd) {
+            targets[target_count++] = client_get(client_info);
         }
     }
+    krwlock_rdunlock(client_table());
+    epoch_exit();
+
+    log_chat_message(broadcast_message);
+    for (int i = 0; i < target_count; i++) {
+        send_to_client(targets[i], broadcast_message, strlen(broadcast_message));
+        client_put(targets[i]);
+    }
 }
 
 
@@ -326,61 +601,53 @@ void *client_handler(void *arg) {
     char buffer[BUFFER_SIZE];
     int nbytes;
 
+    kplacement_apply(&chat_placement, client_info->client_id);
+    chat_touch(client_info);
+
     // 사용자명 수신
     memset(buffer, 0, sizeof(buffer));
     nbytes = read(client_info->client_fd, buffer, BUFFER_SIZE);
     if (nbytes <= 0) {
-        printf("사용자명 수신 실패 또는 클라이언트 연결 종료\n");
-        close(client_info->client_fd);
-        release(sp);
+        KTRACE(KTRACE_CAT_CHAT, KTRACE_LVL_WARN, "사용자명 수신 실패 또는 클라이언트 연결 종료 (fd %d)", client_info->client_fd);
+        retire_client(sp);
         return NULL;
     }
+    chat_touch(client_info);
+    krwlock_wrlock(client_table());
     strncpy(client_info->username, buffer, BUFFER_SIZE);
-    printf("사용자명: %s\n", client_info->username);
+    client_info->username[BUFFER_SIZE - 1] = '\0';
+    krwlock_wrunlock(client_table());
+    KTRACE(KTRACE_CAT_CHAT, KTRACE_LVL_INFO, "사용자명: %s", client_info->username);
 
     // 채팅방 선택 수신
     memset(buffer, 0, sizeof(buffer));
     nbytes = read(client_info->client_fd, buffer, BUFFER_SIZE);
     if (nbytes <= 0) {
-        printf("채팅방 수신 실패 또는 클라이언트 연결 종료\n");
-        close(client_info->client_fd);
-
-        // 클라이언트 종료 시 뮤텍스 제거
-        printf("클라이언트 %d 연결 종료에 따른 뮤텍스 파괴", client_info->client_id);
-        pthread_mutex_destroy(client_info -> client_mutex);
-        free(client_info -> client_mutex);
-        printf("뮤텍스 파괴 완료. 클라이언트 아이디 : [ %d ] -> destroyed\n", client_info->client_id);
+        KTRACE(KTRACE_CAT_CHAT, KTRACE_LVL_WARN, "채팅방 수신 실패 또는 클라이언트 %d 연결 종료", client_info->client_id);
 
-        if(client_info->room_id != 0) {
-            printf("클라이언트 %d가 채팅방 %d에서 퇴장했습니다.\n", client_info->client_id, client_info->room_id);
-        } else {
-            printf("클라이언트 %d 연결 종료\n", client_info->client_id);
-        }
-
-        release(sp);
+        // 뮤텍스와 소켓은 유예 기간 후 free_client_info에서 정리
+        retire_client(sp);
         return NULL;
     }
     
+    chat_touch(client_info);
+    krwlock_wrlock(client_table());
     client_info->room_id = atoi(buffer);
-    printf("클라이언트 %d가 채팅방 %d에 입장했습니다.\n", client_info->client_id, client_info->room_id);
+    krwlock_wrunlock(client_table());
+    KTRACE(KTRACE_CAT_CHAT, KTRACE_LVL_INFO, "클라이언트 %d가 채팅방 %d에 입장했습니다.", client_info->client_id, client_info->room_id);
 
     // 메시지 처리
     while ((nbytes = read(client_info->client_fd, buffer, BUFFER_SIZE)) > 0) {
         buffer[nbytes] = '\0';
-        printf("클라이언트 %d (%s) 메시지: %s\n", client_info->client_id, client_info->username, buffer);
+        chat_touch(client_info);
+        KTRACE(KTRACE_CAT_CHAT, KTRACE_LVL_DEBUG, "클라이언트 %d (%s) 메시지: %s", client_info->client_id, client_info->username, buffer);
         broadcast_message(client_info->client_fd, buffer, client_info->room_id);
     }
 
-    printf("클라이언트 %d 연결 종료\n", client_info->client_id);
-
-    // 뮤텍스 파괴 및 참조 감소 확인
-    printf("클라이언트 %d 연결 종료. 뮤텍스 파괴 중...\n", client_info->client_id);
-    pthread_mutex_destroy(client_info -> client_mutex);
-    free(client_info -> client_mutex);
-    printf("뮤텍스 파괴 완료. 클라이언트 아이디 : [ %d ] -> destroyed\n", client_info->client_id);
+    KTRACE(KTRACE_CAT_CHAT, KTRACE_LVL_INFO, "클라이언트 %d 연결 종료", client_info->client_id);
 
-    close(client_info->client_fd);
-    release(sp);  // 스마트 포인터 해제
+    // 뮤텍스와 소켓은 유예 기간 후 free_client_info에서 정리
+    retire_client(sp);  // 스마트 포인터 해제
     return NULL;
 }
 /**
@@ -393,6 +660,16 @@ int create_network_tcp_process(int num_tcp_proc, ...) {
     va_list args;
     va_start(args, num_tcp_proc);
 
+    if (!chat_placement_set) {
+        kplacement_from_env(&chat_placement, "KERNEL_CHAT_PLACEMENT");
+    }
+    kplacement_apply(&chat_placement, 0);
+
+    if (chat_idle_timeout_ms < 0) {
+        const char *env = getenv("KERNEL_CHAT_IDLE_TIMEOUT");
+        chat_idle_timeout_ms = (long long)(env != NULL ? atoi(env) : CHAT_DEFAULT_IDLE_TIMEOUT) * 1000;
+    }
+
     for (int i = 0; i < num_tcp_proc; i++) {
         int ssock, client_count = 1;
         socklen_t clen;
@@ -443,22 +720,19 @@ int create_network_tcp_process(int num_tcp_proc, ...) {
                 inet_ntop(AF_INET, &cliaddr.sin_addr, client_ip, INET_ADDRSTRLEN);
                 printf("[ 클라이언트 %d가 연결되었습니다. IP: %s ]\n", client_count, client_ip);
 
-                pthread_mutex_t *client_mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
-                pthread_mutex_init(client_mutex, NULL);
+                ClientInfo *client_info = client_info_create(csock, client_count++, "");
 
-                ClientInfo *client_info = (ClientInfo *)malloc(sizeof(ClientInfo));
-                client_info->client_fd = csock;
-                client_info->client_id = client_count++;
-                client_info->client_mutex = client_mutex;
+                // 이전에 끊긴 클라이언트 중 유예 기간이 지난 것을 회수
+                epoch_collect();
 
-                // 클라이언트 정보를 스마트 포인터로 관리
-                // client_infos[csock] = create_smart_ptr(client_info, free);
-                client_infos[csock] = create_smart_ptr(sizeof(ClientInfo), client_info, free);
+                // 클라이언트 정보를 스마트 포인터로 관리 (추가 할당 없이 소유권 이전)
+                publish_client(csock, client_info);
+
+                // 스레드 생성 후에는 client_handler가 client_info를 해제할 수 있으므로 먼저 출력
+                printf("mutex %d called\n", client_info->client_id);
 
                 // 클라이언트 스레드 생성
                 pthread_create(&tid, NULL, client_handler, (void *)&client_infos[csock]);
-
-                printf("mutex %d called\n", client_info->client_id);
                 
                 // 추가: 클라이언트 종료 시 뮤텍스 제거
                 pthread_detach(tid);  // 스레드 분리
@@ -499,6 +773,13 @@ void *server_input_handler(void *arg) {
             list_users();
         }
         
+        // locks 명령어 처리 (잠금 클래스별 경합 통계)
+        if (strcmp(buffer, "locks") == 0) {
+            char report[4096];
+            kmutex_format_report(report, sizeof(report));
+            printf("%s", report);
+        }
+
         // kill 명령어 처리
         if (strncmp(buffer, "kill ", 5) == 0) {
             char *username = buffer + 5;
@@ -543,12 +824,22 @@ void send_server_message(char *message) {
     snprintf(server_message, sizeof(server_message), "[서버]: %s", message);
     log_chat_message(server_message);
 
-    // 채팅방에 있는 클라이언트들에게 메시지 전송
+    // 채팅방에 있는 클라이언트들에게 메시지 전송 (참조만 읽기 구역 안에서 잡음)
+    ClientInfo *targets[MAX_CLIENTS];
+    int target_count = 0;
+    epoch_enter();
     for (int i = 0; i < MAX_CLIENTS; i++) {
-        if (client_infos[i].ptr != NULL) {
-            write(i, server_message, strlen(server_message));
+        ClientInfo *client_info = (ClientInfo *)EPOCH_LOAD(client_infos[i].ptr);
+        if (client_info != NULL) {
+            targets[target_count++] = client_get(client_info);
         }
-    }   
+    }
+    epoch_exit();
+
+    for (int i = 0; i < target_count; i++) {
+        send_to_client(targets[i], server_message, strlen(server_message));
+        client_put(targets[i]);
+    }
 }
 
 /**
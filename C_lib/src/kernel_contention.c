@@ -0,0 +1,539 @@
+/*
+ * Kernel Lock Contention Harness
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the contention harness declared in
+ *             kernel_contention.h. Threads are started behind a gate so the
+ *             measurement window only covers the contended phase; the work
+ *             inside and outside the lock is a calibrated busy loop rather
+ *             than sleep(), so the lock itself dominates the result.
+ */
+
+#include "kernel_contention.h"
+#include "kernel_engine.h"
+#include "kernel_futex.h"
+#include "kernel_mutex.h"
+#include "kernel_sync.h"
+#include "kernel_trace.h"
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* 스핀락/티켓 락이 양보(sched_yield) 전에 도는 횟수 */
+#define KCONTENTION_SPIN_LIMIT 128
+
+/* futex 잠금 상태 (0: 해제, 1: 잠김, 2: 잠김 + 대기자 있음) */
+#define FUTEX_LOCK_FREE 0u
+#define FUTEX_LOCK_HELD 1u
+#define FUTEX_LOCK_CONTENDED 2u
+
+static const char *lock_names[KLOCK_COUNT] = { "mutex", "semaphore", "spin", "ticket", "futex", "kmutex" };
+
+/**
+ * @struct ContentionLock
+ * @brief 측정 대상 잠금 (kind에 해당하는 필드만 사용)
+ */
+typedef struct ContentionLock {
+    KLockKind kind;
+    pthread_mutex_t *mutex;
+    sem_t *semaphore;
+    __attribute__((aligned(64))) int spin;
+    __attribute__((aligned(64))) uint32_t ticket_next;
+    uint32_t ticket_serving;
+    __attribute__((aligned(64))) uint32_t futex_word;
+    __attribute__((aligned(64))) KMutex kmutex;
+} ContentionLock;
+
+/**
+ * @struct ContentionThread
+ * @brief 스레드별 측정 결과 (거짓 공유를 막기 위해 캐시 라인 정렬)
+ */
+typedef struct ContentionThread {
+    __attribute__((aligned(64))) uint64_t ops;
+    uint64_t max_ns;
+    uint64_t hist[KCONTENTION_HIST_BUCKETS];
+    struct ContentionShared *shared;
+    int index;                          /**< 배치 순번 */
+} ContentionThread;
+
+/**
+ * @struct ContentionShared
+ * @brief 한 번의 측정에서 모든 스레드가 공유하는 상태
+ */
+typedef struct ContentionShared {
+    ContentionLock lock;
+    uint64_t hold_iters;    /**< 임계 구역 작업 반복 수 */
+    uint64_t idle_iters;    /**< 임계 구역 밖 작업 반복 수 */
+    const KPlacement *placement; /**< 측정 스레드 배치 */
+    KLatch ready;           /**< 모든 스레드가 준비되면 열림 */
+    KLatch go;              /**< 측정 시작 신호 */
+    int stop;               /**< 측정 종료 신호 */
+} ContentionShared;
+
+/**
+ * @brief 최적화로 지워지지 않는 바쁜 대기 루프
+ *
+ * 보정과 측정이 같은 기계어를 쓰도록 인라인하지 않습니다.
+ */
+static __attribute__((noinline)) void busy_work(uint64_t iters) {
+    for (uint64_t i = 0; i < iters; i++) {
+        __asm__ __volatile__("" ::: "memory");
+    }
+}
+
+/**
+ * @brief busy_work의 ns당 반복 수를 측정하는 함수
+ *
+ * 가상 머신 등에서는 CPU 속도가 시간에 따라 바뀌므로 측정마다 다시 보정합니다.
+ * 가장 빠른 측정값을 써서 선점으로 늘어난 측정이 결과를 흐리지 않도록 합니다.
+ *
+ * @return ns당 반복 수
+ */
+static double calibrate_busy_work(void) {
+    const uint64_t iters = 1u << 18;
+    double iters_per_ns = 1.0;
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < 8; round++) {
+        uint64_t begin = kernel_now_ns();
+        busy_work(iters);
+        uint64_t elapsed = kernel_now_ns() - begin;
+        if (elapsed > 0 && elapsed < best) {
+            best = elapsed;
+        }
+    }
+    if (best != UINT64_MAX) {
+        iters_per_ns = (double)iters / (double)best;
+    }
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "바쁜 대기 보정: %.3f 반복/ns", iters_per_ns);
+    return iters_per_ns;
+}
+
+static uint64_t ns_to_iters(uint32_t ns, double iters_per_ns) {
+    return (uint64_t)((double)ns * iters_per_ns + 0.5);
+}
+
+static pthread_once_t busy_wait_once = PTHREAD_ONCE_INIT;
+static double busy_wait_iters_per_ns = 1.0;
+
+static void busy_wait_calibrate_once(void) {
+    busy_wait_iters_per_ns = calibrate_busy_work();
+}
+
+/**
+ * @brief 보정된 바쁜 대기 루프로 ns 동안 CPU를 사용하는 함수
+ */
+void contention_busy_wait(uint32_t ns) {
+    pthread_once(&busy_wait_once, busy_wait_calibrate_once);
+    busy_work(ns_to_iters(ns, busy_wait_iters_per_ns));
+}
+
+static int lock_init(ContentionLock *lock, KLockKind kind) {
+    memset(lock, 0, sizeof(*lock));
+    lock->kind = kind;
+    if (kind == KLOCK_MUTEX) {
+        lock->mutex = init_mutex();
+        return lock->mutex != NULL ? 0 : -1;
+    }
+    if (kind == KLOCK_SEMAPHORE) {
+        lock->semaphore = init_semaphore(1);
+        return lock->semaphore != NULL ? 0 : -1;
+    }
+    if (kind == KLOCK_KMUTEX) {
+        kmutex_init(&lock->kmutex, "contention.kmutex");
+    }
+    return 0;
+}
+
+static void lock_destroy(ContentionLock *lock) {
+    if (lock->kind == KLOCK_KMUTEX) {
+        kmutex_destroy(&lock->kmutex);
+    }
+    if (lock->mutex != NULL) {
+        pthread_mutex_destroy(lock->mutex);
+        free(lock->mutex);
+    }
+    if (lock->semaphore != NULL) {
+#ifdef __APPLE__
+        sem_close(lock->semaphore);
+#else
+        sem_destroy(lock->semaphore);
+        free(lock->semaphore);
+#endif
+    }
+}
+
+static void lock_acquire(ContentionLock *lock) {
+    switch (lock->kind) {
+        case KLOCK_MUTEX:
+            pthread_mutex_lock(lock->mutex);
+            break;
+        case KLOCK_SEMAPHORE:
+            while (sem_wait(lock->semaphore) == -1 && errno == EINTR) {
+            }
+            break;
+        case KLOCK_SPIN:
+            // 캐시 라인을 읽기 공유 상태로 두고 기다리다가 해제가 보이면 교환 시도 (TTAS)
+            for (int spins = 0;; spins++) {
+                if (!__atomic_load_n(&lock->spin, __ATOMIC_RELAXED) &&
+                    !__atomic_exchange_n(&lock->spin, 1, __ATOMIC_ACQUIRE)) {
+                    break;
+                }
+                if (spins >= KCONTENTION_SPIN_LIMIT) {
+                    sched_yield();
+                    spins = 0;
+                } else {
+                    kernel_cpu_relax();
+                }
+            }
+            break;
+        case KLOCK_TICKET: {
+            uint32_t ticket = __atomic_fetch_add(&lock->ticket_next, 1, __ATOMIC_RELAXED);
+            for (int spins = 0; __atomic_load_n(&lock->ticket_serving, __ATOMIC_ACQUIRE) != ticket; spins++) {
+                if (spins >= KCONTENTION_SPIN_LIMIT) {
+                    sched_yield();
+                    spins = 0;
+                } else {
+                    kernel_cpu_relax();
+                }
+            }
+            break;
+        }
+        case KLOCK_FUTEX: {
+            // Drepper "Futexes Are Tricky"의 3상태 잠금
+            uint32_t state = FUTEX_LOCK_FREE;
+            if (__atomic_compare_exchange_n(&lock->futex_word, &state, FUTEX_LOCK_HELD, false,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                break;
+            }
+            if (state != FUTEX_LOCK_CONTENDED) {
+                state = __atomic_exchange_n(&lock->futex_word, FUTEX_LOCK_CONTENDED, __ATOMIC_ACQUIRE);
+            }
+            while (state != FUTEX_LOCK_FREE) {
+                kernel_futex_wait(&lock->futex_word, FUTEX_LOCK_CONTENDED, NULL);
+                state = __atomic_exchange_n(&lock->futex_word, FUTEX_LOCK_CONTENDED, __ATOMIC_ACQUIRE);
+            }
+            break;
+        }
+        case KLOCK_KMUTEX:
+            kmutex_lock(&lock->kmutex);
+            break;
+        default:
+            break;
+    }
+}
+
+static void lock_release(ContentionLock *lock) {
+    switch (lock->kind) {
+        case KLOCK_MUTEX:
+            pthread_mutex_unlock(lock->mutex);
+            break;
+        case KLOCK_SEMAPHORE:
+            sem_post(lock->semaphore);
+            break;
+        case KLOCK_SPIN:
+            __atomic_store_n(&lock->spin, 0, __ATOMIC_RELEASE);
+            break;
+        case KLOCK_TICKET:
+            // 소유자만 serving을 바꾸므로 읽고 더한 값을 release로 저장하면 충분함
+            __atomic_store_n(&lock->ticket_serving,
+                             __atomic_load_n(&lock->ticket_serving, __ATOMIC_RELAXED) + 1, __ATOMIC_RELEASE);
+            break;
+        case KLOCK_FUTEX:
+            if (__atomic_fetch_sub(&lock->futex_word, 1, __ATOMIC_RELEASE) != FUTEX_LOCK_HELD) {
+                __atomic_store_n(&lock->futex_word, FUTEX_LOCK_FREE, __ATOMIC_RELEASE);
+                kernel_futex_wake(&lock->futex_word, 1);
+            }
+            break;
+        case KLOCK_KMUTEX:
+            kmutex_unlock(&lock->kmutex);
+            break;
+        default:
+            break;
+    }
+}
+
+static int latency_bucket(uint64_t ns) {
+    if (ns == 0) {
+        return 0;
+    }
+    int bucket = 63 - __builtin_clzll(ns);
+    return bucket < KCONTENTION_HIST_BUCKETS ? bucket : KCONTENTION_HIST_BUCKETS - 1;
+}
+
+static void *contention_thread_main(void *arg) {
+    ContentionThread *self = (ContentionThread *)arg;
+    ContentionShared *shared = self->shared;
+
+    kplacement_apply(shared->placement, self->index);
+
+    klatch_count_down(&shared->ready, 1);
+    klatch_wait(&shared->go);
+
+    while (!__atomic_load_n(&shared->stop, __ATOMIC_RELAXED)) {
+        uint64_t begin = kernel_now_ns();
+        lock_acquire(&shared->lock);
+        uint64_t waited = kernel_now_ns() - begin;
+        busy_work(shared->hold_iters);
+        lock_release(&shared->lock);
+
+        self->ops++;
+        self->hist[latency_bucket(waited)]++;
+        if (waited > self->max_ns) {
+            self->max_ns = waited;
+        }
+        busy_work(shared->idle_iters);
+    }
+    return NULL;
+}
+
+/**
+ * @brief 히스토그램에서 백분위가 속한 구간의 상한을 구하는 함수
+ */
+static uint64_t hist_percentile(const uint64_t *hist, uint64_t total, double percentile) {
+    uint64_t target = (uint64_t)((double)total * percentile);
+    uint64_t seen = 0;
+
+    for (int i = 0; i < KCONTENTION_HIST_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen > target) {
+            return (2ULL << i) - 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 잠금 종류 이름을 반환하는 함수
+ *
+ * @param kind 잠금 종류
+ * @return 이름 문자열, 알 수 없는 종류면 "unknown"
+ */
+const char *contention_lock_name(KLockKind kind) {
+    if ((int)kind < 0 || kind >= KLOCK_COUNT) {
+        return "unknown";
+    }
+    return lock_names[kind];
+}
+
+/**
+ * @brief 이름으로 잠금 종류를 찾는 함수
+ *
+ * @param name 잠금 이름
+ * @return 잠금 종류, 없으면 -1
+ */
+int contention_lock_from_name(const char *name) {
+    for (int i = 0; i < KLOCK_COUNT; i++) {
+        if (name != NULL && strcmp(name, lock_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 한 잠금 종류에 대해 경합 측정을 실행하는 함수
+ *
+ * @param kind 잠금 종류
+ * @param config 측정 설정
+ * @param result 결과를 저장할 위치
+ * @return 성공 시 0, 설정이 잘못되었거나 스레드 생성에 실패하면 -1
+ */
+int contention_run(KLockKind kind, const KContentionConfig *config, KContentionResult *result) {
+    if (config == NULL || result == NULL || (int)kind < 0 || kind >= KLOCK_COUNT ||
+        config->num_threads < 1 || config->num_threads > KCONTENTION_MAX_THREADS || config->duration_ms == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    int num_threads = config->num_threads;
+    ContentionShared *shared = NULL;
+    ContentionThread *threads = NULL;
+    pthread_t *tids = (pthread_t *)malloc(sizeof(pthread_t) * (size_t)num_threads);
+    if (posix_memalign((void **)&shared, 64, sizeof(*shared)) != 0 ||
+        posix_memalign((void **)&threads, 64, sizeof(*threads) * (size_t)num_threads) != 0 || tids == NULL) {
+        free(shared);
+        free(threads);
+        free(tids);
+        errno = ENOMEM;
+        return -1;
+    }
+    memset(shared, 0, sizeof(*shared));
+    memset(threads, 0, sizeof(*threads) * (size_t)num_threads);
+    if (lock_init(&shared->lock, kind) != 0) {
+        free(shared);
+        free(threads);
+        free(tids);
+        return -1;
+    }
+    double iters_per_ns = calibrate_busy_work();
+    shared->hold_iters = ns_to_iters(config->hold_ns, iters_per_ns);
+    shared->idle_iters = ns_to_iters(config->idle_ns, iters_per_ns);
+    shared->placement = config->placement;
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "경합 측정 시작 (잠금: %s, 스레드: %d, 임계 구역: %uns, 유휴: %uns)",
+           lock_names[kind], num_threads, config->hold_ns, config->idle_ns);
+
+    klatch_init(&shared->ready, (uint32_t)num_threads);
+    klatch_init(&shared->go, 1);
+
+    int started = 0;
+    for (; started < num_threads; started++) {
+        threads[started].shared = shared;
+        threads[started].index = started;
+        int err = pthread_create(&tids[started], NULL, contention_thread_main, &threads[started]);
+        if (err != 0) {
+            kernel_errMsg("경합 측정 스레드 %d 생성 실패 (%s)", started, strerror(err));
+            break;
+        }
+    }
+
+    // 생성하지 못한 스레드 몫을 대신 내려 준비 래치를 엶
+    klatch_count_down(&shared->ready, (uint32_t)(num_threads - started));
+    klatch_wait(&shared->ready);
+    uint64_t begin = kernel_now_ns();
+    klatch_count_down(&shared->go, 1);
+
+    struct timespec duration = { (time_t)(config->duration_ms / 1000), (long)(config->duration_ms % 1000) * 1000000L };
+    while (started == num_threads && nanosleep(&duration, &duration) == -1 && errno == EINTR) {
+    }
+    __atomic_store_n(&shared->stop, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    uint64_t elapsed = kernel_now_ns() - begin;
+
+    int rc = started == num_threads ? 0 : -1;
+    if (rc == 0) {
+        double sum = 0.0;
+        double sum_sq = 0.0;
+
+        memset(result, 0, sizeof(*result));
+        result->kind = kind;
+        result->config = *config;
+        result->config.placement = NULL;
+        result->elapsed_ns = elapsed;
+        result->min_thread_ops = UINT64_MAX;
+        for (int i = 0; i < num_threads; i++) {
+            uint64_t ops = threads[i].ops;
+            result->total_ops += ops;
+            sum += (double)ops;
+            sum_sq += (double)ops * (double)ops;
+            if (ops < result->min_thread_ops) {
+                result->min_thread_ops = ops;
+            }
+            if (ops > result->max_thread_ops) {
+                result->max_thread_ops = ops;
+            }
+            if (threads[i].max_ns > result->max_ns) {
+                result->max_ns = threads[i].max_ns;
+            }
+            for (int b = 0; b < KCONTENTION_HIST_BUCKETS; b++) {
+                result->latency_hist[b] += threads[i].hist[b];
+            }
+        }
+        result->ops_per_sec = elapsed > 0 ? (double)result->total_ops * 1e9 / (double)elapsed : 0.0;
+        // Jain 지수: (Σx)² / (n·Σx²)
+        result->fairness = sum_sq > 0.0 ? sum * sum / ((double)num_threads * sum_sq) : 0.0;
+        result->p50_ns = hist_percentile(result->latency_hist, result->total_ops, 0.50);
+        result->p99_ns = hist_percentile(result->latency_hist, result->total_ops, 0.99);
+    }
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "경합 측정 종료 (잠금: %s, 획득: %llu)",
+           lock_names[kind], rc == 0 ? (unsigned long long)result->total_ops : 0ULL);
+
+    lock_destroy(&shared->lock);
+    free(shared);
+    free(threads);
+    free(tids);
+    return rc;
+}
+
+/**
+ * @brief 결과를 사람이 읽을 수 있는 여러 줄 문자열로 만드는 함수
+ *
+ * @param result 측정 결과
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int contention_format_result(const KContentionResult *result, char *buf, size_t size) {
+    size_t len = 0;
+    int n;
+
+#define CONTENTION_APPEND(...)                                                  \
+    do {                                                                        \
+        n = snprintf(buf + (len < size ? len : size), len < size ? size - len : 0, __VA_ARGS__); \
+        if (n > 0) {                                                            \
+            len += (size_t)n;                                                   \
+        }                                                                       \
+    } while (0)
+
+    CONTENTION_APPEND("[%s] 스레드 %d, 임계 구역 %uns, 유휴 %uns, %.0fms\n",
+                      contention_lock_name(result->kind), result->config.num_threads,
+                      result->config.hold_ns, result->config.idle_ns, (double)result->elapsed_ns / 1e6);
+    CONTENTION_APPEND("  처리량   : %.0f ops/s (총 %llu회)\n",
+                      result->ops_per_sec, (unsigned long long)result->total_ops);
+    CONTENTION_APPEND("  공정성   : %.3f (스레드별 최소 %llu / 최대 %llu)\n", result->fairness,
+                      (unsigned long long)result->min_thread_ops, (unsigned long long)result->max_thread_ops);
+    CONTENTION_APPEND("  획득 지연: p50 < %lluns, p99 < %lluns, 최대 %lluns\n",
+                      (unsigned long long)result->p50_ns + 1, (unsigned long long)result->p99_ns + 1,
+                      (unsigned long long)result->max_ns);
+    for (int i = 0; i < KCONTENTION_HIST_BUCKETS; i++) {
+        if (result->latency_hist[i] == 0) {
+            continue;
+        }
+        double share = (double)result->latency_hist[i] * 100.0 / (double)result->total_ops;
+        int bar = (int)(share / 2.0 + 0.5);
+        CONTENTION_APPEND("    %10lluns | %6.2f%% %.*s\n", 1ULL << i, share, bar,
+                          "##################################################");
+    }
+
+#undef CONTENTION_APPEND
+    return (int)len;
+}
+
+/**
+ * @brief 결과를 JSON 객체 하나로 만드는 함수
+ *
+ * @param result 측정 결과
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int contention_format_json(const KContentionResult *result, char *buf, size_t size) {
+    size_t len = 0;
+    int n;
+
+    n = snprintf(buf, size,
+                 "{\"lock\": \"%s\", \"threads\": %d, \"hold_ns\": %u, \"idle_ns\": %u, \"elapsed_ns\": %llu, "
+                 "\"ops\": %llu, \"ops_per_sec\": %.0f, \"fairness\": %.4f, \"min_thread_ops\": %llu, "
+                 "\"max_thread_ops\": %llu, \"p50_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu, \"latency_hist\": [",
+                 contention_lock_name(result->kind), result->config.num_threads, result->config.hold_ns,
+                 result->config.idle_ns, (unsigned long long)result->elapsed_ns,
+                 (unsigned long long)result->total_ops, result->ops_per_sec, result->fairness,
+                 (unsigned long long)result->min_thread_ops, (unsigned long long)result->max_thread_ops,
+                 (unsigned long long)result->p50_ns, (unsigned long long)result->p99_ns,
+                 (unsigned long long)result->max_ns);
+    if (n > 0) {
+        len += (size_t)n;
+    }
+    for (int i = 0; i < KCONTENTION_HIST_BUCKETS; i++) {
+        n = snprintf(buf + (len < size ? len : size), len < size ? size - len : 0, "%s%llu",
+                     i == 0 ? "" : ", ", (unsigned long long)result->latency_hist[i]);
+        if (n > 0) {
+            len += (size_t)n;
+        }
+    }
+    n = snprintf(buf + (len < size ? len : size), len < size ? size - len : 0, "]}");
+    if (n > 0) {
+        len += (size_t)n;
+    }
+    return (int)len;
+}
@@ -0,0 +1,883 @@
+/*
+ * Kernel Coroutine Runtime
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the coroutine runtime declared in kernel_coro.h.
+ *             The runtime thread ("main") switches into a coroutine and the
+ *             coroutine always switches back to main, never directly to
+ *             another coroutine. Ready coroutines are run in batches and the
+ *             event source is polled without blocking between batches, so
+ *             coroutines that only yield cannot starve fd waiters.
+ *
+ *             On Linux a timerfd in the epoll set carries the nearest sleep
+ *             deadline with microsecond precision. The poll() fallback rounds
+ *             deadlines up to milliseconds.
+ */
+
+#include "kernel_coro.h"
+#include "kernel_engine.h"
+#include "kernel_futex.h"
+#include "kernel_trace.h"
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+
+#if !defined(KCORO_USE_UCONTEXT) && !defined(__x86_64__) && !defined(__aarch64__)
+#define KCORO_USE_UCONTEXT
+#endif
+#ifdef KCORO_USE_UCONTEXT
+#include <ucontext.h>
+#endif
+
+/* 슬랩 하나에 담는 스택 수 */
+#define KCORO_SLAB_STACKS 16
+
+/* 한 번의 이벤트 대기에서 처리하는 최대 이벤트 수 */
+#define KCORO_MAX_EVENTS 256
+
+enum {
+    KCORO_READY = 0,
+    KCORO_RUNNING,
+    KCORO_SLEEPING,
+    KCORO_WAITING,
+    KCORO_DONE
+};
+
+/**
+ * @struct KCoro
+ * @brief 코루틴 제어 블록 (스택 최상단에 위치)
+ */
+typedef struct KCoro {
+    void *sp;                   /**< 저장된 스택 포인터 (어셈블리 전환) */
+#ifdef KCORO_USE_UCONTEXT
+    ucontext_t uctx;            /**< 저장된 문맥 (ucontext 전환) */
+#endif
+    KCoroFunc func;             /**< 코루틴 본문 */
+    void *arg;                  /**< 본문 인자 */
+    long id;                    /**< 코루틴 ID */
+    int state;                  /**< KCORO_READY 등 */
+    int heap_index;             /**< 수면 힙 위치 (-1이면 없음) */
+    uint64_t wake_ns;           /**< 깨어날 시각 */
+    int wait_fd;                /**< 대기 중인 fd (-1이면 없음) */
+    uint32_t wait_events;       /**< 대기 중인 이벤트 */
+    uint32_t ready_events;      /**< 깨어날 때 준비된 이벤트 */
+    int wait_index;             /**< poll 대체 구현의 대기 목록 위치 */
+    char *stack;                /**< 스택 최하단 (가드 페이지 위) */
+    struct KCoro *next;         /**< 실행 대기열 또는 빈 스택 목록 연결 */
+} KCoro;
+
+/**
+ * @struct KCoroRuntime
+ * @brief 스레드별 런타임 상태
+ */
+typedef struct KCoroRuntime {
+    KCoro *current;             /**< 실행 중인 코루틴 */
+    void *main_sp;              /**< 런타임 스레드의 저장된 스택 포인터 */
+#ifdef KCORO_USE_UCONTEXT
+    ucontext_t main_uctx;
+#endif
+    KCoro *ready_head;          /**< 실행 대기열 */
+    KCoro *ready_tail;
+    KCoro *free_stacks;         /**< 재사용할 스택 목록 */
+    void **slabs;               /**< 할당한 슬랩 */
+    size_t num_slabs;
+    size_t cap_slabs;
+    size_t stack_size;          /**< 가드 페이지를 제외한 스택 크기 */
+    size_t page_size;
+    KCoro **heap;               /**< wake_ns 기준 최소 힙 */
+    size_t heap_len;
+    size_t heap_cap;
+    KCoro **waiters;            /**< fd 대기 코루틴 (poll 대체 구현) */
+    size_t num_waiters;
+    size_t cap_waiters;
+    long next_id;
+    uint64_t live;              /**< 끝나지 않은 코루틴 수 */
+    uint64_t fd_waiters;        /**< fd를 기다리는 코루틴 수 */
+    int epfd;                   /**< epoll fd (-1이면 없음) */
+    int tfd;                    /**< 수면 마감용 timerfd */
+    uint64_t armed_ns;          /**< timerfd에 설정된 마감 (0이면 해제) */
+    int events_ready;           /**< epfd/tfd가 열려 있으면 1 */
+    int guard_exhausted;        /**< 매핑 수 한도에 걸려 가드 페이지를 더 만들 수 없으면 1 */
+    KCoroStats stats;
+} KCoroRuntime;
+
+static __thread KCoroRuntime runtime;
+
+/* ------------------------------------------------------------------------ */
+/* 문맥 전환                                                                 */
+/* ------------------------------------------------------------------------ */
+
+#ifndef KCORO_USE_UCONTEXT
+
+#if defined(__APPLE__)
+#define KCORO_SYM(name) "_" #name
+#define KCORO_HIDDEN(name) ".private_extern " KCORO_SYM(name) "\n"
+#else
+#define KCORO_SYM(name) #name
+#define KCORO_HIDDEN(name) ".hidden " KCORO_SYM(name) "\n"
+#endif
+
+/**
+ * @brief 현재 스택 포인터를 *save_sp에 저장하고 load_sp의 문맥으로 전환 (어셈블리 구현)
+ */
+void kernel_coro_switch(void **save_sp, void *load_sp);
+
+/**
+ * @brief 새 코루틴의 첫 진입점 (어셈블리 구현, 저장된 레지스터로 본문 진입 함수를 호출)
+ */
+void kernel_coro_start(void);
+
+#if defined(__x86_64__)
+/*
+ * 프레임 (낮은 주소부터): mxcsr/x87 제어 워드, r15, r14, r13, r12, rbx, rbp, 복귀 주소
+ * 새 코루틴은 r12 = KCoro*, r13 = 진입 함수로 시작합니다.
+ */
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    ".globl " KCORO_SYM(kernel_coro_switch) "\n"
+    KCORO_HIDDEN(kernel_coro_switch)
+    KCORO_SYM(kernel_coro_switch) ":\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".p2align 4\n"
+    ".globl " KCORO_SYM(kernel_coro_start) "\n"
+    KCORO_HIDDEN(kernel_coro_start)
+    KCORO_SYM(kernel_coro_start) ":\n"
+    "    movq %r12, %rdi\n"
+    "    callq *%r13\n"
+    "    ud2\n");
+
+#define KCORO_FRAME_WORDS 8
+
+static void *frame_init(char *top, KCoro *coro, void (*entry)(KCoro *)) {
+    uint64_t *frame = (uint64_t *)((uintptr_t)top & ~(uintptr_t)15) - KCORO_FRAME_WORDS;
+
+    memset(frame, 0, KCORO_FRAME_WORDS * sizeof(uint64_t));
+    frame[0] = 0x1F80ULL | (0x037FULL << 32);   // 기본 MXCSR, x87 제어 워드
+    frame[3] = (uint64_t)(uintptr_t)entry;      // r13
+    frame[4] = (uint64_t)(uintptr_t)coro;       // r12
+    frame[7] = (uint64_t)(uintptr_t)kernel_coro_start;
+    return frame;
+}
+
+#elif defined(__aarch64__)
+/*
+ * 프레임 (낮은 주소부터): x19-x28, x29, x30, d8-d15
+ * 새 코루틴은 x19 = KCoro*, x20 = 진입 함수, x30 = kernel_coro_start로 시작합니다.
+ */
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    ".globl " KCORO_SYM(kernel_coro_switch) "\n"
+    KCORO_HIDDEN(kernel_coro_switch)
+    KCORO_SYM(kernel_coro_switch) ":\n"
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8, d9, [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x2, sp\n"
+    "    str x2, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8, d9, [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+    ".p2align 4\n"
+    ".globl " KCORO_SYM(kernel_coro_start) "\n"
+    KCORO_HIDDEN(kernel_coro_start)
+    KCORO_SYM(kernel_coro_start) ":\n"
+    "    mov x0, x19\n"
+    "    blr x20\n"
+    "    brk #0\n");
+
+#define KCORO_FRAME_WORDS 20
+
+static void *frame_init(char *top, KCoro *coro, void (*entry)(KCoro *)) {
+    uint64_t *frame = (uint64_t *)((uintptr_t)top & ~(uintptr_t)15) - KCORO_FRAME_WORDS;
+
+    memset(frame, 0, KCORO_FRAME_WORDS * sizeof(uint64_t));
+    frame[0] = (uint64_t)(uintptr_t)coro;       // x19
+    frame[1] = (uint64_t)(uintptr_t)entry;      // x20
+    frame[11] = (uint64_t)(uintptr_t)kernel_coro_start;  // x30
+    return frame;
+}
+#endif
+
+#endif // !KCORO_USE_UCONTEXT
+
+/**
+ * @brief 런타임 스레드에서 코루틴으로 전환하는 함수
+ */
+static inline void switch_to_coro(KCoroRuntime *rt, KCoro *coro) {
+    rt->current = coro;
+    coro->state = KCORO_RUNNING;
+    rt->stats.switches++;
+#ifdef KCORO_USE_UCONTEXT
+    swapcontext(&rt->main_uctx, &coro->uctx);
+#else
+    kernel_coro_switch(&rt->main_sp, coro->sp);
+#endif
+    rt->current = NULL;
+}
+
+/**
+ * @brief 코루틴에서 런타임 스레드로 돌아가는 함수
+ */
+static inline void switch_to_main(KCoroRuntime *rt, KCoro *coro) {
+#ifdef KCORO_USE_UCONTEXT
+    swapcontext(&coro->uctx, &rt->main_uctx);
+#else
+    kernel_coro_switch(&coro->sp, rt->main_sp);
+#endif
+}
+
+/**
+ * @brief 코루틴 본문을 실행하고 끝나면 런타임으로 돌아가는 진입 함수
+ */
+static void coro_entry(KCoro *coro) {
+    coro->func(coro->arg);
+    coro->state = KCORO_DONE;
+    switch_to_main(&runtime, coro);
+    abort();    // 끝난 코루틴은 다시 실행되지 않음
+}
+
+#ifdef KCORO_USE_UCONTEXT
+static void coro_entry_ucontext(unsigned int hi, unsigned int lo) {
+    coro_entry((KCoro *)(uintptr_t)(((uint64_t)hi << 32) | lo));
+}
+
+/**
+ * @brief 새 코루틴의 ucontext를 준비하는 함수 (getcontext가 호출자 지역 변수에 영향을 주지 않도록 분리)
+ */
+static __attribute__((noinline)) void uctx_init(KCoro *coro) {
+    uint64_t self = (uint64_t)(uintptr_t)coro;
+
+    getcontext(&coro->uctx);
+    coro->uctx.uc_stack.ss_sp = coro->stack;
+    coro->uctx.uc_stack.ss_size = (size_t)((char *)coro - coro->stack);
+    coro->uctx.uc_link = NULL;
+    makecontext(&coro->uctx, (void (*)(void))coro_entry_ucontext, 2, (unsigned int)(self >> 32), (unsigned int)self);
+}
+#endif
+
+/* ------------------------------------------------------------------------ */
+/* 스택 풀                                                                   */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 슬랩 하나를 할당해 빈 스택 목록에 넣는 함수
+ *
+ * 스택마다 [가드 페이지][스택 ... KCoro] 구조입니다.
+ */
+static int stack_slab_alloc(KCoroRuntime *rt) {
+    size_t slot = rt->page_size + rt->stack_size;
+    char *slab = (char *)mmap(NULL, slot * KCORO_SLAB_STACKS, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (slab == MAP_FAILED) {
+        kernel_errMsg("코루틴 스택 할당 실패");
+        return -1;
+    }
+
+    if (rt->num_slabs == rt->cap_slabs) {
+        size_t cap = rt->cap_slabs ? rt->cap_slabs * 2 : 16;
+        void **slabs = (void **)realloc(rt->slabs, cap * sizeof(void *));
+        if (slabs == NULL) {
+            munmap(slab, slot * KCORO_SLAB_STACKS);
+            kernel_errMsg("코루틴 슬랩 목록 할당 실패");
+            return -1;
+        }
+        rt->slabs = slabs;
+        rt->cap_slabs = cap;
+    }
+    rt->slabs[rt->num_slabs++] = slab;
+
+    for (int i = KCORO_SLAB_STACKS - 1; i >= 0; i--) {
+        char *base = slab + (size_t)i * slot;
+        // 매핑 수 한도(vm.max_map_count)에 걸리면 이번 실행 동안은 가드 없이 사용
+        if (rt->guard_exhausted || mprotect(base, rt->page_size, PROT_NONE) != 0) {
+            if (!rt->guard_exhausted) {
+                KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_WARN, "가드 페이지 설정 실패, 이후 스택은 가드 없이 할당 (%s)", strerror(errno));
+            }
+            rt->guard_exhausted = 1;
+            rt->stats.unguarded++;
+        }
+        KCoro *coro = (KCoro *)((uintptr_t)(base + slot - sizeof(KCoro)) & ~(uintptr_t)63);
+        coro->stack = base + rt->page_size;
+        coro->next = rt->free_stacks;
+        rt->free_stacks = coro;
+    }
+    rt->stats.stacks += KCORO_SLAB_STACKS;
+    return 0;
+}
+
+static void stack_pool_release(KCoroRuntime *rt) {
+    size_t slot = rt->page_size + rt->stack_size;
+
+    for (size_t i = 0; i < rt->num_slabs; i++) {
+        munmap(rt->slabs[i], slot * KCORO_SLAB_STACKS);
+    }
+    free(rt->slabs);
+    rt->slabs = NULL;
+    rt->num_slabs = rt->cap_slabs = 0;
+    rt->free_stacks = NULL;
+    rt->guard_exhausted = 0;
+}
+
+static void runtime_init(KCoroRuntime *rt) {
+    if (rt->stack_size != 0) {
+        return;
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    const char *env = getenv("KERNEL_CORO_STACK_KB");
+    size_t size = env != NULL && atoi(env) > 0 ? (size_t)atoi(env) * 1024 : KCORO_DEFAULT_STACK_SIZE;
+
+    rt->page_size = page > 0 ? (size_t)page : 4096;
+    rt->stack_size = (size + rt->page_size - 1) & ~(rt->page_size - 1);
+    rt->epfd = -1;
+    rt->tfd = -1;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 실행 대기열과 수면 힙                                                     */
+/* ------------------------------------------------------------------------ */
+
+static inline void ready_push(KCoroRuntime *rt, KCoro *coro) {
+    coro->state = KCORO_READY;
+    coro->next = NULL;
+    if (rt->ready_tail != NULL) {
+        rt->ready_tail->next = coro;
+    } else {
+        rt->ready_head = coro;
+    }
+    rt->ready_tail = coro;
+}
+
+static inline KCoro *ready_pop(KCoroRuntime *rt) {
+    KCoro *coro = rt->ready_head;
+    if (coro != NULL) {
+        rt->ready_head = coro->next;
+        if (rt->ready_head == NULL) {
+            rt->ready_tail = NULL;
+        }
+    }
+    return coro;
+}
+
+static void heap_swap(KCoroRuntime *rt, size_t a, size_t b) {
+    KCoro *tmp = rt->heap[a];
+    rt->heap[a] = rt->heap[b];
+    rt->heap[b] = tmp;
+    rt->heap[a]->heap_index = (int)a;
+    rt->heap[b]->heap_index = (int)b;
+}
+
+static void heap_sift_up(KCoroRuntime *rt, size_t i) {
+    while (i > 0 && rt->heap[(i - 1) / 2]->wake_ns > rt->heap[i]->wake_ns) {
+        heap_swap(rt, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void heap_sift_down(KCoroRuntime *rt, size_t i) {
+    for (;;) {
+        size_t left = 2 * i + 1;
+        size_t smallest = i;
+        if (left < rt->heap_len && rt->heap[left]->wake_ns < rt->heap[smallest]->wake_ns) {
+            smallest = left;
+        }
+        if (left + 1 < rt->heap_len && rt->heap[left + 1]->wake_ns < rt->heap[smallest]->wake_ns) {
+            smallest = left + 1;
+        }
+        if (smallest == i) {
+            return;
+        }
+        heap_swap(rt, i, smallest);
+        i = smallest;
+    }
+}
+
+static int heap_push(KCoroRuntime *rt, KCoro *coro, uint64_t wake_ns) {
+    if (rt->heap_len == rt->heap_cap) {
+        size_t cap = rt->heap_cap ? rt->heap_cap * 2 : 256;
+        KCoro **heap = (KCoro **)realloc(rt->heap, cap * sizeof(KCoro *));
+        if (heap == NULL) {
+            kernel_errMsg("코루틴 수면 힙 할당 실패");
+            return -1;
+        }
+        rt->heap = heap;
+        rt->heap_cap = cap;
+    }
+    coro->wake_ns = wake_ns;
+    coro->heap_index = (int)rt->heap_len;
+    rt->heap[rt->heap_len++] = coro;
+    heap_sift_up(rt, rt->heap_len - 1);
+    return 0;
+}
+
+static void heap_remove(KCoroRuntime *rt, KCoro *coro) {
+    size_t i = (size_t)coro->heap_index;
+
+    coro->heap_index = -1;
+    rt->heap_len--;
+    if (i == rt->heap_len) {
+        return;
+    }
+    rt->heap[i] = rt->heap[rt->heap_len];
+    rt->heap[i]->heap_index = (int)i;
+    heap_sift_down(rt, i);
+    heap_sift_up(rt, i);
+}
+
+/* ------------------------------------------------------------------------ */
+/* fd 대기                                                                   */
+/* ------------------------------------------------------------------------ */
+
+static int events_open(KCoroRuntime *rt) {
+    if (rt->events_ready) {
+        return 0;
+    }
+#ifdef __linux__
+    rt->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (rt->epfd == -1) {
+        kernel_errMsg("epoll_create1 실패");
+        return -1;
+    }
+    rt->tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = NULL };
+    if (rt->tfd == -1 || epoll_ctl(rt->epfd, EPOLL_CTL_ADD, rt->tfd, &ev) == -1) {
+        kernel_errMsg("코루틴 타이머 준비 실패");
+        close(rt->epfd);
+        if (rt->tfd != -1) {
+            close(rt->tfd);
+        }
+        rt->epfd = rt->tfd = -1;
+        return -1;
+    }
+    rt->armed_ns = 0;
+#endif
+    rt->events_ready = 1;
+    return 0;
+}
+
+static void events_close(KCoroRuntime *rt) {
+    if (!rt->events_ready) {
+        return;
+    }
+#ifdef __linux__
+    close(rt->epfd);
+    close(rt->tfd);
+    rt->epfd = rt->tfd = -1;
+#endif
+    free(rt->waiters);
+    rt->waiters = NULL;
+    rt->num_waiters = rt->cap_waiters = 0;
+    rt->events_ready = 0;
+}
+
+/**
+ * @brief 코루틴을 fd 대기 상태로 등록하는 함수
+ */
+static int waiter_add(KCoroRuntime *rt, KCoro *coro, int fd, uint32_t events) {
+    if (events_open(rt) != 0) {
+        return -1;
+    }
+#ifdef __linux__
+    struct epoll_event ev = { .events = events | EPOLLONESHOT, .data.ptr = coro };
+    // 이전에 등록했던 fd는 EPOLLONESHOT으로 비활성 상태이므로 다시 활성화
+    if (epoll_ctl(rt->epfd, EPOLL_CTL_MOD, fd, &ev) == -1 &&
+        (errno != ENOENT || epoll_ctl(rt->epfd, EPOLL_CTL_ADD, fd, &ev) == -1)) {
+        return -1;
+    }
+#else
+    if (rt->num_waiters == rt->cap_waiters) {
+        size_t cap = rt->cap_waiters ? rt->cap_waiters * 2 : 64;
+        KCoro **waiters = (KCoro **)realloc(rt->waiters, cap * sizeof(KCoro *));
+        if (waiters == NULL) {
+            errno = ENOMEM;
+            return -1;
+        }
+        rt->waiters = waiters;
+        rt->cap_waiters = cap;
+    }
+    coro->wait_index = (int)rt->num_waiters;
+    rt->waiters[rt->num_waiters++] = coro;
+#endif
+    coro->wait_fd = fd;
+    coro->wait_events = events;
+    coro->ready_events = 0;
+    rt->fd_waiters++;
+    return 0;
+}
+
+/**
+ * @brief fd 대기를 끝내는 함수 (시간 초과 시에는 등록도 해제)
+ */
+static void waiter_remove(KCoroRuntime *rt, KCoro *coro, int timed_out) {
+#ifdef __linux__
+    if (timed_out) {
+        epoll_ctl(rt->epfd, EPOLL_CTL_DEL, coro->wait_fd, NULL);
+    }
+#else
+    (void)timed_out;
+    size_t i = (size_t)coro->wait_index;
+    rt->waiters[i] = rt->waiters[--rt->num_waiters];
+    rt->waiters[i]->wait_index = (int)i;
+#endif
+    coro->wait_fd = -1;
+    rt->fd_waiters--;
+}
+
+/**
+ * @brief 마감이 지난 수면/대기 코루틴을 실행 대기열로 옮기는 함수
+ */
+static void expire_sleepers(KCoroRuntime *rt) {
+    if (rt->heap_len == 0) {
+        return;
+    }
+    uint64_t now = kernel_now_ns();
+    while (rt->heap_len > 0 && rt->heap[0]->wake_ns <= now) {
+        KCoro *coro = rt->heap[0];
+        heap_remove(rt, coro);
+        if (coro->state == KCORO_WAITING) {
+            waiter_remove(rt, coro, 1);
+            coro->ready_events = 0;
+        }
+        ready_push(rt, coro);
+    }
+}
+
+/**
+ * @brief 준비된 fd를 확인해 대기 코루틴을 깨우는 함수
+ *
+ * @param block 실행할 코루틴이 없으면 1 (다음 마감 또는 fd 이벤트까지 대기)
+ * @return 성공 시 0, 실패 시 -1
+ */
+static int poll_events(KCoroRuntime *rt, int block) {
+#ifdef __linux__
+    struct epoll_event events[KCORO_MAX_EVENTS];
+    int timeout = 0;
+
+    if (block) {
+        timeout = -1;
+        uint64_t deadline = rt->heap_len > 0 ? rt->heap[0]->wake_ns : 0;
+        if (deadline != rt->armed_ns) {
+            struct itimerspec its;
+            memset(&its, 0, sizeof(its));
+            its.it_value.tv_sec = (time_t)(deadline / 1000000000ULL);
+            its.it_value.tv_nsec = (long)(deadline % 1000000000ULL);
+            if (timerfd_settime(rt->tfd, TFD_TIMER_ABSTIME, &its, NULL) == -1) {
+                kernel_errMsg("코루틴 타이머 설정 실패");
+                return -1;
+            }
+            rt->armed_ns = deadline;
+        }
+    }
+
+    rt->stats.polls++;
+    int n = epoll_wait(rt->epfd, events, KCORO_MAX_EVENTS, timeout);
+    if (n == -1) {
+        return errno == EINTR ? 0 : -1;
+    }
+    for (int i = 0; i < n; i++) {
+        KCoro *coro = (KCoro *)events[i].data.ptr;
+        if (coro == NULL) {
+            uint64_t expirations;
+            if (read(rt->tfd, &expirations, sizeof(expirations)) < 0) {
+                // 이미 읽었거나 다시 설정되어 만료가 없음
+            }
+            rt->armed_ns = 0;
+            continue;
+        }
+        if (coro->heap_index >= 0) {
+            heap_remove(rt, coro);
+        }
+        waiter_remove(rt, coro, 0);
+        coro->ready_events = events[i].events & (EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP);
+        ready_push(rt, coro);
+    }
+#else
+    int timeout = 0;
+    if (block && rt->heap_len > 0) {
+        uint64_t now = kernel_now_ns();
+        uint64_t deadline = rt->heap[0]->wake_ns;
+        timeout = deadline > now ? (int)((deadline - now + 999999) / 1000000) : 0;
+    } else if (block) {
+        timeout = -1;
+    }
+
+    struct pollfd *fds = (struct pollfd *)malloc((rt->num_waiters + 1) * sizeof(struct pollfd));
+    if (fds == NULL) {
+        return -1;
+    }
+    size_t count = rt->num_waiters;
+    for (size_t i = 0; i < count; i++) {
+        fds[i].fd = rt->waiters[i]->wait_fd;
+        fds[i].events = (short)rt->waiters[i]->wait_events;
+        fds[i].revents = 0;
+    }
+
+    rt->stats.polls++;
+    int n = poll(fds, (nfds_t)count, timeout);
+    if (n == -1) {
+        free(fds);
+        return errno == EINTR ? 0 : -1;
+    }
+    // 뒤에서부터 제거해야 앞쪽 인덱스가 유지됨
+    for (size_t i = count; n > 0 && i-- > 0;) {
+        if (fds[i].revents == 0) {
+            continue;
+        }
+        KCoro *coro = rt->waiters[i];
+        if (coro->heap_index >= 0) {
+            heap_remove(rt, coro);
+        }
+        waiter_remove(rt, coro, 0);
+        coro->ready_events = (uint32_t)fds[i].revents;
+        ready_push(rt, coro);
+        n--;
+    }
+    free(fds);
+#endif
+    return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 공개 API                                                                  */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 호출 스레드의 런타임에 코루틴을 만드는 함수
+ *
+ * @param func 코루틴 본문
+ * @param arg 본문 인자
+ * @return 코루틴 ID, 스택을 할당할 수 없으면 -1
+ */
+long kcoro_spawn(KCoroFunc func, void *arg) {
+    KCoroRuntime *rt = &runtime;
+
+    runtime_init(rt);
+    if (rt->free_stacks == NULL && stack_slab_alloc(rt) != 0) {
+        return -1;
+    }
+
+    KCoro *coro = rt->free_stacks;
+    rt->free_stacks = coro->next;
+
+    char *stack = coro->stack;
+    memset(coro, 0, sizeof(*coro));
+    coro->stack = stack;
+    coro->func = func;
+    coro->arg = arg;
+    coro->id = ++rt->next_id;
+    coro->heap_index = -1;
+    coro->wait_fd = -1;
+
+#ifdef KCORO_USE_UCONTEXT
+    uctx_init(coro);
+#else
+    coro->sp = frame_init((char *)coro, coro, coro_entry);
+#endif
+
+    rt->live++;
+    rt->stats.spawned++;
+    if (rt->live > rt->stats.peak_live) {
+        rt->stats.peak_live = rt->live;
+    }
+    ready_push(rt, coro);
+    return coro->id;
+}
+
+/**
+ * @brief 호출 스레드의 코루틴을 모두 끝날 때까지 실행하는 함수
+ *
+ * @return 모든 코루틴이 끝나면 0, 실패 시 -1
+ */
+int kcoro_run(void) {
+    KCoroRuntime *rt = &runtime;
+    int ret = 0;
+
+    if (rt->current != NULL) {
+        return -1;
+    }
+    runtime_init(rt);
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "코루틴 실행 시작 (대기 중: %llu)", (unsigned long long)rt->live);
+
+    while (rt->live > 0) {
+        // 이번 묶음에 들어 있던 코루틴만 실행 (도중에 양보한 코루틴은 다음 묶음)
+        KCoro *batch_tail = rt->ready_tail;
+        KCoro *coro;
+        while (batch_tail != NULL && (coro = ready_pop(rt)) != NULL) {
+            switch_to_coro(rt, coro);
+            if (coro->state == KCORO_DONE) {
+                coro->next = rt->free_stacks;
+                rt->free_stacks = coro;
+                rt->live--;
+            }
+            if (coro == batch_tail) {
+                break;
+            }
+        }
+        if (rt->live == 0) {
+            break;
+        }
+
+        expire_sleepers(rt);
+        int idle = rt->ready_head == NULL;
+        if (idle && rt->heap_len == 0 && rt->fd_waiters == 0) {
+            kernel_errMsg("실행할 수 있는 코루틴이 없음 (남은 코루틴: %llu)", (unsigned long long)rt->live);
+            ret = -1;
+            break;
+        }
+        if (rt->fd_waiters > 0 || idle) {
+            if (events_open(rt) != 0 || poll_events(rt, idle) != 0) {
+                kernel_errMsg("코루틴 이벤트 대기 실패");
+                ret = -1;
+                break;
+            }
+        }
+    }
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "코루틴 실행 종료 (전환: %llu, 스택: %llu)",
+           (unsigned long long)rt->stats.switches, (unsigned long long)rt->stats.stacks);
+    events_close(rt);
+    stack_pool_release(rt);
+    rt->ready_head = rt->ready_tail = NULL;
+    rt->heap_len = 0;
+    free(rt->heap);
+    rt->heap = NULL;
+    rt->heap_cap = 0;
+    rt->live = 0;
+    rt->fd_waiters = 0;
+    return ret;
+}
+
+/**
+ * @brief 실행 중인 코루틴의 ID를 반환하는 함수
+ */
+long kcoro_self(void) {
+    return runtime.current != NULL ? runtime.current->id : 0;
+}
+
+/**
+ * @brief 실행 대기 중인 다른 코루틴에게 양보하는 함수
+ */
+void kcoro_yield(void) {
+    KCoroRuntime *rt = &runtime;
+    KCoro *coro = rt->current;
+
+    if (coro == NULL) {
+        return;
+    }
+    ready_push(rt, coro);
+    switch_to_main(rt, coro);
+}
+
+/**
+ * @brief 현재 코루틴을 지정한 시간 동안 재우는 함수
+ *
+ * @param usec 대기 시간 (마이크로초)
+ */
+void kcoro_sleep_us(uint64_t usec) {
+    KCoroRuntime *rt = &runtime;
+    KCoro *coro = rt->current;
+
+    if (coro == NULL) {
+        struct timespec ts = { (time_t)(usec / 1000000), (long)(usec % 1000000) * 1000 };
+        while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {
+        }
+        return;
+    }
+    if (heap_push(rt, coro, kernel_now_ns() + usec * 1000ULL) != 0) {
+        kcoro_yield();
+        return;
+    }
+    coro->state = KCORO_SLEEPING;
+    switch_to_main(rt, coro);
+}
+
+/**
+ * @brief fd가 준비될 때까지 현재 코루틴을 재우는 함수
+ *
+ * @param fd 파일 디스크립터
+ * @param events KCORO_READABLE / KCORO_WRITABLE 조합
+ * @param timeout_us 최대 대기 시간 (마이크로초, 음수면 무한)
+ * @return 준비된 이벤트 비트, 시간 초과면 0, 실패 시 -1
+ */
+int kcoro_wait_fd(int fd, uint32_t events, int64_t timeout_us) {
+    KCoroRuntime *rt = &runtime;
+    KCoro *coro = rt->current;
+
+    if (coro == NULL) {
+        struct pollfd pfd = { .fd = fd, .events = (short)events, .revents = 0 };
+        int timeout = timeout_us < 0 ? -1 : (int)((timeout_us + 999) / 1000);
+        int n;
+        while ((n = poll(&pfd, 1, timeout)) == -1 && errno == EINTR) {
+        }
+        return n < 0 ? -1 : n == 0 ? 0 : (int)pfd.revents;
+    }
+
+    if (waiter_add(rt, coro, fd, events) != 0) {
+        return -1;
+    }
+    if (timeout_us >= 0 && heap_push(rt, coro, kernel_now_ns() + (uint64_t)timeout_us * 1000ULL) != 0) {
+        waiter_remove(rt, coro, 1);
+        return -1;
+    }
+    coro->state = KCORO_WAITING;
+    switch_to_main(rt, coro);
+    return (int)coro->ready_events;
+}
+
+/**
+ * @brief 호출 스레드 런타임의 누적 통계를 복사하는 함수
+ *
+ * @param stats 결과를 저장할 위치
+ */
+void kcoro_get_stats(KCoroStats *stats) {
+    *stats = runtime.stats;
+}
@@ -11,6 +11,10 @@
 
 #include "kernel_engine.h"
 #include "kernel_print.h"
+#include "kernel_trace.h"
+#include "kernel_pool.h"
+#include "kernel_log.h"
+#include "kernel_contention.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -23,49 +27,86 @@
 
 #define BUF_SIZE 500
 
+/* run_multithreading의 측정 설정 (임계 구역 1us, 유휴 1us, 200ms) */
+#define RUN_MULTITHREADING_HOLD_NS 1000
+#define RUN_MULTITHREADING_IDLE_NS 1000
+#define RUN_MULTITHREADING_DURATION_MS 200
+
 /**
  * @brief 스레드 안전한 출력 함수
  * 
+ * 전역 잠금과 호출마다의 fflush 대신 스레드별 줄 버퍼와 백그라운드 플러셔를 사용합니다.
+ * 
  * @param format 포맷 문자열
  * @param ... 가변 인자 리스트
  */
 void safe_kernel_printf(const char *format, ...) {
     va_list args;
     va_start(args, format);
+    kernel_vlogf(format, args);
+    va_end(args);
 
-    pthread_mutex_lock(&print_mutex);  // 출력 뮤텍스 잠금
-    vprintf(format, args);  // 커널 printf 함수 호출
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);  // 출력 뮤텍스 해제
+    // 줄바꿈 없이 끝나는 출력은 사용자가 바로 봐야 하는 경우가 많으므로 즉시 내보냄
+    if (kernel_log_partial()) {
+        kernel_log_flush();
+    }
+}
 
-    va_end(args);
+/**
+ * @brief 스레드 함수들을 공용 스레드 풀에서 실행하고 모두 끝날 때까지 대기하는 함수
+ *
+ * 함수들이 서로를 기다릴 수 있으므로 유휴 작업자를 함수 수만큼 확보하는 묶음 제출을 사용하며,
+ * 확보할 수 없으면 교착 대신 즉시 종료합니다.
+ *
+ * @param num_threads 실행할 함수 수
+ * @param arg 각 함수에 전달할 인자
+ * @param args 스레드 함수 포인터 목록
+ */
+static void run_on_engine_pool(int num_threads, void *arg, va_list args) {
+    ThreadPool *pool = kernel_engine_pool();
+    KWaitGroup wg = KWAIT_GROUP_INIT;
+    KernelTaskFunc funcs[KERNEL_POOL_MAX_THREADS];
+
+    if (num_threads > KERNEL_POOL_MAX_THREADS) {
+        kernel_errExit("스레드 수 %d가 한도 %d를 넘음", num_threads, KERNEL_POOL_MAX_THREADS);
+    }
+    for (int i = 0; i < num_threads; i++) {
+        funcs[i] = va_arg(args, KernelTaskFunc);
+    }
+    if (thread_pool_submit_concurrent(pool, funcs, num_threads, arg, &wg) != 0) {
+        kernel_errExit("스레드 %d개 동시 작업 제출 실패", num_threads);
+    }
+
+    wait_group_wait(&wg);
 }
 
 /**
  * @brief 스레드 생성 함수
+ *
+ * 매번 스레드를 만들고 join하는 대신 엔진 공용 스레드 풀의 작업자를 재사용합니다.
  * 
  * @param num_threads 생성할 스레드 수
  * @param ... 스레드 함수 포인터
  */
 void create_threads(int num_threads, ...) {
-    pthread_t* threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
     va_list args;
     va_start(args, num_threads);
+    run_on_engine_pool(num_threads, NULL, args);
+    va_end(args);
+}
 
-    for (int i = 0; i < num_threads; i++) {
-        void* (*thread_func)(void*) = va_arg(args, void* (*)(void*));
-        int err = pthread_create(&threads[i], NULL, thread_func, NULL);
-        if (err != 0) {
-            kernel_errExitEN(err, "스레드 %d 생성 실패", i);
-        }
-    }
-
-    for (int i = 0; i < num_threads; i++) {
-        pthread_join(threads[i], NULL);
-    }
-
+/**
+ * @brief 같은 인자를 전달하는 스레드 생성 함수
+ *
+ * @param num_threads 생성할 스레드 수
+ * @param arg 각 스레드 함수에 전달할 인자
+ * @param ... 스레드 함수 포인터
+ */
+void create_threads_with_arg(int num_threads, void *arg, ...) {
+    va_list args;
+    va_start(args, arg);
+    run_on_engine_pool(num_threads, arg, args);
     va_end(args);
-    free(threads);
 }
 
 /**
@@ -81,7 +122,8 @@ void create_single_process(void (*func)()) {
         func();
         exit(EXIT_SUCCESS);
     } else {
-        wait(NULL);
+        // 다른 자식 (예: 프로세스 풀 작업자)을 회수하지 않도록 자신이 만든 자식만 대기
+        waitpid(pid, NULL, 0);
     }
 }
 
@@ -95,21 +137,28 @@ void create_multi_processes(int num_processes, ...) {
     va_list args;
     va_start(args, num_processes);
 
+    pid_t *pids = (pid_t *)malloc(sizeof(pid_t) * (num_processes > 0 ? (size_t)num_processes : 1));
+    if (pids == NULL) {
+        kernel_errExit("프로세스 목록 메모리 할당 실패");
+    }
+
     for (int i = 0; i < num_processes; i++) {
+        void (*process_func)() = va_arg(args, void (*)());
         pid_t pid = fork();
         if (pid < 0) {
             kernel_errExit("프로세스 %d 생성 실패", i);
         } else if (pid == 0) {
-            void (*process_func)() = va_arg(args, void (*)());
             process_func();
             exit(EXIT_SUCCESS);
         }
+        pids[i] = pid;
     }
 
     for (int i = 0; i < num_processes; i++) {
-        wait(NULL);
+        waitpid(pids[i], NULL, 0);
     }
 
+    free(pids);
     va_end(args);
 }
 
@@ -162,6 +211,44 @@ pthread_mutex_t* init_mutex() {
     return mutex;
 }
 
+/**
+ * @brief 빈 청크를 꺼내거나 새로 할당하는 함수
+ * 
+ * @param list LinkedList 포인터
+ * @return 비어 있는 청크
+ */
+static ListChunk* chunk_acquire(LinkedList* list) {
+    ListChunk* chunk = list->free_chunks;
+    if (chunk != NULL) {
+        list->free_chunks = chunk->next;
+        list->free_count--;
+    } else {
+        chunk = (ListChunk*)malloc(sizeof(ListChunk));
+        if (chunk == NULL) {
+            kernel_errExit("연결 리스트 청크 메모리 할당 실패");
+        }
+    }
+    chunk->next = NULL;
+    chunk->begin = chunk->end = 0;
+    return chunk;
+}
+
+/**
+ * @brief 다 쓴 청크를 빈 청크 목록에 반납하는 함수 (목록이 가득 차면 해제)
+ * 
+ * @param list LinkedList 포인터
+ * @param chunk 반납할 청크
+ */
+static void chunk_release(LinkedList* list, ListChunk* chunk) {
+    if (list->free_count >= LINKEDLIST_FREE_CHUNKS) {
+        free(chunk);
+        return;
+    }
+    chunk->next = list->free_chunks;
+    list->free_chunks = chunk;
+    list->free_count++;
+}
+
 /**
  * @brief 연결 리스트 생성 함수
  * 
@@ -169,28 +256,38 @@ pthread_mutex_t* init_mutex() {
  */
 LinkedList* create_linkedlist() {
     LinkedList* list = (LinkedList*)malloc(sizeof(LinkedList));
+    if (list == NULL) {
+        kernel_errExit("연결 리스트 메모리 할당 실패");
+    }
     list->head = list->tail = NULL;
     list->size = 0;
+    list->free_chunks = NULL;
+    list->free_count = 0;
     return list;
 }
 
 /**
  * @brief 연결 리스트에 요소 추가 함수
  * 
+ * 마지막 청크에 빈 칸이 있으면 할당 없이 저장합니다.
+ * 
  * @param list LinkedList 포인터
  * @param data 추가할 데이터
  */
 void push(LinkedList* list, void* data) {
-    Node* new_node = (Node*)malloc(sizeof(Node));
-    new_node->data = data;
-    new_node->next = NULL;
+    ListChunk* tail = list->tail;
 
-    if (is_empty(list)) {
-        list->head = list->tail = new_node;
-    } else {
-        list->tail->next = new_node;
-        list->tail = new_node;
+    if (tail == NULL || tail->end == LINKEDLIST_CHUNK_SLOTS) {
+        ListChunk* chunk = chunk_acquire(list);
+        if (tail == NULL) {
+            list->head = chunk;
+        } else {
+            tail->next = chunk;
+        }
+        list->tail = tail = chunk;
     }
+
+    tail->slots[tail->end++] = data;
     list->size++;
 }
 
@@ -206,17 +303,91 @@ void* pop(LinkedList* list) {
         return NULL;
     }
 
-    Node* temp = list->head;
-    void* data = temp->data;
-    list->head = list->head->next;
+    ListChunk* head = list->head;
+    void* data = head->slots[head->begin++];
+    list->size--;
+
+    if (head->begin == head->end) {
+        list->head = head->next;
+        if (list->head == NULL) {
+            list->tail = NULL;
+        }
+        chunk_release(list, head);
+    }
+    return data;
+}
+
+/**
+ * @brief 연결 리스트에 여러 요소를 순서대로 추가하는 함수
+ * 
+ * @param list LinkedList 포인터
+ * @param data 추가할 데이터 배열
+ * @param count 추가할 요소 수
+ */
+void push_n(LinkedList* list, void* const* data, size_t count) {
+    while (count > 0) {
+        ListChunk* tail = list->tail;
+        if (tail == NULL || tail->end == LINKEDLIST_CHUNK_SLOTS) {
+            push(list, *data++);
+            count--;
+            continue;
+        }
 
-    if (list->head == NULL) {
-        list->tail = NULL;
+        size_t room = (size_t)(LINKEDLIST_CHUNK_SLOTS - tail->end);
+        size_t n = count < room ? count : room;
+        memcpy(&tail->slots[tail->end], data, n * sizeof(void*));
+        tail->end += (int)n;
+        list->size += (int)n;
+        data += n;
+        count -= n;
     }
+}
 
-    free(temp);
-    list->size--;
-    return data;
+/**
+ * @brief 연결 리스트에서 최대 max_count개의 요소를 꺼내는 함수
+ * 
+ * @param list LinkedList 포인터
+ * @param out 꺼낸 데이터를 저장할 배열
+ * @param max_count 꺼낼 최대 요소 수
+ * @return 실제로 꺼낸 요소 수
+ */
+size_t pop_n(LinkedList* list, void** out, size_t max_count) {
+    size_t taken = 0;
+
+    while (taken < max_count && list->head != NULL) {
+        ListChunk* head = list->head;
+        size_t avail = (size_t)(head->end - head->begin);
+        size_t n = (max_count - taken) < avail ? (max_count - taken) : avail;
+
+        memcpy(out + taken, &head->slots[head->begin], n * sizeof(void*));
+        head->begin += (int)n;
+        list->size -= (int)n;
+        taken += n;
+
+        if (head->begin == head->end) {
+            list->head = head->next;
+            if (list->head == NULL) {
+                list->tail = NULL;
+            }
+            chunk_release(list, head);
+        }
+    }
+    return taken;
+}
+
+/**
+ * @brief 연결 리스트의 요소를 앞에서부터 순회하는 함수
+ * 
+ * @param list LinkedList 포인터
+ * @param func 요소마다 호출할 함수
+ * @param ctx 함수에 전달할 사용자 데이터
+ */
+void linkedlist_for_each(LinkedList* list, void (*func)(void* data, void* ctx), void* ctx) {
+    for (ListChunk* chunk = list->head; chunk != NULL; chunk = chunk->next) {
+        for (int i = chunk->begin; i < chunk->end; i++) {
+            func(chunk->slots[i], ctx);
+        }
+    }
 }
 
 /**
@@ -233,11 +404,23 @@ bool is_empty(LinkedList* list) {
 /**
  * @brief 연결 리스트 삭제 함수
  * 
+ * 원소 단위가 아니라 청크 단위로 해제합니다.
+ * 
  * @param list LinkedList 포인터
  */
 void destroy_linkedlist(LinkedList* list) {
-    while (!is_empty(list)) {
-        pop(list);
+    ListChunk* chunk = list->head;
+    while (chunk != NULL) {
+        ListChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    chunk = list->free_chunks;
+    while (chunk != NULL) {
+        ListChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
     }
     free(list);
 }
@@ -250,6 +433,9 @@ void destroy_linkedlist(LinkedList* list) {
 static void terminate(bool useExit3) {
     char *s = getenv("EF_DUMPCORE");
 
+    // _exit와 abort는 atexit 처리기를 거치지 않으므로 버퍼링된 로그를 먼저 출력
+    kernel_log_flush();
+
     if (s != NULL && *s != '\0')
         abort();
     else if (useExit3)
@@ -280,8 +466,10 @@ static void outputError(bool useErr, int err, bool flushStdout, const char *form
 
     snprintf(buf, BUF_SIZE, "ERROR%s %s\n", errText, userMsg);
 
-    if (flushStdout)
+    if (flushStdout) {
         fflush(stdout);
+        kernel_log_flush();
+    }
 
     fputs(buf, stderr);
     fflush(stderr);
@@ -393,6 +581,16 @@ void kernel_cmdLineErr(const char *format, ...) {
     exit(EXIT_FAILURE);
 }
 
+/* semaphore_thread / mutex_thread의 임계 구역 길이 (ns) */
+static unsigned sync_hold_ns = 1000000;
+
+/**
+ * @brief semaphore_thread / mutex_thread가 잠금을 쥔 채 일하는 시간을 설정하는 함수
+ */
+void kernel_sync_hold_configure(unsigned hold_ns) {
+    __atomic_store_n(&sync_hold_ns, hold_ns, __ATOMIC_RELAXED);
+}
+
 /**
  * @brief 세마포어를 사용하는 스레드 작업 함수
  * 
@@ -402,17 +600,17 @@ void kernel_cmdLineErr(const char *format, ...) {
 void* semaphore_thread(void* arg) {
     sem_t* semaphore = (sem_t*)arg;
 
-    safe_kernel_printf("세마포어 대기\n");
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "세마포어 대기");
     sem_wait(semaphore);
-    safe_kernel_printf("세마포어 획득\n");
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "세마포어 획득");
 
-    sleep(1);  // 작업을 모방하기 위한 대기 시간
+    // 초 단위 sleep 대신 경합 측정과 같은 보정된 바쁜 대기로 작업을 모방
+    contention_busy_wait(__atomic_load_n(&sync_hold_ns, __ATOMIC_RELAXED));
 
-    sem_post(semaphore);  // 세마포어 해제
-    if(sem_post(semaphore) == -1) {
+    if(sem_post(semaphore) == -1) {  // 세마포어 해제
         kernel_errExit("세마포어 해제 실패");
     } else {
-        safe_kernel_printf("세마포어 해제\n");
+        KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "세마포어 해제");
     }
 
     return NULL;
@@ -427,17 +625,16 @@ void* semaphore_thread(void* arg) {
 void* mutex_thread(void* arg) {
     pthread_mutex_t* mutex = (pthread_mutex_t*)arg;
 
-    safe_kernel_printf("뮤텍스 대기\n");
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "뮤텍스 대기");
     pthread_mutex_lock(mutex);  // 뮤텍스 잠금
-    safe_kernel_printf("뮤텍스 획득\n");
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "뮤텍스 획득");
     
-    sleep(1);  // 작업을 모방하기 위한 대기 시간
+    contention_busy_wait(__atomic_load_n(&sync_hold_ns, __ATOMIC_RELAXED));
     
-    safe_kernel_printf("뮤텍스 해제\n");
     if(pthread_mutex_unlock(mutex) != 0) {
         kernel_errExit("뮤텍스 해제 실패");
     } else {
-        safe_kernel_printf("뮤텍스 해제\n");
+        KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_DEBUG, "뮤텍스 해제");
     }
     
     return NULL;
@@ -446,6 +643,9 @@ void* mutex_thread(void* arg) {
 /**
  * @brief 멀티스레드 실행 함수 (쓰레드 수 및 동기화 방법을 입력받음)
  * 
+ * kernel_contention.h의 경합 측정으로 세마포어 또는 뮤텍스를 측정하고 결과를 출력합니다.
+ * 측정 스레드는 KERNEL_PLACEMENT 환경 변수의 배치를 따릅니다.
+ * 
  * @param num_threads 생성할 스레드 수
  * @param use_semaphore 세마포어 사용 여부
  * @param ... 동기화 방법 (세마포어 또는 뮤텍스)
@@ -456,67 +656,28 @@ void run_multithreading(int num_threads, int use_semaphore, ...) {
         return;
     }
 
-    safe_kernel_printf("멀티스레드 실행 시작 (쓰레드 수: %d, 동기화 방법: %s)\n",
-                       num_threads, use_semaphore ? "세마포어" : "뮤텍스");
-
-    pthread_t* threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
-    int* thread_ids = (int*)malloc(num_threads * sizeof(int));
-    va_list args;
-
-    sem_t* semaphore = NULL;
-    pthread_mutex_t* mutex = NULL;
-
-    if (use_semaphore) {
-        semaphore = init_semaphore(1);  // 세마포어 초기화
-        safe_kernel_printf("세마포어 초기화 완료\n");
-        kernel_printf("세마포어 초기화 완료\n");
-    } else {
-        mutex = init_mutex();  // 뮤텍스 초기화
-        safe_kernel_printf("뮤텍스 초기화 완료\n");
-        kernel_printf("뮤텍스 초기화 완료\n");
-    }
-
-    va_start(args, use_semaphore);
-    for (int i = 0; i < num_threads; i++) {
-        thread_ids[i] = i + 1;
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "멀티스레드 실행 시작 (쓰레드 수: %d, 동기화 방법: %s)",
+           num_threads, use_semaphore ? "세마포어" : "뮤텍스");
 
-        if (use_semaphore) {
-            int err = pthread_create(&threads[i], NULL, semaphore_thread, semaphore);
-            if (err != 0) {
-                kernel_errExitEN(err, "스레드 %d 생성 실패", i);
-            }
-        } else {
-            int err = pthread_create(&threads[i], NULL, mutex_thread, mutex);
-            if (err != 0) {
-                kernel_errExitEN(err, "스레드 %d 생성 실패", i);
-            }
-        }
-    }
-    va_end(args);
+    KPlacement placement;
+    kplacement_from_env(&placement, NULL);
 
-    for (int i = 0; i < num_threads; i++) {
-        pthread_join(threads[i], NULL);
-    }
+    KContentionConfig config = {
+        .num_threads = num_threads,
+        .hold_ns = RUN_MULTITHREADING_HOLD_NS,
+        .idle_ns = RUN_MULTITHREADING_IDLE_NS,
+        .duration_ms = RUN_MULTITHREADING_DURATION_MS,
+        .placement = &placement,
+    };
+    KContentionResult result;
+    char report[4096];
 
-    // 세마포어 또는 뮤텍스 해제
-    if (use_semaphore) {
-#ifdef __APPLE__
-        sem_close(semaphore);
-        sem_unlink("/semaphore");
-        safe_kernel_printf("세마포어 해제 완료 (macOS)\n");
-#else
-        sem_destroy(semaphore);
-        free(semaphore);
-        safe_kernel_printf("세마포어 해제 완료 (Linux)\n");
-#endif
-    } else {
-        pthread_mutex_destroy(mutex);
-        free(mutex);
-        safe_kernel_printf("뮤텍스 해제 완료\n");
+    if (contention_run(use_semaphore ? KLOCK_SEMAPHORE : KLOCK_MUTEX, &config, &result) != 0) {
+        kernel_errMsg("경합 측정 실패");
+        return;
     }
+    contention_format_result(&result, report, sizeof(report));
+    safe_kernel_printf("%s", report);
 
-    free(threads);
-    free(thread_ids);
-
-    safe_kernel_printf("멀티스레드 실행 종료\n");
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "멀티스레드 실행 종료");
 }
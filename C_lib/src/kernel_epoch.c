@@ -0,0 +1,301 @@
+/*
+ * Epoch-Based Reclamation
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the global epoch, per-thread reader records and
+ *             per-thread limbo lists used to defer frees until no reader
+ *             can still hold a reference.
+ */
+
+#include "kernel_epoch.h"
+#include "kernel_engine.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+// 스레드별 limbo 리스트가 이 개수를 넘으면 회수를 시도합니다.
+#define EPOCH_COLLECT_THRESHOLD 64
+
+/**
+ * @struct EpochRetired
+ * @brief 유예 기간을 기다리는 객체 노드
+ */
+typedef struct EpochRetired {
+    void *ptr;                     /**< 해제할 객체 */
+    void (*deleter)(void *);       /**< 소멸자 함수 */
+    unsigned long epoch;           /**< 게시 해제 시점의 전역 에포크 */
+    struct EpochRetired *next;     /**< 다음 노드 */
+} EpochRetired;
+
+/**
+ * @struct EpochRecord
+ * @brief 스레드별 읽기 상태 레코드
+ *
+ * 레코드는 해제하지 않고 재사용하므로 전진 시 목록을 잠금 없이 순회할 수 있습니다.
+ * 캐시 라인 단위로 정렬하여 스레드 간 거짓 공유를 막습니다.
+ */
+typedef struct EpochRecord {
+    unsigned long state;           /**< (에포크 << 1) | 활성 비트 */
+    int in_use;                    /**< 스레드가 점유 중인지 여부 */
+    int depth;                     /**< 중첩 진입 횟수 (소유 스레드만 접근) */
+    EpochRetired *limbo;           /**< 유예 중인 객체 목록 (소유 스레드만 접근) */
+    size_t limbo_count;            /**< limbo 목록 길이 */
+    struct EpochRecord *next;      /**< 전역 레코드 목록의 다음 노드 */
+} __attribute__((aligned(64))) EpochRecord;
+
+static unsigned long global_epoch = 1;
+static EpochRecord *record_list = NULL;
+
+// 종료한 스레드가 남긴 limbo 객체 (드물게 접근하므로 뮤텍스로 보호)
+static pthread_mutex_t orphan_mutex = PTHREAD_MUTEX_INITIALIZER;
+static EpochRetired *orphan_list = NULL;
+
+static pthread_key_t epoch_key;
+static pthread_once_t epoch_once = PTHREAD_ONCE_INIT;
+static __thread EpochRecord *local_record = NULL;
+
+/**
+ * @brief 유예 기간이 지난 노드를 해제하고 남은 노드를 반환하는 함수
+ *
+ * @param list 검사할 노드 목록
+ * @param safe_epoch 이 값 이하의 에포크에 예약된 노드는 해제 가능
+ * @param freed 해제한 노드 수를 누적할 포인터
+ * @return 아직 해제할 수 없는 노드 목록
+ */
+static EpochRetired *epoch_reclaim_list(EpochRetired *list, unsigned long safe_epoch, size_t *freed) {
+    EpochRetired *keep = NULL;
+
+    while (list != NULL) {
+        EpochRetired *node = list;
+        list = list->next;
+
+        if (node->epoch <= safe_epoch) {
+            node->deleter(node->ptr);
+            free(node);
+            (*freed)++;
+        } else {
+            node->next = keep;
+            keep = node;
+        }
+    }
+    return keep;
+}
+
+/**
+ * @brief 스레드 종료 시 레코드를 반납하는 함수
+ *
+ * 남은 limbo 객체는 고아 목록으로 옮겨 다른 스레드가 회수하도록 합니다.
+ *
+ * @param arg 반납할 EpochRecord 포인터
+ */
+static void epoch_thread_exit(void *arg) {
+    EpochRecord *rec = (EpochRecord *)arg;
+
+    if (rec->limbo != NULL) {
+        EpochRetired *tail = rec->limbo;
+        while (tail->next != NULL) {
+            tail = tail->next;
+        }
+
+        pthread_mutex_lock(&orphan_mutex);
+        tail->next = orphan_list;
+        orphan_list = rec->limbo;
+        pthread_mutex_unlock(&orphan_mutex);
+    }
+
+    rec->limbo = NULL;
+    rec->limbo_count = 0;
+    rec->depth = 0;
+    __atomic_store_n(&rec->state, 0UL, __ATOMIC_RELEASE);
+    __atomic_store_n(&rec->in_use, 0, __ATOMIC_RELEASE);
+    local_record = NULL;
+}
+
+static void epoch_init_key(void) {
+    if (pthread_key_create(&epoch_key, epoch_thread_exit) != 0) {
+        kernel_errExit("에포크 스레드 키 생성 실패");
+    }
+}
+
+/**
+ * @brief 현재 스레드의 레코드를 가져오는 함수
+ *
+ * 처음 호출될 때 비어 있는 레코드를 재사용하거나 새 레코드를 목록에 추가합니다.
+ *
+ * @return 현재 스레드의 EpochRecord 포인터
+ */
+static EpochRecord *epoch_local_record(void) {
+    if (local_record != NULL) {
+        return local_record;
+    }
+
+    pthread_once(&epoch_once, epoch_init_key);
+
+    EpochRecord *rec;
+    for (rec = __atomic_load_n(&record_list, __ATOMIC_ACQUIRE); rec != NULL; rec = rec->next) {
+        int expected = 0;
+        if (__atomic_load_n(&rec->in_use, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&rec->in_use, &expected, 1, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (rec == NULL) {
+        if (posix_memalign((void **)&rec, 64, sizeof(EpochRecord)) != 0) {
+            kernel_errExit("에포크 레코드 메모리 할당 실패");
+        }
+        rec->state = 0;
+        rec->in_use = 1;
+        rec->next = __atomic_load_n(&record_list, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&record_list, &rec->next, rec, true,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+    }
+
+    rec->depth = 0;
+    rec->limbo = NULL;
+    rec->limbo_count = 0;
+    local_record = rec;
+    pthread_setspecific(epoch_key, rec);
+    return rec;
+}
+
+/**
+ * @brief 전역 에포크 전진 시도 함수
+ *
+ * 활성 상태인 모든 스레드가 현재 에포크를 관찰했을 때만 1 증가시킵니다.
+ *
+ * @return 전진했거나 다른 스레드가 이미 전진시킨 경우 true
+ */
+static bool epoch_try_advance(void) {
+    unsigned long epoch = __atomic_load_n(&global_epoch, __ATOMIC_RELAXED);
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    for (EpochRecord *rec = __atomic_load_n(&record_list, __ATOMIC_ACQUIRE); rec != NULL; rec = rec->next) {
+        unsigned long state = __atomic_load_n(&rec->state, __ATOMIC_RELAXED);
+        if ((state & 1UL) && (state >> 1) != epoch) {
+            return false;
+        }
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    __atomic_compare_exchange_n(&global_epoch, &epoch, epoch + 1, false,
+                                __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ * @brief 읽기 측 임계 구역 진입 함수
+ */
+void epoch_enter(void) {
+    EpochRecord *rec = epoch_local_record();
+
+    if (rec->depth++ == 0) {
+        unsigned long epoch = __atomic_load_n(&global_epoch, __ATOMIC_RELAXED);
+        __atomic_store_n(&rec->state, (epoch << 1) | 1UL, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+}
+
+/**
+ * @brief 읽기 측 임계 구역 종료 함수
+ */
+void epoch_exit(void) {
+    EpochRecord *rec = local_record;
+
+    if (rec == NULL || rec->depth == 0) {
+        kernel_errMsg("epoch_exit 호출이 epoch_enter와 짝이 맞지 않음");
+        return;
+    }
+
+    if (--rec->depth == 0) {
+        __atomic_store_n(&rec->state, 0UL, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief 게시 해제된 객체를 유예 기간 후 해제하도록 예약하는 함수
+ *
+ * @param ptr 해제할 객체 포인터
+ * @param deleter 소멸자 함수 (NULL이면 free)
+ */
+void epoch_retire(void *ptr, void (*deleter)(void *)) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    EpochRecord *rec = epoch_local_record();
+    EpochRetired *node = (EpochRetired *)malloc(sizeof(EpochRetired));
+    if (node == NULL) {
+        kernel_errExit("에포크 노드 메모리 할당 실패");
+    }
+
+    // 게시 해제가 끝난 뒤의 에포크를 기록해야 그 이전에 진입한 읽기 스레드를 모두 기다리게 됩니다.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    node->ptr = ptr;
+    node->deleter = deleter ? deleter : free;
+    node->epoch = __atomic_load_n(&global_epoch, __ATOMIC_ACQUIRE);
+    node->next = rec->limbo;
+    rec->limbo = node;
+
+    if (++rec->limbo_count >= EPOCH_COLLECT_THRESHOLD) {
+        epoch_collect();
+    }
+}
+
+/**
+ * @brief 에포크 전진을 시도하고 유예 기간이 지난 객체를 해제하는 함수
+ */
+void epoch_collect(void) {
+    EpochRecord *rec = epoch_local_record();
+    size_t freed = 0;
+
+    epoch_try_advance();
+
+    // 예약 시점보다 에포크가 2 이상 전진했으면 그 객체를 볼 수 있는 읽기 스레드는 남아 있지 않습니다.
+    unsigned long epoch = __atomic_load_n(&global_epoch, __ATOMIC_ACQUIRE);
+    if (epoch < 2) {
+        return;
+    }
+    unsigned long safe_epoch = epoch - 2;
+
+    rec->limbo = epoch_reclaim_list(rec->limbo, safe_epoch, &freed);
+    rec->limbo_count -= freed;
+
+    if (__atomic_load_n(&orphan_list, __ATOMIC_RELAXED) != NULL &&
+        pthread_mutex_trylock(&orphan_mutex) == 0) {
+        orphan_list = epoch_reclaim_list(orphan_list, safe_epoch, &freed);
+        pthread_mutex_unlock(&orphan_mutex);
+    }
+}
+
+/**
+ * @brief 현재까지 예약된 객체가 모두 해제될 때까지 대기하는 함수
+ */
+void epoch_synchronize(void) {
+    EpochRecord *rec = epoch_local_record();
+
+    if (rec->depth != 0) {
+        kernel_errMsg("읽기 측 임계 구역 안에서 epoch_synchronize 호출");
+        return;
+    }
+
+    unsigned long target = __atomic_load_n(&global_epoch, __ATOMIC_ACQUIRE) + 2;
+    while (__atomic_load_n(&global_epoch, __ATOMIC_ACQUIRE) < target) {
+        if (!epoch_try_advance()) {
+            sched_yield();
+        }
+    }
+
+    epoch_collect();
+
+    // 고아 목록은 trylock으로만 회수하므로 여기서는 확실히 비웁니다.
+    size_t freed = 0;
+    pthread_mutex_lock(&orphan_mutex);
+    orphan_list = epoch_reclaim_list(orphan_list, target - 2, &freed);
+    pthread_mutex_unlock(&orphan_mutex);
+}
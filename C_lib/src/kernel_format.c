@@ -0,0 +1,820 @@
+/*
+ * Kernel Format Compiler
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements kernel_format.h. fmt_compile parses a format once
+ *             into FmtOp entries; fmt_execute walks them and writes through
+ *             az_print_write, so literal text goes out as whole spans and
+ *             conversions never look back at the format string.
+ *
+ *             Cache slots hold (format pointer, program). A slot is claimed
+ *             by CAS on the key and the program is published with a release
+ *             store; readers that find the key before the program compile a
+ *             private copy for that call instead of waiting.
+ */
+
+#include "kernel_format.h"
+#include "kernel_pr_he.h"
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FmtOp.flags */
+#define FMT_LEFT  AZ_FLAG_LEFT      /* '-' */
+#define FMT_PLUS  AZ_FLAG_PLUS      /* '+' */
+#define FMT_SPACE AZ_FLAG_SPACE     /* ' ' */
+#define FMT_ZERO  AZ_FLAG_ZERO      /* '0' */
+#define FMT_ALT   AZ_FLAG_ALT       /* '#' */
+
+/* width / precision 값: 없음, '*' */
+#define FMT_NONE (-1)
+#define FMT_ARG  (-2)
+
+enum { OP_LITERAL, OP_CONV };
+enum { LEN_NONE, LEN_HH, LEN_H, LEN_L, LEN_LL, LEN_Z, LEN_J, LEN_T, LEN_LD };
+
+/**
+ * @struct FmtOp
+ * @brief 컴파일된 포맷의 한 단계 (리터럴 구간 또는 변환)
+ */
+typedef struct FmtOp {
+    uint8_t kind;           /**< OP_LITERAL / OP_CONV */
+    uint8_t conv;           /**< 변환 문자 ('i'는 'd'로 정규화) */
+    uint8_t flags;          /**< FMT_* */
+    uint8_t length;         /**< LEN_* */
+    int32_t width;          /**< 너비 (FMT_NONE / FMT_ARG) */
+    int32_t precision;      /**< 정밀도 (FMT_NONE / FMT_ARG) */
+    uint32_t offset;        /**< 리터럴 시작 위치 (text 기준) */
+    uint32_t len;           /**< 리터럴 길이 */
+} FmtOp;
+
+/**
+ * @struct FmtProgram
+ * @brief 컴파일된 포맷 (캐시에 올라간 뒤에는 바뀌지 않음)
+ */
+typedef struct FmtProgram {
+    int rejected;           /**< 지원하지 않는 포맷이면 1 (az_* 해석기 사용) */
+    uint32_t nops;          /**< ops 개수 */
+    const char *text;       /**< 포맷 사본 (캐시 확인과 리터럴 출력에 사용) */
+    FmtOp ops[];
+} FmtProgram;
+
+typedef struct FmtSlot {
+    const char *key;        /**< 포맷 포인터 (한 번 차지하면 바뀌지 않음) */
+    FmtProgram *prog;       /**< 컴파일 결과 (NULL이면 컴파일 중) */
+} FmtSlot;
+
+static FmtSlot fmt_cache[KFMT_CACHE_SLOTS];
+static KFmtStats fmt_stats;
+static int fmt_state = -1;      /* -1: 환경 변수 확인 전 */
+
+/* ------------------------------------------------------------------------ */
+/* 컴파일                                                                    */
+/* ------------------------------------------------------------------------ */
+
+static int parse_number(const char **pp, int32_t *out) {
+    const char *p = *pp;
+    int32_t n = 0;
+
+    while (*p >= '0' && *p <= '9') {
+        if (n > (INT32_MAX - 9) / 10) {
+            return -1;
+        }
+        n = n * 10 + (*p++ - '0');
+    }
+    *pp = p;
+    *out = n;
+    return 0;
+}
+
+/**
+ * @brief '%' 다음부터 변환 하나를 해석하는 함수
+ *
+ * @param pp 해석 위치 (성공하면 변환 문자 다음으로 이동)
+ * @param op 결과
+ * @return 성공하면 0, 지원하지 않는 변환이면 -1
+ */
+static int parse_conversion(const char **pp, FmtOp *op) {
+    const char *p = *pp;
+
+    op->kind = OP_CONV;
+    op->flags = 0;
+    op->width = FMT_NONE;
+    op->precision = FMT_NONE;
+    op->length = LEN_NONE;
+    op->offset = 0;
+    op->len = 0;
+
+    for (;; p++) {
+        if (*p == '-') op->flags |= FMT_LEFT;
+        else if (*p == '+') op->flags |= FMT_PLUS;
+        else if (*p == ' ') op->flags |= FMT_SPACE;
+        else if (*p == '0') op->flags |= FMT_ZERO;
+        else if (*p == '#') op->flags |= FMT_ALT;
+        else break;
+    }
+
+    if (*p == '*') {
+        op->width = FMT_ARG;
+        p++;
+    } else if (*p >= '1' && *p <= '9' && parse_number(&p, &op->width) != 0) {
+        return -1;
+    }
+
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            op->precision = FMT_ARG;
+            p++;
+        } else if (parse_number(&p, &op->precision) != 0) {
+            return -1;
+        }
+    }
+
+    switch (*p) {
+        case 'h': op->length = p[1] == 'h' ? LEN_HH : LEN_H; p += p[1] == 'h' ? 2 : 1; break;
+        case 'l': op->length = p[1] == 'l' ? LEN_LL : LEN_L; p += p[1] == 'l' ? 2 : 1; break;
+        case 'z': op->length = LEN_Z; p++; break;
+        case 'j': op->length = LEN_J; p++; break;
+        case 't': op->length = LEN_T; p++; break;
+        case 'L': op->length = LEN_LD; p++; break;
+        default: break;
+    }
+
+    op->conv = (uint8_t)*p;
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            if (op->length == LEN_LD) {
+                return -1;
+            }
+            if (*p == 'i') {
+                op->conv = 'd';
+            }
+            break;
+        case 'c': case 's': case 'p':
+            // 와이드 문자(%lc, %ls)는 해석기에 맡김
+            if (op->length != LEN_NONE) {
+                return -1;
+            }
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            if (op->length != LEN_NONE && op->length != LEN_L && op->length != LEN_LD) {
+                return -1;
+            }
+            break;
+        default:
+            return -1;
+    }
+    *pp = p + 1;
+    return 0;
+}
+
+static void add_literal(FmtProgram *prog, size_t from, size_t to) {
+    if (to > from) {
+        FmtOp *op = &prog->ops[prog->nops++];
+        op->kind = OP_LITERAL;
+        op->offset = (uint32_t)from;
+        op->len = (uint32_t)(to - from);
+    }
+}
+
+/**
+ * @brief 포맷을 ops로 컴파일하는 함수
+ *
+ * @param format 포맷 문자열
+ * @return 컴파일 결과 (지원하지 않는 포맷이면 rejected), 메모리가 없으면 NULL
+ */
+static FmtProgram *fmt_compile(const char *format) {
+    size_t length = strlen(format);
+    size_t max_ops = 1;
+
+    for (size_t i = 0; i < length; i++) {
+        max_ops += format[i] == '%' ? 2 : 0;
+    }
+    FmtProgram *prog = (FmtProgram *)malloc(sizeof(FmtProgram) + max_ops * sizeof(FmtOp) + length + 1);
+    if (prog == NULL) {
+        return NULL;
+    }
+    char *text = (char *)&prog->ops[max_ops];
+    memcpy(text, format, length + 1);
+    prog->text = text;
+    prog->nops = 0;
+    prog->rejected = length > INT32_MAX;
+    __atomic_add_fetch(&fmt_stats.compiled, 1, __ATOMIC_RELAXED);
+
+    size_t lit = 0;
+    size_t i = 0;
+    while (!prog->rejected && text[i] != '\0') {
+        if (text[i] != '%') {
+            i++;
+            continue;
+        }
+        if (text[i + 1] == '%') {
+            // "%%"는 앞쪽 '%'까지를 리터럴에 포함시키고 뒤쪽은 건너뜀
+            add_literal(prog, lit, i + 1);
+            i += 2;
+            lit = i;
+            continue;
+        }
+        add_literal(prog, lit, i);
+        const char *p = text + i + 1;
+        if (parse_conversion(&p, &prog->ops[prog->nops]) != 0) {
+            prog->rejected = 1;
+            break;
+        }
+        prog->nops++;
+        i = (size_t)(p - text);
+        lit = i;
+    }
+    if (prog->rejected) {
+        prog->nops = 0;
+    } else {
+        add_literal(prog, lit, i);
+    }
+    return prog;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 실행                                                                      */
+/* ------------------------------------------------------------------------ */
+
+static void emit_repeat(char c, size_t n) {
+    char chunk[32];
+
+    if (n == 0) {
+        return;
+    }
+    memset(chunk, c, n < sizeof(chunk) ? n : sizeof(chunk));
+    while (n > 0) {
+        size_t k = n < sizeof(chunk) ? n : sizeof(chunk);
+        az_print_write(chunk, k);
+        n -= k;
+    }
+}
+
+/**
+ * @brief [공백][prefix][0 채움][body][공백] 형태로 한 필드를 출력하는 함수
+ */
+static void emit_field(const char *prefix, size_t plen, size_t zeros, const char *body, size_t blen, int width,
+                       unsigned flags) {
+    size_t total = plen + zeros + blen;
+    size_t pad = width > 0 && (size_t)width > total ? (size_t)width - total : 0;
+
+    if (!(flags & FMT_LEFT)) {
+        emit_repeat(' ', pad);
+    }
+    if (plen > 0) {
+        az_print_write(prefix, plen);
+    }
+    emit_repeat('0', zeros);
+    az_print_write(body, blen);
+    if (flags & FMT_LEFT) {
+        emit_repeat(' ', pad);
+    }
+}
+
+/**
+ * @brief 정수 변환 하나를 출력하는 함수 (d u o x X p)
+ */
+static void emit_integer(unsigned char conv, uintmax_t value, int negative, int width, int precision, unsigned flags) {
+    unsigned base = conv == 'o' ? 8 : (conv == 'x' || conv == 'X' || conv == 'p') ? 16 : 10;
+    char digits[AZ_NUMBUF_SIZE];
+    char prefix[2];
+    size_t plen = 0;
+    size_t ndigits = 0;
+
+    // 정밀도 0인 0은 자리 없이 출력
+    if (value != 0 || precision != 0) {
+        ndigits = az_utoa(value, base, conv == 'X', digits + sizeof(digits));
+    }
+    const char *p = digits + sizeof(digits) - ndigits;
+
+    if (conv == 'd') {
+        if (negative) prefix[plen++] = '-';
+        else if (flags & FMT_PLUS) prefix[plen++] = '+';
+        else if (flags & FMT_SPACE) prefix[plen++] = ' ';
+    } else if (base == 16 && value != 0 && ((flags & FMT_ALT) || conv == 'p')) {
+        prefix[plen++] = '0';
+        prefix[plen++] = conv == 'X' ? 'X' : 'x';
+    }
+
+    size_t zeros = precision > 0 && (size_t)precision > ndigits ? (size_t)precision - ndigits : 0;
+    if (conv == 'o' && (flags & FMT_ALT) && zeros == 0 && (ndigits == 0 || *p != '0')) {
+        zeros = 1;
+    }
+    if (precision < 0 && (flags & FMT_ZERO) && !(flags & FMT_LEFT) && width > 0 &&
+        (size_t)width > plen + zeros + ndigits) {
+        zeros = (size_t)width - plen - ndigits;
+    }
+    emit_field(prefix, plen, zeros, p, ndigits, width, flags);
+}
+
+/**
+ * @brief %a / %A와 long double 변환을 출력하는 함수 (C 라이브러리 snprintf로 변환)
+ *
+ * double 값도 long double로 받습니다 (double -> long double -> double 변환은 정확함).
+ */
+static void emit_libc_float(char conv, int is_long, long double value, int width, int precision, unsigned flags) {
+    char spec[16];
+    char local[128];
+    char *buf = local;
+    size_t n = 0;
+    int len;
+
+    spec[n++] = '%';
+    if (flags & FMT_LEFT) spec[n++] = '-';
+    if (flags & FMT_PLUS) spec[n++] = '+';
+    if (flags & FMT_SPACE) spec[n++] = ' ';
+    if (flags & FMT_ZERO) spec[n++] = '0';
+    if (flags & FMT_ALT) spec[n++] = '#';
+    spec[n++] = '*';
+    spec[n++] = '.';
+    spec[n++] = '*';
+    if (is_long) spec[n++] = 'L';
+    spec[n++] = conv;
+    spec[n] = '\0';
+
+    if (precision < 0) {
+        // "%.*f"에 음수 정밀도를 넘기면 정밀도가 없는 것으로 처리됨
+        precision = -1;
+    }
+    if (is_long) {
+        len = snprintf(local, sizeof(local), spec, width, precision, value);
+    } else {
+        len = snprintf(local, sizeof(local), spec, width, precision, (double)value);
+    }
+    if (len < 0) {
+        return;
+    }
+    if ((size_t)len >= sizeof(local)) {
+        buf = (char *)malloc((size_t)len + 1);
+        if (buf == NULL) {
+            az_print_write(local, sizeof(local) - 1);
+            return;
+        }
+        if (is_long) {
+            snprintf(buf, (size_t)len + 1, spec, width, precision, value);
+        } else {
+            snprintf(buf, (size_t)len + 1, spec, width, precision, (double)value);
+        }
+    }
+    az_print_write(buf, (size_t)len);
+    if (buf != local) {
+        free(buf);
+    }
+}
+
+/**
+ * @brief 부호 있는 정수 변환 (d)
+ */
+void kfmt_emit_signed(KFmtSpec spec, intmax_t value) {
+    uintmax_t magnitude = value < 0 ? (uintmax_t)(-(value + 1)) + 1 : (uintmax_t)value;
+    emit_integer('d', magnitude, value < 0, spec.width, spec.precision, spec.flags);
+}
+
+/**
+ * @brief 부호 없는 정수 변환 (u o x X)
+ */
+void kfmt_emit_unsigned(KFmtSpec spec, uintmax_t value) {
+    emit_integer((unsigned char)spec.conv, value, 0, spec.width, spec.precision, spec.flags);
+}
+
+/**
+ * @brief 문자 변환 (c)
+ */
+void kfmt_emit_char(KFmtSpec spec, int c) {
+    char ch = (char)c;
+    emit_field(NULL, 0, 0, &ch, 1, spec.width, spec.flags);
+}
+
+/**
+ * @brief 문자열 변환 (s, NULL은 "(null)")
+ */
+void kfmt_emit_string(KFmtSpec spec, const char *s) {
+    if (s == NULL) {
+        s = "(null)";
+    }
+    size_t n = spec.precision >= 0 ? strnlen(s, (size_t)spec.precision) : strlen(s);
+    emit_field(NULL, 0, 0, s, n, spec.width, spec.flags);
+}
+
+/**
+ * @brief 포인터 변환 (p, NULL은 "(nil)")
+ */
+void kfmt_emit_pointer(KFmtSpec spec, const void *ptr) {
+    if (ptr == NULL) {
+        emit_field(NULL, 0, 0, "(nil)", 5, spec.width, spec.flags);
+    } else {
+        emit_integer('p', (uintmax_t)(uintptr_t)ptr, 0, spec.width, spec.precision, spec.flags);
+    }
+}
+
+/**
+ * @brief 실수 변환 (f F e E g G는 az_putfloat, a A는 C 라이브러리)
+ */
+void kfmt_emit_double(KFmtSpec spec, double value) {
+    if (spec.conv == 'a' || spec.conv == 'A') {
+        emit_libc_float(spec.conv, 0, value, spec.width, spec.precision, spec.flags);
+    } else {
+        az_putfloat(value, spec.conv, spec.width, spec.precision, spec.flags);
+    }
+}
+
+/**
+ * @brief long double 실수 변환 (%Lf 등, C 라이브러리)
+ */
+void kfmt_emit_long_double(KFmtSpec spec, long double value) {
+    emit_libc_float(spec.conv, 1, value, spec.width, spec.precision, spec.flags);
+}
+
+static intmax_t read_signed(unsigned length, va_list *ap) {
+    switch (length) {
+        case LEN_HH: return (signed char)va_arg(*ap, int);
+        case LEN_H:  return (short)va_arg(*ap, int);
+        case LEN_L:  return va_arg(*ap, long);
+        case LEN_LL: return va_arg(*ap, long long);
+        case LEN_Z:  return va_arg(*ap, ptrdiff_t);
+        case LEN_J:  return va_arg(*ap, intmax_t);
+        case LEN_T:  return va_arg(*ap, ptrdiff_t);
+        default:     return va_arg(*ap, int);
+    }
+}
+
+static uintmax_t read_unsigned(unsigned length, va_list *ap) {
+    switch (length) {
+        case LEN_HH: return (unsigned char)va_arg(*ap, unsigned int);
+        case LEN_H:  return (unsigned short)va_arg(*ap, unsigned int);
+        case LEN_L:  return va_arg(*ap, unsigned long);
+        case LEN_LL: return va_arg(*ap, unsigned long long);
+        case LEN_Z:  return va_arg(*ap, size_t);
+        case LEN_J:  return va_arg(*ap, uintmax_t);
+        case LEN_T:  return (uintmax_t)va_arg(*ap, ptrdiff_t);
+        default:     return va_arg(*ap, unsigned int);
+    }
+}
+
+/**
+ * @brief '*' 너비 / 정밀도 값을 지정자에 반영하는 함수 (음수 너비는 '-', 음수 정밀도는 없음)
+ */
+static void spec_set_width(KFmtSpec *spec, int width) {
+    if (width < 0) {
+        spec->flags |= FMT_LEFT;
+        width = width == INT_MIN ? INT_MAX : -width;
+    }
+    spec->width = width;
+}
+
+static void spec_set_precision(KFmtSpec *spec, int precision) {
+    spec->precision = precision < 0 ? FMT_NONE : precision;
+}
+
+static KFmtSpec fmt_spec(const FmtOp *op) {
+    KFmtSpec spec;
+    spec.conv = (char)op->conv;
+    spec.flags = op->flags;
+    spec.width = op->width;
+    spec.precision = op->precision;
+    return spec;
+}
+
+static void fmt_convert(const FmtOp *op, va_list *ap) {
+    KFmtSpec spec = fmt_spec(op);
+
+    if (op->width == FMT_ARG) {
+        spec_set_width(&spec, va_arg(*ap, int));
+    }
+    if (op->precision == FMT_ARG) {
+        spec_set_precision(&spec, va_arg(*ap, int));
+    }
+
+    switch (op->conv) {
+        case 'd':
+            kfmt_emit_signed(spec, read_signed(op->length, ap));
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            kfmt_emit_unsigned(spec, read_unsigned(op->length, ap));
+            break;
+        case 'p':
+            kfmt_emit_pointer(spec, va_arg(*ap, void *));
+            break;
+        case 'c':
+            kfmt_emit_char(spec, va_arg(*ap, int));
+            break;
+        case 's':
+            kfmt_emit_string(spec, va_arg(*ap, const char *));
+            break;
+        default:
+            if (op->length == LEN_LD) {
+                kfmt_emit_long_double(spec, va_arg(*ap, long double));
+            } else {
+                kfmt_emit_double(spec, va_arg(*ap, double));
+            }
+            break;
+    }
+}
+
+static void fmt_execute(const FmtProgram *prog, va_list *ap) {
+    for (uint32_t i = 0; i < prog->nops; i++) {
+        const FmtOp *op = &prog->ops[i];
+        if (op->kind == OP_LITERAL) {
+            az_print_write(prog->text + op->offset, op->len);
+        } else {
+            fmt_convert(op, ap);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------ */
+/* 태그 인자 (kfmt_print_args)                                               */
+/* ------------------------------------------------------------------------ */
+
+static int arg_is_integer(const KFmtArg *arg) {
+    return arg->type == KFMT_ARG_INT || arg->type == KFMT_ARG_UINT;
+}
+
+static int arg_matches(const FmtOp *op, const KFmtArg *arg) {
+    switch (op->conv) {
+        case 'd': case 'u': case 'o': case 'x': case 'X': case 'c':
+            return arg_is_integer(arg);
+        case 's':
+            return arg->type == KFMT_ARG_STRING;
+        case 'p':
+            // 주소를 숫자로만 받을 수 있는 호출자(GUI 명령 등)를 위해 정수도 허용
+            return arg->type == KFMT_ARG_POINTER || arg_is_integer(arg);
+        default:
+            return arg->type == KFMT_ARG_DOUBLE || arg_is_integer(arg);
+    }
+}
+
+static intmax_t arg_signed(const KFmtArg *arg) {
+    return arg->type == KFMT_ARG_UINT ? (intmax_t)arg->v.u : arg->v.i;
+}
+
+static uintmax_t arg_unsigned(const KFmtArg *arg) {
+    return arg->type == KFMT_ARG_UINT ? arg->v.u : (uintmax_t)arg->v.i;
+}
+
+static double arg_double(const KFmtArg *arg) {
+    switch (arg->type) {
+        case KFMT_ARG_INT:  return (double)arg->v.i;
+        case KFMT_ARG_UINT: return (double)arg->v.u;
+        default:            return arg->v.d;
+    }
+}
+
+/* 가변 인자로 받았을 때와 같은 값이 되도록 길이 지정자의 타입으로 자름 */
+static intmax_t narrow_signed(unsigned length, intmax_t v) {
+    switch (length) {
+        case LEN_HH: return (signed char)v;
+        case LEN_H:  return (short)v;
+        case LEN_L:  return (long)v;
+        case LEN_LL: return (long long)v;
+        case LEN_Z:
+        case LEN_T:  return (ptrdiff_t)v;
+        case LEN_J:  return v;
+        default:     return (int)v;
+    }
+}
+
+static uintmax_t narrow_unsigned(unsigned length, uintmax_t v) {
+    switch (length) {
+        case LEN_HH: return (unsigned char)v;
+        case LEN_H:  return (unsigned short)v;
+        case LEN_L:  return (unsigned long)v;
+        case LEN_LL: return (unsigned long long)v;
+        case LEN_Z:
+        case LEN_T:  return (size_t)v;
+        case LEN_J:  return v;
+        default:     return (unsigned int)v;
+    }
+}
+
+/**
+ * @brief 모든 변환이 쓸 인자의 종류와 개수를 확인하는 함수
+ */
+static int fmt_check_args(const FmtProgram *prog, const KFmtArg *args, size_t nargs, size_t *bad_arg) {
+    size_t n = 0;
+
+    for (uint32_t i = 0; i < prog->nops; i++) {
+        const FmtOp *op = &prog->ops[i];
+        if (op->kind == OP_LITERAL) {
+            continue;
+        }
+        if (op->width == FMT_ARG) {
+            if (n < nargs && !arg_is_integer(&args[n])) {
+                *bad_arg = n;
+                return KFMT_ETYPE;
+            }
+            n++;
+        }
+        if (op->precision == FMT_ARG) {
+            if (n < nargs && !arg_is_integer(&args[n])) {
+                *bad_arg = n;
+                return KFMT_ETYPE;
+            }
+            n++;
+        }
+        if (n < nargs && !arg_matches(op, &args[n])) {
+            *bad_arg = n;
+            return KFMT_ETYPE;
+        }
+        n++;
+    }
+    if (n != nargs) {
+        *bad_arg = n;
+        return KFMT_ECOUNT;
+    }
+    return KFMT_OK;
+}
+
+static void fmt_convert_args(const FmtOp *op, const KFmtArg **next) {
+    KFmtSpec spec = fmt_spec(op);
+
+    if (op->width == FMT_ARG) {
+        spec_set_width(&spec, (int)arg_signed((*next)++));
+    }
+    if (op->precision == FMT_ARG) {
+        spec_set_precision(&spec, (int)arg_signed((*next)++));
+    }
+
+    const KFmtArg *arg = (*next)++;
+    switch (op->conv) {
+        case 'd':
+            kfmt_emit_signed(spec, narrow_signed(op->length, arg_signed(arg)));
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            kfmt_emit_unsigned(spec, narrow_unsigned(op->length, arg_unsigned(arg)));
+            break;
+        case 'p':
+            kfmt_emit_pointer(spec, arg->type == KFMT_ARG_POINTER ? arg->v.p
+                                                                  : (const void *)(uintptr_t)arg_unsigned(arg));
+            break;
+        case 'c':
+            kfmt_emit_char(spec, (int)arg_signed(arg));
+            break;
+        case 's':
+            kfmt_emit_string(spec, arg->v.s);
+            break;
+        default:
+            if (op->length == LEN_LD) {
+                kfmt_emit_long_double(spec, arg_double(arg));
+            } else {
+                kfmt_emit_double(spec, arg_double(arg));
+            }
+            break;
+    }
+}
+
+/**
+ * @brief 태그가 붙은 인자로 포맷을 출력하는 함수
+ *
+ * @param format 포맷 문자열
+ * @param args 인자 배열
+ * @param nargs 인자 개수
+ * @param bad_arg 실패 위치 (NULL 가능)
+ * @return KFMT_OK 또는 KFMT_E*
+ */
+int kfmt_print_args(const char *format, const KFmtArg *args, size_t nargs, size_t *bad_arg) {
+    FmtProgram *prog = fmt_compile(format);
+    size_t where = 0;
+    int rc;
+
+    if (prog == NULL) {
+        return KFMT_ENOMEM;
+    }
+    rc = prog->rejected ? KFMT_EFORMAT : fmt_check_args(prog, args, nargs, &where);
+    if (rc == KFMT_OK) {
+        const KFmtArg *next = args;
+        az_print_begin();
+        for (uint32_t i = 0; i < prog->nops; i++) {
+            const FmtOp *op = &prog->ops[i];
+            if (op->kind == OP_LITERAL) {
+                az_print_write(prog->text + op->offset, op->len);
+            } else {
+                fmt_convert_args(op, &next);
+            }
+        }
+        az_print_end();
+    }
+    if (bad_arg != NULL) {
+        *bad_arg = where;
+    }
+    free(prog);
+    return rc;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 캐시                                                                      */
+/* ------------------------------------------------------------------------ */
+
+static size_t fmt_hash(const char *format) {
+    uint64_t h = (uint64_t)(uintptr_t)format * 0x9E3779B97F4A7C15ULL;
+    return (size_t)(h >> 32) & (KFMT_CACHE_SLOTS - 1);
+}
+
+/**
+ * @brief 포맷의 컴파일 결과를 찾는 함수 (없으면 컴파일해서 빈 슬롯에 등록)
+ *
+ * @param format 포맷 문자열
+ * @param owned 캐시에 넣지 못한 결과라면 호출자가 해제할 포인터를 저장
+ * @return 컴파일 결과 (메모리가 없으면 NULL)
+ */
+static const FmtProgram *fmt_lookup(const char *format, FmtProgram **owned) {
+    size_t h = fmt_hash(format);
+
+    *owned = NULL;
+    for (size_t probe = 0; probe < KFMT_MAX_PROBES; probe++) {
+        FmtSlot *slot = &fmt_cache[(h + probe) & (KFMT_CACHE_SLOTS - 1)];
+        const char *key = __atomic_load_n(&slot->key, __ATOMIC_ACQUIRE);
+
+        if (key == NULL &&
+            __atomic_compare_exchange_n(&slot->key, &key, format, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            FmtProgram *prog = fmt_compile(format);
+            __atomic_store_n(&slot->prog, prog, __ATOMIC_RELEASE);
+            if (prog != NULL) {
+                __atomic_add_fetch(&fmt_stats.entries, 1, __ATOMIC_RELAXED);
+            }
+            return prog;
+        }
+        if (key == format) {
+            const FmtProgram *prog = __atomic_load_n(&slot->prog, __ATOMIC_ACQUIRE);
+            // 같은 주소라도 내용이 바뀐 버퍼일 수 있으므로 사본과 비교
+            if (prog != NULL && strcmp(prog->text, format) == 0) {
+                return prog;
+            }
+            break;
+        }
+    }
+    __atomic_add_fetch(&fmt_stats.uncached, 1, __ATOMIC_RELAXED);
+    *owned = fmt_compile(format);
+    return *owned;
+}
+
+static int fmt_is_enabled(void) {
+    int state = __atomic_load_n(&fmt_state, __ATOMIC_RELAXED);
+    if (__builtin_expect(state < 0, 0)) {
+        const char *env = getenv("KERNEL_PRINTF_COMPILE");
+        state = env == NULL || strcmp(env, "0") != 0;
+        __atomic_store_n(&fmt_state, state, __ATOMIC_RELAXED);
+    }
+    return state;
+}
+
+/**
+ * @brief 컴파일된 포맷으로 현재 출력 버퍼에 출력하는 함수
+ *
+ * @param format 포맷 문자열
+ * @param ap 가변 인자
+ * @return 출력했으면 0, 호출자가 az_* 해석기로 출력해야 하면 -1
+ */
+int kfmt_vformat(const char *format, va_list *ap) {
+    FmtProgram *owned;
+    const FmtProgram *prog;
+
+    if (!fmt_is_enabled()) {
+        return -1;
+    }
+    prog = fmt_lookup(format, &owned);
+    if (prog == NULL || prog->rejected) {
+        __atomic_add_fetch(&fmt_stats.fallbacks, 1, __ATOMIC_RELAXED);
+        free(owned);
+        return -1;
+    }
+    fmt_execute(prog, ap);
+    free(owned);
+    return 0;
+}
+
+/**
+ * @brief 포맷 컴파일러를 켜거나 끄는 함수
+ */
+void kfmt_set_enabled(int enabled) {
+    __atomic_store_n(&fmt_state, enabled != 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 포맷 컴파일러가 켜져 있는지 반환하는 함수
+ */
+int kfmt_enabled(void) {
+    return fmt_is_enabled();
+}
+
+/**
+ * @brief 포맷 캐시 통계를 복사하는 함수
+ */
+void kfmt_get_stats(KFmtStats *stats) {
+    stats->compiled = __atomic_load_n(&fmt_stats.compiled, __ATOMIC_RELAXED);
+    stats->uncached = __atomic_load_n(&fmt_stats.uncached, __ATOMIC_RELAXED);
+    stats->fallbacks = __atomic_load_n(&fmt_stats.fallbacks, __ATOMIC_RELAXED);
+    stats->entries = __atomic_load_n(&fmt_stats.entries, __ATOMIC_RELAXED);
+}
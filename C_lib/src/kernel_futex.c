@@ -0,0 +1,188 @@
+/*
+ * Kernel Futex Wrapper
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Linux futex(2) wait/wake and a portable parking-lot fallback.
+ */
+
+#include "kernel_futex.h"
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+#ifdef __linux__
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/**
+ * @brief *addr가 expected와 같으면 깨울 때까지 대기하는 함수 (Linux)
+ */
+int kernel_futex_wait(uint32_t *addr, uint32_t expected, const struct timespec *timeout) {
+    long ret = syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+    return ret == 0 ? 0 : -1;
+}
+
+/**
+ * @brief addr에서 대기 중인 스레드를 깨우는 함수 (Linux)
+ */
+int kernel_futex_wake(uint32_t *addr, int count) {
+    long ret = syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+    return ret < 0 ? 0 : (int)ret;
+}
+
+/**
+ * @brief 공유 메모리 주소에서 대기하는 함수 (Linux, 프로세스 간 futex)
+ */
+int kernel_futex_wait_shared(uint32_t *addr, uint32_t expected, const struct timespec *timeout) {
+    long ret = syscall(SYS_futex, addr, FUTEX_WAIT, expected, timeout, NULL, 0);
+    return ret == 0 ? 0 : -1;
+}
+
+/**
+ * @brief 공유 메모리 주소에서 대기 중인 프로세스를 깨우는 함수 (Linux)
+ */
+int kernel_futex_wake_shared(uint32_t *addr, int count) {
+    long ret = syscall(SYS_futex, addr, FUTEX_WAKE, count, NULL, NULL, 0);
+    return ret < 0 ? 0 : (int)ret;
+}
+
+#else
+
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+// 주소를 해시하여 대기 버킷을 고르는 주차장(parking lot) 구현
+#define FUTEX_BUCKETS 64
+
+typedef struct FutexBucket {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int waiters;
+} __attribute__((aligned(64))) FutexBucket;
+
+static FutexBucket futex_buckets[FUTEX_BUCKETS];
+static pthread_once_t futex_once = PTHREAD_ONCE_INIT;
+
+static void futex_init_buckets(void) {
+    for (int i = 0; i < FUTEX_BUCKETS; i++) {
+        pthread_mutex_init(&futex_buckets[i].mutex, NULL);
+        pthread_cond_init(&futex_buckets[i].cond, NULL);
+        futex_buckets[i].waiters = 0;
+    }
+}
+
+static FutexBucket *futex_bucket(uint32_t *addr) {
+    uintptr_t key = (uintptr_t)addr;
+    pthread_once(&futex_once, futex_init_buckets);
+    key ^= key >> 9;
+    return &futex_buckets[(key >> 2) & (FUTEX_BUCKETS - 1)];
+}
+
+/**
+ * @brief *addr가 expected와 같으면 깨울 때까지 대기하는 함수 (대체 구현)
+ *
+ * 값 확인과 대기를 버킷 뮤텍스 안에서 하므로, 값을 바꾼 뒤 같은 버킷을 잠그는 wake와 경쟁해도 깨어남을 놓치지 않습니다.
+ */
+int kernel_futex_wait(uint32_t *addr, uint32_t expected, const struct timespec *timeout) {
+    FutexBucket *bucket = futex_bucket(addr);
+    int ret = 0;
+
+    pthread_mutex_lock(&bucket->mutex);
+    if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) != expected) {
+        pthread_mutex_unlock(&bucket->mutex);
+        errno = EAGAIN;
+        return -1;
+    }
+
+    bucket->waiters++;
+    if (timeout == NULL) {
+        ret = pthread_cond_wait(&bucket->cond, &bucket->mutex);
+    } else {
+        struct timeval now;
+        struct timespec deadline;
+        gettimeofday(&now, NULL);
+        deadline.tv_sec = now.tv_sec + timeout->tv_sec;
+        deadline.tv_nsec = now.tv_usec * 1000L + timeout->tv_nsec;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        ret = pthread_cond_timedwait(&bucket->cond, &bucket->mutex, &deadline);
+    }
+    bucket->waiters--;
+    pthread_mutex_unlock(&bucket->mutex);
+
+    if (ret != 0) {
+        errno = ret;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief addr에서 대기 중인 스레드를 깨우는 함수 (대체 구현)
+ *
+ * 버킷을 여러 주소가 공유하므로 모두 깨우고, 깨어난 스레드가 자신의 조건을 다시 확인합니다.
+ */
+int kernel_futex_wake(uint32_t *addr, int count) {
+    FutexBucket *bucket = futex_bucket(addr);
+    int waiters;
+
+    (void)count;
+    pthread_mutex_lock(&bucket->mutex);
+    waiters = bucket->waiters;
+    if (waiters > 0) {
+        pthread_cond_broadcast(&bucket->cond);
+    }
+    pthread_mutex_unlock(&bucket->mutex);
+    return waiters;
+}
+
+/**
+ * @brief 공유 메모리 주소에서 대기하는 함수 (대체 구현)
+ *
+ * 프로세스 간 깨우기 수단이 없으므로 값이 같으면 최대 1ms 동안 잠든 뒤 반환합니다.
+ */
+int kernel_futex_wait_shared(uint32_t *addr, uint32_t expected, const struct timespec *timeout) {
+    struct timespec nap = { 0, 1000000L };
+
+    if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) != expected) {
+        errno = EAGAIN;
+        return -1;
+    }
+    if (timeout != NULL && timeout->tv_sec == 0 && timeout->tv_nsec < nap.tv_nsec) {
+        nap = *timeout;
+    }
+    nanosleep(&nap, NULL);
+    return 0;
+}
+
+/**
+ * @brief 공유 메모리 주소에서 대기 중인 프로세스를 깨우는 함수 (대체 구현, 대기자가 스스로 깨어남)
+ */
+int kernel_futex_wake_shared(uint32_t *addr, int count) {
+    (void)addr;
+    (void)count;
+    return 0;
+}
+
+#endif
+
+static int online_cpus = 0;
+
+/**
+ * @brief 온라인 CPU 수를 반환하는 함수 (경쟁해도 같은 값을 쓰므로 완화된 원자 연산으로 충분)
+ */
+int kernel_online_cpus(void) {
+    int cpus = __atomic_load_n(&online_cpus, __ATOMIC_RELAXED);
+    if (cpus == 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        cpus = n > 0 ? (int)n : 1;
+        __atomic_store_n(&online_cpus, cpus, __ATOMIC_RELAXED);
+    }
+    return cpus;
+}
@@ -10,6 +10,10 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "kernel_print_sink.h"
+#include "kernel_rwlock.h"
 
 // 최대 프로세스 수 정의
 #define MAX_PROCESSES 10
@@ -23,20 +27,44 @@ typedef struct
 static Process process_table[MAX_PROCESSES];
 static int process_count = 0;
 
+// 프로세스 테이블 잠금 (목록 조회는 동시에, 생성/종료는 단독으로 수행)
+static KRWLock process_lock;
+static pthread_once_t process_lock_once = PTHREAD_ONCE_INIT;
+
+static void process_lock_init(void)
+{
+    krwlock_init(&process_lock, "process_table");
+}
+
 // Qt에서 구현된 함수 포인터를 사용해 출력
 static void (*qt_print_function)(const char *str) = NULL;
 
 // 새로운 az_printf 함수 구현
+// kernel_vsnprintf로 포맷하고, 스택 버퍼보다 길면 힙에 다시 포맷하여 잘리지 않게 출력
 void az_printf(const char *format, ...)
 {
     if (qt_print_function)
     {
         char buffer[1024];
+        char *out = buffer;
         va_list args;
         va_start(args, format);
-        vsnprintf(buffer, sizeof(buffer), format, args);
+        va_list copy;
+        va_copy(copy, args);
+        int len = kernel_vsnprintf(buffer, sizeof(buffer), format, args);
+        if (len >= (int)sizeof(buffer))
+        {
+            out = (char *)malloc((size_t)len + 1);
+            if (out != NULL)
+                kernel_vsnprintf(out, (size_t)len + 1, format, copy);
+            else
+                out = buffer; // 할당 실패 시에만 잘린 내용 출력
+        }
+        va_end(copy);
         va_end(args);
-        qt_print_function(buffer);
+        qt_print_function(out);
+        if (out != buffer)
+            free(out);
     }
 }
 
@@ -49,8 +77,11 @@ void register_print_function(void (*print_function)(const char *str))
 // cmd창의 printf 함수 구현
 int kernel_create_process(const char *process_name)
 {
+    pthread_once(&process_lock_once, process_lock_init);
+    krwlock_wrlock(&process_lock);
     if (process_count >= MAX_PROCESSES)
     {
+        krwlock_wrunlock(&process_lock);
         az_printf("\nError: Process table is full.");
         return 0; // false
     }
@@ -63,6 +94,7 @@ int kernel_create_process(const char *process_name)
 
     // 프로세스 테이블에 추가
     process_table[process_count++] = new_process;
+    krwlock_wrunlock(&process_lock);
 
     az_printf("\nProcess created: %s", process_name);
     return 1; // true
@@ -71,25 +103,32 @@ int kernel_create_process(const char *process_name)
 // 프로세스 목록 출력
 void kernel_list_processes()
 {
+    pthread_once(&process_lock_once, process_lock_init);
+    krwlock_rdlock(&process_lock);
     az_printf("\nProcess List:\n");
     for (int i = 0; i < process_count; i++)
     {
         az_printf(" - %s (%s)\n", process_table[i].name, process_table[i].running ? "Running" : "Stopped");
     }
+    krwlock_rdunlock(&process_lock);
 }
 
 // 프로세스 종료
 int kernel_kill_process(const char *process_name)
 {
+    pthread_once(&process_lock_once, process_lock_init);
+    krwlock_wrlock(&process_lock);
     for (int i = 0; i < process_count; i++)
     {
         if (strcmp(process_table[i].name, process_name) == 0)
         {
             process_table[i].running = 0; // false
+            krwlock_wrunlock(&process_lock);
             az_printf("\nProcess killed: %s", process_name);
             return 1; // true
         }
     }
+    krwlock_wrunlock(&process_lock);
     az_printf("\nError: Process not found: %s", process_name);
     return 0; // false
 }
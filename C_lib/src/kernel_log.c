@@ -0,0 +1,394 @@
+/*
+ * Kernel Log Sink
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the buffered log sink: per-thread line buffers,
+ *             a double-buffered shared block swapped by the flusher, and
+ *             the exit/fork/thread-exit flush hooks.
+ */
+
+#include "kernel_log.h"
+#include "kernel_futex.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOG_MODE_ASYNC 0
+#define LOG_MODE_SYNC 1
+
+/**
+ * @struct LogThreadBuffer
+ * @brief 스레드별 줄 버퍼 (아직 줄바꿈이 오지 않은 데이터 보관)
+ */
+typedef struct LogThreadBuffer {
+    size_t used;
+    char data[KLOG_LINE_BUFFER];
+} LogThreadBuffer;
+
+static pthread_mutex_t log_append_lock = PTHREAD_MUTEX_INITIALIZER;    /* 활성 블록 보호 */
+static pthread_mutex_t log_write_lock = PTHREAD_MUTEX_INITIALIZER;     /* 블록 교체와 write(2) 직렬화 */
+static char log_blocks[2][KLOG_BLOCK_SIZE];
+static size_t log_used[2];
+static int log_active = 0;
+static int log_fd = STDOUT_FILENO;
+static int log_mode = LOG_MODE_ASYNC;
+
+static pthread_t log_flusher;
+static int log_flusher_running = 0;
+static uint32_t log_kick = 0;       /* 플러셔 깨우기용 futex 워드 */
+static int log_stop = 0;
+
+static pthread_once_t log_once = PTHREAD_ONCE_INIT;
+static pthread_key_t log_key;
+static __thread LogThreadBuffer *log_local = NULL;
+static __thread int log_partial = 0;    /* 이 스레드가 마지막으로 쓴 바이트가 줄바꿈이 아니면 1 */
+
+/**
+ * @brief 짧은 쓰기와 EINTR을 처리하며 모두 기록하는 함수
+ */
+static void write_all(int fd, const char *data, size_t len) {
+    if (fd == STDOUT_FILENO) {
+        // stdio로 먼저 출력된 내용이 로그보다 뒤에 나오지 않도록 함
+        fflush(stdout);
+    }
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+/**
+ * @brief 활성 블록을 교체하고 이전 블록을 출력하는 함수
+ *
+ * write_lock을 잡고 있는 동안 비활성 블록은 항상 비어 있으므로, 교체 후 새 활성 블록에 바로 기록할 수 있습니다.
+ */
+static void log_drain(void) {
+    pthread_mutex_lock(&log_write_lock);
+    pthread_mutex_lock(&log_append_lock);
+    int idx = log_active;
+    size_t len = log_used[idx];
+    if (len > 0) {
+        log_active = idx ^ 1;
+    }
+    pthread_mutex_unlock(&log_append_lock);
+
+    if (len > 0) {
+        write_all(log_fd, log_blocks[idx], len);
+        log_used[idx] = 0;
+    }
+    pthread_mutex_unlock(&log_write_lock);
+}
+
+/**
+ * @brief 완성된 줄들을 공유 블록에 한 번에 복사하는 함수
+ *
+ * 블록에 자리가 없으면 호출 스레드가 직접 출력하여 공간을 만듭니다.
+ */
+static void log_publish(const char *data, size_t len) {
+    for (;;) {
+        pthread_mutex_lock(&log_append_lock);
+        if (log_mode == LOG_MODE_SYNC) {
+            pthread_mutex_unlock(&log_append_lock);
+            pthread_mutex_lock(&log_write_lock);
+            write_all(log_fd, data, len);
+            pthread_mutex_unlock(&log_write_lock);
+            return;
+        }
+
+        size_t used = log_used[log_active];
+        if (used + len <= KLOG_BLOCK_SIZE) {
+            memcpy(log_blocks[log_active] + used, data, len);
+            log_used[log_active] = used + len;
+            pthread_mutex_unlock(&log_append_lock);
+
+            // 블록이 절반을 넘는 순간 플러셔를 깨워 다음 기록이 막히지 않게 함
+            if (used < KLOG_BLOCK_SIZE / 2 && used + len >= KLOG_BLOCK_SIZE / 2) {
+                __atomic_add_fetch(&log_kick, 1, __ATOMIC_RELEASE);
+                kernel_futex_wake(&log_kick, 1);
+            }
+            return;
+        }
+        pthread_mutex_unlock(&log_append_lock);
+
+        log_drain();
+        if (len > KLOG_BLOCK_SIZE) {
+            pthread_mutex_lock(&log_write_lock);
+            write_all(log_fd, data, len);
+            pthread_mutex_unlock(&log_write_lock);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 스레드 버퍼에 새로 추가된 n바이트를 확인하여 완성된 줄을 게시하는 함수
+ */
+static void log_commit(LogThreadBuffer *tb, size_t added) {
+    size_t end = tb->used;
+
+    // 새로 추가된 구간에서만 마지막 줄바꿈을 찾음
+    for (size_t i = end; i > end - added; i--) {
+        if (tb->data[i - 1] == '\n') {
+            log_publish(tb->data, i);
+            memmove(tb->data, tb->data + i, end - i);
+            tb->used = end - i;
+            return;
+        }
+    }
+
+    if (tb->used == KLOG_LINE_BUFFER) {
+        log_publish(tb->data, tb->used);
+        tb->used = 0;
+    }
+}
+
+/**
+ * @brief 호출 스레드의 미완성 줄을 그대로 게시하는 함수
+ */
+static void log_flush_local(void) {
+    LogThreadBuffer *tb = log_local;
+    if (tb != NULL && tb->used > 0) {
+        log_publish(tb->data, tb->used);
+        tb->used = 0;
+    }
+}
+
+static void log_thread_exit(void *arg) {
+    LogThreadBuffer *tb = (LogThreadBuffer *)arg;
+    if (tb->used > 0) {
+        log_publish(tb->data, tb->used);
+    }
+    log_local = NULL;
+    free(tb);
+}
+
+static void *log_flusher_main(void *arg) {
+    struct timespec interval = { 0, KLOG_FLUSH_INTERVAL_MS * 1000000L };
+    (void)arg;
+
+    while (!__atomic_load_n(&log_stop, __ATOMIC_ACQUIRE)) {
+        uint32_t kick = __atomic_load_n(&log_kick, __ATOMIC_ACQUIRE);
+        log_drain();
+        kernel_futex_wait(&log_kick, kick, &interval);
+    }
+    return NULL;
+}
+
+/**
+ * @brief fork 직전: 대기 중인 로그를 모두 출력하고 잠금을 잡아 자식이 빈 상태를 물려받게 함
+ */
+static void log_atfork_prepare(void) {
+    log_flush_local();
+    pthread_mutex_lock(&log_write_lock);
+    pthread_mutex_lock(&log_append_lock);
+    if (log_used[log_active] > 0) {
+        write_all(log_fd, log_blocks[log_active], log_used[log_active]);
+        log_used[log_active] = 0;
+    }
+}
+
+static void log_atfork_parent(void) {
+    pthread_mutex_unlock(&log_append_lock);
+    pthread_mutex_unlock(&log_write_lock);
+}
+
+/**
+ * @brief fork 직후 자식: 플러셔 스레드가 없으므로 즉시 출력 모드로 전환
+ */
+static void log_atfork_child(void) {
+    log_mode = LOG_MODE_SYNC;
+    log_flusher_running = 0;
+    pthread_mutex_unlock(&log_append_lock);
+    pthread_mutex_unlock(&log_write_lock);
+}
+
+static void log_init(void) {
+    const char *sync_env = getenv("KERNEL_LOG_SYNC");
+
+    if (pthread_key_create(&log_key, log_thread_exit) != 0) {
+        log_mode = LOG_MODE_SYNC;
+    }
+    pthread_atfork(log_atfork_prepare, log_atfork_parent, log_atfork_child);
+    atexit(kernel_log_shutdown);
+
+    if (sync_env != NULL && *sync_env != '\0' && *sync_env != '0') {
+        log_mode = LOG_MODE_SYNC;
+    }
+    if (log_mode == LOG_MODE_ASYNC) {
+        if (pthread_create(&log_flusher, NULL, log_flusher_main, NULL) == 0) {
+            log_flusher_running = 1;
+        } else {
+            log_mode = LOG_MODE_SYNC;
+        }
+    }
+}
+
+/**
+ * @brief 호출 스레드의 줄 버퍼를 반환하는 함수 (처음 호출 시 할당, 실패하면 NULL)
+ */
+static LogThreadBuffer *log_thread_buffer(void) {
+    pthread_once(&log_once, log_init);
+
+    LogThreadBuffer *tb = log_local;
+    if (tb == NULL) {
+        tb = (LogThreadBuffer *)malloc(sizeof(LogThreadBuffer));
+        if (tb == NULL) {
+            return NULL;
+        }
+        tb->used = 0;
+        log_local = tb;
+        pthread_setspecific(log_key, tb);
+    }
+    return tb;
+}
+
+/**
+ * @brief 로그 데이터를 기록하는 함수
+ */
+void kernel_log_write(const char *data, size_t len) {
+    LogThreadBuffer *tb = log_thread_buffer();
+    if (len > 0) {
+        log_partial = data[len - 1] != '\n';
+    }
+    if (tb == NULL) {
+        log_publish(data, len);
+        return;
+    }
+
+    while (len > 0) {
+        size_t room = KLOG_LINE_BUFFER - tb->used;
+        size_t n = len < room ? len : room;
+        memcpy(tb->data + tb->used, data, n);
+        tb->used += n;
+        data += n;
+        len -= n;
+        log_commit(tb, n);
+    }
+}
+
+/**
+ * @brief va_list를 받는 kernel_logf 함수
+ *
+ * 스레드 버퍼에 바로 포맷하고, 남은 공간보다 길면 임시 버퍼를 거칩니다.
+ */
+int kernel_vlogf(const char *format, va_list args) {
+    LogThreadBuffer *tb = log_thread_buffer();
+    va_list copy;
+    int len;
+
+    if (tb != NULL) {
+        size_t room = KLOG_LINE_BUFFER - tb->used;
+        va_copy(copy, args);
+        len = vsnprintf(tb->data + tb->used, room, format, copy);
+        va_end(copy);
+        if (len < 0) {
+            return len;
+        }
+        if ((size_t)len < room) {
+            if (len > 0) {
+                log_partial = tb->data[tb->used + (size_t)len - 1] != '\n';
+            }
+            tb->used += (size_t)len;
+            log_commit(tb, (size_t)len);
+            return len;
+        }
+    }
+
+    char stack_buf[256];
+    char *buf = stack_buf;
+    va_copy(copy, args);
+    len = vsnprintf(stack_buf, sizeof(stack_buf), format, copy);
+    va_end(copy);
+    if (len < 0) {
+        return len;
+    }
+    if ((size_t)len >= sizeof(stack_buf)) {
+        buf = (char *)malloc((size_t)len + 1);
+        if (buf == NULL) {
+            return -1;
+        }
+        va_copy(copy, args);
+        vsnprintf(buf, (size_t)len + 1, format, copy);
+        va_end(copy);
+    }
+
+    kernel_log_write(buf, (size_t)len);
+    if (buf != stack_buf) {
+        free(buf);
+    }
+    return len;
+}
+
+/**
+ * @brief printf 형식으로 로그를 기록하는 함수
+ */
+int kernel_logf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int len = kernel_vlogf(format, args);
+    va_end(args);
+    return len;
+}
+
+/**
+ * @brief 호출 스레드가 마지막으로 기록한 바이트가 줄바꿈이 아닌지 확인하는 함수
+ */
+int kernel_log_partial(void) {
+    return log_partial;
+}
+
+/**
+ * @brief 호출 스레드의 미완성 줄과 대기 중인 모든 로그를 출력하는 함수
+ */
+void kernel_log_flush(void) {
+    pthread_once(&log_once, log_init);
+    log_flush_local();
+    log_drain();
+}
+
+/**
+ * @brief 로그 출력 파일 디스크립터를 바꾸는 함수
+ */
+void kernel_log_set_fd(int fd) {
+    kernel_log_flush();
+    pthread_mutex_lock(&log_write_lock);
+    log_fd = fd;
+    pthread_mutex_unlock(&log_write_lock);
+}
+
+/**
+ * @brief 로그를 모두 출력하고 플러셔를 종료하는 함수
+ */
+void kernel_log_shutdown(void) {
+    pthread_once(&log_once, log_init);
+    log_flush_local();
+
+    // 즉시 출력 모드로 바꾼 뒤에는 새 로그가 블록에 쌓이지 않으므로 마지막 drain으로 충분함
+    pthread_mutex_lock(&log_append_lock);
+    log_mode = LOG_MODE_SYNC;
+    pthread_mutex_unlock(&log_append_lock);
+
+    if (log_flusher_running && !pthread_equal(log_flusher, pthread_self())) {
+        __atomic_store_n(&log_stop, 1, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&log_kick, 1, __ATOMIC_RELEASE);
+        kernel_futex_wake(&log_kick, 1);
+        pthread_join(log_flusher, NULL);
+        log_flusher_running = 0;
+    }
+    log_drain();
+}
@@ -0,0 +1,349 @@
+/*
+ * Kernel Adaptive Mutex
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the adaptive futex mutex declared in
+ *             kernel_mutex.h. The lock word follows Drepper's three-state
+ *             protocol (free / locked / locked with waiters). Counters are
+ *             written only by the current owner, so the uncontended path is
+ *             one CAS plus stores to a cache line the owner already holds.
+ */
+
+#include "kernel_mutex.h"
+#include "kernel_engine.h"
+#include "kernel_futex.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KMUTEX_FREE 0u
+#define KMUTEX_LOCKED 1u
+#define KMUTEX_CONTENDED 2u
+
+/**
+ * @struct KMutexClass
+ * @brief 정리된 잠금의 통계를 이름별로 합산한 항목
+ */
+typedef struct KMutexClass {
+    const char *name;
+    KMutexStats stats;
+} KMutexClass;
+
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+static KMutex *registry_head = NULL;
+static KMutexClass retired_classes[KMUTEX_MAX_CLASSES];
+static int retired_count = 0;
+static KMutexStats retired_other;
+
+/**
+ * @brief 이번 대기에 허용할 스핀 횟수를 구하는 함수
+ *
+ * CPU가 하나면 소유자가 실행 중일 수 없으므로 스핀하지 않습니다.
+ */
+static uint32_t spin_limit(const KMutex *mutex) {
+    if (kernel_online_cpus() == 1) {
+        return 0;
+    }
+
+    uint32_t limit = 2 * __atomic_load_n(&mutex->spin_avg, __ATOMIC_RELAXED) + KMUTEX_SPIN_MIN;
+    return limit < KMUTEX_SPIN_MAX ? limit : KMUTEX_SPIN_MAX;
+}
+
+/* 소유자만 통계를 쓰지만 다른 스레드가 읽을 수 있으므로 원자적 저장 사용 */
+#define KMUTEX_STAT_ADD(field, value) \
+    __atomic_store_n(&(field), __atomic_load_n(&(field), __ATOMIC_RELAXED) + (value), __ATOMIC_RELAXED)
+
+static inline void record_acquire(KMutex *mutex) {
+    KMUTEX_STAT_ADD(mutex->stats.acquisitions, 1);
+}
+
+static void record_contended(KMutex *mutex, uint64_t waited) {
+    KMUTEX_STAT_ADD(mutex->stats.contended, 1);
+    KMUTEX_STAT_ADD(mutex->stats.wait_ns_total, waited);
+    if (waited > __atomic_load_n(&mutex->stats.wait_ns_max, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&mutex->stats.wait_ns_max, waited, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief 스핀 결과로 스핀 예산의 이동 평균을 갱신하는 함수 (잠금 소유 중 호출)
+ *
+ * @param spins 스핀으로 획득했으면 걸린 횟수, 실패했으면 -1
+ */
+static void adapt_spin(KMutex *mutex, int spins) {
+    int32_t avg = (int32_t)__atomic_load_n(&mutex->spin_avg, __ATOMIC_RELAXED);
+
+    if (spins >= 0) {
+        avg += (spins - avg) / 8;
+    } else {
+        // 소유자가 예산보다 오래 잡고 있었으므로 다음에는 덜 스핀하고 바로 대기
+        avg -= avg / 8 + 1;
+    }
+    if (avg < 0) {
+        avg = 0;
+    }
+    __atomic_store_n(&mutex->spin_avg, (uint32_t)avg, __ATOMIC_RELAXED);
+}
+
+static void kmutex_lock_slow(KMutex *mutex) {
+    uint64_t begin = kernel_now_ns();
+    uint32_t limit = spin_limit(mutex);
+    uint32_t state;
+
+    // 대기자가 이미 있으면 새치기하지 않도록 스핀하지 않음
+    for (uint32_t spins = 0; spins < limit; spins++) {
+        state = __atomic_load_n(&mutex->state, __ATOMIC_RELAXED);
+        if (state == KMUTEX_CONTENDED) {
+            break;
+        }
+        if (state == KMUTEX_FREE &&
+            __atomic_compare_exchange_n(&mutex->state, &state, KMUTEX_LOCKED, false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            adapt_spin(mutex, (int)spins);
+            record_acquire(mutex);
+            record_contended(mutex, kernel_now_ns() - begin);
+            return;
+        }
+        kernel_cpu_relax();
+    }
+
+    state = __atomic_exchange_n(&mutex->state, KMUTEX_CONTENDED, __ATOMIC_ACQUIRE);
+    while (state != KMUTEX_FREE) {
+        kernel_futex_wait(&mutex->state, KMUTEX_CONTENDED, NULL);
+        state = __atomic_exchange_n(&mutex->state, KMUTEX_CONTENDED, __ATOMIC_ACQUIRE);
+    }
+    if (limit > 0) {
+        adapt_spin(mutex, -1);
+    }
+    record_acquire(mutex);
+    record_contended(mutex, kernel_now_ns() - begin);
+}
+
+/**
+ * @brief 뮤텍스를 잠그는 함수
+ *
+ * @param mutex 잠글 뮤텍스
+ */
+void kmutex_lock(KMutex *mutex) {
+    uint32_t expected = KMUTEX_FREE;
+
+    if (__builtin_expect(__atomic_compare_exchange_n(&mutex->state, &expected, KMUTEX_LOCKED, false,
+                                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED), 1)) {
+        record_acquire(mutex);
+        return;
+    }
+    kmutex_lock_slow(mutex);
+}
+
+/**
+ * @brief 뮤텍스 잠금을 시도하는 함수
+ *
+ * @param mutex 잠글 뮤텍스
+ * @return 잠갔으면 1, 이미 잠겨 있으면 0
+ */
+int kmutex_trylock(KMutex *mutex) {
+    uint32_t expected = KMUTEX_FREE;
+
+    if (!__atomic_compare_exchange_n(&mutex->state, &expected, KMUTEX_LOCKED, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    record_acquire(mutex);
+    return 1;
+}
+
+/**
+ * @brief 뮤텍스를 해제하는 함수
+ *
+ * @param mutex 해제할 뮤텍스
+ */
+void kmutex_unlock(KMutex *mutex) {
+    if (__atomic_fetch_sub(&mutex->state, 1, __ATOMIC_RELEASE) != KMUTEX_LOCKED) {
+        __atomic_store_n(&mutex->state, KMUTEX_FREE, __ATOMIC_RELEASE);
+        kernel_futex_wake(&mutex->state, 1);
+    }
+}
+
+/**
+ * @brief 뮤텍스를 초기화하고 등록하는 함수
+ *
+ * @param mutex 초기화할 뮤텍스
+ * @param name 잠금 클래스 이름
+ */
+void kmutex_init(KMutex *mutex, const char *name) {
+    memset(mutex, 0, sizeof(*mutex));
+    mutex->name = name != NULL ? name : "anonymous";
+
+    pthread_mutex_lock(&registry_mutex);
+    mutex->reg_next = registry_head;
+    if (registry_head != NULL) {
+        registry_head->reg_prev = mutex;
+    }
+    registry_head = mutex;
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+static void stats_add(KMutexStats *dst, const KMutexStats *src) {
+    dst->acquisitions += src->acquisitions;
+    dst->contended += src->contended;
+    dst->wait_ns_total += src->wait_ns_total;
+    if (src->wait_ns_max > dst->wait_ns_max) {
+        dst->wait_ns_max = src->wait_ns_max;
+    }
+}
+
+/**
+ * @brief 뮤텍스의 등록을 해제하고 통계를 클래스에 합산하는 함수
+ *
+ * @param mutex 정리할 뮤텍스
+ */
+void kmutex_destroy(KMutex *mutex) {
+    KMutexStats stats;
+    kmutex_get_stats(mutex, &stats);
+
+    pthread_mutex_lock(&registry_mutex);
+    if (mutex->reg_prev != NULL) {
+        mutex->reg_prev->reg_next = mutex->reg_next;
+    } else if (registry_head == mutex) {
+        registry_head = mutex->reg_next;
+    }
+    if (mutex->reg_next != NULL) {
+        mutex->reg_next->reg_prev = mutex->reg_prev;
+    }
+    mutex->reg_prev = mutex->reg_next = NULL;
+
+    KMutexStats *target = &retired_other;
+    for (int i = 0; i < retired_count; i++) {
+        if (strcmp(retired_classes[i].name, mutex->name) == 0) {
+            target = &retired_classes[i].stats;
+            break;
+        }
+    }
+    if (target == &retired_other && retired_count < KMUTEX_MAX_CLASSES) {
+        retired_classes[retired_count].name = mutex->name;
+        target = &retired_classes[retired_count++].stats;
+    }
+    stats_add(target, &stats);
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+/**
+ * @brief 힙에 뮤텍스를 할당하고 초기화하는 함수
+ *
+ * @param name 잠금 클래스 이름
+ * @return 뮤텍스 포인터
+ */
+KMutex *kmutex_create(const char *name) {
+    KMutex *mutex = (KMutex *)malloc(sizeof(KMutex));
+    if (mutex == NULL) {
+        kernel_errExit("뮤텍스 메모리 할당 실패");
+    }
+    kmutex_init(mutex, name);
+    return mutex;
+}
+
+/**
+ * @brief kmutex_create로 만든 뮤텍스를 정리하고 해제하는 함수
+ *
+ * @param mutex 해제할 뮤텍스
+ */
+void kmutex_free(KMutex *mutex) {
+    if (mutex == NULL) {
+        return;
+    }
+    kmutex_destroy(mutex);
+    free(mutex);
+}
+
+/**
+ * @brief 뮤텍스 하나의 통계를 읽는 함수
+ *
+ * @param mutex 뮤텍스
+ * @param stats 통계를 저장할 위치
+ */
+void kmutex_get_stats(const KMutex *mutex, KMutexStats *stats) {
+    stats->acquisitions = __atomic_load_n(&mutex->stats.acquisitions, __ATOMIC_RELAXED);
+    stats->contended = __atomic_load_n(&mutex->stats.contended, __ATOMIC_RELAXED);
+    stats->wait_ns_total = __atomic_load_n(&mutex->stats.wait_ns_total, __ATOMIC_RELAXED);
+    stats->wait_ns_max = __atomic_load_n(&mutex->stats.wait_ns_max, __ATOMIC_RELAXED);
+}
+
+static int compare_wait_desc(const void *a, const void *b) {
+    const KMutexClass *ca = (const KMutexClass *)a;
+    const KMutexClass *cb = (const KMutexClass *)b;
+
+    if (ca->stats.wait_ns_total != cb->stats.wait_ns_total) {
+        return ca->stats.wait_ns_total < cb->stats.wait_ns_total ? 1 : -1;
+    }
+    return strcmp(ca->name, cb->name);
+}
+
+/**
+ * @brief 잠금 클래스별 통계를 경합 대기 시간이 긴 순서로 문자열로 만드는 함수
+ *
+ * @param buf 출력 버퍼
+ * @param size 버퍼 크기
+ * @return 기록한 길이 (snprintf와 동일한 의미)
+ */
+int kmutex_format_report(char *buf, size_t size) {
+    KMutexClass classes[KMUTEX_MAX_CLASSES + 1];
+    KMutexStats other;
+    int count;
+
+    // 정리된 잠금의 합계에서 시작하여 살아 있는 잠금을 이름별로 더함
+    pthread_mutex_lock(&registry_mutex);
+    count = retired_count;
+    memcpy(classes, retired_classes, sizeof(KMutexClass) * (size_t)retired_count);
+    other = retired_other;
+    for (KMutex *mutex = registry_head; mutex != NULL; mutex = mutex->reg_next) {
+        KMutexStats stats;
+        KMutexStats *target = &other;
+
+        kmutex_get_stats(mutex, &stats);
+        for (int i = 0; i < count; i++) {
+            if (strcmp(classes[i].name, mutex->name) == 0) {
+                target = &classes[i].stats;
+                break;
+            }
+        }
+        if (target == &other && count < KMUTEX_MAX_CLASSES) {
+            classes[count].name = mutex->name;
+            memset(&classes[count].stats, 0, sizeof(KMutexStats));
+            target = &classes[count++].stats;
+        }
+        stats_add(target, &stats);
+    }
+    pthread_mutex_unlock(&registry_mutex);
+
+    if (other.acquisitions > 0) {
+        classes[count].name = "other";
+        classes[count++].stats = other;
+    }
+    qsort(classes, (size_t)count, sizeof(KMutexClass), compare_wait_desc);
+
+    size_t len = 0;
+    int n = snprintf(buf, size, "%-24s %12s %12s %8s %12s %12s %12s\n",
+                     "lock", "acquired", "contended", "rate", "wait_ms", "avg_wait_ns", "max_wait_ns");
+    if (n > 0) {
+        len += (size_t)n;
+    }
+    for (int i = 0; i < count; i++) {
+        const KMutexStats *s = &classes[i].stats;
+        double rate = s->acquisitions > 0 ? (double)s->contended * 100.0 / (double)s->acquisitions : 0.0;
+        unsigned long long avg = s->contended > 0 ? (unsigned long long)(s->wait_ns_total / s->contended) : 0ULL;
+
+        n = snprintf(buf + (len < size ? len : size), len < size ? size - len : 0,
+                     "%-24s %12llu %12llu %7.2f%% %12.3f %12llu %12llu\n", classes[i].name,
+                     (unsigned long long)s->acquisitions, (unsigned long long)s->contended, rate,
+                     (double)s->wait_ns_total / 1e6, avg, (unsigned long long)s->wait_ns_max);
+        if (n > 0) {
+            len += (size_t)n;
+        }
+    }
+    return (int)len;
+}
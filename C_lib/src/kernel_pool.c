@@ -0,0 +1,491 @@
+/*
+ * Kernel Thread Pool
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the persistent engine thread pool: a growable ring
+ *             of pending tasks protected by one mutex, futex-parked idle
+ *             workers and a lazily created shared pool for the engine.
+ */
+
+#include "kernel_pool.h"
+#include "kernel_futex.h"
+#include "kernel_engine.h"
+#include "kernel_trace.h"
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define POOL_INITIAL_CAPACITY 64
+#define WAIT_GROUP_WAKE_WORDS 64
+
+/**
+ * @struct PoolTask
+ * @brief 대기열에 저장되는 작업
+ */
+typedef struct PoolTask {
+    KernelTaskFunc func;    /**< 작업 함수 */
+    void *arg;              /**< 작업 인자 */
+    KWaitGroup *wg;         /**< 완료를 알릴 대기 그룹 */
+} PoolTask;
+
+/**
+ * @struct ThreadPool
+ * @brief 스레드 풀 내부 상태
+ */
+struct ThreadPool {
+    pthread_mutex_t lock;           /**< 대기열과 작업자 목록 보호 */
+    PoolTask *tasks;                /**< 원형 대기열 */
+    size_t capacity;                /**< 대기열 용량 (2의 거듭제곱) */
+    size_t head;                    /**< 다음에 꺼낼 위치 */
+    size_t count;                   /**< 대기 중인 작업 수 */
+    int idle;                       /**< 주차 중인 작업자 수 */
+    int running;                    /**< 작업을 꺼내 실행 중인 작업자 수 */
+    int shutdown;                   /**< 종료 요청 여부 */
+    pthread_t *threads;             /**< 작업자 스레드 */
+    int num_threads;                /**< 작업자 수 */
+    uint32_t signal;                /**< 작업자 주차용 futex 워드 (작업 추가 시 증가) */
+    KWaitGroup outstanding;         /**< 제출 후 완료되지 않은 전체 작업 수 */
+    KPlacement placement;           /**< 작업자 배치 */
+    int started;                    /**< 시작한 작업자 수 (배치 순번) */
+};
+
+static pthread_mutex_t engine_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static ThreadPool *engine_pool = NULL;
+static int engine_pool_workers = 0;
+static KPlacement engine_pool_placement;
+static int engine_pool_placement_set = 0;
+
+/**
+ * 대기 그룹의 깨우기용 futex 워드
+ *
+ * 카운터가 0이 되는 순간 대기 스레드가 반환하고 스택의 대기 그룹이 사라질 수 있으므로,
+ * 완료 측은 카운터를 줄인 뒤 대기 그룹 대신 수명이 프로세스 전체인 이 워드로만 깨웁니다.
+ * 주소 해시로 나눠 쓰므로 같은 워드를 공유하는 다른 대기 그룹은 가짜 깨어남만 겪습니다.
+ */
+static uint32_t wait_group_wake_words[WAIT_GROUP_WAKE_WORDS];
+
+/**
+ * @brief 대기 그룹 주소에 대응하는 깨우기 워드를 반환하는 함수
+ */
+static uint32_t *wait_group_wake_word(const KWaitGroup *wg) {
+    uintptr_t addr = (uintptr_t)wg;
+    return &wait_group_wake_words[(addr >> 4) % WAIT_GROUP_WAKE_WORDS];
+}
+
+/**
+ * @brief 대기 그룹 카운터를 증가시키는 함수
+ */
+void wait_group_add(KWaitGroup *wg, uint32_t count) {
+    __atomic_add_fetch(&wg->pending, count, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 대기 그룹 카운터를 1 감소시키고 0이 되면 대기 스레드를 깨우는 함수
+ */
+void wait_group_done(KWaitGroup *wg) {
+    uint32_t *word = wait_group_wake_word(wg);
+
+    // 감소 이후에는 wg가 해제됐을 수 있으므로 wg를 다시 건드리지 않음
+    if (__atomic_sub_fetch(&wg->pending, 1, __ATOMIC_SEQ_CST) == 0) {
+        __atomic_add_fetch(word, 1, __ATOMIC_SEQ_CST);
+        kernel_futex_wake(word, INT_MAX);
+    }
+}
+
+/**
+ * @brief 대기 그룹 카운터가 0이 될 때까지 대기하는 함수
+ */
+void wait_group_wait(KWaitGroup *wg) {
+    uint32_t *word = wait_group_wake_word(wg);
+
+    for (;;) {
+        // 워드를 먼저 읽어야 카운터 확인 뒤의 완료가 워드 변경으로 드러나 깨우기를 놓치지 않음
+        uint32_t seq = __atomic_load_n(word, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&wg->pending, __ATOMIC_SEQ_CST) == 0) {
+            return;
+        }
+        kernel_futex_wait(word, seq, NULL);
+    }
+}
+
+/**
+ * @brief 작업자 스레드 루프
+ *
+ * 대기열이 비면 signal 값을 기억해 두고 futex에서 주차하며, 종료 요청 시 남은 작업을 모두 처리한 뒤 종료합니다.
+ *
+ * @param arg ThreadPool 포인터
+ * @return NULL
+ */
+static void *pool_worker(void *arg) {
+    ThreadPool *pool = (ThreadPool *)arg;
+    int index = __atomic_fetch_add(&pool->started, 1, __ATOMIC_RELAXED);
+
+    // 실패하면 kplacement_apply가 추적 로그를 남기며 작업자는 고정 없이 계속 실행
+    kplacement_apply(&pool->placement, index);
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        if (pool->count > 0) {
+            PoolTask task = pool->tasks[pool->head];
+            pool->head = (pool->head + 1) & (pool->capacity - 1);
+            pool->count--;
+            pool->running++;
+            pthread_mutex_unlock(&pool->lock);
+
+            task.func(task.arg);
+            if (task.wg != NULL) {
+                wait_group_done(task.wg);
+            }
+            wait_group_done(&pool->outstanding);
+
+            pthread_mutex_lock(&pool->lock);
+            pool->running--;
+            continue;
+        }
+
+        if (pool->shutdown) {
+            break;
+        }
+
+        uint32_t seq = __atomic_load_n(&pool->signal, __ATOMIC_ACQUIRE);
+        pool->idle++;
+        pthread_mutex_unlock(&pool->lock);
+
+        kernel_futex_wait(&pool->signal, seq, NULL);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->idle--;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief 주차 중인 작업자를 깨우는 함수
+ *
+ * @param pool 스레드 풀
+ * @param count 깨울 작업자 수
+ */
+static void pool_signal(ThreadPool *pool, int count) {
+    __atomic_add_fetch(&pool->signal, 1, __ATOMIC_RELEASE);
+    kernel_futex_wake(&pool->signal, count);
+}
+
+/**
+ * @brief 스레드 풀 생성 함수
+ *
+ * @param num_workers 작업자 수 (0 이하이면 온라인 CPU 수)
+ * @return 생성된 ThreadPool 포인터 (실패 시 NULL)
+ */
+ThreadPool *thread_pool_create(int num_workers) {
+    return thread_pool_create_placed(num_workers, NULL);
+}
+
+/**
+ * @brief 작업자 배치를 지정해 스레드 풀을 생성하는 함수
+ *
+ * @param num_workers 작업자 수 (0 이하이면 온라인 CPU 수)
+ * @param placement 작업자 배치 (NULL이면 고정하지 않음)
+ * @return 생성된 ThreadPool 포인터 (실패 시 NULL)
+ */
+ThreadPool *thread_pool_create_placed(int num_workers, const KPlacement *placement) {
+    if (num_workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cpus > 0 ? (int)cpus : 1;
+    }
+
+    ThreadPool *pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+    if (pool == NULL) {
+        kernel_errMsg("스레드 풀 메모리 할당 실패");
+        return NULL;
+    }
+
+    pool->capacity = POOL_INITIAL_CAPACITY;
+    pool->tasks = (PoolTask *)malloc(pool->capacity * sizeof(PoolTask));
+    pool->threads = (pthread_t *)malloc(KERNEL_POOL_MAX_THREADS * sizeof(pthread_t));
+    if (pool->tasks == NULL || pool->threads == NULL) {
+        kernel_errMsg("스레드 풀 메모리 할당 실패");
+        free(pool->tasks);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    if (placement != NULL) {
+        pool->placement = *placement;
+    }
+
+    if (thread_pool_reserve(pool, num_workers) <= 0) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "스레드 풀 생성 (작업자 수: %d)", pool->num_threads);
+    return pool;
+}
+
+/**
+ * @brief 대기열 용량을 최소 needed개로 늘리는 함수 (lock 보유 상태에서 호출)
+ *
+ * @return 성공 시 0, 메모리 부족 시 -1
+ */
+static int pool_grow_locked(ThreadPool *pool, size_t needed) {
+    if (needed <= pool->capacity) {
+        return 0;
+    }
+
+    size_t new_capacity = pool->capacity;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    // 원형 대기열을 늘리면서 순서를 펼쳐서 복사
+    PoolTask *tasks = (PoolTask *)malloc(new_capacity * sizeof(PoolTask));
+    if (tasks == NULL) {
+        kernel_errMsg("작업 대기열 확장 실패");
+        return -1;
+    }
+    for (size_t i = 0; i < pool->count; i++) {
+        tasks[i] = pool->tasks[(pool->head + i) & (pool->capacity - 1)];
+    }
+    free(pool->tasks);
+    pool->tasks = tasks;
+    pool->capacity = new_capacity;
+    pool->head = 0;
+    return 0;
+}
+
+/**
+ * @brief 용량이 확보된 대기열 끝에 작업을 넣는 함수 (lock 보유 상태에서 호출)
+ */
+static void pool_push_locked(ThreadPool *pool, KernelTaskFunc func, void *arg, KWaitGroup *wg) {
+    if (wg != NULL) {
+        wait_group_add(wg, 1);
+    }
+    wait_group_add(&pool->outstanding, 1);
+
+    PoolTask *task = &pool->tasks[(pool->head + pool->count) & (pool->capacity - 1)];
+    task->func = func;
+    task->arg = arg;
+    task->wg = wg;
+    pool->count++;
+}
+
+/**
+ * @brief 작업자를 num_workers개까지 만드는 함수 (lock 보유 상태에서 호출)
+ *
+ * @return 모두 만들었으면 0, 생성 실패 시 -1
+ */
+static int pool_spawn_locked(ThreadPool *pool, int num_workers) {
+    while (!pool->shutdown && pool->num_threads < num_workers) {
+        int err = pthread_create(&pool->threads[pool->num_threads], NULL, pool_worker, pool);
+        if (err != 0) {
+            errno = err;
+            kernel_errMsg("스레드 풀 작업자 %d 생성 실패", pool->num_threads);
+            return -1;
+        }
+        pool->num_threads++;
+    }
+    return 0;
+}
+
+/**
+ * @brief 작업 제출 함수
+ *
+ * @param pool 스레드 풀
+ * @param func 실행할 작업 함수
+ * @param arg 작업 함수에 전달할 인자
+ * @param wg 완료를 알릴 대기 그룹 (NULL 가능)
+ * @return 성공 시 0, 풀이 종료 중이면 -1
+ */
+int thread_pool_submit(ThreadPool *pool, KernelTaskFunc func, void *arg, KWaitGroup *wg) {
+    pthread_mutex_lock(&pool->lock);
+    if (pool->shutdown || pool_grow_locked(pool, pool->count + 1) != 0) {
+        pthread_mutex_unlock(&pool->lock);
+        return -1;
+    }
+
+    pool_push_locked(pool, func, arg, wg);
+    int idle = pool->idle;
+    pthread_mutex_unlock(&pool->lock);
+
+    // 주차 중인 작업자가 없으면 실행 중인 작업자가 루프에서 작업을 가져감
+    if (idle > 0) {
+        pool_signal(pool, 1);
+    }
+    return 0;
+}
+
+/**
+ * @brief 서로를 기다릴 수 있는 작업 묶음을 동시에 실행되도록 제출하는 함수
+ *
+ * 실행 중인 작업과 앞서 대기 중인 작업을 모두 맡고도 count개가 남도록 작업자를 늘린 뒤
+ * 같은 잠금 구간에서 묶음을 넣습니다. 이후 제출된 작업은 묶음 뒤에 줄을 서므로
+ * 다른 호출자, 타이머 콜백이나 풀 작업 안에서의 호출과 겹쳐도 묶음 전체가 작업자를 받습니다.
+ *
+ * @return 성공 시 0, 작업자 한도 초과/생성 실패/종료 중이면 -1
+ */
+int thread_pool_submit_concurrent(ThreadPool *pool, const KernelTaskFunc *funcs, int count,
+                                  void *arg, KWaitGroup *wg) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->shutdown) {
+        pthread_mutex_unlock(&pool->lock);
+        return -1;
+    }
+
+    long needed = (long)pool->running + (long)pool->count + count;
+    if (needed > KERNEL_POOL_MAX_THREADS) {
+        int running = pool->running;
+        size_t queued = pool->count;
+        pthread_mutex_unlock(&pool->lock);
+        errno = EAGAIN;
+        kernel_errMsg("동시 작업 %d개에 필요한 작업자 %ld개가 한도 %d개를 넘음 (실행 중 %d, 대기 %zu)",
+                      count, needed, KERNEL_POOL_MAX_THREADS, running, queued);
+        return -1;
+    }
+    if (pool_spawn_locked(pool, (int)needed) != 0 || pool->shutdown ||
+        pool_grow_locked(pool, pool->count + (size_t)count) != 0) {
+        pthread_mutex_unlock(&pool->lock);
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        pool_push_locked(pool, funcs[i], arg, wg);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    pool_signal(pool, count);
+    return 0;
+}
+
+/**
+ * @brief 지금까지 제출된 모든 작업이 끝날 때까지 대기하는 함수
+ */
+void thread_pool_wait(ThreadPool *pool) {
+    wait_group_wait(&pool->outstanding);
+}
+
+/**
+ * @brief 작업자 수를 최소 num_workers개로 늘리는 함수
+ */
+int thread_pool_reserve(ThreadPool *pool, int num_workers) {
+    if (num_workers > KERNEL_POOL_MAX_THREADS) {
+        errno = EINVAL;
+        kernel_errMsg("작업자 %d개 요청이 한도 %d개를 넘음", num_workers, KERNEL_POOL_MAX_THREADS);
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool_spawn_locked(pool, num_workers);
+    int size = pool->num_threads;
+    pthread_mutex_unlock(&pool->lock);
+    return size;
+}
+
+/**
+ * @brief 현재 작업자 수를 반환하는 함수
+ */
+int thread_pool_size(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    int size = pool->num_threads;
+    pthread_mutex_unlock(&pool->lock);
+    return size;
+}
+
+/**
+ * @brief 대기 중인 작업을 모두 실행한 뒤 작업자를 종료하고 풀을 해제하는 함수
+ */
+void thread_pool_destroy(ThreadPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    int num_threads = pool->num_threads;
+    pthread_mutex_unlock(&pool->lock);
+
+    pool_signal(pool, INT_MAX);
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "스레드 풀 종료 (작업자 수: %d)", num_threads);
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->tasks);
+    free(pool->threads);
+    free(pool);
+}
+
+/**
+ * @brief 엔진 공용 스레드 풀 설정 함수
+ */
+void kernel_engine_pool_configure(int num_workers) {
+    pthread_mutex_lock(&engine_pool_mutex);
+    engine_pool_workers = num_workers;
+    pthread_mutex_unlock(&engine_pool_mutex);
+}
+
+/**
+ * @brief 엔진 공용 스레드 풀의 작업자 배치 설정 함수
+ */
+void kernel_engine_pool_configure_placement(const KPlacement *placement) {
+    pthread_mutex_lock(&engine_pool_mutex);
+    engine_pool_placement_set = placement != NULL;
+    if (placement != NULL) {
+        engine_pool_placement = *placement;
+    }
+    pthread_mutex_unlock(&engine_pool_mutex);
+}
+
+/**
+ * @brief 엔진 공용 스레드 풀을 반환하는 함수 (처음 호출 시 생성)
+ */
+ThreadPool *kernel_engine_pool(void) {
+    ThreadPool *pool = __atomic_load_n(&engine_pool, __ATOMIC_ACQUIRE);
+    if (pool != NULL) {
+        return pool;
+    }
+
+    pthread_mutex_lock(&engine_pool_mutex);
+    if (engine_pool == NULL) {
+        int workers = engine_pool_workers;
+        const char *env = getenv("KERNEL_POOL_THREADS");
+        if (workers <= 0 && env != NULL) {
+            workers = atoi(env);
+        }
+        if (!engine_pool_placement_set) {
+            kplacement_from_env(&engine_pool_placement, "KERNEL_POOL_PLACEMENT");
+        }
+        pool = thread_pool_create_placed(workers, &engine_pool_placement);
+        if (pool == NULL) {
+            pthread_mutex_unlock(&engine_pool_mutex);
+            kernel_errExit("엔진 스레드 풀 생성 실패");
+        }
+        __atomic_store_n(&engine_pool, pool, __ATOMIC_RELEASE);
+    }
+    pool = engine_pool;
+    pthread_mutex_unlock(&engine_pool_mutex);
+    return pool;
+}
+
+/**
+ * @brief 엔진 공용 스레드 풀을 종료하는 함수
+ */
+void kernel_engine_pool_shutdown(void) {
+    pthread_mutex_lock(&engine_pool_mutex);
+    ThreadPool *pool = engine_pool;
+    __atomic_store_n(&engine_pool, NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&engine_pool_mutex);
+
+    thread_pool_destroy(pool);
+}
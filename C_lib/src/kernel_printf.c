@@ -9,7 +9,10 @@
  */
 #include <stdio.h>
 #include <stdarg.h>
+#include "kernel_format.h"
 #include "kernel_pr_he.h"
+#include "kernel_print_sink.h"
+#include "kernel_trace.h"
 
 // 함수 전방 선언
 int az_default_mod(char *format);
@@ -405,14 +408,8 @@ void az_f(va_list ap, char *format, char flag) {
         param_precision = atoi(precision_ptr + 1);
     }
     
-    // 서식 옵션에 따라 부동소수점 출력
-    char format_string[20];
-    sprintf(format_string, "%%%s%d.%df", (flag == '-') ? "-" : "", param_width, param_precision);
-    
-    char buffer[50];
-    sprintf(buffer, format_string, f);
-    
-    az_putstr(buffer);
+    // 서식 옵션에 따라 부동소수점 출력 (az_dtoa.c, 버퍼 크기 제한 없음)
+    az_putfloat(f, 'f', param_width, param_precision, (flag == '-') ? AZ_FLAG_LEFT : 0);
 }
 
 
@@ -472,11 +469,13 @@ void az_s(va_list ap, char *format, char flag)
 // az_p 함수는 'p' (포인터) 형식의 데이터를 처리합니다.
 void az_p(va_list ap)
 {
-    int nbr;
+    char buf[AZ_NUMBUF_SIZE];
+    size_t len;
 
-    nbr = va_arg(ap, int);
+    // 포인터 전체 폭으로 변환 (int로 읽으면 64비트 주소의 위쪽이 잘림)
+    len = az_utoa((uintptr_t)va_arg(ap, void *), 16, 0, buf + sizeof(buf));
     az_putstr("0x");
-    az_puthex(nbr); // 포인터 값 16진수로 출력
+    az_print_write(buf + sizeof(buf) - len, len); // 포인터 값 16진수로 출력
 }
 
 // az_x 함수는 'x' 또는 'X' (16진수) 형식의 데이터를 처리합니다.
@@ -484,6 +483,8 @@ void az_x(va_list ap, char *format, char flag)
 {
     int x;
     int param;
+    char buf[AZ_NUMBUF_SIZE];
+    size_t len;
 
     x = va_arg(ap, int);
     param = az_getparam(format, flag);
@@ -492,7 +493,10 @@ void az_x(va_list ap, char *format, char flag)
     if (flag == '#' && az_strchr(format, 'X'))
         az_putstr("0X"); // '0X' 접두사 출력
     if (x && az_strchr(format, 'X'))
-        az_putstr(az_itoa(x, 16)); // 16진수 대문자 형식으로 출력
+    {
+        len = az_utoa((unsigned int)x, 16, 1, buf + sizeof(buf));
+        az_print_write(buf + sizeof(buf) - len, len); // 16진수 대문자 형식으로 출력
+    }
     if (x && !param && !az_strchr(format, 'X'))
         az_puthex(x); // 16진수 소문자 형식으로 출력
 }
@@ -596,13 +600,97 @@ int kernel_printf(const char *format, ...)
 {
     va_list ap; // 가변 인자를 저장하기 위한 va_list 선언
 
+    KTRACE(KTRACE_CAT_PRINTF, KTRACE_LVL_DEBUG, "kernel_printf(\"%s\")", format);
+
     va_start(ap, format);           // 가변 인자 리스트를 초기화
-    az_default((char *)format, ap); // 포맷 문자열과 가변 인자 리스트를 처리하는 az_default 함수 호출
+    az_print_begin();               // 호출 전체를 스레드 버퍼에 모아 한 번에 출력
+    // 컴파일된 포맷(kernel_format.h)으로 출력하고, 지원하지 않는 포맷만 az_default로 해석
+    if (kfmt_vformat(format, &ap) != 0)
+        az_default((char *)format, ap);
+    az_print_end();
     va_end(ap);                     // 가변 인자 리스트를 종료
 
     return (0); // 0을 반환
 }
 
+// az_print_to_sink에 넘길 포맷 작업
+typedef struct
+{
+    const char *format;
+    va_list ap;
+} AzRender;
+
+static void az_render(void *arg)
+{
+    AzRender *r = (AzRender *)arg;
+    if (kfmt_vformat(r->format, &r->ap) != 0)
+        az_default((char *)r->format, r->ap);
+}
+
+// kernel_printf와 같은 포맷터로 sink에 출력 (호출 스레드의 출력 버퍼는 건드리지 않음)
+int kernel_sink_vprintf(const KPrintSink *sink, const char *format, va_list ap)
+{
+    AzRender r;
+    size_t len;
+
+    r.format = format;
+    va_copy(r.ap, ap);
+    len = az_print_to_sink(sink, az_render, &r);
+    va_end(r.ap);
+    return ((int)len);
+}
+
+int kernel_sink_printf(const KPrintSink *sink, const char *format, ...)
+{
+    va_list ap;
+    int len;
+
+    va_start(ap, format);
+    len = kernel_sink_vprintf(sink, format, ap);
+    va_end(ap);
+    return (len);
+}
+
+// 버퍼에 포맷 (시스템 호출 없음, 반환값은 snprintf와 같이 잘리기 전 길이)
+int kernel_vsnprintf(char *buf, size_t size, const char *format, va_list ap)
+{
+    KPrintMem mem;
+    KPrintSink sink = { kernel_print_mem_write, &mem };
+
+    kernel_print_mem_init(&mem, buf, size);
+    kernel_sink_vprintf(&sink, format, ap);
+    return ((int)mem.len);
+}
+
+int kernel_snprintf(char *buf, size_t size, const char *format, ...)
+{
+    va_list ap;
+    int len;
+
+    va_start(ap, format);
+    len = kernel_vsnprintf(buf, size, format, ap);
+    va_end(ap);
+    return (len);
+}
+
+// 파일 디스크립터에 출력 (KPRINT_BUFFER_SIZE 이하면 write 한 번)
+int kernel_vdprintf(int fd, const char *format, va_list ap)
+{
+    KPrintSink sink = { kernel_print_fd_write, (void *)(intptr_t)fd };
+    return (kernel_sink_vprintf(&sink, format, ap));
+}
+
+int kernel_dprintf(int fd, const char *format, ...)
+{
+    va_list ap;
+    int len;
+
+    va_start(ap, format);
+    len = kernel_vdprintf(fd, format, ap);
+    va_end(ap);
+    return (len);
+}
+
 /* ************************************************************************************
  *
  *      test_kernel_printf method
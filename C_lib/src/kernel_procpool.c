@@ -0,0 +1,526 @@
+/*
+ * Kernel Process Pool
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the pre-forked process pool. The owner fills a
+ *             free slot in the shared ring and marks it queued; a worker
+ *             claims it by CAS-ing its own id into the slot state, runs the
+ *             job and publishes the result. Because the claiming worker is
+ *             recorded in the state word itself, the zygote that reaps the
+ *             workers can fail exactly the job a crashed worker was running.
+ */
+
+#include "kernel_procpool.h"
+#include "kernel_futex.h"
+#include "kernel_engine.h"
+#include "kernel_trace.h"
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* 작업자 충돌 확인 주기 (ms) */
+#define KPROC_MONITOR_INTERVAL_MS 20
+
+/* 종료 단계별 유예 시간 (ms): 정상 종료 -> SIGTERM -> SIGKILL */
+#define KPROC_SHUTDOWN_GRACE_MS 500
+
+/* 슬롯 상태 (RUNNING은 하위 비트에 작업자 번호를 담음) */
+#define SLOT_FREE 0u
+#define SLOT_RESERVED 1u
+#define SLOT_QUEUED 2u
+#define SLOT_DONE 3u
+#define SLOT_CRASHED 4u
+#define SLOT_RUNNING 0x100u
+
+/* 자이고트 초기화 상태 */
+#define ZYGOTE_STARTING 0u
+#define ZYGOTE_READY 1u
+#define ZYGOTE_FAILED 2u
+
+/**
+ * @struct KProcSlot
+ * @brief 공유 메모리 링의 작업 슬롯
+ */
+typedef struct KProcSlot {
+    uint32_t state;                         /**< 슬롯 상태 (futex 워드) */
+    uint32_t input_len;                     /**< 입력 크기 */
+    uint32_t output_len;                    /**< 결과 크기 */
+    int result;                             /**< 작업 반환값 또는 종료 시그널 */
+    KProcJobFunc func;                      /**< 실행할 함수 */
+    unsigned char input[KPROC_JOB_INPUT_MAX];
+    unsigned char output[KPROC_JOB_OUTPUT_MAX];
+} __attribute__((aligned(64))) KProcSlot;
+
+/**
+ * @struct KProcShared
+ * @brief 소유 프로세스, 자이고트와 작업자들이 공유하는 영역
+ */
+typedef struct KProcShared {
+    uint32_t shutdown;                      /**< 종료 요청 (자이고트 깨우기용 futex 워드) */
+    uint32_t work_seq;                      /**< 작업 추가 시 증가 (작업자 주차용 futex 워드) */
+    uint32_t free_seq;                      /**< 슬롯 반납 시 증가 (제출자 대기용 futex 워드) */
+    uint32_t head;                          /**< 작업자가 탐색을 시작할 위치 */
+    uint32_t tail;                          /**< 제출자가 탐색을 시작할 위치 */
+    uint32_t zygote_state;                  /**< 자이고트 초기화 상태 (futex 워드) */
+    uint32_t respawns;                      /**< 재생성된 작업자 수 */
+    int num_workers;                        /**< 작업자 수 */
+    pid_t owner;                            /**< 풀을 만든 프로세스 */
+    pid_t zygote;                           /**< 작업자를 fork하는 자이고트 프로세스 */
+    pid_t pids[KPROC_POOL_MAX_WORKERS];     /**< 작업자 PID (자이고트만 기록) */
+    KProcSlot slots[KPROC_POOL_SLOTS];
+} KProcShared;
+
+/**
+ * @struct KProcPool
+ * @brief 소유 프로세스 쪽 풀 상태
+ */
+struct KProcPool {
+    KProcShared *shm;                       /**< 공유 영역 */
+    size_t shm_size;                        /**< 공유 영역 크기 */
+    int memfd;                              /**< 공유 영역 파일 디스크립터 (없으면 -1) */
+    int num_workers;                        /**< 작업자 수 */
+    pid_t zygote;                           /**< 자이고트 PID (프로세스 그룹 번호와 같음, 회수 후 -1) */
+};
+
+/**
+ * @brief 대기 중인 슬롯 하나를 가져와 자신의 번호로 표시하는 함수
+ */
+static KProcSlot *worker_claim(KProcShared *shm, int id) {
+    uint32_t start = __atomic_load_n(&shm->head, __ATOMIC_RELAXED);
+
+    for (uint32_t i = 0; i < KPROC_POOL_SLOTS; i++) {
+        uint32_t idx = (start + i) % KPROC_POOL_SLOTS;
+        KProcSlot *slot = &shm->slots[idx];
+        uint32_t expected = SLOT_QUEUED;
+
+        if (__atomic_load_n(&slot->state, __ATOMIC_RELAXED) != SLOT_QUEUED) {
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&slot->state, &expected, SLOT_RUNNING + (uint32_t)id, false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&shm->head, (idx + 1) % KPROC_POOL_SLOTS, __ATOMIC_RELAXED);
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 작업자 프로세스 루프 (반환하지 않음)
+ *
+ * 자이고트가 사라지면 주기적인 확인에서 이를 감지하고 종료합니다.
+ */
+static void worker_main(KProcShared *shm, int id) {
+    // 자이고트가 무시하도록 해 둔 SIGTERM을 작업자에서는 다시 기본 동작으로 되돌림
+    signal(SIGTERM, SIG_DFL);
+
+    for (;;) {
+        if (__atomic_load_n(&shm->shutdown, __ATOMIC_ACQUIRE)) {
+            _exit(EXIT_SUCCESS);
+        }
+
+        uint32_t seq = __atomic_load_n(&shm->work_seq, __ATOMIC_ACQUIRE);
+        KProcSlot *slot = worker_claim(shm, id);
+        if (slot != NULL) {
+            size_t output_len = 0;
+            int result = slot->func(slot->input, slot->input_len, slot->output, KPROC_JOB_OUTPUT_MAX, &output_len);
+
+            slot->result = result;
+            slot->output_len = (uint32_t)(output_len > KPROC_JOB_OUTPUT_MAX ? KPROC_JOB_OUTPUT_MAX : output_len);
+            __atomic_store_n(&slot->state, SLOT_DONE, __ATOMIC_RELEASE);
+            kernel_futex_wake_shared(&slot->state, INT_MAX);
+            continue;
+        }
+
+        struct timespec timeout = { 1, 0 };
+        kernel_futex_wait_shared(&shm->work_seq, seq, &timeout);
+        if (getppid() != shm->zygote) {
+            _exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * @brief 자이고트에서 작업자 프로세스 하나를 fork하는 함수
+ *
+ * @return 성공 시 0, 실패 시 -1
+ */
+static int spawn_worker(KProcShared *shm, int id) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        worker_main(shm, id);
+    }
+    __atomic_store_n(&shm->pids[id], pid, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/**
+ * @brief 종료된 작업자가 실행 중이던 작업을 실패로 표시하는 함수
+ */
+static void handle_worker_exit(KProcShared *shm, int id, int status) {
+    int code = WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status);
+
+    for (int i = 0; i < KPROC_POOL_SLOTS; i++) {
+        KProcSlot *slot = &shm->slots[i];
+        if (__atomic_load_n(&slot->state, __ATOMIC_ACQUIRE) == SLOT_RUNNING + (uint32_t)id) {
+            slot->result = code;
+            slot->output_len = 0;
+            __atomic_store_n(&slot->state, SLOT_CRASHED, __ATOMIC_RELEASE);
+            kernel_futex_wake_shared(&slot->state, INT_MAX);
+        }
+    }
+    __atomic_store_n(&shm->pids[id], -1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 자이고트 프로세스 루프 (반환하지 않음)
+ *
+ * 소유 프로세스가 여러 스레드를 가진 뒤에는 fork가 다른 스레드가 잡고 있던 잠금을 복제할 수 있으므로,
+ * 생성 시 한 번만 fork된 단일 스레드 자이고트가 모든 작업자를 fork하고 회수합니다.
+ * 같은 이유로 여기서는 stdio, malloc, 추적 로그를 사용하지 않고 공유 영역만 갱신합니다.
+ *
+ * 종료 요청을 받으면 작업자를 더 만들지 않고, 모든 작업자를 회수한 뒤 종료합니다.
+ * 소유 프로세스가 SIGTERM으로 작업자들을 정리할 수 있도록 자이고트 자신은 SIGTERM을 무시합니다.
+ */
+static void zygote_main(KProcShared *shm, int num_workers) {
+    struct timespec interval = { 0, KPROC_MONITOR_INTERVAL_MS * 1000000L };
+
+    signal(SIGTERM, SIG_IGN);
+    shm->zygote = getpid();
+
+    for (int i = 0; i < num_workers; i++) {
+        if (spawn_worker(shm, i) != 0) {
+            __atomic_store_n(&shm->shutdown, 1, __ATOMIC_RELEASE);
+            __atomic_add_fetch(&shm->work_seq, 1, __ATOMIC_RELEASE);
+            kernel_futex_wake_shared(&shm->work_seq, INT_MAX);
+            __atomic_store_n(&shm->zygote_state, ZYGOTE_FAILED, __ATOMIC_RELEASE);
+            kernel_futex_wake_shared(&shm->zygote_state, INT_MAX);
+            while (wait(NULL) > 0 || errno == EINTR) {
+            }
+            _exit(EXIT_FAILURE);
+        }
+    }
+    __atomic_store_n(&shm->zygote_state, ZYGOTE_READY, __ATOMIC_RELEASE);
+    kernel_futex_wake_shared(&shm->zygote_state, INT_MAX);
+
+    for (;;) {
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            for (int i = 0; i < num_workers; i++) {
+                if (shm->pids[i] == pid) {
+                    handle_worker_exit(shm, i, status);
+                    break;
+                }
+            }
+        }
+
+        int shutdown = __atomic_load_n(&shm->shutdown, __ATOMIC_ACQUIRE);
+        if (!shutdown && getppid() != shm->owner) {
+            // 소유 프로세스가 사라지면 작업자들이 현재 작업을 마치고 종료하도록 함
+            __atomic_store_n(&shm->shutdown, 1, __ATOMIC_RELEASE);
+            __atomic_add_fetch(&shm->work_seq, 1, __ATOMIC_RELEASE);
+            kernel_futex_wake_shared(&shm->work_seq, INT_MAX);
+            shutdown = 1;
+        }
+
+        int live = 0;
+        for (int i = 0; i < num_workers; i++) {
+            if (shm->pids[i] > 0) {
+                live++;
+            } else if (!shutdown && spawn_worker(shm, i) == 0) {
+                __atomic_add_fetch(&shm->respawns, 1, __ATOMIC_RELAXED);
+                live++;
+            }
+            // fork가 실패하면 다음 주기에 다시 시도
+        }
+        if (shutdown && live == 0) {
+            _exit(EXIT_SUCCESS);
+        }
+
+        kernel_futex_wait_shared(&shm->shutdown, (uint32_t)shutdown, &interval);
+    }
+}
+
+/**
+ * @brief 자이고트가 종료될 때까지 최대 timeout_ms 동안 기다리며 회수하는 함수
+ *
+ * @return 회수했으면 1, 시간이 지나도 살아 있으면 0
+ */
+static int reap_zygote(KProcPool *pool, int timeout_ms) {
+    struct timespec interval = { 0, KPROC_MONITOR_INTERVAL_MS * 1000000L };
+
+    for (int waited = 0;; waited += KPROC_MONITOR_INTERVAL_MS) {
+        pid_t pid = waitpid(pool->zygote, NULL, WNOHANG);
+        if (pid == pool->zygote || (pid < 0 && errno == ECHILD)) {
+            pool->zygote = -1;
+            return 1;
+        }
+        if (waited >= timeout_ms) {
+            return 0;
+        }
+        nanosleep(&interval, NULL);
+    }
+}
+
+/**
+ * @brief 공유 영역을 만드는 함수 (Linux는 memfd, 그 외는 익명 공유 매핑)
+ */
+static int create_shared(KProcPool *pool) {
+    pool->shm_size = sizeof(KProcShared);
+    pool->memfd = -1;
+
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+    pool->memfd = memfd_create("kernel_procpool", MFD_CLOEXEC);
+    if (pool->memfd < 0 || ftruncate(pool->memfd, (off_t)pool->shm_size) != 0) {
+        kernel_errMsg("프로세스 풀 공유 메모리 생성 실패");
+        if (pool->memfd >= 0) {
+            close(pool->memfd);
+        }
+        return -1;
+    }
+    void *mem = mmap(NULL, pool->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, pool->memfd, 0);
+#else
+    void *mem = mmap(NULL, pool->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANON, -1, 0);
+#endif
+    if (mem == MAP_FAILED) {
+        kernel_errMsg("프로세스 풀 공유 메모리 매핑 실패");
+        if (pool->memfd >= 0) {
+            close(pool->memfd);
+        }
+        return -1;
+    }
+
+    pool->shm = (KProcShared *)mem;
+    memset(pool->shm, 0, pool->shm_size);
+    pool->shm->owner = getpid();
+    return 0;
+}
+
+/**
+ * @brief 프로세스 풀 생성 함수
+ */
+KProcPool *kproc_pool_create(int num_workers) {
+    if (num_workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (num_workers > KPROC_POOL_MAX_WORKERS) {
+        num_workers = KPROC_POOL_MAX_WORKERS;
+    }
+
+    KProcPool *pool = (KProcPool *)calloc(1, sizeof(KProcPool));
+    if (pool == NULL) {
+        kernel_errMsg("프로세스 풀 메모리 할당 실패");
+        return NULL;
+    }
+    if (create_shared(pool) != 0) {
+        free(pool);
+        return NULL;
+    }
+    pool->num_workers = num_workers;
+    pool->shm->num_workers = num_workers;
+    for (int i = 0; i < num_workers; i++) {
+        pool->shm->pids[i] = -1;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        kernel_errMsg("프로세스 풀 자이고트 생성 실패");
+        pool->zygote = -1;
+        kproc_pool_destroy(pool);
+        return NULL;
+    }
+    if (pid == 0) {
+        // 자이고트를 새 프로세스 그룹으로 만들어 종료 시 작업자와 함께 시그널을 보낼 수 있도록 함
+        setpgid(0, 0);
+        zygote_main(pool->shm, num_workers);
+    }
+    setpgid(pid, pid);
+    pool->zygote = pid;
+    pool->shm->zygote = pid;
+
+    // 자이고트가 초기 작업자를 모두 만들 때까지 대기 (그 사이 자이고트가 죽으면 실패)
+    struct timespec interval = { 0, KPROC_MONITOR_INTERVAL_MS * 1000000L };
+    uint32_t state;
+    while ((state = __atomic_load_n(&pool->shm->zygote_state, __ATOMIC_ACQUIRE)) == ZYGOTE_STARTING) {
+        if (waitpid(pid, NULL, WNOHANG) == pid) {
+            pool->zygote = -1;
+            break;
+        }
+        kernel_futex_wait_shared(&pool->shm->zygote_state, ZYGOTE_STARTING, &interval);
+    }
+    if (state != ZYGOTE_READY) {
+        kernel_errMsg("프로세스 풀 작업자 생성 실패");
+        kproc_pool_destroy(pool);
+        return NULL;
+    }
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "프로세스 풀 생성 (작업자 수: %d, 자이고트 PID %d)",
+           num_workers, (int)pid);
+    return pool;
+}
+
+/**
+ * @brief 작업 제출 함수
+ */
+int kproc_pool_submit(KProcPool *pool, KProcJobFunc func, const void *input, size_t input_len) {
+    KProcShared *shm = pool->shm;
+
+    if (input_len > KPROC_JOB_INPUT_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    for (;;) {
+        if (__atomic_load_n(&shm->shutdown, __ATOMIC_ACQUIRE)) {
+            errno = ESHUTDOWN;
+            return -1;
+        }
+
+        uint32_t free_seq = __atomic_load_n(&shm->free_seq, __ATOMIC_ACQUIRE);
+        uint32_t start = __atomic_fetch_add(&shm->tail, 1, __ATOMIC_RELAXED);
+
+        for (uint32_t i = 0; i < KPROC_POOL_SLOTS; i++) {
+            uint32_t idx = (start + i) % KPROC_POOL_SLOTS;
+            KProcSlot *slot = &shm->slots[idx];
+            uint32_t expected = SLOT_FREE;
+
+            if (!__atomic_compare_exchange_n(&slot->state, &expected, SLOT_RESERVED, false,
+                                             __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                continue;
+            }
+
+            slot->func = func;
+            slot->input_len = (uint32_t)input_len;
+            slot->output_len = 0;
+            slot->result = 0;
+            if (input_len > 0) {
+                memcpy(slot->input, input, input_len);
+            }
+            __atomic_store_n(&slot->state, SLOT_QUEUED, __ATOMIC_RELEASE);
+
+            __atomic_add_fetch(&shm->work_seq, 1, __ATOMIC_RELEASE);
+            kernel_futex_wake_shared(&shm->work_seq, 1);
+            return (int)idx;
+        }
+
+        // 모든 슬롯이 사용 중이면 반납될 때까지 대기
+        kernel_futex_wait_shared(&shm->free_seq, free_seq, NULL);
+    }
+}
+
+/**
+ * @brief 작업 완료를 기다리고 결과를 가져오는 함수
+ */
+int kproc_pool_wait(KProcPool *pool, int job, void *output, size_t output_cap, size_t *output_len, int *job_result) {
+    KProcShared *shm = pool->shm;
+    KProcSlot *slot;
+    uint32_t state;
+
+    if (job < 0 || job >= KPROC_POOL_SLOTS) {
+        kernel_errMsg("잘못된 작업 번호: %d", job);
+        return KPROC_JOB_CRASHED;
+    }
+    slot = &shm->slots[job];
+
+    while ((state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE)) != SLOT_DONE && state != SLOT_CRASHED) {
+        kernel_futex_wait_shared(&slot->state, state, NULL);
+    }
+
+    size_t len = slot->output_len;
+    if (output != NULL) {
+        if (len > output_cap) {
+            len = output_cap;
+        }
+        memcpy(output, slot->output, len);
+    }
+    if (output_len != NULL) {
+        *output_len = len;
+    }
+    if (job_result != NULL) {
+        *job_result = slot->result;
+    }
+
+    __atomic_store_n(&slot->state, SLOT_FREE, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&shm->free_seq, 1, __ATOMIC_RELEASE);
+    kernel_futex_wake_shared(&shm->free_seq, 1);
+
+    return state == SLOT_DONE ? KPROC_JOB_DONE : KPROC_JOB_CRASHED;
+}
+
+/**
+ * @brief 작업을 제출하고 완료까지 기다리는 함수
+ */
+int kproc_pool_run(KProcPool *pool, KProcJobFunc func, const void *input, size_t input_len,
+                   void *output, size_t output_cap, size_t *output_len, int *job_result) {
+    int job = kproc_pool_submit(pool, func, input, input_len);
+    if (job < 0) {
+        return -2;
+    }
+    return kproc_pool_wait(pool, job, output, output_cap, output_len, job_result);
+}
+
+/**
+ * @brief 작업자 프로세스 수를 반환하는 함수
+ */
+int kproc_pool_size(KProcPool *pool) {
+    return pool->num_workers;
+}
+
+/**
+ * @brief 충돌 후 다시 생성된 작업자 수를 반환하는 함수
+ */
+unsigned kproc_pool_respawns(KProcPool *pool) {
+    return __atomic_load_n(&pool->shm->respawns, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 프로세스 풀 종료 함수
+ *
+ * 종료를 알린 뒤 유예 시간 안에 자이고트가 작업자를 모두 회수하고 끝나지 않으면 프로세스 그룹에 SIGTERM을,
+ * 그래도 남아 있으면 SIGKILL을 보낸 다음 자이고트를 회수합니다.
+ */
+void kproc_pool_destroy(KProcPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    KProcShared *shm = pool->shm;
+    __atomic_store_n(&shm->shutdown, 1, __ATOMIC_RELEASE);
+    kernel_futex_wake_shared(&shm->shutdown, INT_MAX);
+    __atomic_add_fetch(&shm->work_seq, 1, __ATOMIC_RELEASE);
+    kernel_futex_wake_shared(&shm->work_seq, INT_MAX);
+
+    if (pool->zygote > 0 && !reap_zygote(pool, KPROC_SHUTDOWN_GRACE_MS)) {
+        KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_WARN, "프로세스 풀 작업자가 종료되지 않아 SIGTERM 전송");
+        kill(-pool->zygote, SIGTERM);
+        if (!reap_zygote(pool, KPROC_SHUTDOWN_GRACE_MS)) {
+            KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_WARN, "프로세스 풀 작업자가 종료되지 않아 SIGKILL 전송");
+            kill(-pool->zygote, SIGKILL);
+            while (waitpid(pool->zygote, NULL, 0) < 0 && errno == EINTR) {
+            }
+            pool->zygote = -1;
+        }
+    }
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "프로세스 풀 종료 (작업자 수: %d, 재생성: %u)",
+           pool->num_workers, shm->respawns);
+
+    munmap(shm, pool->shm_size);
+    if (pool->memfd >= 0) {
+        close(pool->memfd);
+    }
+    free(pool);
+}
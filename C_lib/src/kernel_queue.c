@@ -0,0 +1,317 @@
+/*
+ * Kernel Concurrent Queues
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the bounded Vyukov MPMC ring and the unbounded
+ *             fetch-and-add segment queue declared in kernel_queue.h.
+ */
+
+#include "kernel_queue.h"
+#include "kernel_epoch.h"
+#include "kernel_engine.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KQUEUE_CACHE_LINE 64
+
+/**
+ * @struct BoundedCell
+ * @brief 순번과 데이터를 가진 링 칸
+ *
+ * seq == pos 이면 pos번째 push가, seq == pos + 1 이면 pos번째 pop이 이 칸을 쓸 차례입니다.
+ */
+typedef struct BoundedCell {
+    size_t seq;
+    void *data;
+} BoundedCell;
+
+struct BoundedQueue {
+    BoundedCell *cells;
+    size_t mask;
+    size_t enqueue_pos __attribute__((aligned(KQUEUE_CACHE_LINE)));
+    size_t dequeue_pos __attribute__((aligned(KQUEUE_CACHE_LINE)));
+};
+
+/**
+ * @struct QueueSegment
+ * @brief 무제한 큐의 세그먼트
+ */
+typedef struct QueueSegment {
+    long dequeue_idx __attribute__((aligned(KQUEUE_CACHE_LINE)));
+    long enqueue_idx __attribute__((aligned(KQUEUE_CACHE_LINE)));
+    struct QueueSegment *next __attribute__((aligned(KQUEUE_CACHE_LINE)));
+    void *items[KQUEUE_SEGMENT_SIZE];
+} QueueSegment;
+
+struct UnboundedQueue {
+    QueueSegment *head __attribute__((aligned(KQUEUE_CACHE_LINE)));
+    QueueSegment *tail __attribute__((aligned(KQUEUE_CACHE_LINE)));
+};
+
+/* pop이 먼저 지나간 칸 표시 (늦게 도착한 push는 다음 칸으로 재시도) */
+static char segment_taken_marker;
+#define SEGMENT_TAKEN ((void *)&segment_taken_marker)
+
+static void *aligned_alloc_or_die(size_t size, const char *what) {
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, KQUEUE_CACHE_LINE, size) != 0) {
+        kernel_errExit("%s 메모리 할당 실패", what);
+    }
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+/* ---------------------------------------------------------------------------
+ * 고정 크기 큐
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief 고정 크기 MPMC 큐 생성 함수
+ */
+BoundedQueue *create_bounded_queue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    BoundedQueue *queue = (BoundedQueue *)aligned_alloc_or_die(sizeof(BoundedQueue), "고정 크기 큐");
+    queue->cells = (BoundedCell *)aligned_alloc_or_die(sizeof(BoundedCell) * size, "고정 크기 큐 버퍼");
+    queue->mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        queue->cells[i].seq = i;
+    }
+    return queue;
+}
+
+/**
+ * @brief 고정 크기 큐에 원소 추가 함수
+ */
+bool bounded_queue_push(BoundedQueue *queue, void *data) {
+    size_t pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+    BoundedCell *cell;
+
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;   // 한 바퀴 앞선 pop이 아직 칸을 비우지 않음: 가득 참
+        } else {
+            pos = __atomic_load_n(&queue->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    cell->data = data;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief 고정 크기 큐에서 원소 제거 함수
+ */
+void *bounded_queue_pop(BoundedQueue *queue) {
+    size_t pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+    BoundedCell *cell;
+
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->dequeue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return NULL;    // 아직 채워지지 않은 칸: 비어 있음
+        } else {
+            pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    void *data = cell->data;
+    __atomic_store_n(&cell->seq, pos + queue->mask + 1, __ATOMIC_RELEASE);
+    return data;
+}
+
+/**
+ * @brief 고정 크기 큐가 비었는지 확인하는 함수
+ */
+bool bounded_queue_is_empty(BoundedQueue *queue) {
+    size_t pos = __atomic_load_n(&queue->dequeue_pos, __ATOMIC_ACQUIRE);
+    size_t seq = __atomic_load_n(&queue->cells[pos & queue->mask].seq, __ATOMIC_ACQUIRE);
+    return (intptr_t)seq - (intptr_t)(pos + 1) < 0;
+}
+
+/**
+ * @brief 고정 크기 큐의 용량을 반환하는 함수
+ */
+size_t bounded_queue_capacity(BoundedQueue *queue) {
+    return queue->mask + 1;
+}
+
+/**
+ * @brief 고정 크기 큐 삭제 함수
+ */
+void destroy_bounded_queue(BoundedQueue *queue) {
+    if (queue == NULL) {
+        return;
+    }
+    free(queue->cells);
+    free(queue);
+}
+
+/* ---------------------------------------------------------------------------
+ * 무제한 큐
+ * ------------------------------------------------------------------------- */
+
+static QueueSegment *segment_create(void *first) {
+    QueueSegment *segment = (QueueSegment *)aligned_alloc_or_die(sizeof(QueueSegment), "큐 세그먼트");
+    if (first != NULL) {
+        segment->items[0] = first;
+        segment->enqueue_idx = 1;
+    }
+    return segment;
+}
+
+/**
+ * @brief 무제한 MPMC 큐 생성 함수
+ */
+UnboundedQueue *create_unbounded_queue(void) {
+    UnboundedQueue *queue = (UnboundedQueue *)aligned_alloc_or_die(sizeof(UnboundedQueue), "무제한 큐");
+    QueueSegment *segment = segment_create(NULL);
+    queue->head = segment;
+    queue->tail = segment;
+    return queue;
+}
+
+/**
+ * @brief 무제한 큐에 원소 추가 함수
+ *
+ * 세그먼트의 칸 번호를 fetch-and-add로 받고, 세그먼트가 가득 차면 첫 칸을 채운 새 세그먼트를 연결합니다.
+ */
+void unbounded_queue_push(UnboundedQueue *queue, void *data) {
+    epoch_enter();
+    for (;;) {
+        QueueSegment *tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        long idx = __atomic_fetch_add(&tail->enqueue_idx, 1, __ATOMIC_ACQ_REL);
+
+        if (idx >= KQUEUE_SEGMENT_SIZE) {
+            if (tail != __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE)) {
+                continue;
+            }
+            QueueSegment *next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+            if (next == NULL) {
+                QueueSegment *segment = segment_create(data);
+                QueueSegment *expected = NULL;
+                if (__atomic_compare_exchange_n(&tail->next, &expected, segment, false,
+                                                __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                    __atomic_compare_exchange_n(&queue->tail, &tail, segment, false,
+                                                __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+                    break;
+                }
+                free(segment);  // 다른 스레드가 먼저 연결함 (게시되지 않았으므로 바로 해제)
+            } else {
+                __atomic_compare_exchange_n(&queue->tail, &tail, next, false,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+            }
+            continue;
+        }
+
+        void *expected = NULL;
+        if (__atomic_compare_exchange_n(&tail->items[idx], &expected, data, false,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    epoch_exit();
+}
+
+/**
+ * @brief 무제한 큐에서 원소 제거 함수
+ *
+ * 다 읽은 세그먼트는 tail이 먼저 지나가도록 도운 뒤 head에서 떼어 내고 epoch_retire로 해제합니다.
+ */
+void *unbounded_queue_pop(UnboundedQueue *queue) {
+    void *data = NULL;
+
+    epoch_enter();
+    for (;;) {
+        QueueSegment *head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&head->dequeue_idx, __ATOMIC_ACQUIRE) >= __atomic_load_n(&head->enqueue_idx, __ATOMIC_ACQUIRE) &&
+            __atomic_load_n(&head->next, __ATOMIC_ACQUIRE) == NULL) {
+            break;
+        }
+
+        long idx = __atomic_fetch_add(&head->dequeue_idx, 1, __ATOMIC_ACQ_REL);
+        if (idx >= KQUEUE_SEGMENT_SIZE) {
+            QueueSegment *next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+            if (next == NULL) {
+                break;
+            }
+            // tail이 head보다 뒤에 남지 않도록 먼저 전진시켜야 해제 후 tail로 접근하는 일이 없음
+            QueueSegment *expected_tail = head;
+            __atomic_compare_exchange_n(&queue->tail, &expected_tail, next, false,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+            if (__atomic_compare_exchange_n(&queue->head, &head, next, false,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                epoch_retire(head, NULL);
+            }
+            continue;
+        }
+
+        data = __atomic_exchange_n(&head->items[idx], SEGMENT_TAKEN, __ATOMIC_ACQ_REL);
+        if (data != NULL) {
+            break;
+        }
+    }
+    epoch_exit();
+    return data;
+}
+
+/**
+ * @brief 무제한 큐가 비었는지 확인하는 함수
+ */
+bool unbounded_queue_is_empty(UnboundedQueue *queue) {
+    bool empty = true;
+
+    epoch_enter();
+    QueueSegment *head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    long deq = __atomic_load_n(&head->dequeue_idx, __ATOMIC_ACQUIRE);
+    long enq = __atomic_load_n(&head->enqueue_idx, __ATOMIC_ACQUIRE);
+    if (deq < enq && deq < KQUEUE_SEGMENT_SIZE) {
+        empty = false;
+    } else if (__atomic_load_n(&head->next, __ATOMIC_ACQUIRE) != NULL) {
+        empty = false;
+    }
+    epoch_exit();
+    return empty;
+}
+
+/**
+ * @brief 무제한 큐 삭제 함수
+ */
+void destroy_unbounded_queue(UnboundedQueue *queue) {
+    if (queue == NULL) {
+        return;
+    }
+
+    QueueSegment *segment = queue->head;
+    while (segment != NULL) {
+        QueueSegment *next = segment->next;
+        free(segment);
+        segment = next;
+    }
+    free(queue);
+}
@@ -0,0 +1,127 @@
+/*
+ * Kernel Sharded Reader-Writer Lock
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the reader-writer lock declared in kernel_rwlock.h.
+ *             A reader increments its shard and then checks the writer flag;
+ *             a writer sets the flag and then checks every shard. Both sides
+ *             use sequentially consistent operations, so at least one of
+ *             them sees the other and they never both enter.
+ */
+
+#include "kernel_rwlock.h"
+#include "kernel_futex.h"
+#include <limits.h>
+#include <string.h>
+
+/* 쓰기 스레드가 읽기 스레드의 퇴장을 기다리며 futex 대기 전에 스핀하는 횟수 */
+#define KRWLOCK_WRITER_SPIN 100
+
+static uint32_t next_shard = 0;
+static __thread int thread_shard = -1;
+
+/**
+ * @brief 호출 스레드의 읽기 카운터 샤드를 반환하는 함수 (처음 호출 시 순서대로 배정)
+ */
+static inline KRWLockShard *reader_shard(KRWLock *lock) {
+    if (__builtin_expect(thread_shard < 0, 0)) {
+        thread_shard = (int)(__atomic_fetch_add(&next_shard, 1, __ATOMIC_RELAXED) % KRWLOCK_SHARDS);
+    }
+    return &lock->shards[thread_shard];
+}
+
+/**
+ * @brief 읽기/쓰기 잠금 초기화 함수
+ *
+ * @param lock 초기화할 잠금
+ * @param name 쓰기 뮤텍스의 잠금 클래스 이름
+ */
+void krwlock_init(KRWLock *lock, const char *name) {
+    memset(lock->shards, 0, sizeof(lock->shards));
+    lock->writer = 0;
+    kmutex_init(&lock->writer_mutex, name);
+}
+
+/**
+ * @brief 읽기/쓰기 잠금 정리 함수
+ *
+ * @param lock 정리할 잠금
+ */
+void krwlock_destroy(KRWLock *lock) {
+    kmutex_destroy(&lock->writer_mutex);
+}
+
+/**
+ * @brief 읽기 잠금 획득 함수
+ *
+ * @param lock 잠금
+ */
+void krwlock_rdlock(KRWLock *lock) {
+    KRWLockShard *shard = reader_shard(lock);
+
+    for (;;) {
+        __atomic_add_fetch(&shard->readers, 1, __ATOMIC_SEQ_CST);
+        if (__builtin_expect(!__atomic_load_n(&lock->writer, __ATOMIC_SEQ_CST), 1)) {
+            return;
+        }
+
+        // 쓰기 스레드가 우선이므로 물러나서 끝날 때까지 대기
+        __atomic_sub_fetch(&shard->readers, 1, __ATOMIC_SEQ_CST);
+        kernel_futex_wake(&shard->readers, 1);
+        while (__atomic_load_n(&lock->writer, __ATOMIC_ACQUIRE)) {
+            kernel_futex_wait(&lock->writer, 1, NULL);
+        }
+    }
+}
+
+/**
+ * @brief 읽기 잠금 해제 함수
+ *
+ * @param lock 잠금
+ */
+void krwlock_rdunlock(KRWLock *lock) {
+    KRWLockShard *shard = reader_shard(lock);
+
+    __atomic_sub_fetch(&shard->readers, 1, __ATOMIC_SEQ_CST);
+    if (__builtin_expect(__atomic_load_n(&lock->writer, __ATOMIC_SEQ_CST) != 0, 0)) {
+        kernel_futex_wake(&shard->readers, 1);
+    }
+}
+
+/**
+ * @brief 쓰기 잠금 획득 함수
+ *
+ * @param lock 잠금
+ */
+void krwlock_wrlock(KRWLock *lock) {
+    kmutex_lock(&lock->writer_mutex);
+    __atomic_store_n(&lock->writer, 1, __ATOMIC_SEQ_CST);
+
+    // 이미 들어와 있는 읽기 스레드가 모두 나갈 때까지 대기 (새 읽기 스레드는 물러남)
+    for (int i = 0; i < KRWLOCK_SHARDS; i++) {
+        uint32_t *readers = &lock->shards[i].readers;
+        int spins = 0;
+        uint32_t count;
+
+        while ((count = __atomic_load_n(readers, __ATOMIC_SEQ_CST)) != 0) {
+            if (spins++ < KRWLOCK_WRITER_SPIN) {
+                kernel_cpu_relax();
+            } else {
+                kernel_futex_wait(readers, count, NULL);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 쓰기 잠금 해제 함수
+ *
+ * @param lock 잠금
+ */
+void krwlock_wrunlock(KRWLock *lock) {
+    __atomic_store_n(&lock->writer, 0, __ATOMIC_RELEASE);
+    kernel_futex_wake(&lock->writer, INT_MAX);
+    kmutex_unlock(&lock->writer_mutex);
+}
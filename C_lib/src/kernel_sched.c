@@ -0,0 +1,663 @@
+/*
+ * Kernel Work-Stealing Scheduler
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements per-thread Chase-Lev deques (Le et al., "Correct
+ *             and Efficient Work-Stealing for Weak Memory Models"), helping
+ *             task-group waits, futex parking for idle workers, and the
+ *             recursive-split parallel_for / chunked parallel_reduce.
+ *             Workers follow KERNEL_SCHED_PLACEMENT and each worker deque is
+ *             allocated on the NUMA node of the CPU its owner is pinned to.
+ */
+
+#include "kernel_sched.h"
+#include "kernel_affinity.h"
+#include "kernel_futex.h"
+#include "kernel_engine.h"
+#include "kernel_trace.h"
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KSCHED_MAX_WORKERS 256
+#define KSCHED_SPIN_ROUNDS 64
+#define KSCHED_TASK_CACHE 256
+#define KSCHED_WAKE_WORDS 64
+
+/**
+ * @struct KSchedTask
+ * @brief 덱에 저장되는 작업
+ *
+ * parallel_for 분할 작업은 사용자 함수 대신 범위 정보를 함께 담아 추가 할당을 피합니다.
+ */
+typedef struct KSchedTask {
+    void (*run)(struct KSchedTask *task);   /**< 실행 진입점 */
+    KTaskGroup *tg;                         /**< 완료를 알릴 작업 그룹 */
+    union {
+        struct {
+            KSchedFunc func;
+            void *arg;
+        } user;
+        struct {
+            size_t begin;
+            size_t end;
+            size_t grain;
+            KRangeFunc body;
+            void *ctx;
+        } range;
+    } u;
+    struct KSchedTask *next;                /**< 재사용 목록 연결 */
+} KSchedTask;
+
+/**
+ * @struct KSchedDeque
+ * @brief Chase-Lev 덱 (소유 스레드는 bottom, 다른 스레드는 top에서 접근)
+ */
+typedef struct KSchedDeque {
+    long top __attribute__((aligned(64)));
+    long bottom __attribute__((aligned(64)));
+    KSchedTask *buffer[KSCHED_DEQUE_SIZE];
+    int in_use;                             /**< 외부 스레드 슬롯 점유 여부 */
+} KSchedDeque;
+
+/**
+ * @struct KScheduler
+ * @brief 스케줄러 전역 상태
+ */
+typedef struct KScheduler {
+    KSchedDeque **deques;                   /**< 워커 덱 + 외부 스레드 덱 (덱마다 별도 페이지) */
+    int num_workers;                        /**< 워커 스레드 수 */
+    int num_slots;                          /**< 전체 덱 수 */
+    pthread_t *threads;
+    KPlacement placement;                   /**< 워커 배치 */
+    int shutdown;
+    int idle;                               /**< 주차 중인 워커 수 */
+    uint32_t signal;                        /**< 워커 주차용 futex 워드 */
+    unsigned generation;                    /**< 초기화 세대 (스레드 로컬 캐시 무효화용) */
+} KScheduler;
+
+static KScheduler scheduler;
+static int scheduler_ready = 0;
+static unsigned scheduler_generation = 0;
+static pthread_mutex_t scheduler_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* 작업 그룹 깨우기용 futex 워드 (그룹은 대기 스레드의 스택에 있어 완료 직후 사라질 수 있으므로 대신 사용) */
+static uint32_t task_group_wake_words[KSCHED_WAKE_WORDS];
+
+static __thread int local_slot = -1;
+static __thread unsigned local_generation = 0;
+static __thread KSchedTask *task_cache = NULL;
+static __thread int task_cache_count = 0;
+static __thread unsigned steal_seed = 0;
+
+/* ---------------------------------------------------------------------------
+ * Chase-Lev 덱
+ * ------------------------------------------------------------------------- */
+
+static bool deque_push(KSchedDeque *dq, KSchedTask *task) {
+    long b = __atomic_load_n(&dq->bottom, __ATOMIC_RELAXED);
+    long t = __atomic_load_n(&dq->top, __ATOMIC_ACQUIRE);
+
+    if (b - t >= KSCHED_DEQUE_SIZE) {
+        return false;
+    }
+    __atomic_store_n(&dq->buffer[b & (KSCHED_DEQUE_SIZE - 1)], task, __ATOMIC_RELAXED);
+    __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static KSchedTask *deque_pop(KSchedDeque *dq) {
+    long b = __atomic_load_n(&dq->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&dq->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long t = __atomic_load_n(&dq->top, __ATOMIC_RELAXED);
+    KSchedTask *task = NULL;
+
+    if (t <= b) {
+        task = __atomic_load_n(&dq->buffer[b & (KSCHED_DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+        if (t == b) {
+            // 마지막 하나는 도둑과 경쟁하므로 top을 CAS로 가져옴
+            if (!__atomic_compare_exchange_n(&dq->top, &t, t + 1, false,
+                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                task = NULL;
+            }
+            __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return task;
+}
+
+static KSchedTask *deque_steal(KSchedDeque *dq) {
+    long t = __atomic_load_n(&dq->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    long b = __atomic_load_n(&dq->bottom, __ATOMIC_ACQUIRE);
+
+    if (t < b) {
+        KSchedTask *task = __atomic_load_n(&dq->buffer[t & (KSCHED_DEQUE_SIZE - 1)], __ATOMIC_RELAXED);
+        if (!__atomic_compare_exchange_n(&dq->top, &t, t + 1, false,
+                                         __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            return NULL;
+        }
+        return task;
+    }
+    return NULL;
+}
+
+static bool deque_maybe_nonempty(KSchedDeque *dq) {
+    return __atomic_load_n(&dq->top, __ATOMIC_ACQUIRE) <
+           __atomic_load_n(&dq->bottom, __ATOMIC_ACQUIRE);
+}
+
+/* ---------------------------------------------------------------------------
+ * 작업 할당 (스레드별 재사용 목록)
+ * ------------------------------------------------------------------------- */
+
+static KSchedTask *task_alloc(void) {
+    KSchedTask *task = task_cache;
+    if (task != NULL) {
+        task_cache = task->next;
+        task_cache_count--;
+        return task;
+    }
+
+    task = (KSchedTask *)malloc(sizeof(KSchedTask));
+    if (task == NULL) {
+        kernel_errExit("스케줄러 작업 메모리 할당 실패");
+    }
+    return task;
+}
+
+static void task_free(KSchedTask *task) {
+    if (task_cache_count >= KSCHED_TASK_CACHE) {
+        free(task);
+        return;
+    }
+    task->next = task_cache;
+    task_cache = task;
+    task_cache_count++;
+}
+
+/**
+ * @brief 현재 스레드의 재사용 목록을 모두 해제하는 함수 (스레드 종료 시 호출)
+ */
+static void task_cache_drain(void) {
+    while (task_cache != NULL) {
+        KSchedTask *next = task_cache->next;
+        free(task_cache);
+        task_cache = next;
+    }
+    task_cache_count = 0;
+}
+
+static uint32_t *task_group_wake_word(const KTaskGroup *tg) {
+    return &task_group_wake_words[((uintptr_t)tg >> 4) % KSCHED_WAKE_WORDS];
+}
+
+static void task_execute(KSchedTask *task) {
+    KTaskGroup *tg = task->tg;
+    uint32_t *word = task_group_wake_word(tg);
+
+    task->run(task);
+    task_free(task);
+
+    // 감소 이후에는 tg가 해제됐을 수 있으므로 수명이 프로세스 전체인 워드로만 깨움
+    if (__atomic_sub_fetch(&tg->pending, 1, __ATOMIC_SEQ_CST) == 0) {
+        __atomic_add_fetch(word, 1, __ATOMIC_SEQ_CST);
+        kernel_futex_wake(word, INT_MAX);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * 스케줄러 수명 주기
+ * ------------------------------------------------------------------------- */
+
+static KSchedTask *find_work(int self) {
+    KSchedTask *task;
+
+    if (self >= 0) {
+        task = deque_pop(scheduler.deques[self]);
+        if (task != NULL) {
+            return task;
+        }
+    }
+
+    // 임의의 위치부터 한 바퀴 돌며 훔치기 시도
+    int n = scheduler.num_slots;
+    steal_seed = steal_seed * 1103515245u + 12345u;
+    int start = (int)((steal_seed >> 16) % (unsigned)n);
+    for (int i = 0; i < n; i++) {
+        int victim = (start + i) % n;
+        if (victim == self) {
+            continue;
+        }
+        task = deque_steal(scheduler.deques[victim]);
+        if (task != NULL) {
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static bool any_work_visible(void) {
+    for (int i = 0; i < scheduler.num_slots; i++) {
+        if (deque_maybe_nonempty(scheduler.deques[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 워커 스레드 루프
+ *
+ * 일을 찾지 못하면 잠시 회전한 뒤, 유휴 수를 올리고 덱을 다시 확인한 다음 futex에서 주차합니다.
+ */
+static void *sched_worker(void *arg) {
+    int self = (int)(intptr_t)arg;
+    int spins = 0;
+
+    kplacement_apply(&scheduler.placement, self);
+    local_slot = self;
+    local_generation = scheduler.generation;
+    steal_seed = (unsigned)self * 2654435761u + 1u;
+
+    while (!__atomic_load_n(&scheduler.shutdown, __ATOMIC_ACQUIRE)) {
+        KSchedTask *task = find_work(self);
+        if (task != NULL) {
+            task_execute(task);
+            spins = 0;
+            continue;
+        }
+
+        if (++spins < KSCHED_SPIN_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+        spins = 0;
+
+        uint32_t seq = __atomic_load_n(&scheduler.signal, __ATOMIC_ACQUIRE);
+        __atomic_add_fetch(&scheduler.idle, 1, __ATOMIC_SEQ_CST);
+        if (!any_work_visible() && !__atomic_load_n(&scheduler.shutdown, __ATOMIC_ACQUIRE)) {
+            kernel_futex_wait(&scheduler.signal, seq, NULL);
+        }
+        __atomic_sub_fetch(&scheduler.idle, 1, __ATOMIC_SEQ_CST);
+    }
+
+    task_cache_drain();
+    return NULL;
+}
+
+static void wake_workers(int count) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&scheduler.idle, __ATOMIC_SEQ_CST) > 0) {
+        __atomic_add_fetch(&scheduler.signal, 1, __ATOMIC_RELEASE);
+        kernel_futex_wake(&scheduler.signal, count);
+    }
+}
+
+static int sched_start_locked(int num_workers) {
+    if (num_workers <= 0) {
+        const char *env = getenv("KERNEL_SCHED_THREADS");
+        if (env != NULL) {
+            num_workers = atoi(env);
+        }
+    }
+    if (num_workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (num_workers > KSCHED_MAX_WORKERS) {
+        num_workers = KSCHED_MAX_WORKERS;
+    }
+
+    memset(&scheduler, 0, sizeof(scheduler));
+    scheduler.num_workers = num_workers;
+    scheduler.num_slots = num_workers + KSCHED_MAX_EXTERNAL;
+    scheduler.generation = ++scheduler_generation;
+
+    kplacement_from_env(&scheduler.placement, "KERNEL_SCHED_PLACEMENT");
+
+    // 워커 덱은 소유 워커가 고정될 CPU의 노드에, 외부 스레드 덱은 노드 지정 없이 할당
+    scheduler.deques = (KSchedDeque **)calloc((size_t)scheduler.num_slots, sizeof(KSchedDeque *));
+    if (scheduler.deques == NULL) {
+        kernel_errExit("스케줄러 덱 메모리 할당 실패");
+    }
+    for (int i = 0; i < scheduler.num_slots; i++) {
+        int cpu = i < num_workers ? kplacement_cpu(&scheduler.placement, i) : -1;
+        scheduler.deques[i] = (KSchedDeque *)kernel_numa_alloc(sizeof(KSchedDeque), cpu >= 0 ? kernel_cpu_node(cpu) : -1);
+        if (scheduler.deques[i] == NULL) {
+            kernel_errExit("스케줄러 덱 메모리 할당 실패");
+        }
+    }
+    scheduler.threads = (pthread_t *)malloc(sizeof(pthread_t) * (size_t)num_workers);
+    if (scheduler.threads == NULL) {
+        kernel_errExit("스케줄러 스레드 메모리 할당 실패");
+    }
+
+    for (int i = 0; i < num_workers; i++) {
+        scheduler.deques[i]->in_use = 1;
+        int err = pthread_create(&scheduler.threads[i], NULL, sched_worker, (void *)(intptr_t)i);
+        if (err != 0) {
+            kernel_errExitEN(err, "스케줄러 워커 %d 생성 실패", i);
+        }
+    }
+
+    __atomic_store_n(&scheduler_ready, 1, __ATOMIC_RELEASE);
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "작업 훔치기 스케줄러 시작 (워커 수: %d)", num_workers);
+    return 0;
+}
+
+static void sched_ensure_started(void) {
+    if (__atomic_load_n(&scheduler_ready, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+    pthread_mutex_lock(&scheduler_mutex);
+    if (!scheduler_ready) {
+        sched_start_locked(0);
+    }
+    pthread_mutex_unlock(&scheduler_mutex);
+}
+
+/**
+ * @brief 외부 스레드 종료 시 슬롯을 반납하고 작업 재사용 목록을 해제하는 함수
+ *
+ * 그 사이 스케줄러가 재초기화되었으면 덱 배열이 바뀌었으므로 슬롯은 건드리지 않습니다.
+ */
+static void release_external_slot(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&scheduler_mutex);
+    if (scheduler_ready && local_slot >= 0 && local_generation == scheduler.generation) {
+        __atomic_store_n(&scheduler.deques[local_slot]->in_use, 0, __ATOMIC_RELEASE);
+    }
+    local_slot = -1;
+    pthread_mutex_unlock(&scheduler_mutex);
+
+    task_cache_drain();
+}
+
+static pthread_key_t external_key;
+static pthread_once_t external_once = PTHREAD_ONCE_INIT;
+
+static void external_key_init(void) {
+    if (pthread_key_create(&external_key, release_external_slot) != 0) {
+        kernel_errExit("스케줄러 스레드 키 생성 실패");
+    }
+}
+
+/**
+ * @brief 현재 스레드의 덱 번호를 반환하는 함수
+ *
+ * 워커가 아닌 스레드는 처음 사용할 때 외부 슬롯을 하나 점유하며, 남은 슬롯이 없으면 -1을 반환합니다.
+ * 슬롯이 없어도 작업을 직접 실행하며 재사용 목록을 쌓으므로 종료 시 해제되도록 스레드 키는 항상 등록합니다.
+ */
+static int current_slot(void) {
+    sched_ensure_started();
+
+    if (local_slot >= 0 && local_generation == scheduler.generation) {
+        return local_slot;
+    }
+
+    pthread_once(&external_once, external_key_init);
+    if (pthread_getspecific(external_key) == NULL) {
+        pthread_setspecific(external_key, &task_cache);
+    }
+    for (int i = scheduler.num_workers; i < scheduler.num_slots; i++) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&scheduler.deques[i]->in_use, &expected, 1, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            local_slot = i;
+            local_generation = scheduler.generation;
+            steal_seed = (unsigned)i * 2654435761u + 7u;
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 스케줄러 초기화 함수
+ */
+int ksched_init(int num_workers) {
+    int ret = -1;
+    pthread_mutex_lock(&scheduler_mutex);
+    if (!scheduler_ready) {
+        ret = sched_start_locked(num_workers);
+    }
+    pthread_mutex_unlock(&scheduler_mutex);
+    return ret;
+}
+
+/**
+ * @brief 스케줄러 종료 함수
+ */
+void ksched_shutdown(void) {
+    pthread_mutex_lock(&scheduler_mutex);
+    if (!scheduler_ready) {
+        pthread_mutex_unlock(&scheduler_mutex);
+        return;
+    }
+
+    __atomic_store_n(&scheduler.shutdown, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&scheduler.signal, 1, __ATOMIC_RELEASE);
+    kernel_futex_wake(&scheduler.signal, INT_MAX);
+    for (int i = 0; i < scheduler.num_workers; i++) {
+        pthread_join(scheduler.threads[i], NULL);
+    }
+
+    __atomic_store_n(&scheduler_ready, 0, __ATOMIC_RELEASE);
+    free(scheduler.threads);
+    for (int i = 0; i < scheduler.num_slots; i++) {
+        kernel_numa_free(scheduler.deques[i], sizeof(KSchedDeque));
+    }
+    free(scheduler.deques);
+    scheduler.threads = NULL;
+    scheduler.deques = NULL;
+    local_slot = -1;
+    pthread_mutex_unlock(&scheduler_mutex);
+}
+
+/**
+ * @brief 워커 스레드 수를 반환하는 함수
+ */
+int ksched_num_workers(void) {
+    sched_ensure_started();
+    return scheduler.num_workers;
+}
+
+/* ---------------------------------------------------------------------------
+ * 작업 그룹
+ * ------------------------------------------------------------------------- */
+
+void task_group_init(KTaskGroup *tg) {
+    tg->pending = 0;
+}
+
+static void run_user_task(KSchedTask *task) {
+    task->u.user.func(task->u.user.arg);
+}
+
+/**
+ * @brief 작업을 현재 스레드의 덱에 넣는 함수 (넣을 수 없으면 즉시 실행)
+ */
+static void spawn_task(KSchedTask *task) {
+    int slot = current_slot();
+
+    __atomic_add_fetch(&task->tg->pending, 1, __ATOMIC_RELAXED);
+    if (slot < 0 || !deque_push(scheduler.deques[slot], task)) {
+        task_execute(task);
+        return;
+    }
+    wake_workers(1);
+}
+
+void task_group_spawn(KTaskGroup *tg, KSchedFunc func, void *arg) {
+    KSchedTask *task = task_alloc();
+    task->run = run_user_task;
+    task->tg = tg;
+    task->u.user.func = func;
+    task->u.user.arg = arg;
+    spawn_task(task);
+}
+
+/**
+ * @brief 작업 그룹 완료를 기다리는 동안 다른 작업을 대신 실행하는 함수
+ */
+void task_group_wait(KTaskGroup *tg) {
+    int slot = current_slot();
+    uint32_t *word = task_group_wake_word(tg);
+    int spins = 0;
+
+    for (;;) {
+        uint32_t seq = __atomic_load_n(word, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&tg->pending, __ATOMIC_SEQ_CST) == 0) {
+            break;
+        }
+
+        KSchedTask *task = find_work(slot);
+        if (task != NULL) {
+            task_execute(task);
+            spins = 0;
+            continue;
+        }
+
+        if (++spins < KSCHED_SPIN_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+
+        // 남은 작업이 다른 스레드에서 실행 중이면 짧게 잠든 뒤 다시 훔칠 일을 확인
+        struct timespec timeout = { 0, 200000 };
+        kernel_futex_wait(word, seq, &timeout);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * parallel_for / parallel_reduce
+ * ------------------------------------------------------------------------- */
+
+static void range_split_run(size_t begin, size_t end, size_t grain, KRangeFunc body, void *ctx, KTaskGroup *tg);
+
+static void run_range_task(KSchedTask *task) {
+    range_split_run(task->u.range.begin, task->u.range.end, task->u.range.grain,
+                    task->u.range.body, task->u.range.ctx, task->tg);
+}
+
+/**
+ * @brief 구간을 반으로 나누며 오른쪽 절반을 spawn하고 왼쪽을 계속 처리하는 함수
+ */
+static void range_split_run(size_t begin, size_t end, size_t grain, KRangeFunc body, void *ctx, KTaskGroup *tg) {
+    while (end - begin > grain) {
+        size_t mid = begin + (end - begin) / 2;
+        KSchedTask *task = task_alloc();
+        task->run = run_range_task;
+        task->tg = tg;
+        task->u.range.begin = mid;
+        task->u.range.end = end;
+        task->u.range.grain = grain;
+        task->u.range.body = body;
+        task->u.range.ctx = ctx;
+        spawn_task(task);
+        end = mid;
+    }
+    body(begin, end, ctx);
+}
+
+static size_t auto_grain(size_t count) {
+    size_t parts = (size_t)ksched_num_workers() * 8;
+    size_t grain = (count + parts - 1) / parts;
+    return grain > 0 ? grain : 1;
+}
+
+void parallel_for(size_t begin, size_t end, size_t grain, KRangeFunc body, void *ctx) {
+    if (end <= begin) {
+        return;
+    }
+    if (grain == 0) {
+        grain = auto_grain(end - begin);
+    }
+    if (end - begin <= grain) {
+        body(begin, end, ctx);
+        return;
+    }
+
+    KTaskGroup tg = KTASK_GROUP_INIT;
+    range_split_run(begin, end, grain, body, ctx, &tg);
+    task_group_wait(&tg);
+}
+
+/**
+ * @struct ReduceState
+ * @brief parallel_reduce의 구간별 누적값 배열
+ */
+typedef struct ReduceState {
+    size_t begin;
+    size_t chunk;
+    size_t end;
+    size_t result_size;
+    unsigned char *accs;
+    KReduceMapFunc map;
+    void *ctx;
+} ReduceState;
+
+static void reduce_chunks(size_t first, size_t last, void *arg) {
+    ReduceState *st = (ReduceState *)arg;
+    for (size_t c = first; c < last; c++) {
+        size_t b = st->begin + c * st->chunk;
+        size_t e = (st->end - b > st->chunk) ? b + st->chunk : st->end;
+        st->map(b, e, st->ctx, st->accs + c * st->result_size);
+    }
+}
+
+void parallel_reduce(size_t begin, size_t end, size_t grain, size_t result_size,
+                     const void *identity, KReduceMapFunc map, KReduceCombineFunc combine,
+                     void *ctx, void *result) {
+    memcpy(result, identity, result_size);
+    if (end <= begin) {
+        return;
+    }
+
+    size_t count = end - begin;
+    size_t chunk = auto_grain(count);
+    if (chunk < grain) {
+        chunk = grain;
+    }
+    size_t nchunks = (count + chunk - 1) / chunk;
+
+    if (nchunks == 1) {
+        map(begin, end, ctx, result);
+        return;
+    }
+
+    ReduceState st;
+    st.begin = begin;
+    st.chunk = chunk;
+    st.end = end;
+    st.result_size = result_size;
+    st.map = map;
+    st.ctx = ctx;
+    st.accs = (unsigned char *)malloc(nchunks * result_size);
+    if (st.accs == NULL) {
+        kernel_errExit("parallel_reduce 메모리 할당 실패");
+    }
+    for (size_t c = 0; c < nchunks; c++) {
+        memcpy(st.accs + c * result_size, identity, result_size);
+    }
+
+    parallel_for(0, nchunks, 1, reduce_chunks, &st);
+
+    // 구간 순서대로 결합하여 교환 법칙이 없는 연산도 결과가 결정적이 되도록 함
+    for (size_t c = 0; c < nchunks; c++) {
+        combine(result, st.accs + c * result_size, ctx);
+    }
+    free(st.accs);
+}
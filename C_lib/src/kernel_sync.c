@@ -0,0 +1,296 @@
+/*
+ * Kernel Phase Synchronization
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the barrier, latch and countdown declared in
+ *             kernel_sync.h. Every primitive waits on one 32-bit word.
+ *             A waiter bumps a sleeper count before parking and the releaser
+ *             reads it after publishing the new word, both sequentially
+ *             consistent, so either the releaser sees the sleeper and wakes
+ *             it, or the futex sees the new word and does not park.
+ */
+
+#include "kernel_sync.h"
+#include "kernel_futex.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief 한 번의 대기에 허용할 스핀 횟수를 구하는 함수 (CPU가 하나면 0)
+ */
+static uint32_t spin_limit(void) {
+    return kernel_online_cpus() > 1 ? KSYNC_SPIN_LIMIT : 0;
+}
+
+/**
+ * @brief *word가 value에서 바뀔 때까지 스핀 후 futex에서 대기하는 함수
+ *
+ * @param word 대기 워드
+ * @param value 대기 조건 값
+ * @param sleepers 잠든 스레드 수 카운터
+ * @param spins 남은 스핀 예산 (호출 간에 이어서 사용)
+ * @param deadline 마감 시각 (0이면 무한)
+ * @return 값이 바뀌었으면 0, 마감을 넘겼으면 -1
+ */
+static int wait_change(uint32_t *word, uint32_t value, uint32_t *sleepers, uint32_t *spins, uint64_t deadline) {
+    while (*spins > 0) {
+        (*spins)--;
+        if (__atomic_load_n(word, __ATOMIC_ACQUIRE) != value) {
+            return 0;
+        }
+        kernel_cpu_relax();
+    }
+
+    int ret = 0;
+    __atomic_add_fetch(sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(word, __ATOMIC_ACQUIRE) == value) {
+        if (deadline == 0) {
+            kernel_futex_wait(word, value, NULL);
+            continue;
+        }
+        uint64_t now = kernel_now_ns();
+        if (now >= deadline) {
+            ret = -1;
+            break;
+        }
+        uint64_t left = deadline - now;
+        struct timespec timeout = { (time_t)(left / 1000000000ULL), (long)(left % 1000000000ULL) };
+        kernel_futex_wait(word, value, &timeout);
+    }
+    __atomic_sub_fetch(sleepers, 1, __ATOMIC_RELAXED);
+    return ret;
+}
+
+/**
+ * @brief *word가 0이 될 때까지 대기하는 함수
+ *
+ * @return 0이 되면 0, 마감을 넘겼으면 -1
+ */
+static int wait_zero(uint32_t *word, uint32_t *sleepers, uint64_t deadline) {
+    uint32_t spins = spin_limit();
+    uint32_t value;
+
+    while ((value = __atomic_load_n(word, __ATOMIC_ACQUIRE)) != 0) {
+        if (wait_change(word, value, sleepers, &spins, deadline) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief *word를 n만큼 줄이되 0 아래로 내려가지 않게 하고, 0이 되면 잠든 스레드를 깨우는 함수
+ *
+ * @return 이 호출로 0이 되었으면 1, 아니면 0
+ */
+static int count_down(uint32_t *word, uint32_t *sleepers, uint32_t n) {
+    uint32_t value = __atomic_load_n(word, __ATOMIC_RELAXED);
+    uint32_t next;
+
+    do {
+        if (value == 0) {
+            return 0;
+        }
+        next = n >= value ? 0 : value - n;
+    } while (!__atomic_compare_exchange_n(word, &value, next, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+
+    if (next != 0) {
+        return 0;
+    }
+    if (__atomic_load_n(sleepers, __ATOMIC_SEQ_CST) != 0) {
+        kernel_futex_wake(word, INT_MAX);
+    }
+    return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 배리어                                                                    */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 배리어를 초기화하는 함수
+ *
+ * @param barrier 초기화할 배리어
+ * @param count 참여 스레드 수
+ * @return 성공 시 0, count가 0이면 -1
+ */
+int kbarrier_init(KBarrier *barrier, uint32_t count) {
+    if (count == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    barrier->count = count;
+    barrier->arrived = 0;
+    barrier->generation = 0;
+    barrier->sleepers = 0;
+    return 0;
+}
+
+/**
+ * @brief 모든 참여 스레드가 도착할 때까지 대기하는 함수
+ *
+ * 마지막 도착 스레드가 도착 수를 되돌린 뒤 세대를 올리므로, 세대 변화를 본 스레드가
+ * 곧바로 다음 단계에 도착해도 새 세대로 집계됩니다.
+ *
+ * @param barrier 배리어
+ * @return 마지막 도착 스레드면 KBARRIER_SERIAL_THREAD, 아니면 0
+ */
+int kbarrier_wait(KBarrier *barrier) {
+    uint32_t generation = __atomic_load_n(&barrier->generation, __ATOMIC_ACQUIRE);
+
+    if (__atomic_add_fetch(&barrier->arrived, 1, __ATOMIC_ACQ_REL) == barrier->count) {
+        __atomic_store_n(&barrier->arrived, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&barrier->generation, generation + 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&barrier->sleepers, __ATOMIC_SEQ_CST) != 0) {
+            kernel_futex_wake(&barrier->generation, INT_MAX);
+        }
+        return KBARRIER_SERIAL_THREAD;
+    }
+
+    uint32_t spins = spin_limit();
+    wait_change(&barrier->generation, generation, &barrier->sleepers, &spins, 0);
+    return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* 래치                                                                      */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 래치를 초기화하는 함수
+ *
+ * @param latch 초기화할 래치
+ * @param count 초기 수
+ */
+void klatch_init(KLatch *latch, uint32_t count) {
+    latch->count = count;
+    latch->sleepers = 0;
+}
+
+/**
+ * @brief 래치의 수를 n만큼 줄이는 함수
+ *
+ * @param latch 래치
+ * @param n 줄일 수
+ */
+void klatch_count_down(KLatch *latch, uint32_t n) {
+    count_down(&latch->count, &latch->sleepers, n);
+}
+
+/**
+ * @brief 래치가 열렸는지 확인하는 함수
+ *
+ * @param latch 래치
+ * @return 열렸으면 1, 아니면 0
+ */
+int klatch_try_wait(const KLatch *latch) {
+    return __atomic_load_n(&latch->count, __ATOMIC_ACQUIRE) == 0;
+}
+
+/**
+ * @brief 래치가 열릴 때까지 대기하는 함수
+ *
+ * @param latch 래치
+ */
+void klatch_wait(KLatch *latch) {
+    wait_zero(&latch->count, &latch->sleepers, 0);
+}
+
+/**
+ * @brief 래치의 수를 1 줄이고 열릴 때까지 대기하는 함수
+ *
+ * @param latch 래치
+ */
+void klatch_arrive_and_wait(KLatch *latch) {
+    if (!count_down(&latch->count, &latch->sleepers, 1)) {
+        wait_zero(&latch->count, &latch->sleepers, 0);
+    }
+}
+
+/* ------------------------------------------------------------------------ */
+/* 카운트다운 이벤트                                                         */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 카운트다운 이벤트를 초기화하는 함수
+ *
+ * @param countdown 초기화할 카운트다운
+ * @param count 초기 수
+ */
+void kcountdown_init(KCountdown *countdown, uint32_t count) {
+    countdown->count = count;
+    countdown->sleepers = 0;
+}
+
+/**
+ * @brief 남은 수를 n만큼 늘리는 함수
+ *
+ * @param countdown 카운트다운
+ * @param n 늘릴 수
+ */
+void kcountdown_add(KCountdown *countdown, uint32_t n) {
+    __atomic_add_fetch(&countdown->count, n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 남은 수를 n만큼 줄이는 함수
+ *
+ * @param countdown 카운트다운
+ * @param n 줄일 수
+ * @return 이 호출로 0이 되었으면 1, 아니면 0
+ */
+int kcountdown_signal(KCountdown *countdown, uint32_t n) {
+    return count_down(&countdown->count, &countdown->sleepers, n);
+}
+
+/**
+ * @brief 남은 수가 0이 될 때까지 대기하는 함수
+ *
+ * @param countdown 카운트다운
+ * @param timeout_us 최대 대기 시간 (마이크로초, 음수면 무한)
+ * @return 0에 도달하면 0, 시간 초과면 -1
+ */
+int kcountdown_wait(KCountdown *countdown, int64_t timeout_us) {
+    uint64_t deadline = 0;
+
+    if (timeout_us == 0) {
+        if (kcountdown_remaining(countdown) != 0) {
+            errno = ETIMEDOUT;
+            return -1;
+        }
+        return 0;
+    }
+    if (timeout_us > 0) {
+        deadline = kernel_now_ns() + (uint64_t)timeout_us * 1000ULL;
+    }
+    if (wait_zero(&countdown->count, &countdown->sleepers, deadline) != 0) {
+        errno = ETIMEDOUT;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 카운트다운을 새 라운드로 다시 설정하는 함수
+ *
+ * @param countdown 카운트다운
+ * @param count 새 초기 수
+ */
+void kcountdown_reset(KCountdown *countdown, uint32_t count) {
+    __atomic_store_n(&countdown->count, count, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 남은 수를 반환하는 함수
+ *
+ * @param countdown 카운트다운
+ * @return 남은 수
+ */
+uint32_t kcountdown_remaining(const KCountdown *countdown) {
+    return __atomic_load_n(&countdown->count, __ATOMIC_ACQUIRE);
+}
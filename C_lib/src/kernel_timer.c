@@ -0,0 +1,543 @@
+/*
+ * Kernel Timer Service
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Implements the timer service declared in kernel_timer.h.
+ *             Placement and cascading follow the classic Linux timer wheel:
+ *             a timer goes into the lowest level whose range covers its
+ *             distance from the next unprocessed tick, and whenever the root
+ *             level wraps, the next slot of the level above is emptied and
+ *             its timers are placed again.
+ */
+
+#include "kernel_timer.h"
+#include "kernel_engine.h"
+#include "kernel_epoch.h"
+#include "kernel_futex.h"
+#include "kernel_mutex.h"
+#include "kernel_pool.h"
+#include "kernel_trace.h"
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
+#define WHEEL_ROOT_BITS 8
+#define WHEEL_ROOT_SIZE (1 << WHEEL_ROOT_BITS)
+#define WHEEL_ROOT_MASK (WHEEL_ROOT_SIZE - 1)
+#define WHEEL_LEVEL_BITS 6
+#define WHEEL_LEVEL_SIZE (1 << WHEEL_LEVEL_BITS)
+#define WHEEL_LEVEL_MASK (WHEEL_LEVEL_SIZE - 1)
+#define WHEEL_LEVELS 4
+#define WHEEL_MAX_DELTA ((1ULL << (WHEEL_ROOT_BITS + WHEEL_LEVELS * WHEEL_LEVEL_BITS)) - 1)
+#define WHEEL_NOT_ARMED UINT64_MAX
+
+/**
+ * @struct TimerService
+ * @brief 타이머 휠과 서비스 스레드 상태
+ *
+ * 슬롯은 KTimer 센티널을 머리로 하는 원형 이중 연결 리스트입니다.
+ */
+typedef struct TimerService {
+    KMutex lock;                                        /**< 휠 전체 보호 */
+    KTimer root[WHEEL_ROOT_SIZE];                       /**< 1틱 단위 슬롯 */
+    KTimer levels[WHEEL_LEVELS][WHEEL_LEVEL_SIZE];      /**< 상위 단계 슬롯 */
+    uint64_t root_bitmap[WHEEL_ROOT_SIZE / 64];         /**< 비어 있지 않은 root 슬롯 */
+    uint64_t current;                                   /**< 다음에 처리할 틱 */
+    uint64_t count;                                     /**< 휠에 등록된 타이머 수 */
+    uint64_t armed;                                     /**< 서비스 스레드가 깨어날 틱 */
+    uint64_t tick_ns;                                   /**< 틱 길이 */
+    uint64_t origin_ns;                                 /**< 0번 틱의 CLOCK_MONOTONIC 시각 */
+    int fd;                                             /**< timerfd (대체 구현에서는 -1) */
+    uint32_t wake_seq;                                  /**< 대체 구현의 재계산 요청 futex 워드 */
+    int shutdown;                                       /**< 종료 요청 여부 */
+    pthread_t thread;                                   /**< 서비스 스레드 */
+} TimerService;
+
+/*
+ * 실행 중인 서비스 (service_mutex 아래에서 게시/해제)
+ *
+ * ktimer_schedule / ktimer_cancel / ktimer_pending_count는 에포크 읽기 구역 안에서만 읽고 사용하며,
+ * 종료 시에는 게시를 해제한 뒤 epoch_retire로 넘겨 그 구역들이 모두 끝난 다음에 해제합니다.
+ */
+static pthread_mutex_t service_mutex = PTHREAD_MUTEX_INITIALIZER;
+static TimerService *service = NULL;
+
+static inline void slot_init(KTimer *slot) {
+    slot->next = slot;
+    slot->prev = slot;
+}
+
+static inline int slot_empty(const KTimer *slot) {
+    return slot->next == slot;
+}
+
+static inline void slot_append(KTimer *slot, KTimer *timer) {
+    timer->prev = slot->prev;
+    timer->next = slot;
+    slot->prev->next = timer;
+    slot->prev = timer;
+}
+
+/**
+ * @brief 타이머를 만료 틱에 맞는 슬롯에 넣는 함수 (잠금 필요)
+ */
+static void wheel_add(TimerService *s, KTimer *timer) {
+    uint64_t expires = timer->expires;
+    KTimer *slot = NULL;
+
+    if (expires < s->current) {
+        expires = s->current;
+    } else if (expires - s->current > WHEEL_MAX_DELTA) {
+        expires = s->current + WHEEL_MAX_DELTA;
+    }
+    timer->expires = expires;
+
+    uint64_t delta = expires - s->current;
+    if (delta < WHEEL_ROOT_SIZE) {
+        unsigned idx = (unsigned)(expires & WHEEL_ROOT_MASK);
+        slot = &s->root[idx];
+        s->root_bitmap[idx / 64] |= 1ULL << (idx % 64);
+    } else {
+        for (int level = 0; level < WHEEL_LEVELS; level++) {
+            int shift = WHEEL_ROOT_BITS + level * WHEEL_LEVEL_BITS;
+            if (level == WHEEL_LEVELS - 1 || delta < (1ULL << (shift + WHEEL_LEVEL_BITS))) {
+                slot = &s->levels[level][(expires >> shift) & WHEEL_LEVEL_MASK];
+                break;
+            }
+        }
+    }
+    slot_append(slot, timer);
+}
+
+/**
+ * @brief 타이머를 슬롯에서 빼는 함수 (잠금 필요)
+ */
+static void wheel_remove(TimerService *s, KTimer *timer) {
+    KTimer *next = timer->next;
+
+    timer->prev->next = next;
+    next->prev = timer->prev;
+    timer->next = timer->prev = NULL;
+
+    // root 슬롯이 비었으면 점유 비트 해제 (센티널은 배열 안에 있음)
+    if (next == next->next && next >= s->root && next < s->root + WHEEL_ROOT_SIZE) {
+        unsigned idx = (unsigned)(next - s->root);
+        s->root_bitmap[idx / 64] &= ~(1ULL << (idx % 64));
+    }
+}
+
+/**
+ * @brief 상위 단계 슬롯 하나를 비우고 타이머를 다시 배치하는 함수 (잠금 필요)
+ */
+static void wheel_cascade(TimerService *s, KTimer *slot) {
+    KTimer *timer = slot->next;
+
+    slot_init(slot);
+    while (timer != slot) {
+        KTimer *next = timer->next;
+        wheel_add(s, timer);
+        timer = next;
+    }
+}
+
+/**
+ * @brief 스레드 풀에서 만료 콜백을 실행하는 작업 함수
+ */
+static void *timer_task(void *arg) {
+    KTimer *timer = (KTimer *)arg;
+
+    timer->func(timer->arg);
+
+    // 이 감소 이후 소유자가 타이머를 해제할 수 있으므로 다른 필드는 건드리지 않음
+    if (__atomic_sub_fetch(&timer->running, 1, __ATOMIC_RELEASE) == 0) {
+        kernel_futex_wake(&timer->running, INT_MAX);
+    }
+    return NULL;
+}
+
+/**
+ * @brief current 틱을 처리하는 함수 (잠금 필요)
+ *
+ * root 단계가 한 바퀴 돌았으면 상위 단계를 먼저 내려보낸 뒤 해당 슬롯의 타이머를 풀에 넘깁니다.
+ */
+static void wheel_tick(TimerService *s) {
+    uint64_t tick = s->current;
+    unsigned idx = (unsigned)(tick & WHEEL_ROOT_MASK);
+
+    if (idx == 0) {
+        for (int level = 0; level < WHEEL_LEVELS; level++) {
+            unsigned lidx = (unsigned)((tick >> (WHEEL_ROOT_BITS + level * WHEEL_LEVEL_BITS)) & WHEEL_LEVEL_MASK);
+            wheel_cascade(s, &s->levels[level][lidx]);
+            if (lidx != 0) {
+                break;
+            }
+        }
+    }
+    s->current = tick + 1;
+
+    KTimer *slot = &s->root[idx];
+    while (!slot_empty(slot)) {
+        KTimer *timer = slot->next;
+        wheel_remove(s, timer);
+        timer->pending = 0;
+        s->count--;
+
+        __atomic_add_fetch(&timer->running, 1, __ATOMIC_RELAXED);
+        if (thread_pool_submit(kernel_engine_pool(), timer_task, timer, NULL) != 0) {
+            KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_WARN, "타이머 콜백을 스레드 풀에 넘기지 못함");
+            __atomic_sub_fetch(&timer->running, 1, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/**
+ * @brief 서비스 스레드가 다음에 깨어날 틱을 구하는 함수 (잠금 필요)
+ *
+ * root 단계에서 다음으로 차 있는 슬롯, 없으면 상위 단계를 내려보낼 다음 한 바퀴의 시작입니다.
+ */
+static uint64_t wheel_next_tick(const TimerService *s) {
+    if (s->count == 0) {
+        return WHEEL_NOT_ARMED;
+    }
+
+    unsigned idx = (unsigned)(s->current & WHEEL_ROOT_MASK);
+    for (unsigned word = idx / 64; word < WHEEL_ROOT_SIZE / 64; word++) {
+        uint64_t bits = s->root_bitmap[word];
+        if (word == idx / 64) {
+            bits &= ~0ULL << (idx % 64);
+        }
+        if (bits != 0) {
+            return s->current + (word * 64 + (unsigned)__builtin_ctzll(bits) - idx);
+        }
+    }
+    return s->current + (WHEEL_ROOT_SIZE - idx);
+}
+
+/**
+ * @brief 서비스 스레드를 tick 시각에 깨우도록 설정하는 함수 (잠금 필요)
+ */
+static void service_arm(TimerService *s, uint64_t tick) {
+    s->armed = tick;
+#ifdef __linux__
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    if (tick != WHEEL_NOT_ARMED) {
+        uint64_t at = s->origin_ns + tick * s->tick_ns;
+        its.it_value.tv_sec = (time_t)(at / 1000000000ULL);
+        its.it_value.tv_nsec = (long)(at % 1000000000ULL);
+    }
+    if (timerfd_settime(s->fd, TFD_TIMER_ABSTIME, &its, NULL) == -1) {
+        kernel_errMsg("timerfd_settime 실패");
+    }
+#else
+    __atomic_add_fetch(&s->wake_seq, 1, __ATOMIC_RELEASE);
+    kernel_futex_wake(&s->wake_seq, 1);
+#endif
+}
+
+/**
+ * @brief 현재 시각까지의 틱을 모두 처리하는 함수 (잠금 필요)
+ */
+static void service_advance(TimerService *s) {
+    uint64_t now_tick = (kernel_now_ns() - s->origin_ns) / s->tick_ns;
+
+    if (s->count == 0) {
+        // 빈 휠은 돌릴 필요 없이 현재 시각으로 이동
+        if (s->current <= now_tick) {
+            s->current = now_tick + 1;
+        }
+        return;
+    }
+    while (s->current <= now_tick && s->count > 0) {
+        wheel_tick(s);
+    }
+    if (s->count == 0 && s->current <= now_tick) {
+        s->current = now_tick + 1;
+    }
+}
+
+/**
+ * @brief 서비스 스레드 루프
+ */
+static void *service_thread(void *arg) {
+    TimerService *s = (TimerService *)arg;
+
+    kmutex_lock(&s->lock);
+    while (!s->shutdown) {
+        service_advance(s);
+#ifdef __linux__
+        service_arm(s, wheel_next_tick(s));
+        kmutex_unlock(&s->lock);
+
+        uint64_t expirations;
+        if (read(s->fd, &expirations, sizeof(expirations)) == -1 && errno != EINTR && errno != EAGAIN) {
+            kernel_errMsg("timerfd 읽기 실패");
+        }
+#else
+        uint64_t next = wheel_next_tick(s);
+        struct timespec timeout;
+        const struct timespec *wait = NULL;
+
+        s->armed = next;
+        uint32_t seq = __atomic_load_n(&s->wake_seq, __ATOMIC_ACQUIRE);
+        if (next != WHEEL_NOT_ARMED) {
+            uint64_t at = s->origin_ns + next * s->tick_ns;
+            uint64_t now = kernel_now_ns();
+            uint64_t left = at > now ? at - now : 0;
+            timeout.tv_sec = (time_t)(left / 1000000000ULL);
+            timeout.tv_nsec = (long)(left % 1000000000ULL);
+            wait = &timeout;
+        }
+        kmutex_unlock(&s->lock);
+
+        if (wait == NULL || wait->tv_sec > 0 || wait->tv_nsec > 0) {
+            kernel_futex_wait(&s->wake_seq, seq, wait);
+        }
+#endif
+        kmutex_lock(&s->lock);
+    }
+    kmutex_unlock(&s->lock);
+    return NULL;
+}
+
+/**
+ * @brief 타이머 서비스를 시작하는 함수
+ *
+ * @param tick_ms 틱 길이 (0이면 환경 변수 또는 기본값)
+ * @return 새로 시작하면 0, 이미 실행 중이면 -1
+ */
+int ktimer_service_start(uint32_t tick_ms) {
+    pthread_mutex_lock(&service_mutex);
+    if (service != NULL) {
+        pthread_mutex_unlock(&service_mutex);
+        return -1;
+    }
+
+    if (tick_ms == 0) {
+        const char *env = getenv("KERNEL_TIMER_TICK_MS");
+        tick_ms = env != NULL && atoi(env) > 0 ? (uint32_t)atoi(env) : KTIMER_DEFAULT_TICK_MS;
+    }
+
+    TimerService *s = (TimerService *)calloc(1, sizeof(TimerService));
+    if (s == NULL) {
+        kernel_errExit("타이머 서비스 메모리 할당 실패");
+    }
+    kmutex_init(&s->lock, "timer.wheel");
+    for (int i = 0; i < WHEEL_ROOT_SIZE; i++) {
+        slot_init(&s->root[i]);
+    }
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        for (int i = 0; i < WHEEL_LEVEL_SIZE; i++) {
+            slot_init(&s->levels[level][i]);
+        }
+    }
+    s->tick_ns = (uint64_t)tick_ms * 1000000ULL;
+    s->origin_ns = kernel_now_ns();
+    s->armed = WHEEL_NOT_ARMED;
+    s->fd = -1;
+#ifdef __linux__
+    s->fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (s->fd == -1) {
+        kernel_errExit("timerfd_create 실패");
+    }
+#endif
+
+    int err = pthread_create(&s->thread, NULL, service_thread, s);
+    if (err != 0) {
+        kernel_errExitEN(err, "타이머 서비스 스레드 생성 실패");
+    }
+    EPOCH_STORE(service, s);
+    pthread_mutex_unlock(&service_mutex);
+
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "타이머 서비스 시작 (틱: %u ms)", tick_ms);
+    return 0;
+}
+
+/**
+ * @brief 유예 기간이 지난 서비스를 해제하는 함수 (epoch_retire 소멸자)
+ */
+static void service_free(void *arg) {
+    TimerService *s = (TimerService *)arg;
+
+    if (s->fd != -1) {
+        close(s->fd);
+    }
+    kmutex_destroy(&s->lock);
+    free(s);
+}
+
+/**
+ * @brief 타이머 서비스를 종료하는 함수
+ *
+ * 게시를 해제한 뒤에도 이전에 서비스를 읽은 스레드가 있을 수 있으므로,
+ * 해제는 epoch_synchronize로 그 스레드들의 읽기 구역이 끝나기를 기다린 다음에 합니다.
+ * 따라서 에포크 읽기 구역 안이나 타이머 콜백 안에서 호출하면 안 됩니다.
+ */
+void ktimer_service_shutdown(void) {
+    pthread_mutex_lock(&service_mutex);
+    TimerService *s = service;
+    if (s == NULL) {
+        pthread_mutex_unlock(&service_mutex);
+        return;
+    }
+
+    kmutex_lock(&s->lock);
+    s->shutdown = 1;
+    for (int i = 0; i < WHEEL_ROOT_SIZE + WHEEL_LEVELS * WHEEL_LEVEL_SIZE; i++) {
+        KTimer *slot = i < WHEEL_ROOT_SIZE ? &s->root[i] : &s->levels[0][0] + (i - WHEEL_ROOT_SIZE);
+        while (!slot_empty(slot)) {
+            KTimer *timer = slot->next;
+            wheel_remove(s, timer);
+            timer->pending = 0;
+        }
+    }
+    uint64_t dropped = s->count;
+    s->count = 0;
+    // 이미 지난 시각으로 설정해 서비스 스레드를 바로 깨움
+    service_arm(s, 0);
+    kmutex_unlock(&s->lock);
+
+    EPOCH_STORE(service, NULL);
+    pthread_join(s->thread, NULL);
+    pthread_mutex_unlock(&service_mutex);
+
+    // 종료 표시 이후 서비스를 읽은 스레드는 shutdown을 보고 물러나므로, 읽기 구역이 끝나면 해제해도 안전함
+    epoch_retire(s, service_free);
+    epoch_synchronize();
+    KTRACE(KTRACE_CAT_ENGINE, KTRACE_LVL_INFO, "타이머 서비스 종료 (취소된 타이머: %llu)", (unsigned long long)dropped);
+}
+
+/**
+ * @brief 타이머를 초기화하는 함수
+ *
+ * @param timer 초기화할 타이머
+ * @param func 만료 콜백
+ * @param arg 콜백 인자
+ */
+void ktimer_init(KTimer *timer, KTimerFunc func, void *arg) {
+    memset(timer, 0, sizeof(*timer));
+    timer->func = func;
+    timer->arg = arg;
+}
+
+/**
+ * @brief delay_ms 뒤에 만료되도록 타이머를 등록하는 함수
+ *
+ * @param timer 타이머
+ * @param delay_ms 지연 시간
+ * @return 성공 시 0, 서비스를 시작할 수 없으면 -1
+ */
+int ktimer_schedule(KTimer *timer, uint64_t delay_ms) {
+    epoch_enter();
+    TimerService *s = EPOCH_LOAD(service);
+    if (s == NULL) {
+        // 시작은 service_mutex를 잡으므로 읽기 구역 밖에서 호출 (종료가 그 잠금을 쥔 채 유예 기간을 기다림)
+        epoch_exit();
+        ktimer_service_start(0);
+        epoch_enter();
+        s = EPOCH_LOAD(service);
+        if (s == NULL) {
+            epoch_exit();
+            return -1;
+        }
+    }
+
+    // 만료 시각을 틱 경계로 올려서 지연 시간보다 일찍 실행되지 않게 함
+    uint64_t delay_ns = delay_ms > UINT64_MAX / 1000000ULL ? UINT64_MAX / 2 : delay_ms * 1000000ULL;
+    uint64_t elapsed = kernel_now_ns() - s->origin_ns;
+    uint64_t at = elapsed + delay_ns;
+    uint64_t expires = at / s->tick_ns + (at % s->tick_ns != 0);
+
+    kmutex_lock(&s->lock);
+    if (s->shutdown) {
+        kmutex_unlock(&s->lock);
+        epoch_exit();
+        return -1;
+    }
+    // 휠이 비어 있는 동안 서비스 스레드는 깨지 않으므로 current가 과거에 머물러 있음.
+    // 그대로 넣으면 경과한 틱을 잠금 안에서 하나씩 돌게 되므로 현재 틱으로 옮김
+    if (s->count == 0 && s->current < elapsed / s->tick_ns) {
+        s->current = elapsed / s->tick_ns;
+    }
+    if (timer->pending) {
+        wheel_remove(s, timer);
+    } else {
+        timer->pending = 1;
+        s->count++;
+    }
+    timer->expires = expires;
+    wheel_add(s, timer);
+    if (timer->expires < s->armed) {
+        service_arm(s, timer->expires);
+    }
+    kmutex_unlock(&s->lock);
+    epoch_exit();
+    return 0;
+}
+
+/**
+ * @brief 등록된 타이머를 취소하는 함수
+ *
+ * @param timer 타이머
+ * @return 대기 중이던 타이머를 취소했으면 1, 아니면 0
+ */
+int ktimer_cancel(KTimer *timer) {
+    int cancelled = 0;
+
+    epoch_enter();
+    TimerService *s = EPOCH_LOAD(service);
+    if (s != NULL) {
+        kmutex_lock(&s->lock);
+        if (timer->pending) {
+            wheel_remove(s, timer);
+            timer->pending = 0;
+            s->count--;
+            cancelled = 1;
+        }
+        kmutex_unlock(&s->lock);
+    }
+    epoch_exit();
+    return cancelled;
+}
+
+/**
+ * @brief 타이머를 취소하고 실행 중인 콜백이 끝날 때까지 기다리는 함수
+ *
+ * @param timer 타이머
+ * @return 대기 중이던 타이머를 취소했으면 1, 아니면 0
+ */
+int ktimer_cancel_sync(KTimer *timer) {
+    int cancelled = ktimer_cancel(timer);
+    uint32_t running;
+
+    while ((running = __atomic_load_n(&timer->running, __ATOMIC_ACQUIRE)) != 0) {
+        kernel_futex_wait(&timer->running, running, NULL);
+    }
+    return cancelled;
+}
+
+/**
+ * @brief 휠에 등록된 타이머 수를 반환하는 함수
+ */
+uint64_t ktimer_pending_count(void) {
+    uint64_t count = 0;
+
+    epoch_enter();
+    TimerService *s = EPOCH_LOAD(service);
+    if (s != NULL) {
+        kmutex_lock(&s->lock);
+        count = s->count;
+        kmutex_unlock(&s->lock);
+    }
+    epoch_exit();
+    return count;
+}
@@ -0,0 +1,540 @@
+/*
+ * Kernel Trace Points
+ *
+ * Maintainer: Azabell1993 Github master
+ * Created   : 2026-10-19
+ *
+ * Purpose   : Per-thread binary trace rings. Recording copies the format
+ *             pointer and raw argument words into a fixed-size slot without
+ *             formatting or locking; ktrace_dump() decodes the slots later.
+ *             Builds with tracing register an exit-time dump.
+ */
+
+#include "kernel_trace.h"
+#include "kernel_engine.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// 스레드별 링 버퍼의 레코드 수 (2의 거듭제곱)
+#ifndef KTRACE_RING_SIZE
+#define KTRACE_RING_SIZE 256
+#endif
+
+#if (KTRACE_RING_SIZE & (KTRACE_RING_SIZE - 1)) != 0
+#error "KTRACE_RING_SIZE must be a power of two"
+#endif
+
+/**
+ * @struct KTraceRecord
+ * @brief 링 버퍼에 저장되는 고정 크기 트레이스 레코드
+ *
+ * seq가 0이면 비어 있거나 기록 중인 슬롯입니다.
+ */
+typedef struct KTraceRecord {
+    uint64_t seq;                       /**< 기록 순번 + 1 (기록 완료 후 게시) */
+    uint64_t timestamp;                 /**< CLOCK_MONOTONIC 기준 나노초 */
+    const char *fmt;                    /**< 포맷 문자열 (복사하지 않음) */
+    uint8_t category;                   /**< 카테고리 */
+    uint8_t level;                      /**< 레벨 */
+    uint8_t nargs;                      /**< 기록된 인자 수 */
+    uint8_t text_used;                  /**< text 영역 사용 바이트 수 */
+    uint32_t reserved;
+    uint64_t args[KTRACE_MAX_ARGS];     /**< 정수/포인터/실수 비트 또는 text 오프셋 */
+    char text[KTRACE_TEXT_SIZE];        /**< %s 인자 복사본 (NUL 구분) */
+} KTraceRecord;
+
+/**
+ * @struct KTraceRing
+ * @brief 스레드별 링 버퍼
+ *
+ * 링은 해제하지 않고 재사용하므로 덤프 시 목록을 잠금 없이 순회할 수 있습니다.
+ */
+typedef struct KTraceRing {
+    KTraceRecord records[KTRACE_RING_SIZE];
+    uint64_t head;                      /**< 다음 기록 위치 (소유 스레드만 증가) */
+    unsigned id;                        /**< 덤프 시 표시할 링 번호 */
+    int in_use;                         /**< 스레드가 점유 중인지 여부 */
+    struct KTraceRing *next;            /**< 전역 링 목록의 다음 노드 */
+} KTraceRing;
+
+/**
+ * @struct KTraceEntry
+ * @brief 덤프 시 정렬에 사용하는 레코드 복사본
+ */
+typedef struct KTraceEntry {
+    KTraceRecord record;
+    unsigned ring_id;
+} KTraceEntry;
+
+static KTraceRing *ring_list = NULL;
+static unsigned ring_count = 0;
+static unsigned runtime_mask = KTRACE_CAT_ALL;
+
+static pthread_key_t ktrace_key;
+static pthread_once_t ktrace_once = PTHREAD_ONCE_INIT;
+static __thread KTraceRing *local_ring = NULL;
+
+/**
+ * @brief 스레드 종료 시 링을 반납하는 함수
+ *
+ * 기록은 지우지 않으므로 다른 스레드가 링을 재사용하기 전까지 덤프에 남습니다.
+ *
+ * @param arg 반납할 KTraceRing 포인터
+ */
+static void ktrace_thread_exit(void *arg) {
+    KTraceRing *ring = (KTraceRing *)arg;
+    __atomic_store_n(&ring->in_use, 0, __ATOMIC_RELEASE);
+    local_ring = NULL;
+}
+
+static void ktrace_init_key(void) {
+    if (pthread_key_create(&ktrace_key, ktrace_thread_exit) != 0) {
+        kernel_errExit("트레이스 스레드 키 생성 실패");
+    }
+}
+
+/**
+ * @brief 현재 스레드의 링을 가져오는 함수
+ *
+ * @return 현재 스레드의 KTraceRing 포인터
+ */
+static KTraceRing *ktrace_local_ring(void) {
+    if (local_ring != NULL) {
+        return local_ring;
+    }
+
+    pthread_once(&ktrace_once, ktrace_init_key);
+
+    KTraceRing *ring;
+    for (ring = __atomic_load_n(&ring_list, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+        int expected = 0;
+        if (__atomic_load_n(&ring->in_use, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&ring->in_use, &expected, 1, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    if (ring == NULL) {
+        ring = (KTraceRing *)calloc(1, sizeof(KTraceRing));
+        if (ring == NULL) {
+            kernel_errExit("트레이스 링 메모리 할당 실패");
+        }
+        ring->in_use = 1;
+        ring->id = __atomic_add_fetch(&ring_count, 1, __ATOMIC_RELAXED);
+        ring->next = __atomic_load_n(&ring_list, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&ring_list, &ring->next, ring, true,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+    }
+
+    local_ring = ring;
+    pthread_setspecific(ktrace_key, ring);
+    return ring;
+}
+
+/**
+ * @brief 포맷 지정자 하나를 해석하는 함수
+ *
+ * '%' 다음 위치에서 플래그, 폭, 정밀도, 길이 수식자를 건너뛰고 변환 문자를 찾습니다.
+ *
+ * @param p '%' 다음 문자 포인터
+ * @param length 길이 수식자 ('H' = hh, 'L' = ll/j, 'l', 'h', 'z', 'D' = long double, 0 = 없음)
+ * @return 변환 문자 포인터 (문자열 끝이면 NUL 위치)
+ */
+static const char *ktrace_parse_spec(const char *p, char *length) {
+    while (*p && strchr("-+ #0", *p)) {
+        p++;
+    }
+    while ((*p >= '0' && *p <= '9') || *p == '.') {
+        p++;
+    }
+
+    *length = 0;
+    if (p[0] == 'h' && p[1] == 'h') {
+        *length = 'H';
+        p += 2;
+    } else if (p[0] == 'l' && p[1] == 'l') {
+        *length = 'L';
+        p += 2;
+    } else if (*p == 'j') {
+        *length = 'L';
+        p++;
+    } else if (*p == 'l' || *p == 'h' || *p == 'z' || *p == 't') {
+        *length = (*p == 't') ? 'z' : *p;
+        p++;
+    } else if (*p == 'L') {
+        *length = 'D';
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief 가변 인자를 레코드의 원시 인자 슬롯으로 복사하는 함수
+ *
+ * @param rec 기록할 레코드
+ * @param fmt 포맷 문자열
+ * @param ap 가변 인자 리스트
+ */
+static void ktrace_capture(KTraceRecord *rec, const char *fmt, va_list ap) {
+    rec->nargs = 0;
+    rec->text_used = 0;
+
+    for (const char *p = fmt; *p && rec->nargs < KTRACE_MAX_ARGS; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        if (p[1] == '%') {
+            p++;
+            continue;
+        }
+
+        char length;
+        p = ktrace_parse_spec(p + 1, &length);
+        uint64_t value = 0;
+
+        switch (*p) {
+            case 'd': case 'i':
+                if (length == 'L')      value = (uint64_t)va_arg(ap, long long);
+                else if (length == 'l') value = (uint64_t)va_arg(ap, long);
+                else if (length == 'z') value = (uint64_t)va_arg(ap, ssize_t);
+                else                    value = (uint64_t)(int64_t)va_arg(ap, int);
+                break;
+            case 'u': case 'o': case 'x': case 'X': case 'c':
+                if (length == 'L')      value = (uint64_t)va_arg(ap, unsigned long long);
+                else if (length == 'l') value = (uint64_t)va_arg(ap, unsigned long);
+                else if (length == 'z') value = (uint64_t)va_arg(ap, size_t);
+                else                    value = (uint64_t)va_arg(ap, unsigned int);
+                break;
+            case 'p':
+                value = (uint64_t)(uintptr_t)va_arg(ap, void *);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                double d = (length == 'D') ? (double)va_arg(ap, long double) : va_arg(ap, double);
+                memcpy(&value, &d, sizeof(value));
+                break;
+            }
+            case 's': {
+                // 문자열은 덤프 시점에 해제되어 있을 수 있으므로 레코드 안에 복사
+                const char *s = va_arg(ap, const char *);
+                size_t room = KTRACE_TEXT_SIZE - rec->text_used;
+                size_t len = 0;
+                if (s == NULL) {
+                    s = "(null)";
+                }
+                if (room > 0) {
+                    while (len + 1 < room && s[len] != '\0') {
+                        len++;
+                    }
+                    memcpy(rec->text + rec->text_used, s, len);
+                    rec->text[rec->text_used + len] = '\0';
+                }
+                value = rec->text_used;
+                rec->text_used += (room > 0) ? (uint8_t)(len + 1) : 0;
+                break;
+            }
+            case 'n':
+                (void)va_arg(ap, int *);
+                continue;
+            default:
+                return;
+        }
+        rec->args[rec->nargs++] = value;
+    }
+}
+
+/**
+ * @brief 현재 스레드의 링 버퍼에 트레이스 레코드를 기록하는 함수
+ *
+ * @param category 카테고리
+ * @param level 레벨
+ * @param fmt 포맷 문자열
+ * @param ... 가변 인자 리스트
+ */
+void ktrace_record(unsigned category, unsigned level, const char *fmt, ...) {
+    if ((category & __atomic_load_n(&runtime_mask, __ATOMIC_RELAXED)) == 0) {
+        return;
+    }
+
+    KTraceRing *ring = ktrace_local_ring();
+    uint64_t pos = ring->head++;
+    KTraceRecord *rec = &ring->records[pos & (KTRACE_RING_SIZE - 1)];
+    struct timespec ts;
+
+    // 덤프 중인 스레드가 반쯤 기록된 슬롯을 읽지 않도록 seq를 먼저 비움
+    __atomic_store_n(&rec->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    rec->timestamp = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    rec->fmt = fmt;
+    rec->category = (uint8_t)category;
+    rec->level = (uint8_t)level;
+
+    va_list ap;
+    va_start(ap, fmt);
+    ktrace_capture(rec, fmt, ap);
+    va_end(ap);
+
+    __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 실행 중에 기록할 카테고리를 제한하는 함수
+ *
+ * @param mask 기록할 카테고리 마스크
+ */
+void ktrace_set_mask(unsigned mask) {
+    __atomic_store_n(&runtime_mask, mask, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 실행 중 기록 중인 카테고리 마스크를 반환하는 함수
+ */
+unsigned ktrace_get_mask(void) {
+    return __atomic_load_n(&runtime_mask, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 라이브러리가 빌드된 트레이스 레벨을 반환하는 함수
+ */
+int ktrace_compiled_level(void) {
+    return KTRACE_LEVEL;
+}
+
+static const char *ktrace_category_name(unsigned category) {
+    switch (category) {
+        case KTRACE_CAT_SMARTPTR: return "smartptr";
+        case KTRACE_CAT_CHAT:     return "chat";
+        case KTRACE_CAT_ENGINE:   return "engine";
+        case KTRACE_CAT_PRINTF:   return "printf";
+        default:                  return "misc";
+    }
+}
+
+static const char *ktrace_level_name(unsigned level) {
+    switch (level) {
+        case KTRACE_LVL_ERROR: return "ERROR";
+        case KTRACE_LVL_WARN:  return "WARN";
+        case KTRACE_LVL_INFO:  return "INFO";
+        default:               return "DEBUG";
+    }
+}
+
+/**
+ * @brief 레코드 하나를 사람이 읽을 수 있는 문자열로 복원하는 함수
+ *
+ * @param rec 복원할 레코드
+ * @param buf 출력 버퍼
+ * @param size 출력 버퍼 크기
+ */
+static void ktrace_format_record(const KTraceRecord *rec, char *buf, size_t size) {
+    size_t out = 0;
+    unsigned argi = 0;
+    const char *p = rec->fmt;
+
+    while (*p && out + 1 < size) {
+        if (*p != '%') {
+            buf[out++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            buf[out++] = '%';
+            p += 2;
+            continue;
+        }
+
+        char length;
+        const char *conv = ktrace_parse_spec(p + 1, &length);
+        if (*conv == '\0') {
+            break;
+        }
+        if (*conv == 'n') {
+            p = conv + 1;
+            continue;
+        }
+        if (argi >= rec->nargs) {
+            // 기록하지 못한 인자는 생략 표시
+            out += (size_t)snprintf(buf + out, size - out, "...");
+            break;
+        }
+
+        char spec[32];
+        size_t spec_len = (size_t)(conv - p + 1);
+        if (spec_len >= sizeof(spec)) {
+            break;
+        }
+        memcpy(spec, p, spec_len);
+        spec[spec_len] = '\0';
+
+        uint64_t v = rec->args[argi++];
+        int n;
+        switch (*conv) {
+            case 'd': case 'i':
+                if (length == 'L')      n = snprintf(buf + out, size - out, spec, (long long)v);
+                else if (length == 'l') n = snprintf(buf + out, size - out, spec, (long)v);
+                else if (length == 'z') n = snprintf(buf + out, size - out, spec, (ssize_t)v);
+                else                    n = snprintf(buf + out, size - out, spec, (int)v);
+                break;
+            case 'u': case 'o': case 'x': case 'X': case 'c':
+                if (length == 'L')      n = snprintf(buf + out, size - out, spec, (unsigned long long)v);
+                else if (length == 'l') n = snprintf(buf + out, size - out, spec, (unsigned long)v);
+                else if (length == 'z') n = snprintf(buf + out, size - out, spec, (size_t)v);
+                else                    n = snprintf(buf + out, size - out, spec, (unsigned int)v);
+                break;
+            case 'p':
+                n = snprintf(buf + out, size - out, spec, (void *)(uintptr_t)v);
+                break;
+            case 's':
+                n = snprintf(buf + out, size - out, spec,
+                             v < KTRACE_TEXT_SIZE ? rec->text + v : "");
+                break;
+            default: {
+                double d;
+                memcpy(&d, &v, sizeof(d));
+                if (length == 'D') n = snprintf(buf + out, size - out, spec, (long double)d);
+                else               n = snprintf(buf + out, size - out, spec, d);
+                break;
+            }
+        }
+        if (n < 0) {
+            break;
+        }
+        out += (size_t)n;
+        p = conv + 1;
+    }
+
+    if (out >= size) {
+        out = size - 1;
+    }
+    buf[out] = '\0';
+}
+
+static int ktrace_compare(const void *a, const void *b) {
+    const KTraceEntry *x = (const KTraceEntry *)a;
+    const KTraceEntry *y = (const KTraceEntry *)b;
+    if (x->record.timestamp != y->record.timestamp) {
+        return x->record.timestamp < y->record.timestamp ? -1 : 1;
+    }
+    return x->record.seq < y->record.seq ? -1 : (x->record.seq > y->record.seq);
+}
+
+/**
+ * @brief 모든 스레드의 링 버퍼 내용을 시간순으로 출력하는 함수
+ *
+ * @param out 출력 스트림 (NULL이면 stderr)
+ * @return 출력한 레코드 수
+ */
+size_t ktrace_dump(FILE *out) {
+    size_t capacity = (size_t)__atomic_load_n(&ring_count, __ATOMIC_ACQUIRE) * KTRACE_RING_SIZE;
+    size_t count = 0;
+
+    if (out == NULL) {
+        out = stderr;
+    }
+    if (capacity == 0) {
+        return 0;
+    }
+
+    KTraceEntry *entries = (KTraceEntry *)malloc(capacity * sizeof(KTraceEntry));
+    if (entries == NULL) {
+        kernel_errMsg("트레이스 덤프 메모리 할당 실패");
+        return 0;
+    }
+
+    for (KTraceRing *ring = __atomic_load_n(&ring_list, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+        for (size_t i = 0; i < KTRACE_RING_SIZE && count < capacity; i++) {
+            KTraceRecord *rec = &ring->records[i];
+            uint64_t seq = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+            if (seq == 0) {
+                continue;
+            }
+
+            memcpy(&entries[count].record, rec, sizeof(KTraceRecord));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+            // 복사 중에 덮어쓰인 슬롯은 버림
+            if (__atomic_load_n(&rec->seq, __ATOMIC_RELAXED) != seq) {
+                continue;
+            }
+            entries[count].ring_id = ring->id;
+            count++;
+        }
+    }
+
+    qsort(entries, count, sizeof(KTraceEntry), ktrace_compare);
+
+    char line[256];
+    for (size_t i = 0; i < count; i++) {
+        const KTraceRecord *rec = &entries[i].record;
+        ktrace_format_record(rec, line, sizeof(line));
+        fprintf(out, "[%llu.%09llu] [T%u] [%s] [%s] %s\n",
+                (unsigned long long)(rec->timestamp / 1000000000ULL),
+                (unsigned long long)(rec->timestamp % 1000000000ULL),
+                entries[i].ring_id, ktrace_category_name(rec->category),
+                ktrace_level_name(rec->level), line);
+    }
+    fflush(out);
+
+    free(entries);
+    return count;
+}
+
+/**
+ * @brief 모든 스레드의 링 버퍼를 비우는 함수
+ *
+ * 기록 중인 스레드가 없을 때 호출해야 모든 레코드가 확실히 비워집니다.
+ */
+void ktrace_reset(void) {
+    for (KTraceRing *ring = __atomic_load_n(&ring_list, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+        for (size_t i = 0; i < KTRACE_RING_SIZE; i++) {
+            __atomic_store_n(&ring->records[i].seq, 0, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+#if KTRACE_LEVEL > 0
+/**
+ * @brief 프로그램 종료 시 링 버퍼를 덤프하는 함수
+ *
+ * KERNEL_TRACE_DUMP가 없으면 stderr로, 경로면 해당 파일에 이어 쓰며, "off"면 덤프하지 않습니다.
+ */
+static void ktrace_dump_at_exit(void) {
+    const char *target = getenv("KERNEL_TRACE_DUMP");
+    if (target != NULL && strcmp(target, "off") == 0) {
+        return;
+    }
+
+    FILE *out = NULL;
+    if (target != NULL && target[0] != '\0') {
+        out = fopen(target, "a");
+        if (out == NULL) {
+            kernel_errMsg("트레이스 덤프 파일 열기 실패: %s", target);
+            return;
+        }
+    }
+    ktrace_dump(out);
+    if (out != NULL) {
+        fclose(out);
+    }
+}
+
+/**
+ * @brief 트레이스가 빌드된 경우 시작 시 종료 덤프를 등록하고 KERNEL_TRACE_MASK를 적용하는 함수
+ */
+__attribute__((constructor))
+static void ktrace_install_exit_dump(void) {
+    const char *mask = getenv("KERNEL_TRACE_MASK");
+    if (mask != NULL && mask[0] != '\0') {
+        ktrace_set_mask((unsigned)strtoul(mask, NULL, 0));
+    }
+    if (atexit(ktrace_dump_at_exit) != 0) {
+        kernel_errMsg("트레이스 종료 덤프 등록 실패");
+    }
+}
+#endif
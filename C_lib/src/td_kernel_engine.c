@@ -19,23 +19,62 @@
 #include <semaphore.h>
 #include <sys/socket.h>
 #include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <time.h>
 
 // td_kernel_engine.c 파일에 정의된 함수를 사용하기 위해 헤더 파일을 포함합니다.(정적 라이브러리와 무관)
 #include "kernel_chat.h"
 #include "kernel_engine.h"
 #include "kernel_print.h"
+#include "kernel_procpool.h"
+#include "kernel_sched.h"
 #include "kernel_smartptr.h"
+#include "kernel_sync.h"
 
 #define NUM_THREADS 3
 #define NUM_PROCESSES 2
+#define NUM_PHASES 3
 #define DEFAULT_TCP_PORT 5100
+#define SCHED_TEST_WORKERS 2
+#define SCHED_TEST_ITEMS 100000
+#define SCHED_TEST_FIB 18
+#define SCHED_TEST_EXTERNAL (KSCHED_MAX_EXTERNAL + 4)
+#define SCHED_TEST_OVERFLOW 100
+#define PROCPOOL_TEST_WORKERS 2
+#define PROCPOOL_TEST_JOBS 32
+#define PROCPOOL_TEST_RESPAWN_MS 2000
+#define PROCPOOL_TEST_SHUTDOWN_MS 3000
+
+// 검사가 실패하면 메시지를 남기고 테스트 함수에서 -1을 반환
+#define TEST_CHECK(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            safe_kernel_printf("테스트 실패: " __VA_ARGS__); \
+            safe_kernel_printf("\n"); \
+            return -1; \
+        } \
+    } while (0)
+
+/**
+ * @struct EngineCommand
+ * @brief 명령줄에서 이름으로 선택해 실행하는 개별 테스트
+ */
+typedef struct {
+    const char *name;       /**< 명령 이름 */
+    int (*run)(void);       /**< 성공 시 0을 반환하는 테스트 함수 */
+} EngineCommand;
 
 // Forward declarations of test functions
 static void test_smart_pointer();
 static void test_file_reading();
 static void test_multithreading();
+static void test_phased_threads();
 static void test_multiprocessing();
 static void test_synchronization();
+static int test_work_stealing_scheduler(void);
+static int test_process_pool(void);
+static int run_command(const char *name);
 static void run_all_tests();
 static pid_t kernel_fork();
 static void kernel_create_thread(pthread_t *thread, void *(*start_routine)(void *), void *arg);
@@ -53,8 +92,18 @@ void* thread_function(void* arg);
 // Function prototype for process function
 static void process_function();
 
+static const EngineCommand engine_commands[] = {
+    { "sched", test_work_stealing_scheduler },
+    { "procpool", test_process_pool },
+};
+
 // Main function
-int main(int argc __attribute__((unused)), char** argv __attribute__((unused))) {
+int main(int argc, char** argv) {
+    // 인자로 명령 이름을 주면 해당 테스트만 실행하고 결과를 종료 코드로 반환
+    if (argc > 1) {
+        return run_command(argv[1]);
+    }
+
     kernel_printf("커널 메인 함수 시작\n");
 
     // 단계 1: 변수 초기화
@@ -388,6 +437,51 @@ static void test_multithreading() {
     safe_kernel_printf("멀티스레드 테스트 종료\n");
 }
 
+typedef struct {
+    KBarrier barrier;
+    long sums[NUM_PHASES];
+} PhaseShared;
+
+typedef struct {
+    PhaseShared *shared;
+    int id;
+} PhaseArg;
+
+// 단계마다 다시 만들지 않고 같은 스레드가 배리어에서 다음 단계를 기다림
+static void* phase_thread(void* arg) {
+    PhaseArg *pa = (PhaseArg *)arg;
+
+    for (int phase = 0; phase < NUM_PHASES; phase++) {
+        __atomic_add_fetch(&pa->shared->sums[phase], pa->id * (phase + 1), __ATOMIC_RELAXED);
+        if (kbarrier_wait(&pa->shared->barrier) == KBARRIER_SERIAL_THREAD) {
+            safe_kernel_printf("단계 %d 완료 (합계: %ld)\n", phase + 1, pa->shared->sums[phase]);
+        }
+    }
+    return NULL;
+}
+
+// 배리어 단계 테스트 함수
+static void test_phased_threads() {
+    safe_kernel_printf("배리어 단계 테스트 시작\n");
+
+    PhaseShared shared = { 0 };
+    PhaseArg args[NUM_THREADS];
+    pthread_t threads[NUM_THREADS];
+
+    kbarrier_init(&shared.barrier, NUM_THREADS);
+    for (int i = 0; i < NUM_THREADS; i++) {
+        args[i].shared = &shared;
+        args[i].id = i + 1;
+        pthread_create(&threads[i], NULL, phase_thread, &args[i]);
+    }
+
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    safe_kernel_printf("배리어 단계 테스트 종료\n");
+}
+
 // 프로세스 함수 예제
 static void process_function() {
     pid_t pid = getpid();
@@ -444,11 +538,372 @@ static void test_synchronization() {
     safe_kernel_printf("동기화 테스트 종료\n");
 }
 
+/* ---------------------------------------------------------------------------
+ * 작업 훔치기 스케줄러 테스트
+ * ------------------------------------------------------------------------- */
+
+static void sched_mark_range(size_t begin, size_t end, void *ctx) {
+    unsigned char *visits = (unsigned char *)ctx;
+    for (size_t i = begin; i < end; i++) {
+        __atomic_add_fetch(&visits[i], 1, __ATOMIC_RELAXED);
+    }
+}
+
+// 모든 인덱스가 정확히 한 번씩 처리되는지 확인
+static int sched_check_parallel_for(size_t count, size_t grain) {
+    unsigned char *visits = calloc(count, 1);
+    TEST_CHECK(visits != NULL, "parallel_for 메모리 할당 실패");
+
+    parallel_for(0, count, grain, sched_mark_range, visits);
+    size_t bad = count;
+    for (size_t i = 0; i < count && bad == count; i++) {
+        if (visits[i] != 1) {
+            bad = i;
+        }
+    }
+    int times = bad < count ? visits[bad] : 1;
+    free(visits);
+    TEST_CHECK(bad == count, "parallel_for 인덱스 %zu 처리 횟수 %d (count %zu, grain %zu)", bad, times, count, grain);
+    return 0;
+}
+
+/**
+ * @struct SpanAcc
+ * @brief 순서대로 이어 붙인 구간 (결합 순서가 틀리면 ordered가 0이 됨)
+ */
+typedef struct {
+    size_t first;
+    size_t last;
+    int empty;
+    int ordered;
+} SpanAcc;
+
+static void span_map(size_t begin, size_t end, void *ctx, void *acc) {
+    (void)ctx;
+    SpanAcc *a = (SpanAcc *)acc;
+    if (a->empty) {
+        a->first = begin;
+    } else if (a->last != begin) {
+        a->ordered = 0;
+    }
+    a->last = end;
+    a->empty = 0;
+}
+
+// 교환 법칙이 없는 결합: 왼쪽 구간의 끝이 오른쪽 구간의 시작과 맞아야 함
+static void span_combine(void *acc, const void *other, void *ctx) {
+    (void)ctx;
+    SpanAcc *a = (SpanAcc *)acc;
+    const SpanAcc *b = (const SpanAcc *)other;
+    if (b->empty) {
+        return;
+    }
+    if (a->empty) {
+        *a = *b;
+        return;
+    }
+    a->ordered = a->ordered && b->ordered && a->last == b->first;
+    a->last = b->last;
+}
+
+typedef struct {
+    int n;
+    long result;
+} FibTask;
+
+// 작업마다 하위 작업을 spawn하고 task_group_wait에서 남의 작업을 대신 실행하며 기다림
+static void sched_fib(void *arg) {
+    FibTask *task = (FibTask *)arg;
+    if (task->n < 2) {
+        task->result = task->n;
+        return;
+    }
+
+    FibTask left = { task->n - 1, 0 };
+    FibTask right = { task->n - 2, 0 };
+    KTaskGroup tg = KTASK_GROUP_INIT;
+    task_group_spawn(&tg, sched_fib, &left);
+    sched_fib(&right);
+    task_group_wait(&tg);
+    task->result = left.result + right.result;
+}
+
+static void *sched_external_thread(void *arg) {
+    int *status = (int *)arg;
+    *status = sched_check_parallel_for(SCHED_TEST_ITEMS / 10, 16);
+    return NULL;
+}
+
+typedef struct {
+    int release;
+    int started;
+    int spawning;
+    pthread_t spawner;
+    int inline_runs;
+} OverflowState;
+
+static OverflowState overflow_state;
+
+// 워커를 모두 붙잡아 두어 덱에서 작업을 훔쳐 가지 못하게 함
+static void sched_hold_worker(void *arg) {
+    (void)arg;
+    __atomic_add_fetch(&overflow_state.started, 1, __ATOMIC_ACQ_REL);
+    while (!__atomic_load_n(&overflow_state.release, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+}
+
+static void sched_count_inline(void *arg) {
+    (void)arg;
+    if (__atomic_load_n(&overflow_state.spawning, __ATOMIC_ACQUIRE) &&
+        pthread_equal(pthread_self(), overflow_state.spawner)) {
+        __atomic_add_fetch(&overflow_state.inline_runs, 1, __ATOMIC_RELAXED);
+    }
+}
+
+// 스케줄러 테스트 함수
+static int test_work_stealing_scheduler(void) {
+    safe_kernel_printf("작업 훔치기 스케줄러 테스트 시작\n");
+    ksched_init(SCHED_TEST_WORKERS);
+
+    // 1. parallel_for: 자동/고정 grain, grain보다 작은 구간
+    TEST_CHECK(sched_check_parallel_for(SCHED_TEST_ITEMS, 0) == 0, "parallel_for 자동 grain");
+    TEST_CHECK(sched_check_parallel_for(SCHED_TEST_ITEMS, 1) == 0, "parallel_for grain 1");
+    TEST_CHECK(sched_check_parallel_for(7, 64) == 0, "parallel_for 단일 구간");
+
+    // 2. parallel_reduce: 결과가 구간 순서대로 결합되어야 함
+    SpanAcc identity = { 0, 0, 1, 1 };
+    SpanAcc span;
+    parallel_reduce(0, SCHED_TEST_ITEMS, 1, sizeof(SpanAcc), &identity, span_map, span_combine, NULL, &span);
+    TEST_CHECK(!span.empty && span.ordered && span.first == 0 && span.last == SCHED_TEST_ITEMS,
+               "parallel_reduce 결합 순서 (first %zu, last %zu, ordered %d)", span.first, span.last, span.ordered);
+
+    // 3. 중첩 spawn과 돕는 대기
+    FibTask fib = { SCHED_TEST_FIB, 0 };
+    sched_fib(&fib);
+    TEST_CHECK(fib.result == 2584, "중첩 spawn fib(%d) = %ld", SCHED_TEST_FIB, fib.result);
+
+    // 4. 외부 스레드: 슬롯보다 많은 스레드가 동시에 참여 (슬롯이 없는 스레드는 직렬 실행)
+    pthread_t threads[SCHED_TEST_EXTERNAL];
+    int status[SCHED_TEST_EXTERNAL];
+    for (int i = 0; i < SCHED_TEST_EXTERNAL; i++) {
+        status[i] = -1;
+        TEST_CHECK(pthread_create(&threads[i], NULL, sched_external_thread, &status[i]) == 0, "외부 스레드 %d 생성", i);
+    }
+    for (int i = 0; i < SCHED_TEST_EXTERNAL; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    for (int i = 0; i < SCHED_TEST_EXTERNAL; i++) {
+        TEST_CHECK(status[i] == 0, "외부 스레드 %d parallel_for", i);
+    }
+
+    // 5. 덱이 가득 차면 spawn한 작업을 그 자리에서 실행
+    KTaskGroup holders = KTASK_GROUP_INIT;
+    KTaskGroup flood = KTASK_GROUP_INIT;
+    memset(&overflow_state, 0, sizeof(overflow_state));
+    overflow_state.spawner = pthread_self();
+    for (int i = 0; i < SCHED_TEST_WORKERS; i++) {
+        task_group_spawn(&holders, sched_hold_worker, NULL);
+    }
+    while (__atomic_load_n(&overflow_state.started, __ATOMIC_ACQUIRE) < SCHED_TEST_WORKERS) {
+        sched_yield();
+    }
+    __atomic_store_n(&overflow_state.spawning, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < KSCHED_DEQUE_SIZE + SCHED_TEST_OVERFLOW; i++) {
+        task_group_spawn(&flood, sched_count_inline, NULL);
+    }
+    __atomic_store_n(&overflow_state.spawning, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&overflow_state.release, 1, __ATOMIC_RELEASE);
+    task_group_wait(&flood);
+    task_group_wait(&holders);
+    TEST_CHECK(overflow_state.inline_runs == SCHED_TEST_OVERFLOW,
+               "덱 초과 작업 즉시 실행 수 %d (기대값 %d)", overflow_state.inline_runs, SCHED_TEST_OVERFLOW);
+
+    ksched_shutdown();
+    safe_kernel_printf("작업 훔치기 스케줄러 테스트 종료\n");
+    return 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * 프로세스 풀 테스트
+ * ------------------------------------------------------------------------- */
+
+static long elapsed_ms_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000L + (now.tv_nsec - start->tv_nsec) / 1000000L;
+}
+
+// 입력 정수를 두 배로 만들어 돌려주고 작업자 PID를 결과 코드로 반환
+static int procpool_double_job(const void *input, size_t input_len, void *output, size_t output_cap, size_t *output_len) {
+    int value = 0;
+    if (input_len == sizeof(value) && output_cap >= sizeof(value)) {
+        memcpy(&value, input, sizeof(value));
+        value *= 2;
+        memcpy(output, &value, sizeof(value));
+        *output_len = sizeof(value);
+    }
+    return (int)getpid();
+}
+
+// 작업자 프로세스를 SIGSEGV로 종료시킴 (코어 파일은 남기지 않음)
+static int procpool_crash_job(const void *input, size_t input_len, void *output, size_t output_cap, size_t *output_len) {
+    (void)input; (void)input_len; (void)output; (void)output_cap; (void)output_len;
+    struct rlimit no_core = { 0, 0 };
+    setrlimit(RLIMIT_CORE, &no_core);
+    raise(SIGSEGV);
+    return 0;
+}
+
+static int procpool_pid_pipe[2] = { -1, -1 };
+
+// 끝나지 않는 작업 (입력이 1이면 SIGTERM도 무시), 시작하면 PID를 파이프로 알림
+static int procpool_hang_job(const void *input, size_t input_len, void *output, size_t output_cap, size_t *output_len) {
+    (void)output; (void)output_cap; (void)output_len;
+    if (input_len == 1 && *(const unsigned char *)input == 1) {
+        signal(SIGTERM, SIG_IGN);
+    }
+    pid_t pid = getpid();
+    if (write(procpool_pid_pipe[1], &pid, sizeof(pid)) != (ssize_t)sizeof(pid)) {
+        _exit(EXIT_FAILURE);
+    }
+    for (;;) {
+        pause();
+    }
+    return 0;
+}
+
+static int procpool_check_double(KProcPool *pool, int value) {
+    int doubled = 0;
+    size_t len = 0;
+    int result = 0;
+    int state = kproc_pool_run(pool, procpool_double_job, &value, sizeof(value), &doubled, sizeof(doubled), &len, &result);
+    TEST_CHECK(state == KPROC_JOB_DONE && len == sizeof(doubled) && doubled == value * 2,
+               "작업 %d 결과 (상태 %d, 크기 %zu, 값 %d)", value, state, len, doubled);
+    TEST_CHECK(result != (int)getpid(), "작업이 소유 프로세스에서 실행됨");
+    return 0;
+}
+
+// 프로세스가 없거나 회수만 기다리는 좀비이면 1
+static int process_gone(pid_t pid) {
+    if (kill(pid, 0) != 0) {
+        return 1;
+    }
+
+    char path[64];
+    char stat[256];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return 1;
+    }
+    size_t len = fread(stat, 1, sizeof(stat) - 1, file);
+    fclose(file);
+    stat[len] = '\0';
+
+    const char *paren = strrchr(stat, ')');
+    return paren != NULL && paren[1] == ' ' && paren[2] == 'Z';
+}
+
+// 끝나지 않는 작업이 남아 있어도 종료가 유예 시간 단계를 거쳐 끝나고 작업자가 사라지는지 확인
+static int procpool_check_shutdown(unsigned char ignore_term) {
+    TEST_CHECK(pipe(procpool_pid_pipe) == 0, "PID 파이프 생성");
+    KProcPool *pool = kproc_pool_create(1);
+    TEST_CHECK(pool != NULL, "프로세스 풀 생성");
+    TEST_CHECK(kproc_pool_submit(pool, procpool_hang_job, &ignore_term, 1) >= 0, "끝나지 않는 작업 제출");
+
+    pid_t worker = -1;
+    TEST_CHECK(read(procpool_pid_pipe[0], &worker, sizeof(worker)) == (ssize_t)sizeof(worker), "작업자 PID 수신");
+    close(procpool_pid_pipe[0]);
+    close(procpool_pid_pipe[1]);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    kproc_pool_destroy(pool);
+    long elapsed = elapsed_ms_since(&start);
+    TEST_CHECK(elapsed < PROCPOOL_TEST_SHUTDOWN_MS, "종료 시간 %ldms (SIGTERM 무시: %d)", elapsed, ignore_term);
+
+    // SIGKILL로 끝난 작업자는 init이 회수하므로 잠시 기다림
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (!process_gone(worker) && elapsed_ms_since(&start) < PROCPOOL_TEST_RESPAWN_MS) {
+        usleep(10000);
+    }
+    TEST_CHECK(process_gone(worker), "종료 후 작업자 %d가 남아 있음 (SIGTERM 무시: %d)", (int)worker, ignore_term);
+    return 0;
+}
+
+// 프로세스 풀 테스트 함수
+static int test_process_pool(void) {
+    safe_kernel_printf("프로세스 풀 테스트 시작\n");
+
+    KProcPool *pool = kproc_pool_create(PROCPOOL_TEST_WORKERS);
+    TEST_CHECK(pool != NULL, "프로세스 풀 생성");
+    TEST_CHECK(kproc_pool_size(pool) == PROCPOOL_TEST_WORKERS, "작업자 수 %d", kproc_pool_size(pool));
+
+    // 1. 정상 작업 (여러 개를 먼저 제출한 뒤 회수)
+    int jobs[PROCPOOL_TEST_JOBS];
+    for (int i = 0; i < PROCPOOL_TEST_JOBS; i++) {
+        jobs[i] = kproc_pool_submit(pool, procpool_double_job, &i, sizeof(i));
+        TEST_CHECK(jobs[i] >= 0, "작업 %d 제출", i);
+    }
+    for (int i = 0; i < PROCPOOL_TEST_JOBS; i++) {
+        int doubled = 0;
+        int state = kproc_pool_wait(pool, jobs[i], &doubled, sizeof(doubled), NULL, NULL);
+        TEST_CHECK(state == KPROC_JOB_DONE && doubled == i * 2, "작업 %d 결과 (상태 %d, 값 %d)", i, state, doubled);
+    }
+
+    // 2. 충돌 격리: 작업만 실패하고 종료 시그널 번호가 전달되어야 함
+    int result = 0;
+    int state = kproc_pool_run(pool, procpool_crash_job, NULL, 0, NULL, 0, NULL, &result);
+    TEST_CHECK(state == KPROC_JOB_CRASHED && result == SIGSEGV, "충돌 작업 (상태 %d, 시그널 %d)", state, result);
+
+    // 3. 재생성: 충돌한 작업자가 다시 만들어지고 이후 작업이 정상 처리되어야 함
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (kproc_pool_respawns(pool) < 1 && elapsed_ms_since(&start) < PROCPOOL_TEST_RESPAWN_MS) {
+        usleep(10000);
+    }
+    TEST_CHECK(kproc_pool_respawns(pool) == 1, "재생성 수 %u", kproc_pool_respawns(pool));
+    for (int i = 0; i < PROCPOOL_TEST_JOBS; i++) {
+        TEST_CHECK(procpool_check_double(pool, i) == 0, "재생성 후 작업 %d", i);
+    }
+    kproc_pool_destroy(pool);
+
+    // 4. 종료: 정상 종료, SIGTERM, SIGKILL 단계
+    TEST_CHECK(procpool_check_shutdown(0) == 0, "SIGTERM 단계 종료");
+    TEST_CHECK(procpool_check_shutdown(1) == 0, "SIGKILL 단계 종료");
+
+    safe_kernel_printf("프로세스 풀 테스트 종료\n");
+    return 0;
+}
+
+/**
+ * @brief 이름이 일치하는 명령을 실행하는 함수
+ *
+ * @param name 명령 이름
+ * @return 테스트 성공 시 0, 실패하거나 알 수 없는 명령이면 1
+ */
+static int run_command(const char *name) {
+    for (size_t i = 0; i < sizeof(engine_commands) / sizeof(engine_commands[0]); i++) {
+        if (strcmp(name, engine_commands[i].name) == 0) {
+            return engine_commands[i].run() == 0 ? 0 : 1;
+        }
+    }
+
+    safe_kernel_printf("알 수 없는 명령: %s (사용 가능:", name);
+    for (size_t i = 0; i < sizeof(engine_commands) / sizeof(engine_commands[0]); i++) {
+        safe_kernel_printf(" %s", engine_commands[i].name);
+    }
+    safe_kernel_printf(")\n");
+    return 1;
+}
+
 // 모든 테스트를 실행하는 함수
 static void run_all_tests() {
     test_smart_pointer();
     test_file_reading();
     test_multithreading();
+    test_phased_threads();
     test_multiprocessing();
     test_synchronization();
 }
@@ -25,11 +25,13 @@
 #include <QLabel>
 #include <QDialog>
 #include <cstdarg>
+#include <vector>
 #include <QFile>
 #include <QDir>
 #include <QVariant>
 #include <QFileInfo>
 #include <QList>
+#include <QStringList>
 
 #include "cmdwindow.h"
 #include "ui_cmdwindow.h"
@@ -38,12 +40,15 @@
 // kernel engine
 #include "kernel_engine.h"
 #include "kernel_smartptr.h"
+#include "kernel_contention.h"
+#include "kernel_trace.h"
 
 // 전역에서 접근 가능한 QTextEdit 포인터
 QTextEdit* globalProgressLog = nullptr;
 
 // C 정적 라이브러리
 #include "kernel_print.h"
+#include "kernel_format.hpp"
 // #include "kernel_asm.h"
 
 // 직접 하드코딩된 C 함수
@@ -654,6 +659,8 @@ void CmdWindow::handleCommand(const QString &command) {
         ui->textEdit->append("  clear                      - Clear the screen");
         ui->textEdit->append("  ifconfig                   - Show network interfaces");
         ui->textEdit->append("  netstat                    - Show network connections");
+        ui->textEdit->append("  trace mask [<mask>]        - Show or set the trace category mask");
+        ui->textEdit->append("  trace dump                 - Show the recorded trace points");
         ui->textEdit->append("  help_modal                 - Show help in a new modal window");
         ui->textEdit->append("  exit                       - Exit the shell");
         ui->textEdit->append("  shutdown || poweroff       - Shutdown the system");
@@ -681,6 +688,8 @@ void CmdWindow::handleCommand(const QString &command) {
                           "  clear                      - Clear the screen\n"
                           "  ifconfig                   - Show network interfaces\n"
                           "  netstat                    - Show network connections\n"
+                          "  trace mask [<mask>]        - Show or set the trace category mask\n"
+                          "  trace dump                 - Show the recorded trace points\n"
                           "  help_modal                 - Show help in a new modal window\n"
                           "  exit                       - Exit the shell\n"
                           "  shutdown  || poweroff      - Shutdown the system\n");
@@ -714,7 +723,7 @@ void CmdWindow::handleCommand(const QString &command) {
             debugMessage.replace("\\n", "\n");
             qDebug().noquote() << debugMessage;
             ui->textEdit->append(message);
-            kernel_printf("%s", message.toStdString().c_str());
+            kernel::format(KERNEL_FMT("%s"), message.toStdString().c_str());
             ui->textEdit->append("");
         }
         else if (match2.hasMatch()) {
@@ -731,7 +740,7 @@ void CmdWindow::handleCommand(const QString &command) {
                 QVariantList args = parseArguments(arguments);
                 executeKernelPrintf(format, args);
             } else {
-                kernel_printf(format.toStdString().c_str());
+                executeKernelPrintf(format, QVariantList());
             }
 
             ui->textEdit->append("");
@@ -828,7 +837,7 @@ void CmdWindow::handleCommand(const QString &command) {
     else if (command.startsWith("echo ")) {
         QString message = command.mid(5).trimmed(); // echo 이후의 메시지 추출
         ui->textEdit->append(message); // 화면에 출력
-        kernel_printf("%s\n", message.toStdString().c_str()); // 콘솔에 출력
+        kernel::format(KERNEL_FMT("%s\n"), message.toStdString().c_str()); // 콘솔에 출력
     }
 
     else if (command == "ifconfig") {
@@ -855,6 +864,54 @@ void CmdWindow::handleCommand(const QString &command) {
         ui->textEdit->append(output);  // 결과를 UI에 출력
     }
 
+    else if (command == "trace mask" || command.startsWith("trace mask ")) {
+        // 라이브러리가 트레이스 없이 빌드되었으면 마스크를 바꿔도 기록되지 않음
+        if (ktrace_compiled_level() == 0) {
+            ui->textEdit->append("Tracing is compiled out. Rebuild C_lib with: make TRACE_LEVEL=4");
+        }
+
+        QString value = command.mid(QString("trace mask").length()).trimmed();
+        if (!value.isEmpty()) {
+            bool ok = false;
+            unsigned mask = value.toUInt(&ok, 0);
+            if (!ok || (mask & ~KTRACE_CAT_ALL) != 0) {
+                ui->textEdit->append("Usage: trace mask [<mask>]  (0x01 smartptr, 0x02 chat, 0x04 engine, 0x08 printf)");
+                return;
+            }
+            ktrace_set_mask(mask);
+        }
+        ui->textEdit->append(QString("Trace mask: 0x%1 (level %2)")
+                                 .arg(ktrace_get_mask(), 2, 16, QChar('0'))
+                                 .arg(ktrace_compiled_level()));
+    }
+
+    else if (command == "trace dump") {
+        if (ktrace_compiled_level() == 0) {
+            ui->textEdit->append("Tracing is compiled out. Rebuild C_lib with: make TRACE_LEVEL=4");
+            return;
+        }
+
+        // 덤프는 FILE*로 출력하므로 임시 파일을 거쳐 화면에 표시
+        FILE *out = tmpfile();
+        if (out == nullptr) {
+            ui->textEdit->append("Failed to create a temporary file for the trace dump.");
+            return;
+        }
+        size_t records = ktrace_dump(out);
+        rewind(out);
+
+        QByteArray dump;
+        char chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), out)) > 0) {
+            dump.append(chunk, static_cast<int>(n));
+        }
+        fclose(out);
+
+        ui->textEdit->append(QString::fromUtf8(dump).trimmed());
+        ui->textEdit->append(QString("%1 trace records").arg(records));
+    }
+
     else if (command == "shutdown" || command == "poweroff") {
         ui->textEdit->append("Shutting down...");
         QApplication::quit();  // 애플리케이션 종료
@@ -888,7 +945,7 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
     QString command = args[0];
     commandHistory.append(command);  // 명령어를 히스토리에 추가
 
-    kernel_printf("Executing command: %s\n", command.toStdString().c_str());
+    kernel::format(KERNEL_FMT("Executing command: %s\n"), command.toStdString().c_str());
     ui->textEdit->append("Executing command: " + command);
 
     // 포인터 생성 및 스마트 포인터 할당
@@ -898,12 +955,12 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
     smartPointers[testData] = sp;  // 생성된 스마트 포인터를 맵에 추가
 
     ui->textEdit->append(QString("Smart pointer created with value: %1").arg(*testData));
-    kernel_printf("Smart pointer created with value: %d\n", *testData);
+    kernel::format(KERNEL_FMT("Smart pointer created with value: %d\n"), *testData);
     ui->textEdit->append("Smart pointer created with value: " + QString::number(*testData));
 
     // 스마트 포인터로 프로세스 데이터를 관리
     auto processData = std::make_shared<int>(rand() % 1000);
-    kernel_printf("Process Smart Pointer Created With Value : %d\n", *processData);
+    kernel::format(KERNEL_FMT("Process Smart Pointer Created With Value : %d\n"), *processData);
     ui->textEdit->append("Process Smart Pointer Created With Value : " + QString::number(*processData));
 
     QProcess process;
@@ -920,10 +977,10 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
 
         if (QDir::setCurrent(directory)) {
             ui->textEdit->append("Changed directory to: " + QDir::currentPath());
-            kernel_printf("Directory changed to: %s\n", QDir::currentPath().toStdString().c_str());
+            kernel::format(KERNEL_FMT("Directory changed to: %s\n"), QDir::currentPath().toStdString().c_str());
         } else {
             ui->textEdit->append("Failed to change directory: " + directory);
-            kernel_printf("Error: Failed to change directory to: %s\n", directory.toStdString().c_str());
+            kernel::format(KERNEL_FMT("Error: Failed to change directory to: %s\n"), directory.toStdString().c_str());
         }
     }
 
@@ -937,20 +994,20 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
         ui->textEdit->append("Command history:");
         for(int i=0; i<commandHistory.size(); i++) {
             QString historyEntry = QString::number(i+1) + ": " + commandHistory[i];
-            kernel_printf("%s\n", historyEntry.toStdString().c_str());
+            kernel::format(KERNEL_FMT("%s\n"), historyEntry.toStdString().c_str());
             ui->textEdit->append(historyEntry);
         }
     }
 
     if (command == "mkdir" && args.size() == 2) {
         QDir().mkdir(args[1]);
-        kernel_printf("Directory %s created\n", args[1].toStdString().c_str());
+        kernel::format(KERNEL_FMT("Directory %s created\n"), args[1].toStdString().c_str());
         return;
     }
 
     if (command == "rmdir" && args.size() == 2) {
         QDir().rmdir(args[1]);
-        kernel_printf("Directory %s removed\n", args[1].toStdString().c_str());
+        kernel::format(KERNEL_FMT("Directory %s removed\n"), args[1].toStdString().c_str());
         return;
     }
 
@@ -960,7 +1017,7 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
 
         // 소스 파일 확인
         if (!QFile::exists(src)) {
-            kernel_printf("Error: Source file does not exist: %s\n", src.toStdString().c_str());
+            kernel::format(KERNEL_FMT("Error: Source file does not exist: %s\n"), src.toStdString().c_str());
             ui->textEdit->append("Error: Source file does not exist: " + src);
             return;
         }
@@ -968,14 +1025,14 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
         // 목적지 파일 경로 유효성 확인 (목적지 폴더가 존재하는지)
         QFileInfo dstInfo(dst);
         if (!dstInfo.dir().exists()) {
-            kernel_printf("Error: Destination directory does not exist: %s\n", dstInfo.dir().absolutePath().toStdString().c_str());
+            kernel::format(KERNEL_FMT("Error: Destination directory does not exist: %s\n"), dstInfo.dir().absolutePath().toStdString().c_str());
             ui->textEdit->append("Error: Destination directory does not exist: " + dstInfo.dir().absolutePath());
             return;
         }
 
         // 파일 복사
         if (QFile::copy(src, dst)) {
-            kernel_printf("File copied from %s to %s\n", src.toStdString().c_str(), dst.toStdString().c_str());
+            kernel::format(KERNEL_FMT("File copied from %s to %s\n"), src.toStdString().c_str(), dst.toStdString().c_str());
             ui->textEdit->append("File copied from " + src + " to " + dst);
         } else {
             kernel_printf("Error: Failed to copy file. Please check permissions or if the file already exists.\n");
@@ -988,7 +1045,7 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
         QString dst = args[2];
 
         if (!QFile::exists(src)) {
-            kernel_printf("Error: Source file does not exist: %s\n", src.toStdString().c_str());
+            kernel::format(KERNEL_FMT("Error: Source file does not exist: %s\n"), src.toStdString().c_str());
             ui->textEdit->append("Error: Source file does not exist: " + src);
             return;
         }
@@ -997,21 +1054,21 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
             kernel_printf("Error: Failed to move file.\n");
             ui->textEdit->append("Error: Failed to move file.");
         } else {
-            kernel_printf("File moved from %s to %s\n", src.toStdString().c_str(), dst.toStdString().c_str());
+            kernel::format(KERNEL_FMT("File moved from %s to %s\n"), src.toStdString().c_str(), dst.toStdString().c_str());
             ui->textEdit->append("File moved from " + src + " to " + dst);
         }
     }
 
     if (command == "rm" && args.size() == 2) {
         QFile::remove(args[1]);
-        kernel_printf("File %s removed\n", args[1].toStdString().c_str());
+        kernel::format(KERNEL_FMT("File %s removed\n"), args[1].toStdString().c_str());
         return;
     }
 
     if (command.startsWith("echo ")) {
         QString message = command.mid(5).trimmed(); // echo 이후의 메시지 추출
         ui->textEdit->append(message); // 화면에 출력
-        kernel_printf("%s\n", message.toStdString().c_str()); // 콘솔에 출력
+        kernel::format(KERNEL_FMT("%s\n"), message.toStdString().c_str()); // 콘솔에 출력
     }
 
     // 디스크 정보 및 로그 관리
@@ -1020,7 +1077,7 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
         process.start("df", QStringList() << "-h");
         process.waitForFinished();
         QString output = process.readAllStandardOutput();
-        kernel_printf("%s", output.toStdString().c_str());
+        kernel::format(KERNEL_FMT("%s"), output.toStdString().c_str());
         ui->textEdit->append(output);
     } else if (command == "du" && args.size() == 2) {
         QString dir = args[1];
@@ -1028,7 +1085,7 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
         process.start("du", QStringList() << "-sh" << dir);
         process.waitForFinished();
         QString output = process.readAllStandardOutput();
-        kernel_printf("%s", output.toStdString().c_str());
+        kernel::format(KERNEL_FMT("%s"), output.toStdString().c_str());
         ui->textEdit->append(output);
     }
 
@@ -1041,13 +1098,13 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
     }
 
     else {
-        kernel_printf("Unknown command: %s\n", command.toStdString().c_str());
+        kernel::format(KERNEL_FMT("Unknown command: %s\n"), command.toStdString().c_str());
     }
 
 
     process.waitForFinished();
     output = process.readAllStandardOutput();
-    kernel_printf("%s", output.toStdString().c_str());
+    kernel::format(KERNEL_FMT("%s"), output.toStdString().c_str());
     ui->textEdit->append(output);  // 명령어 결과를 GUI에 출력
 
     // 스마트 포인터 메모리 사용량을 추적
@@ -1055,11 +1112,11 @@ void CmdWindow::runUnifiedProcess(const QStringList &args) {
     for (int* ptr : smartPointers.keys()) {
         totalMemory += sizeof(*ptr);  // 할당된 포인터 크기를 합산
     }
-    kernel_printf("Total memory used by smart pointers: %d bytes.\n", totalMemory);
+    kernel::format(KERNEL_FMT("Total memory used by smart pointers: %d bytes.\n"), totalMemory);
     ui->textEdit->append("Total memory used by smart pointers: " + QString::number(totalMemory) + " bytes.");
 
     // 스마트 포인터 참조 카운트 체크 후 자동 해제
-    kernel_printf("Smart pointer reference count: %ld\n", processData.use_count());
+    kernel::format(KERNEL_FMT("Smart pointer reference count: %ld\n"), processData.use_count());
     ui->textEdit->append("Smart pointer reference count: " + QString::number(processData.use_count()));
 
     kernel_printf("Smart pointer will be automatically released when out of scope.\n");
@@ -1108,7 +1165,8 @@ void CmdWindow::resetSmartPointer() {
 
 /*
  * @brief 멀티스레딩 테스트 실행
- * @details 사용자로부터 스레드 수와 세마포어 사용 여부를 입력받아, 멀티스레딩 테스트를 실행합니다.
+ * @details 사용자로부터 스레드 수, 잠금 종류, 임계 구역 길이, 유휴/임계 구역 비율과 스레드 배치를
+ *          입력받아 잠금 경합을 측정하고 처리량, 공정성, 획득 지연 히스토그램을 표시합니다.
  */
 void CmdWindow::runMultithreadingTest() {
     bool ok;
@@ -1116,9 +1174,32 @@ void CmdWindow::runMultithreadingTest() {
                                            tr("Enter the number of threads:"), 3, 1, 100, 1, &ok);
     if (!ok) return;
 
-    int use_semaphore = QInputDialog::getInt(this, tr("Synchronization Method"),
-                                             tr("Use semaphore? (0: Mutex, 1: Semaphore)"), 0, 0, 1, 1, &ok);
-    if (!ok || (use_semaphore != 0 && use_semaphore != 1)) return;
+    QStringList lockNames;
+    for (int kind = 0; kind < KLOCK_COUNT; kind++) {
+        lockNames << QString::fromUtf8(contention_lock_name(static_cast<KLockKind>(kind)));
+    }
+    lockNames << "all";
+    QString lockName = QInputDialog::getItem(this, tr("Synchronization Method"),
+                                             tr("Lock to measure:"), lockNames, 0, false, &ok);
+    if (!ok) return;
+
+    int hold_ns = QInputDialog::getInt(this, tr("Critical Section"),
+                                       tr("Critical section length (ns):"), 1000, 0, 1000000, 100, &ok);
+    if (!ok) return;
+
+    double ratio = QInputDialog::getDouble(this, tr("Hold/Idle Ratio"),
+                                           tr("Idle time per critical section (x hold time):"), 1.0, 0.0, 1000.0, 2, &ok);
+    if (!ok) return;
+
+    QStringList placementNames = { "none", "compact", "spread" };
+    QString placementName = QInputDialog::getItem(this, tr("Thread Placement"),
+                                                  tr("Pin threads to CPUs:"), placementNames, 0, false, &ok);
+    if (!ok) return;
+
+    KPlacement placement;
+    if (kplacement_parse(&placement, placementName.toUtf8().constData()) != 0) {
+        QMessageBox::warning(this, tr("Thread Placement"), tr("No CPUs available for placement; threads are not pinned."));
+    }
 
     QDialog *threadDialog = new QDialog(this);
     QVBoxLayout *layout = new QVBoxLayout(threadDialog);
@@ -1138,12 +1219,34 @@ void CmdWindow::runMultithreadingTest() {
     // 진행 상황을 실시간으로 UI에 표시
     progressLog->append("Starting multithreading test with " + QString::number(num_threads) + " threads...");
     QCoreApplication::processEvents();
-    kernel_printf("Starting multithreading test with %d threads...\n", num_threads);
-    kernel_printf("Using %s\n", use_semaphore ? "semaphore" : "mutex");
+    kernel::format(KERNEL_FMT("Starting multithreading test with %d threads...\n"), num_threads);
+    kernel::format(KERNEL_FMT("Using %s\n"), lockName.toUtf8().constData());
     kernel_printf("\n");
 
-    // 멀티스레드 실행
-    run_multithreading(num_threads, use_semaphore);
+    KContentionConfig config;
+    config.num_threads = num_threads;
+    config.hold_ns = static_cast<uint32_t>(hold_ns);
+    config.idle_ns = static_cast<uint32_t>(hold_ns * ratio + 0.5);
+    config.duration_ms = 200;
+    config.placement = &placement;
+
+    // 잠금별 경합 측정
+    for (int kind = 0; kind < KLOCK_COUNT; kind++) {
+        if (lockName != "all" && lockName != lockNames[kind]) {
+            continue;
+        }
+
+        KContentionResult result;
+        if (contention_run(static_cast<KLockKind>(kind), &config, &result) != 0) {
+            progressLog->append("Contention test failed for " + lockNames[kind] + ".");
+            continue;
+        }
+
+        char report[4096];
+        contention_format_result(&result, report, sizeof(report));
+        progressLog->append(QString::fromUtf8(report));
+        QCoreApplication::processEvents();
+    }
 
     progressLog->append("Multithreading test completed.");
     QCoreApplication::processEvents();
@@ -1182,7 +1285,7 @@ void CmdWindow::runSemaphoreTest() {
     // 진행 상황을 실시간으로 UI에 표시
     progressLog->append("Starting semaphore test with " + QString::number(num_threads) + " threads...");
     QCoreApplication::processEvents();
-    kernel_printf("Starting semaphore test with %d threads...\n", num_threads);
+    kernel::format(KERNEL_FMT("Starting semaphore test with %d threads...\n"), num_threads);
     kernel_printf("\n");
 
     // 세마포어 테스트 진행
@@ -1225,7 +1328,7 @@ void CmdWindow::runMutexTest() {
     // 진행 상황을 실시간으로 UI에 표시
     progressLog->append("Starting mutex test with " + QString::number(num_threads) + " threads...");
     QCoreApplication::processEvents();
-    kernel_printf("Starting mutex test with %d threads...\n", num_threads);
+    kernel::format(KERNEL_FMT("Starting mutex test with %d threads...\n"), num_threads);
     kernel_printf("\n");
 
     // 뮤텍스 테스트 진행
@@ -1244,45 +1347,64 @@ void CmdWindow::runMutexTest() {
  * @brief kernel_printf와 함께 가변 인자를 처리하는 함수
  * @param format 포맷 문자열
  * @param args 가변 인자 리스트
- * @details 이 함수는 QString 포맷 문자열과 QVariantList 인자를 받아, kernel_printf를 호출하여 C 스타일로 포맷된 출력을 수행합니다.
+ * @details 이 함수는 QString 포맷 문자열과 QVariantList 인자를 받아, 인자마다 종류 태그를 붙여 kfmt_print_args로 출력합니다.
+ *          포맷의 각 변환과 인자 종류를 출력 전에 확인하므로 인자 개수에 제한이 없고, 맞지 않는 인자는 오류로 표시합니다.
  */
 void CmdWindow::executeKernelPrintf(const QString &format, const QVariantList &args) {
     QString modifiedFormat = format;
     modifiedFormat.replace("\\n", "\n"); // 개행 처리
     QByteArray formatArray = modifiedFormat.toUtf8();
-    const char *cFormat = formatArray.data();
 
-    if (args.isEmpty()) {
-        kernel_printf(cFormat);
-        return;
+    std::vector<KFmtArg> tagged(args.size());
+    std::vector<QByteArray> strings;    // 문자열 인자가 출력할 때까지 유지되도록 보관
+    strings.reserve(args.size());
+
+    for (int i = 0; i < args.size(); ++i) {
+        const QVariant &arg = args[i];
+        KFmtArg &t = tagged[i];
+
+        switch (arg.userType()) {
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+            t.type = KFMT_ARG_INT;
+            t.v.i = arg.toLongLong();
+            break;
+        case QMetaType::UInt:
+        case QMetaType::ULongLong:
+            t.type = KFMT_ARG_UINT;
+            t.v.u = arg.toULongLong();
+            break;
+        case QMetaType::Double:
+            t.type = KFMT_ARG_DOUBLE;
+            t.v.d = arg.toDouble();
+            break;
+        case QMetaType::QChar:
+            t.type = KFMT_ARG_INT;
+            t.v.i = arg.toChar().toLatin1();
+            break;
+        default:
+            strings.push_back(arg.toString().toUtf8());
+            t.type = KFMT_ARG_STRING;
+            t.v.s = strings.back().constData();
+            break;
+        }
     }
 
-    switch (args.size()) {
-    case 1:
-        if (format.contains("%f")) {
-            kernel_printf(cFormat, args[0].toDouble());
-        } else if (format.contains("%c")) {
-            kernel_printf(cFormat, args[0].toChar().toLatin1());
-        } else {
-            kernel_printf(cFormat, args[0].toInt());
-        }
+    size_t where = 0;
+    switch (kfmt_print_args(formatArray.constData(), tagged.data(), tagged.size(), &where)) {
+    case KFMT_OK:
         break;
-    case 2:
-        if (format.contains("%f")) {
-            kernel_printf(cFormat, args[0].toDouble(), args[1].toDouble());
-        } else {
-            kernel_printf(cFormat, args[0].toInt(), args[1].toInt());
-        }
+    case KFMT_ETYPE:
+        ui->textEdit->append(QString("Error: argument %1 does not match its conversion.").arg(where + 1));
         break;
-    case 3:
-        if (format.contains("%f")) {
-            kernel_printf(cFormat, args[0].toDouble(), args[1].toDouble(), args[2].toDouble());
-        } else {
-            kernel_printf(cFormat, args[0].toInt(), args[1].toInt(), args[2].toInt());
-        }
+    case KFMT_ECOUNT:
+        ui->textEdit->append(QString("Error: format expects %1 argument(s), got %2.").arg(where).arg(args.size()));
+        break;
+    case KFMT_EFORMAT:
+        ui->textEdit->append("Error: unsupported conversion in format.");
         break;
     default:
-        kernel_printf("Error: Unsupported number of arguments.\n");
+        ui->textEdit->append("Error: out of memory.");
         break;
     }
 }
@@ -1293,6 +1415,7 @@ void CmdWindow::executeKernelPrintf(const QString &format, const QVariantList &a
  * @param arguments 콤마로 구분된 문자열 인자 목록
  * @return QVariantList 파싱된 인자 리스트
  * @details 이 함수는 문자열로 전달된 인자 목록을 파싱하여 QVariantList로 반환합니다.
+ *          0x로 시작하는 16진수는 부호 없는 정수가 되며, %p 변환에는 주소 값으로 출력됩니다.
  */
 QVariantList CmdWindow::parseArguments(const QString &arguments) {
     QVariantList parsedArgs;
@@ -1302,6 +1425,8 @@ QVariantList CmdWindow::parseArguments(const QString &arguments) {
         arg = arg.trimmed();
         if (arg.endsWith('U')) {
             parsedArgs.append(arg.left(arg.length() - 1).toUInt());
+        } else if (arg.contains(QRegularExpression("^0[xX][0-9a-fA-F]+$"))) {  // 16진수 (주소 값 등, %p에도 사용)
+            parsedArgs.append(arg.toULongLong(nullptr, 0));
         } else if (arg.contains(QRegularExpression("^-?\\d*\\.\\d+$"))) {  // 소수점을 포함하는 경우
             parsedArgs.append(arg.toDouble());
         } else if (arg.contains(QRegularExpression("\\d+"))) {
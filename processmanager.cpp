@@ -10,6 +10,9 @@
 #include "processmanager.h"
 #include "kernel_lib.h"
 
+#include <mutex>
+#include <shared_mutex>
+
 /*
  * @brief 프로세스 생성 함수
  * @param name 생성할 프로세스의 이름
@@ -17,6 +20,7 @@
  * @details 새로운 프로세스를 생성하고, 프로세스 목록에 추가합니다.
  */
 int ProcessManager::createProcess(const std::string& name) {
+    std::unique_lock<kernel::shared_rwlock> guard(lock);
     Process process;
     process.pid = next_pid++;
     process.name = name;
@@ -34,6 +38,7 @@ int ProcessManager::createProcess(const std::string& name) {
  * @details 주어진 PID를 가진 프로세스를 종료합니다. 프로세스가 실행 중이지 않은 경우 종료에 실패합니다.
  */
 bool ProcessManager::killProcess(int pid) {
+    std::unique_lock<kernel::shared_rwlock> guard(lock);
     auto it = processes.find(pid);
     if (it != processes.end() && it->second.running) {
         it->second.running = false;
@@ -49,6 +54,7 @@ bool ProcessManager::killProcess(int pid) {
  * @details 현재 관리 중인 모든 프로세스의 목록을 출력합니다. 각 프로세스의 PID, 이름, 상태(실행 중/중지됨)를 포함합니다.
  */
 void ProcessManager::listProcesses() const {
+    std::shared_lock<kernel::shared_rwlock> guard(lock);
     std::cout << "PID\tName\t\tStatus\n";
     std::cout << "---------------------------------\n";
     for (const auto& [pid, process] : processes) {
@@ -16,6 +16,8 @@
 #include <unordered_map>
 #include <unistd.h>
 
+#include "kernel_rwlock.h"
+
 // C 언어로 작성된 kernel_create_process 함수 선언을 위한 extern "C" 블록
 extern "C" {
     bool kernel_create_process(const char *process_name);
@@ -31,7 +33,7 @@ struct Process {
 
 class ProcessManager {
 public:
-    ProcessManager() : next_pid(1) {}
+    ProcessManager() : next_pid(1), lock("ProcessManager") {}
 
     int createProcess(const std::string& name);
     bool killProcess(int pid);
@@ -40,6 +42,7 @@ public:
 private:
     int next_pid;
     std::unordered_map<int, Process> processes;
+    mutable kernel::shared_rwlock lock; // 목록 조회는 동시에, 생성/종료는 단독으로 수행
 };
 
 #endif // PROCESSMANAGER_H